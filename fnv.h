@@ -100,10 +100,12 @@
 #if !defined(__FNV_H__)
 #define __FNV_H__
 
+#include <stdio.h>
 #include <stdint.h>
+#include <signal.h>
 #include <sys/types.h>
 
-#define FNV_VERSION "5.0.7 2025-11-19"	     /* format: major.minor YYYY-MM-DD */
+#define FNV_VERSION "5.1.0 2026-10-19"	     /* format: major.minor YYYY-MM-DD */
 
 
 /*
@@ -192,6 +194,16 @@ extern const Fnv64_t fnv1a_64_init;
 #endif /* HAVE_64BIT_LONG_LONG */
 
 
+/*
+ * prefetch the memory at p, for batched lookups
+ */
+#if defined(__GNUC__)
+#define FNV_PREFETCH(p) __builtin_prefetch(p)
+#else /* __GNUC__ */
+#define FNV_PREFETCH(p)
+#endif /* __GNUC__ */
+
+
 /*
  * hash types
  */
@@ -206,6 +218,23 @@ enum fnv_type {
 };
 
 
+/*
+ * fnv64 --serve coprocess protocol
+ *
+ * A request is an FNV_SERVE_REQ_SIZE octet header: hash type (enum
+ * fnv_type), flags, 2 reserved zero octets and a 32 bit little endian
+ * payload length, followed by the payload.  A response is
+ * FNV_SERVE_RESP_SIZE octets: status, hash type, 6 zero octets and the
+ * 64 bit little endian hash value.  See README.md for details.
+ */
+#define FNV_SERVE_REQ_SIZE 8	/* octets in a request header */
+#define FNV_SERVE_RESP_SIZE 16	/* octets in a response */
+#define FNV_SERVE_CONTINUE 0x01	/* flag: continue from the last hash */
+#define FNV_SERVE_OK 0		/* status: hash value is valid */
+#define FNV_SERVE_BAD_TYPE 1	/* status: unknown hash type */
+#define FNV_SERVE_BAD_FLAGS 2	/* status: unknown flag or reserved octet */
+
+
 /*
  * these test vectors are used as part o the FNV test suite
  */
@@ -239,24 +268,357 @@ struct fnv1a_64_test_vector {
 };
 
 
+/*
+ * file hash cache statistics
+ */
+struct fnv_cache;		/* open hash cache, see fnv_cache.c */
+struct fnv_cache_stat {
+    unsigned long long lookups;	/* number of cache lookups */
+    unsigned long long hits;	/* lookups that found an unchanged file */
+    unsigned long long misses;	/* lookups that did not */
+    unsigned long long stores;	/* hashes recorded in the cache */
+};
+struct stat;
+
+
+/*
+ * hashing context that may be saved and restored, see fnv_ctx.c
+ */
+struct fnv_ctx {
+    enum fnv_type type;	/* type of FNV hash */
+    Fnv64_t hval;	/* hash value so far, 32 bit hashes in the low bits */
+    off_t offset;	/* number of octets hashed so far */
+    off_t size;		/* size of the hashed file, -1 ==> not a file */
+    time_t mtime;	/* modification time of the hashed file */
+    long mtime_nsec;	/* nanoseconds of mtime */
+};
+#define FNV_CTX_SIZE 56	/* octets in a serialized struct fnv_ctx */
+
+
+/*
+ * per-block hashes of a file, see fnv_sidecar.c
+ */
+struct fnv_sidecar {
+    enum fnv_type type;	/* 64 bit type of FNV hash */
+    off_t blksize;	/* block size in octets */
+    off_t size;		/* file size in octets */
+    time_t mtime;	/* file modification time */
+    long mtime_nsec;	/* nanoseconds of mtime */
+    Fnv64_t hval;	/* hash of the whole file */
+    off_t nblock;	/* number of blocks */
+    Fnv64_t *block;	/* hash of each block */
+};
+
+
+/*
+ * Merkle tree of a directory, see fnv_tree.c
+ */
+struct fnv_tree;		/* directory tree hashes */
+struct fnv_tree_stat {
+    unsigned long long nodes;	/* files, links and directories visited */
+    unsigned long long hashed;	/* files and links read and hashed */
+    unsigned long long reused;	/* unchanged hashes taken from the old tree */
+    char errpath[1024];		/* path that caused an error */
+};
+
+
+/*
+ * memory mapped table of file hashes, see fnv_manifest.c and fnv_watch.c
+ */
+struct fnv_manifest;		/* open manifest */
+struct fnv_watch_stat {
+    unsigned long long events;	/* inotify events handled */
+    unsigned long long dirs;	/* directories watched */
+    unsigned long long hashed;	/* files hashed into the manifest */
+    unsigned long long removed;	/* paths removed from the manifest */
+    unsigned long long overflows;	/* event queue overflows */
+    unsigned long long errors;	/* files that could not be hashed */
+    char errpath[1024];		/* path that caused an error */
+};
+
+
 /*
  * external functions
  */
 /* hash_32.c */
 extern Fnv32_t fnv_32_buf(void *buf, size_t len, Fnv32_t hashval);
 extern Fnv32_t fnv_32_str(char *buf, Fnv32_t hashval);
+extern Fnv32_t fnv_32_zeros(Fnv32_t hashval, off_t n);
 
 /* hash_32a.c */
 extern Fnv32_t fnv_32a_buf(void *buf, size_t len, Fnv32_t hashval);
 extern Fnv32_t fnv_32a_str(char *buf, Fnv32_t hashval);
+extern Fnv32_t fnv_32a_zeros(Fnv32_t hashval, off_t n);
 
 /* hash_64.c */
 extern Fnv64_t fnv_64_buf(void *buf, size_t len, Fnv64_t hashval);
 extern Fnv64_t fnv_64_str(char *buf, Fnv64_t hashval);
+extern Fnv64_t fnv_64_zeros(Fnv64_t hashval, off_t n);
 
 /* hash_64a.c */
 extern Fnv64_t fnv_64a_buf(void *buf, size_t len, Fnv64_t hashval);
 extern Fnv64_t fnv_64a_str(char *buf, Fnv64_t hashval);
+extern Fnv64_t fnv_64a_zeros(Fnv64_t hashval, off_t n);
+extern unsigned long long fnv_mix64(unsigned long long x);
+extern unsigned long long fnv_64a_mix(const void *buf, size_t len,
+				      unsigned long long seed);
+
+/* fnv_cache.c */
+extern struct fnv_cache *fnv_cache_open(char *path);
+extern int fnv_cache_lookup(struct fnv_cache *c, struct stat *st,
+			    enum fnv_type type, void *basis, void *hval,
+			    size_t hlen);
+extern int fnv_cache_store(struct fnv_cache *c, struct stat *st,
+			   enum fnv_type type, void *basis, void *hval,
+			   size_t hlen);
+extern int fnv_cache_same(struct stat *a, struct stat *b);
+extern void fnv_cache_getstat(struct fnv_cache *c, struct fnv_cache_stat *stat);
+extern void fnv_cache_close(struct fnv_cache *c);
+
+/* fnv_file.c */
+extern Fnv64_t fnv_buf_64(enum fnv_type type, void *buf, size_t len,
+			  Fnv64_t hval);
+extern Fnv64_t fnv_zeros_64(enum fnv_type type, off_t n, Fnv64_t hval);
+extern int fnv_range_64(int fd, enum fnv_type type, off_t offset,
+			off_t length, Fnv64_t *hval);
+extern int fnv_sample_64(int fd, enum fnv_type type, int nblock,
+			 size_t blksize, Fnv64_t *hval);
+extern int fnv_parse_size(char *str, off_t *size);
+
+/* fnv_ctx.c */
+extern void fnv_ctx_export(struct fnv_ctx *ctx, unsigned char *buf);
+extern int fnv_ctx_import(struct fnv_ctx *ctx, unsigned char *buf, size_t len);
+extern int fnv_ctx_save(struct fnv_ctx *ctx, char *path);
+extern int fnv_ctx_load(struct fnv_ctx *ctx, char *path);
+
+/* fnv_sidecar.c */
+extern int fnv_sidecar_create(int fd, enum fnv_type type, off_t blksize,
+			      struct fnv_sidecar *sc);
+extern int fnv_sidecar_write(struct fnv_sidecar *sc, char *path);
+extern int fnv_sidecar_read(struct fnv_sidecar *sc, char *path);
+extern void fnv_sidecar_free(struct fnv_sidecar *sc);
+extern off_t fnv_sidecar_verify(int fd, struct fnv_sidecar *sc, off_t offset,
+				off_t length, int nthread, unsigned char *bad);
+
+/* fnv_tree.c */
+extern struct fnv_tree *fnv_tree_build(char *dir, enum fnv_type type,
+				       struct fnv_tree *old,
+				       struct fnv_tree_stat *stat);
+extern Fnv64_t fnv_tree_hash(struct fnv_tree *t);
+extern enum fnv_type fnv_tree_hash_type(struct fnv_tree *t);
+extern int fnv_tree_save(struct fnv_tree *t, char *path);
+extern struct fnv_tree *fnv_tree_load(char *path);
+extern unsigned long long fnv_tree_diff(struct fnv_tree *a, struct fnv_tree *b,
+					FILE *out);
+extern void fnv_tree_free(struct fnv_tree *t);
+
+/* fnv_manifest.c */
+extern struct fnv_manifest *fnv_manifest_create(char *path, enum fnv_type type,
+						size_t nfile);
+extern struct fnv_manifest *fnv_manifest_open(char *path);
+extern void fnv_manifest_close(struct fnv_manifest *m);
+extern enum fnv_type fnv_manifest_hash_type(struct fnv_manifest *m);
+extern int fnv_manifest_same_file(struct fnv_manifest *m, struct stat *st);
+extern int fnv_manifest_lookup(struct fnv_manifest *m, char *path,
+			       Fnv64_t *hval, off_t *size, long long *mtime_ns);
+extern int fnv_manifest_update(struct fnv_manifest *m, char *path,
+			       Fnv64_t hval, off_t size, long long mtime_ns);
+extern unsigned long fnv_manifest_remove(struct fnv_manifest *m, char *path,
+					 int subtree);
+extern void fnv_manifest_walk(struct fnv_manifest *m,
+			      void (*fn)(char *path, void *arg), void *arg);
+
+/* fnv_watch.c */
+extern int fnv_watch(char *dir, enum fnv_type type, char *mpath, int nthread,
+		     int debounce_ms, FILE *log, volatile sig_atomic_t *stop,
+		     struct fnv_watch_stat *stat);
+
+/* fnv_tar.c */
+extern long long fnv_tar_hash(int fd, enum fnv_type type,
+			      void (*fn)(char *path, Fnv64_t hval, off_t size,
+					 void *arg),
+			      void *arg);
+
+/* fnv_map.c */
+struct fnv_map;			/* hash table, see fnv_map.c */
+extern struct fnv_map *fnv_map_new(size_t hint);
+extern void fnv_map_free(struct fnv_map *m);
+extern size_t fnv_map_count(struct fnv_map *m);
+extern int fnv_map_put(struct fnv_map *m, const void *key, size_t len,
+		       void *val);
+extern int fnv_map_get(struct fnv_map *m, const void *key, size_t len,
+		       void **val);
+extern size_t fnv_map_get_batch(struct fnv_map *m, size_t n,
+				const void * const *key, const size_t *len,
+				void **val);
+extern int fnv_map_del(struct fnv_map *m, const void *key, size_t len);
+extern int fnv_map_next(struct fnv_map *m, size_t *iter, const void **key,
+			size_t *len, void **val);
+
+/* fnv_cmap.c */
+struct fnv_cmap;		/* concurrent hash table, see fnv_cmap.c */
+extern struct fnv_cmap *fnv_cmap_new(size_t hint);
+extern void fnv_cmap_free(struct fnv_cmap *m);
+extern size_t fnv_cmap_count(struct fnv_cmap *m);
+extern int fnv_cmap_put(struct fnv_cmap *m, const void *key, size_t len,
+			void *val, void **old);
+extern int fnv_cmap_get(struct fnv_cmap *m, const void *key, size_t len,
+			void **val);
+extern int fnv_cmap_del(struct fnv_cmap *m, const void *key, size_t len,
+			void **old);
+extern int fnv_cmap_enter(void);
+extern void fnv_cmap_exit(void);
+extern int fnv_cmap_retire(void *ptr, void (*fn)(void *));
+
+/* fnv_bloom.c */
+struct fnv_bloom;		/* blocked Bloom filter, see fnv_bloom.c */
+extern struct fnv_bloom *fnv_bloom_new(unsigned long long nkey, double fpr);
+extern struct fnv_bloom *fnv_bloom_open(char *path);
+extern int fnv_bloom_save(struct fnv_bloom *b, char *path);
+extern void fnv_bloom_free(struct fnv_bloom *b);
+extern double fnv_bloom_info(struct fnv_bloom *b, unsigned long long *nbit,
+			     int *k, unsigned long long *nkey);
+extern void fnv_bloom_add(struct fnv_bloom *b, const void *key, size_t len);
+extern int fnv_bloom_has(struct fnv_bloom *b, const void *key, size_t len);
+extern void fnv_bloom_add_batch(struct fnv_bloom *b, size_t n,
+				const void * const *key, const size_t *len);
+extern size_t fnv_bloom_has_batch(struct fnv_bloom *b, size_t n,
+				  const void * const *key, const size_t *len,
+				  unsigned char *out);
+
+/* fnv_cuckoo.c */
+struct fnv_cuckoo;		/* cuckoo filter, see fnv_cuckoo.c */
+extern struct fnv_cuckoo *fnv_cuckoo_new(unsigned long long nkey, int bits);
+extern struct fnv_cuckoo *fnv_cuckoo_open(char *path);
+extern int fnv_cuckoo_save(struct fnv_cuckoo *c, char *path);
+extern void fnv_cuckoo_free(struct fnv_cuckoo *c);
+extern double fnv_cuckoo_info(struct fnv_cuckoo *c, unsigned long long *nbit,
+			      int *bits, unsigned long long *nkey);
+extern int fnv_cuckoo_add(struct fnv_cuckoo *c, const void *key, size_t len);
+extern int fnv_cuckoo_has(struct fnv_cuckoo *c, const void *key, size_t len);
+extern int fnv_cuckoo_del(struct fnv_cuckoo *c, const void *key, size_t len);
+extern size_t fnv_cuckoo_add_batch(struct fnv_cuckoo *c, size_t n,
+				   const void * const *key,
+				   const size_t *len);
+extern size_t fnv_cuckoo_has_batch(struct fnv_cuckoo *c, size_t n,
+				   const void * const *key,
+				   const size_t *len, unsigned char *out);
+
+/* fnv_sketch.c */
+struct fnv_cms;			/* count-min sketch, see fnv_sketch.c */
+struct fnv_topk;		/* Space-Saving top-K, see fnv_sketch.c */
+struct fnv_topk_item {
+    const char *key;		/* key, not NUL terminated */
+    size_t len;			/* key length */
+    unsigned long long count;	/* count, over by at most err */
+    unsigned long long err;	/* most count may be over */
+};
+extern struct fnv_cms *fnv_cms_new(double eps, double delta);
+extern void fnv_cms_free(struct fnv_cms *c);
+extern void fnv_cms_add(struct fnv_cms *c, const void *key, size_t len,
+			unsigned long long n);
+extern unsigned long long fnv_cms_count(struct fnv_cms *c, const void *key,
+					size_t len);
+extern unsigned long long fnv_cms_total(struct fnv_cms *c);
+extern int fnv_cms_merge(struct fnv_cms *dst, struct fnv_cms *src);
+extern struct fnv_topk *fnv_topk_new(size_t m);
+extern void fnv_topk_free(struct fnv_topk *t);
+extern int fnv_topk_add(struct fnv_topk *t, const void *key, size_t len,
+			unsigned long long n);
+extern int fnv_topk_lines(struct fnv_topk *t, const char *buf, size_t len);
+extern unsigned long long fnv_topk_total(struct fnv_topk *t);
+extern size_t fnv_topk_list(struct fnv_topk *t, size_t k,
+			    struct fnv_topk_item *out);
+extern int fnv_topk_merge(struct fnv_topk *dst, struct fnv_topk *src);
+
+/* fnv_hll.c */
+struct fnv_hll;			/* HyperLogLog++ counter, see fnv_hll.c */
+extern struct fnv_hll *fnv_hll_new(unsigned int p);
+extern void fnv_hll_free(struct fnv_hll *h);
+extern int fnv_hll_add(struct fnv_hll *h, const void *key, size_t len);
+extern int fnv_hll_lines(struct fnv_hll *h, const char *buf, size_t len);
+extern int fnv_hll_merge(struct fnv_hll *dst, struct fnv_hll *src);
+extern unsigned long long fnv_hll_count(struct fnv_hll *h);
+
+/* fnv_shard.c */
+enum fnv_shard_type {
+    FNV_SHARD_JUMP = 0,		/* jump consistent hash */
+    FNV_SHARD_HRW,		/* weighted rendezvous hash */
+    FNV_SHARD_RING		/* ring of virtual nodes */
+};
+struct fnv_shard;		/* set of nodes, see fnv_shard.c */
+extern int fnv_jump(const void *key, size_t len, int nbucket);
+extern struct fnv_shard *fnv_shard_new(enum fnv_shard_type type,
+				       unsigned int vnodes);
+extern void fnv_shard_free(struct fnv_shard *s);
+extern int fnv_shard_add(struct fnv_shard *s, const char *name,
+			 double weight);
+extern int fnv_shard_del(struct fnv_shard *s, const char *name);
+extern const char *fnv_shard_name(struct fnv_shard *s, int id);
+extern int fnv_shard_ids(struct fnv_shard *s);
+extern int fnv_shard_lookup(struct fnv_shard *s, const void *key,
+			    size_t len);
+extern void fnv_shard_lookup_batch(struct fnv_shard *s, size_t n,
+				   const void * const *key,
+				   const size_t *len, int *out);
+
+/* fnv_intern.c */
+#define FNV_INTERN_NONE ((uint32_t)0xffffffff)	/* no string id */
+struct fnv_intern;		/* string interning pool, see fnv_intern.c */
+struct fnv_intern_local;	/* per-thread front cache of a pool */
+struct fnv_intern_stat {
+    unsigned long long count;	/* distinct strings */
+    unsigned long long bytes;	/* octets of strings, with NULs */
+    unsigned long long arena;	/* octets of arena chunks */
+    unsigned long long table;	/* octets of hash table and id index */
+    unsigned long long allocs;	/* memory allocations made */
+};
+extern struct fnv_intern *fnv_intern_new(size_t hint);
+extern void fnv_intern_free(struct fnv_intern *p);
+extern uint32_t fnv_intern(struct fnv_intern *p, const void *str,
+			   size_t len);
+extern int fnv_intern_batch(struct fnv_intern *p, size_t n,
+			    const void * const *str, const size_t *len,
+			    uint32_t *id);
+extern uint32_t fnv_intern_find(struct fnv_intern *p, const void *str,
+				size_t len);
+extern const char *fnv_intern_str(struct fnv_intern *p, uint32_t id,
+				  size_t *len);
+extern void fnv_intern_stats(struct fnv_intern *p,
+			     struct fnv_intern_stat *st);
+extern struct fnv_intern_local *fnv_intern_local_new(struct fnv_intern *p,
+						     size_t size);
+extern void fnv_intern_local_free(struct fnv_intern_local *l);
+extern uint32_t fnv_intern_local(struct fnv_intern_local *l,
+				 const void *str, size_t len);
+
+/* fnv_minhash.c */
+struct fnv_minhash;		/* MinHash functions, see fnv_minhash.c */
+struct fnv_lsh;			/* LSH banding index, see fnv_minhash.c */
+extern size_t fnv_shingle(const void *text, size_t len, int w,
+			  unsigned long long seed, unsigned long long *out,
+			  size_t max);
+extern struct fnv_minhash *fnv_minhash_new(int k, unsigned long long seed);
+extern void fnv_minhash_free(struct fnv_minhash *m);
+extern void fnv_minhash_sig(struct fnv_minhash *m,
+			    const unsigned long long *shingle, size_t n,
+			    uint32_t *sig);
+extern double fnv_minhash_sim(const uint32_t *a, const uint32_t *b, int k);
+extern unsigned long long fnv_simhash(const unsigned long long *shingle,
+				      size_t n);
+extern int fnv_simhash_dist(unsigned long long a, unsigned long long b);
+extern struct fnv_lsh *fnv_lsh_new(int bands, int rows);
+extern void fnv_lsh_free(struct fnv_lsh *l);
+extern int fnv_lsh_add(struct fnv_lsh *l, uint32_t id, const uint32_t *sig);
+extern size_t fnv_lsh_query(struct fnv_lsh *l, const uint32_t *sig,
+			    uint32_t *id, unsigned int *nband, size_t max);
+
+/* fnv_reader.c */
+struct fnv_reader;		/* read ahead thread, see fnv_reader.c */
+extern struct fnv_reader *fnv_reader_start(int fd, int nbuf, size_t bufsize);
+extern ssize_t fnv_reader_next(struct fnv_reader *r, char **data);
+extern void fnv_reader_release(struct fnv_reader *r);
+extern unsigned long long fnv_reader_finish(struct fnv_reader *r);
 
 /* test_fnv.c */
 extern struct test_vector fnv_test_str[];
@@ -269,6 +631,8 @@ extern struct fnv1a_64_test_vector fnv1a_64_vector[];
 extern void unknown_hash_type(char *prog, enum fnv_type type);
 extern void print_fnv32(Fnv32_t hval, Fnv32_t mask, int verbose, char *arg);
 extern void print_fnv64(Fnv64_t hval, Fnv64_t mask, int verbose, char *arg);
+extern void fprint_fnv64(FILE *stream, Fnv64_t hval, Fnv64_t mask,
+			 int verbose, char *arg);
 
 
 #endif /* __FNV_H__ */
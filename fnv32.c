@@ -81,15 +81,20 @@
 #include <fcntl.h>
 #include <string.h>
 #include <strings.h>
+#include <errno.h>
+#include <getopt.h>
 #include "longlong.h"
 #include "fnv.h"
 
 #define WIDTH 32		/* bit width of hash */
 
 #define BUF_SIZE (32*1024)	/* number of bytes to hash at a time */
+#define READER_BUFS 4		/* --pipeline ring buffers */
+#define READER_BUF_SIZE (1024*1024)	/* --pipeline ring buffer size */
 
 static const char * const usage =
-"usage: %s [-h] [-v] [-V] [-b bcnt] [-m] [-s arg] [-t code] [arg ...]\n"
+"usage: %s [-h] [-v] [-V] [-b bcnt] [-m] [-s arg] [-t code]\n"
+"	[--cache file [--cache-stats]] [--pipeline] [arg ...]\n"
 "\n"
 "    -h         print help and exit\n"
 "    -v         verbose mode, print arg after hash (implies -m)\n"
@@ -101,6 +106,13 @@ static const char * const usage =
 "    -t code    test hash code: (0 ==> generate test vectors\n"
 "                                1 ==> validate against FNV test vectors)\n"
 "\n"
+"    --cache file    consult and update the file hash cache in file\n"
+"                    (only the first file arg: each later one continues\n"
+"                    the hash of the args before it)\n"
+"    --cache-stats   print cache hit rate on stderr when done\n"
+"\n"
+"    --pipeline      read with a separate thread so that I/O overlaps hashing\n"
+"\n"
 "    arg        string (if -s was given) or filename (default stdin)\n"
 "\n"
 "Exit codes:\n"
@@ -122,6 +134,23 @@ static const char * const usage =
 "%s version: %s\n";
 static char *program = NULL;	/* our name */
 static char *prog = NULL;	/* basename of our name */
+static struct fnv_cache *cache = NULL;	/* open --cache file or NULL */
+static int pipeline = 0;	/* 1 ==> --pipeline read ahead thread */
+
+/*
+ * long only options
+ */
+enum long_opt {
+    OPT_CACHE = 256,		/* --cache file */
+    OPT_CACHE_STATS,		/* --cache-stats */
+    OPT_PIPELINE,		/* --pipeline */
+};
+static const struct option long_opts[] = {
+    {"cache", required_argument, NULL, OPT_CACHE},
+    {"cache-stats", no_argument, NULL, OPT_CACHE_STATS},
+    {"pipeline", no_argument, NULL, OPT_PIPELINE},
+    {NULL, 0, NULL, 0}
+};
 
 
 /*
@@ -267,6 +296,174 @@ test_fnv32(enum fnv_type hash_type, Fnv32_t init_hval,
 }
 
 
+/*
+ * hash_pipeline - hash an open file until EOF using a read ahead thread
+ *
+ * given:
+ *	fd		open file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *	name		filename for error messages
+ *
+ * returns:	hash value after hashing the rest of the file
+ *
+ * A reader thread fills a ring of large aligned buffers while this
+ * thread hashes them, so that the time taken is about the greater of
+ * the I/O time and the hash time rather than their sum.  The reader
+ * thread skips the holes of a sparse file, which are hashed as runs of
+ * zero octets without being read.
+ *
+ * NOTE: This function does not return on a read error.
+ */
+static Fnv32_t
+hash_pipeline(int fd, enum fnv_type hash_type, Fnv32_t hval, char *name)
+{
+    struct fnv_reader *r;	/* read ahead thread */
+    char *data;			/* full buffer */
+    ssize_t len;		/* octets in the buffer */
+
+    r = fnv_reader_start(fd, READER_BUFS, READER_BUF_SIZE);
+    if (r == NULL) {
+	fprintf(stderr, "%s: unable to start reader thread: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    while ((len = fnv_reader_next(r, &data)) > 0) {
+	switch (hash_type) {
+	case FNV0_32:
+	case FNV1_32:
+	    hval = (data == NULL) ? fnv_32_zeros(hval, (off_t)len) :
+				    fnv_32_buf(data, (size_t)len, hval);
+	    break;
+	case FNV1a_32:
+	    hval = (data == NULL) ? fnv_32a_zeros(hval, (off_t)len) :
+				    fnv_32a_buf(data, (size_t)len, hval);
+	    break;
+	default:
+	    unknown_hash_type(prog, hash_type);
+	    exit(21);
+	    /*NOTREACHED*/
+	}
+	fnv_reader_release(r);
+    }
+    if (len < 0) {
+	fprintf(stderr, "%s: error reading file: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    (void) fnv_reader_finish(r);
+    return hval;
+}
+
+
+/*
+ * hash_fd - hash an open file until EOF
+ *
+ * given:
+ *	fd		open file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *	name		filename for error messages
+ *
+ * returns:	hash value after hashing the rest of the file
+ *
+ * NOTE: This function does not return on a read error.
+ */
+static Fnv32_t
+hash_fd(int fd, enum fnv_type hash_type, Fnv32_t hval, char *name)
+{
+    char buf[BUF_SIZE+1];	/* read buffer */
+    ssize_t readcnt;		/* number of octets read */
+
+    if (pipeline) {
+	return hash_pipeline(fd, hash_type, hval, name);
+    }
+    while ((readcnt = read(fd, buf, BUF_SIZE)) != 0) {
+	if (readcnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    fprintf(stderr, "%s: error reading file: %s: %s\n",
+		    prog, name, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+	switch (hash_type) {
+	case FNV0_32:
+	case FNV1_32:
+	    hval = fnv_32_buf(buf, readcnt, hval);
+	    break;
+	case FNV1a_32:
+	    hval = fnv_32a_buf(buf, readcnt, hval);
+	    break;
+	default:
+	    unknown_hash_type(prog, hash_type);
+	    exit(21);
+	    /*NOTREACHED*/
+	}
+    }
+    return hval;
+}
+
+
+/*
+ * hash_file - hash a file, consulting the --cache file if open
+ *
+ * given:
+ *	name		file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *
+ * returns:	hash value after hashing the file
+ *
+ * The cache is keyed by the file and the hval it is hashed from, so a
+ * file that continues the hash of earlier args hits only when those
+ * args hashed the same as before.  A cache hit costs one stat(2) and
+ * the file is not opened.
+ *
+ * NOTE: This function does not return on an open or read error.
+ */
+static Fnv32_t
+hash_file(char *name, enum fnv_type hash_type, Fnv32_t hval)
+{
+    Fnv32_t basis = hval;		/* hash value the file is hashed from */
+    struct stat before;		/* file status before hashing */
+    struct stat after;		/* file status after hashing */
+    int use_cache = 0;		/* 1 ==> regular file we may cache */
+    int fd;			/* open file to process */
+
+    /* try the cache first */
+    if (cache != NULL &&
+	stat(name, &before) == 0 && S_ISREG(before.st_mode) &&
+	fnv_cache_lookup(cache, &before, hash_type, &basis, &hval,
+			 sizeof(hval))) {
+	return hval;
+    }
+
+    /* open the file */
+    fd = open(name, O_RDONLY);
+    if (fd < 0) {
+	fprintf(stderr, "%s: unable to open file: %s\n", prog, name);
+	exit(4); /*ooo*/
+    }
+    if (cache != NULL &&
+	fstat(fd, &before) == 0 && S_ISREG(before.st_mode)) {
+	use_cache = 1;
+    }
+
+    /* hash the file */
+    hval = hash_fd(fd, hash_type, hval, name);
+
+    /* record the hash unless the file changed while we were reading it */
+    if (use_cache && fstat(fd, &after) == 0 &&
+	fnv_cache_same(&before, &after)) {
+	(void) fnv_cache_store(cache, &before, hash_type, &basis, &hval,
+			       sizeof(hval));
+    }
+    close(fd);
+    return hval;
+}
+
+
 /*
  * main - the main function
  *
@@ -275,8 +472,6 @@ test_fnv32(enum fnv_type hash_type, Fnv32_t init_hval,
 int
 main(int argc, char *argv[])
 {
-    char buf[BUF_SIZE+1];	/* read buffer */
-    int readcnt;		/* number of characters written */
     Fnv32_t hval;		/* current hash value */
     int s_flag = 0;		/* 1 => -s was given, hash args as strings */
     int m_flag = 0;		/* 1 => print multiple hashes, one per arg */
@@ -287,7 +482,8 @@ main(int argc, char *argv[])
     Fnv32_t bmask;		/* mask to apply to output */
     extern char *optarg;	/* option argument */
     extern int optind;		/* argv index of the next arg */
-    int fd;			/* open file to process */
+    char *cache_file = NULL;	/* --cache file or NULL */
+    int cache_stats = 0;	/* 1 => --cache-stats was given */
     int i;
 
     /*
@@ -296,7 +492,8 @@ main(int argc, char *argv[])
     program = argv[0];
     prog = rindex(program, '/');
     prog = (prog == NULL) ? program : prog+1;
-    while ((i = getopt(argc, argv, "hvVb:mst:")) != -1) {
+    while ((i = getopt_long(argc, argv, "hvVb:mst:",
+			    long_opts, NULL)) != -1) {
 	switch (i) {
 
 	case 'h':	/* -h - print help and exit */
@@ -336,6 +533,18 @@ main(int argc, char *argv[])
 	    m_flag = 1;
 	    break;
 
+	case OPT_CACHE:	/* --cache file - file hash cache */
+	    cache_file = optarg;
+	    break;
+
+	case OPT_CACHE_STATS:	/* --cache-stats - print cache statistics */
+	    cache_stats = 1;
+	    break;
+
+	case OPT_PIPELINE:	/* --pipeline - read ahead thread */
+	    pipeline = 1;
+	    break;
+
 	case ':':
             (void) fprintf(stderr, "%s: ERROR: requires an argument -- %c\n", prog, optopt);
 	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
@@ -343,7 +552,14 @@ main(int argc, char *argv[])
             /*NOTREACHED*/
 
         case '?':
-            (void) fprintf(stderr, "%s: ERROR: illegal option -- %c\n", prog, optopt);
+	    /* a long option has no single letter optopt to report */
+	    if (optopt == 0 || optopt >= OPT_CACHE) {
+		(void) fprintf(stderr, "%s: ERROR: illegal option -- %s\n",
+			       prog, argv[optind-1]);
+	    } else {
+		(void) fprintf(stderr, "%s: ERROR: illegal option -- %c\n",
+			       prog, optopt);
+	    }
 	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
             exit(3); /*ooo*/
             /*NOTREACHED*/
@@ -368,6 +584,19 @@ main(int argc, char *argv[])
 	    exit(3); /*ooo*/
 	}
     }
+    /* --cache only applies to file args */
+    if (cache_file != NULL && (t_flag >= 0 || s_flag)) {
+	fprintf(stderr, "%s: --cache incompatible with -t and -s\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (pipeline && (t_flag >= 0 || s_flag)) {
+	fprintf(stderr, "%s: --pipeline incompatible with -t and -s\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (cache_stats && cache_file == NULL) {
+	fprintf(stderr, "%s: --cache-stats requires --cache\n", prog);
+	exit(3); /*ooo*/
+    }
     /* -s requires at least 1 arg */
     if (s_flag && optind >= argc) {
 	fprintf(stderr, usage, prog, prog, FNV_VERSION);
@@ -431,6 +660,18 @@ main(int argc, char *argv[])
 	}
     }
 
+    /*
+     * open the file hash cache, if needed
+     */
+    if (cache_file != NULL) {
+	cache = fnv_cache_open(cache_file);
+	if (cache == NULL) {
+	    fprintf(stderr, "%s: unable to open cache file: %s: %s\n",
+		    prog, cache_file, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+    }
+
     /*
      * string hashing
      */
@@ -468,20 +709,7 @@ main(int argc, char *argv[])
 	if (optind >= argc) {
 
 	    /* case: process only stdin */
-	    while ((readcnt = read(0, buf, BUF_SIZE)) > 0) {
-		switch (hash_type) {
-		case FNV0_32:
-		case FNV1_32:
-		    hval = fnv_32_buf(buf, readcnt, hval);
-		    break;
-		case FNV1a_32:
-		    hval = fnv_32a_buf(buf, readcnt, hval);
-		default:
-		    unknown_hash_type(prog, hash_type);
-		    exit(21);
-		    /*NOTREACHED*/
-		}
-	    }
+	    hval = hash_fd(0, hash_type, hval, "(stdin)");
 	    if (m_flag) {
 		print_fnv32(hval, bmask, v_flag, "(stdin)");
 	    }
@@ -493,39 +721,35 @@ main(int argc, char *argv[])
 	     */
 	    for (i=optind; i < argc; ++i) {
 
-		/* open the file */
-		fd = open(argv[i], O_RDONLY);
-		if (fd < 0) {
-		    fprintf(stderr, "%s: unable to open file: %s\n",
-			    prog, argv[i]);
-		    exit(4); /*ooo*/
-		}
-
-		/*  hash the file */
-		while ((readcnt = read(fd, buf, BUF_SIZE)) > 0) {
-		    switch (hash_type) {
-		    case FNV0_32:
-		    case FNV1_32:
-			hval = fnv_32_buf(buf, readcnt, hval);
-			break;
-		    case FNV1a_32:
-			hval = fnv_32a_buf(buf, readcnt, hval);
-		    default:
-			unknown_hash_type(prog, hash_type);
-			exit(22);
-			/*NOTREACHED*/
-		    }
-		}
+		/* hash the file */
+		hval = hash_file(argv[i], hash_type, hval);
 
 		/* finish processing the file */
 		if (m_flag) {
 		    print_fnv32(hval, bmask, v_flag, argv[i]);
 		}
-		close(fd);
 	    }
 	}
     }
 
+    /*
+     * report cache statistics, if needed
+     */
+    if (cache != NULL) {
+	if (cache_stats) {
+	    struct fnv_cache_stat cstat;	/* cache statistics */
+
+	    fnv_cache_getstat(cache, &cstat);
+	    fprintf(stderr, "%s: cache: %llu lookups, %llu hits (%.1f%%), "
+		    "%llu misses, %llu stores\n", prog,
+		    cstat.lookups, cstat.hits,
+		    (cstat.lookups > 0) ?
+			(100.0 * (double)cstat.hits / (double)cstat.lookups) : 0.0,
+		    cstat.misses, cstat.stores);
+	}
+	fnv_cache_close(cache);
+    }
+
     /*
      * report hash and exit
      */
@@ -0,0 +1,601 @@
+/*
+ * fnv_bloom - blocked Bloom filter hashed with one FNV-1a pass
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * A blocked Bloom filter: the filter is an array of 512 bit blocks, each
+ * one cache line, and all k bits of a key are set in a single block.  A
+ * lookup therefore costs one cache miss, at the price of a slightly
+ * higher false positive rate than a classic Bloom filter of the same
+ * size.
+ *
+ * Each key is hashed once with fnv_64a_mix().  The upper 32 bits of the
+ * hash choose the block.  The hash also gives three 32 bit values h1,
+ * h2 and h3, and bit i of the key, for i = 0 .. k-1, is the top 9 bits
+ * of
+ *
+ *	h1 + i*h2 + i*i*h3	(mod 2^32)
+ *
+ * This is Kirsch and Mitzenmacher double hashing with the i*i*h3 term
+ * of Dillinger and Manolios.  Plain double hashing is not enough in a
+ * 512 bit block: two keys of a block whose h1 and h2 are close set
+ * nearly the same bits, which at 20 or more bits per key quadruples
+ * the false positive rate.
+ *
+ * The file form is a 64 octet header followed by the blocks, so that a
+ * filter can be mapped and queried in place.  All fields are in the
+ * native byte order of the host.
+ */
+#define FNV_BLOOM_MAGIC "FNVblm\0\1"	/* filter file magic */
+#define BLOOM_BLOCK 64			/* octets in a block */
+#define BLOOM_BLOCK_BITS 512		/* bits in a block */
+#define BLOOM_MAX_K 16			/* most bits set per key */
+#define BLOOM_BATCH 16			/* keys hashed and prefetched at once */
+
+struct bloom_hdr {
+    char magic[8];		/* FNV_BLOOM_MAGIC */
+    Fnv32_t k;			/* bits set per key */
+    Fnv32_t pad0;		/* unused, 0 */
+    unsigned long long nblock;	/* number of blocks */
+    unsigned long long nkey;	/* keys added */
+    char pad[32];		/* header is 64 octets */
+};
+
+struct fnv_bloom {
+    struct bloom_hdr *hdr;	/* header, followed by the blocks */
+    unsigned char *block;	/* nblock blocks */
+    size_t len;			/* octets of header and blocks */
+    int mapped;			/* 1 ==> mapped by fnv_bloom_open() */
+};
+
+
+/*
+ * where the bits of a key are
+ */
+struct bloom_pos {
+    unsigned char *block;	/* block of the key */
+    Fnv32_t h1;			/* first bit, in the top 9 bits */
+    Fnv32_t h2;			/* linear step */
+    Fnv32_t h3;			/* quadratic step */
+};
+
+
+/*
+ * bloom_pos - hash a key and find its block and bits
+ */
+static void
+bloom_pos(struct fnv_bloom *b, const void *key, size_t len,
+	  struct bloom_pos *p)
+{
+    unsigned long long x;	/* hash of key */
+    Fnv32_t hi;			/* upper 32 bits of x */
+
+    x = fnv_64a_mix(key, len, 0);
+    hi = (Fnv32_t)(x >> 32);
+    /* hi * nblock / 2^32 maps hi onto the blocks without a division */
+    p->block = b->block + (size_t)(((unsigned long long)hi *
+				    b->hdr->nblock) >> 32) * BLOOM_BLOCK;
+    p->h1 = (Fnv32_t)x;
+    p->h2 = (hi << 16) | (hi >> 16);
+    p->h3 = ((Fnv32_t)x * 0x9e3779b9U) ^ hi;
+}
+
+
+/*
+ * bloom_set - set the bits of a key
+ */
+static void
+bloom_set(struct fnv_bloom *b, struct bloom_pos *p)
+{
+    Fnv32_t g = p->h1;		/* h1 + i*h2 + i*i*h3 */
+    Fnv32_t d = p->h2 + p->h3;	/* g(i+1) - g(i) */
+    Fnv32_t bit;		/* bit being set */
+    Fnv32_t i;
+
+    for (i = 0; i < b->hdr->k; ++i, g += d, d += 2 * p->h3) {
+	bit = g >> 23;
+	p->block[bit >> 3] |= (unsigned char)(1 << (bit & 7));
+    }
+}
+
+
+/*
+ * bloom_test - test the bits of a key
+ *
+ * returns:
+ *	1 ==> all bits set, 0 ==> some bit clear
+ */
+static int
+bloom_test(struct fnv_bloom *b, struct bloom_pos *p)
+{
+    Fnv32_t g = p->h1;		/* h1 + i*h2 + i*i*h3 */
+    Fnv32_t d = p->h2 + p->h3;	/* g(i+1) - g(i) */
+    Fnv32_t bit;		/* bit being tested */
+    Fnv32_t i;
+
+    for (i = 0; i < b->hdr->k; ++i, g += d, d += 2 * p->h3) {
+	bit = g >> 23;
+	if ((p->block[bit >> 3] & (1 << (bit & 7))) == 0) {
+	    return 0;
+	}
+    }
+    return 1;
+}
+
+
+/*
+ * blocked_fpr - false positive rate of a blocked filter
+ *
+ * input:
+ *	bpk	- bits per key
+ *	k	- bits set per key
+ *
+ * returns:
+ *	expected false positive rate
+ *
+ * The number of keys in a block is Poisson distributed with a mean of
+ * 512 / bpk, and a block holding j keys answers a false positive with
+ * the probability of a classic filter of 512 bits holding j keys.
+ */
+static double
+blocked_fpr(double bpk, int k)
+{
+    double mean = BLOOM_BLOCK_BITS / bpk;	/* mean keys per block */
+    double pj = exp(-mean);	/* Poisson probability of j keys */
+    double fpr = 0.0;		/* false positive rate */
+    int last = (int)(mean + 12.0 * sqrt(mean) + 12.0);	/* largest j */
+    int j;
+
+    for (j = 0; j <= last; ++j) {
+	fpr += pj * pow(1.0 - exp(-(double)k * j / BLOOM_BLOCK_BITS), k);
+	pj *= mean / (j + 1);
+    }
+    return fpr;
+}
+
+
+/*
+ * fnv_bloom_new - create an empty Bloom filter
+ *
+ * input:
+ *	nkey	- number of keys the filter is sized for, > 0
+ *	fpr	- false positive rate wanted with nkey keys, 0 < fpr < 1
+ *
+ * returns:
+ *	new filter, free with fnv_bloom_free(), or NULL ==> error, errno set
+ */
+struct fnv_bloom *
+fnv_bloom_new(unsigned long long nkey, double fpr)
+{
+    struct fnv_bloom *b;	/* new filter */
+    double bpk;			/* bits per key */
+    unsigned long long nblock;	/* number of blocks */
+    int k;			/* bits set per key */
+    int best_k = 1;		/* k with the lowest rate */
+    double best;		/* lowest rate for bpk */
+    double rate;		/* rate for bpk and k */
+
+    if (nkey == 0 || !(fpr > 0.0 && fpr < 1.0)) {
+	errno = EINVAL;
+	return NULL;
+    }
+
+    /*
+     * start from the size of a classic filter, then grow in 2% steps
+     * until the blocked filter, with its best k, reaches the rate
+     */
+    for (bpk = -log(fpr) / (M_LN2 * M_LN2); bpk < 1024.0; bpk *= 1.02) {
+	best = 1.0;
+	for (k = 1; k <= BLOOM_MAX_K; ++k) {
+	    rate = blocked_fpr(bpk, k);
+	    if (rate < best) {
+		best = rate;
+		best_k = k;
+	    }
+	}
+	if (best <= fpr) {
+	    break;
+	}
+    }
+    nblock = (unsigned long long)ceil(bpk * (double)nkey / BLOOM_BLOCK_BITS);
+    if (nblock > 0xffffffffULL ||
+	nblock > (SIZE_MAX - sizeof(struct bloom_hdr)) / BLOOM_BLOCK) {
+	errno = EFBIG;
+	return NULL;
+    }
+    b = calloc(1, sizeof(*b));
+    if (b == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    b->len = sizeof(struct bloom_hdr) + (size_t)nblock * BLOOM_BLOCK;
+    if (posix_memalign((void **)&b->hdr, BLOOM_BLOCK, b->len) != 0) {
+	free(b);
+	errno = ENOMEM;
+	return NULL;
+    }
+    memset(b->hdr, 0, b->len);
+    memcpy(b->hdr->magic, FNV_BLOOM_MAGIC, sizeof(b->hdr->magic));
+    b->hdr->k = (Fnv32_t)best_k;
+    b->hdr->nblock = nblock;
+    b->block = (unsigned char *)(b->hdr + 1);
+    return b;
+}
+
+
+/*
+ * fnv_bloom_open - map a filter saved by fnv_bloom_save()
+ *
+ * input:
+ *	path	- filter file
+ *
+ * returns:
+ *	open filter, or NULL ==> error, errno set (EINVAL ==> not a filter)
+ *
+ * The file is mapped private: lookups read the page cache in place,
+ * and keys added to the filter change only this process's copy until
+ * it is saved.
+ */
+struct fnv_bloom *
+fnv_bloom_open(char *path)
+{
+    struct fnv_bloom *b;	/* opened filter */
+    struct stat st;		/* file status */
+    void *map;			/* mapped file */
+    int fd;			/* open filter */
+    int err;			/* saved errno */
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+	return NULL;
+    }
+    if (fstat(fd, &st) < 0) {
+	err = errno;
+	close(fd);
+	errno = err;
+	return NULL;
+    }
+    if (st.st_size < (off_t)(sizeof(struct bloom_hdr) + BLOOM_BLOCK) ||
+	(unsigned long long)st.st_size > SIZE_MAX) {
+	close(fd);
+	errno = EINVAL;
+	return NULL;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE,
+	       fd, 0);
+    err = errno;
+    close(fd);
+    if (map == MAP_FAILED) {
+	errno = err;
+	return NULL;
+    }
+    b = calloc(1, sizeof(*b));
+    if (b == NULL) {
+	munmap(map, (size_t)st.st_size);
+	errno = ENOMEM;
+	return NULL;
+    }
+    b->hdr = (struct bloom_hdr *)map;
+    b->block = (unsigned char *)(b->hdr + 1);
+    b->len = (size_t)st.st_size;
+    b->mapped = 1;
+    if (memcmp(b->hdr->magic, FNV_BLOOM_MAGIC, sizeof(b->hdr->magic)) != 0 ||
+	b->hdr->k < 1 || b->hdr->k > BLOOM_MAX_K ||
+	b->hdr->nblock == 0 || b->hdr->nblock > 0xffffffffULL ||
+	b->len != sizeof(struct bloom_hdr) +
+		  (size_t)b->hdr->nblock * BLOOM_BLOCK) {
+	fnv_bloom_free(b);
+	errno = EINVAL;
+	return NULL;
+    }
+    return b;
+}
+
+
+/*
+ * fnv_bloom_save - write a filter to a file
+ *
+ * input:
+ *	b	- filter
+ *	path	- file to create or replace
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ *
+ * The filter is written to path.tmp and renamed to path, so that a
+ * process mapping the old file keeps a whole filter.
+ */
+int
+fnv_bloom_save(struct fnv_bloom *b, char *path)
+{
+    char *tmp;			/* temporary file name */
+    const char *p;		/* octets left to write */
+    size_t left;		/* number of octets left */
+    ssize_t n;			/* octets written */
+    int fd;			/* open temporary file */
+    int err;			/* saved errno */
+
+    tmp = malloc(strlen(path) + sizeof(".tmp"));
+    if (tmp == NULL) {
+	errno = ENOMEM;
+	return -1;
+    }
+    sprintf(tmp, "%s.tmp", path);
+    fd = open(tmp, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+	err = errno;
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    for (p = (const char *)b->hdr, left = b->len; left > 0;
+	 p += n, left -= (size_t)n) {
+	n = write(fd, p, left);
+	if (n < 0 && errno == EINTR) {
+	    n = 0;
+	} else if (n <= 0) {
+	    goto error;
+	}
+    }
+    if (close(fd) < 0) {
+	fd = -1;
+	goto error;
+    }
+    if (rename(tmp, path) < 0) {
+	fd = -1;
+	goto error;
+    }
+    free(tmp);
+    return 0;
+
+error:
+    err = (errno == 0) ? EIO : errno;
+    if (fd >= 0) {
+	close(fd);
+    }
+    unlink(tmp);
+    free(tmp);
+    errno = err;
+    return -1;
+}
+
+
+/*
+ * fnv_bloom_free - free or unmap a filter
+ */
+void
+fnv_bloom_free(struct fnv_bloom *b)
+{
+    if (b == NULL) {
+	return;
+    }
+    if (b->mapped) {
+	munmap(b->hdr, b->len);
+    } else {
+	free(b->hdr);
+    }
+    free(b);
+}
+
+
+/*
+ * fnv_bloom_info - describe a filter
+ *
+ * input:
+ *	b	- filter
+ *	nbit	- where to store the number of bits, or NULL
+ *	k	- where to store the number of bits set per key, or NULL
+ *	nkey	- where to store the number of keys added, or NULL
+ *
+ * returns:
+ *	false positive rate expected with the keys added so far
+ */
+double
+fnv_bloom_info(struct fnv_bloom *b, unsigned long long *nbit, int *k,
+	       unsigned long long *nkey)
+{
+    if (nbit != NULL) {
+	*nbit = b->hdr->nblock * BLOOM_BLOCK_BITS;
+    }
+    if (k != NULL) {
+	*k = (int)b->hdr->k;
+    }
+    if (nkey != NULL) {
+	*nkey = b->hdr->nkey;
+    }
+    if (b->hdr->nkey == 0) {
+	return 0.0;
+    }
+    return blocked_fpr((double)(b->hdr->nblock * BLOOM_BLOCK_BITS) /
+		       (double)b->hdr->nkey, (int)b->hdr->k);
+}
+
+
+/*
+ * fnv_bloom_add - add a key to a filter
+ */
+void
+fnv_bloom_add(struct fnv_bloom *b, const void *key, size_t len)
+{
+    struct bloom_pos p;		/* bits of key */
+
+    bloom_pos(b, key, len, &p);
+    bloom_set(b, &p);
+    ++b->hdr->nkey;
+}
+
+
+/*
+ * fnv_bloom_has - test whether a key may have been added to a filter
+ *
+ * returns:
+ *	1 ==> key may have been added, 0 ==> key was not added
+ */
+int
+fnv_bloom_has(struct fnv_bloom *b, const void *key, size_t len)
+{
+    struct bloom_pos p;		/* bits of key */
+
+    bloom_pos(b, key, len, &p);
+    return bloom_test(b, &p);
+}
+
+
+/*
+ * fnv_bloom_add_batch - add many keys to a filter
+ *
+ * input:
+ *	b	- filter
+ *	n	- number of keys
+ *	key	- key octets of each key
+ *	len	- length of each key
+ *
+ * The blocks of BLOOM_BATCH keys are prefetched before any is changed,
+ * so that their cache misses overlap.
+ */
+void
+fnv_bloom_add_batch(struct fnv_bloom *b, size_t n, const void * const *key,
+		    const size_t *len)
+{
+    struct bloom_pos p[BLOOM_BATCH];	/* bits of each key of a batch */
+    size_t first;		/* first key of the batch */
+    size_t cnt;			/* keys in the batch */
+    size_t i;
+
+    for (first = 0; first < n; first += cnt) {
+	cnt = (n - first < BLOOM_BATCH) ? n - first : BLOOM_BATCH;
+	for (i = 0; i < cnt; ++i) {
+	    bloom_pos(b, key[first + i], len[first + i], &p[i]);
+	    FNV_PREFETCH(p[i].block);
+	}
+	for (i = 0; i < cnt; ++i) {
+	    bloom_set(b, &p[i]);
+	}
+    }
+    b->hdr->nkey += n;
+}
+
+
+/*
+ * fnv_bloom_has_batch - test many keys
+ *
+ * input:
+ *	b	- filter
+ *	n	- number of keys
+ *	key	- key octets of each key
+ *	len	- length of each key
+ *	out	- where to store 1 (may have been added) or 0 for each key
+ *
+ * returns:
+ *	number of keys that may have been added
+ */
+size_t
+fnv_bloom_has_batch(struct fnv_bloom *b, size_t n, const void * const *key,
+		    const size_t *len, unsigned char *out)
+{
+    struct bloom_pos p[BLOOM_BATCH];	/* bits of each key of a batch */
+    size_t first;		/* first key of the batch */
+    size_t cnt;			/* keys in the batch */
+    size_t found = 0;		/* keys that may have been added */
+    size_t i;
+
+    for (first = 0; first < n; first += cnt) {
+	cnt = (n - first < BLOOM_BATCH) ? n - first : BLOOM_BATCH;
+	for (i = 0; i < cnt; ++i) {
+	    bloom_pos(b, key[first + i], len[first + i], &p[i]);
+	    FNV_PREFETCH(p[i].block);
+	}
+	for (i = 0; i < cnt; ++i) {
+	    out[first + i] = (unsigned char)bloom_test(b, &p[i]);
+	    found += out[first + i];
+	}
+    }
+    return found;
+}
@@ -0,0 +1,566 @@
+/*
+ * fnv_cache - persistent cache of FNV file hashes
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include "fnv.h"
+
+
+/*
+ * The cache file is a fixed header followed by a power of 2 sized
+ * open addressing table of fixed size entries.  The table is indexed
+ * by the FNV-1a 32 bit hash of the (device, inode, hash type, basis)
+ * key and probed linearly.  The basis is the hash value the file was
+ * hashed from: the initial basis for the first file arg, or the hash
+ * of the earlier args for a file that continues them.  The whole file is mmap-ed MAP_SHARED so that a
+ * lookup costs no read or write system calls.
+ *
+ * Concurrent fnv processes may share the same cache file: lookups
+ * are performed under a shared flock(2) and updates under an exclusive
+ * flock(2).  When a process grows the table, it rewrites the header
+ * nslots value and other processes notice the change (while holding
+ * the lock) and remap the file.
+ */
+#define FNV_CACHE_MAGIC "FNVcache"	/* cache file magic, no NUL */
+#define FNV_CACHE_VERSION 2		/* cache file format version */
+#define FNV_CACHE_MIN_SLOTS 4096	/* initial number of table slots */
+
+struct fnv_cache_hdr {
+    char magic[8];		/* FNV_CACHE_MAGIC */
+    u_int32_t version;		/* FNV_CACHE_VERSION */
+    u_int32_t entsize;		/* sizeof(struct fnv_cache_ent) */
+    u_int32_t nslots;		/* number of table slots, power of 2 */
+    u_int32_t nused;		/* number of slots in use */
+    u_int32_t spare[10];	/* reserved, must be 0 */
+};
+
+struct fnv_cache_ent {
+    u_int64_t dev;		/* st_dev of file */
+    u_int64_t ino;		/* st_ino of file */
+    u_int64_t size;		/* st_size of file */
+    int64_t mtime_ns;		/* st_mtime in nanoseconds */
+    int64_t ctime_ns;		/* st_ctime in nanoseconds */
+    u_int32_t type;		/* enum fnv_type, FNV_NONE ==> empty slot */
+    u_int32_t hlen;		/* length of hval in octets */
+    unsigned char hval[8];	/* hash value in native byte order */
+    unsigned char basis[8];	/* hash value hashed from, zero padded */
+};
+
+struct fnv_cache {
+    int fd;			/* open cache file */
+    size_t maplen;		/* length of mapping */
+    struct fnv_cache_hdr *hdr;	/* mmap-ed cache file */
+    struct fnv_cache_ent *ent;	/* start of table in the mapping */
+    u_int32_t nslots;		/* nslots when we mapped the file */
+    struct fnv_cache_stat stat;	/* lookup statistics */
+};
+
+
+/*
+ * stat(2) nanosecond time stamps
+ */
+#if defined(__APPLE__)
+#define ST_MTIME_NS(st) ((int64_t)(st)->st_mtimespec.tv_sec * 1000000000LL + \
+			 (int64_t)(st)->st_mtimespec.tv_nsec)
+#define ST_CTIME_NS(st) ((int64_t)(st)->st_ctimespec.tv_sec * 1000000000LL + \
+			 (int64_t)(st)->st_ctimespec.tv_nsec)
+#else /* __APPLE__ */
+#define ST_MTIME_NS(st) ((int64_t)(st)->st_mtim.tv_sec * 1000000000LL + \
+			 (int64_t)(st)->st_mtim.tv_nsec)
+#define ST_CTIME_NS(st) ((int64_t)(st)->st_ctim.tv_sec * 1000000000LL + \
+			 (int64_t)(st)->st_ctim.tv_nsec)
+#endif /* __APPLE__ */
+
+
+/*
+ * cache_slot - return the first table slot to probe for a key
+ */
+static u_int32_t
+cache_slot(struct stat *st, enum fnv_type type, unsigned char *basis,
+	   u_int32_t nslots)
+{
+    u_int64_t key[4];		/* key to hash */
+
+    memset(key, 0, sizeof(key));
+    key[0] = (u_int64_t)st->st_dev;
+    key[1] = (u_int64_t)st->st_ino;
+    key[2] = (u_int64_t)type;
+    memcpy(&key[3], basis, sizeof(key[3]));
+    return fnv_32a_buf(key, sizeof(key), FNV1_32A_INIT) & (nslots - 1);
+}
+
+
+/*
+ * cache_mmap - map (or remap) the cache file for a given number of slots
+ *
+ * The new mapping is made before the old one is released, so on error
+ * the cache keeps its current (still valid) mapping.
+ *
+ * given:
+ *	c	open cache
+ *	nslots	number of table slots to map
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error
+ */
+static int
+cache_mmap(struct fnv_cache *c, u_int32_t nslots)
+{
+    size_t len;			/* length of the mapping */
+    void *p;
+
+    len = sizeof(struct fnv_cache_hdr) +
+	  (size_t)nslots * sizeof(struct fnv_cache_ent);
+    p = mmap(NULL, len, PROT_READ|PROT_WRITE, MAP_SHARED, c->fd, 0);
+    if (p == MAP_FAILED) {
+	return -1;
+    }
+    if (c->hdr != NULL) {
+	munmap(c->hdr, c->maplen);
+    }
+    c->hdr = (struct fnv_cache_hdr *)p;
+    c->ent = (struct fnv_cache_ent *)(c->hdr + 1);
+    c->maplen = len;
+    c->nslots = nslots;
+    return 0;
+}
+
+
+/*
+ * cache_map - map (or remap) the cache file based on its current nslots
+ *
+ * The caller must hold a lock on the cache file.
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error
+ */
+static int
+cache_map(struct fnv_cache *c)
+{
+    struct fnv_cache_hdr hdr;	/* header as found in the file */
+
+    if (pread(c->fd, &hdr, sizeof(hdr), 0) != sizeof(hdr) ||
+	memcmp(hdr.magic, FNV_CACHE_MAGIC, sizeof(hdr.magic)) != 0 ||
+	hdr.version != FNV_CACHE_VERSION ||
+	hdr.entsize != sizeof(struct fnv_cache_ent) ||
+	hdr.nslots == 0 || (hdr.nslots & (hdr.nslots - 1)) != 0) {
+	errno = EINVAL;
+	return -1;
+    }
+    return cache_mmap(c, hdr.nslots);
+}
+
+
+/*
+ * cache_lock - lock the cache file and make sure our mapping is current
+ *
+ * given:
+ *	c	open cache
+ *	how	LOCK_SH or LOCK_EX
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error (and the cache is not locked)
+ */
+static int
+cache_lock(struct fnv_cache *c, int how)
+{
+    while (flock(c->fd, how) < 0) {
+	if (errno != EINTR) {
+	    return -1;
+	}
+    }
+    if (c->hdr->nslots != c->nslots && cache_map(c) < 0) {
+	flock(c->fd, LOCK_UN);
+	return -1;
+    }
+    return 0;
+}
+
+
+/*
+ * cache_find - find the slot for a key
+ *
+ * returns:
+ *	matching slot, or the empty slot where the key would go
+ */
+static struct fnv_cache_ent *
+cache_find(struct fnv_cache_ent *ent, u_int32_t nslots,
+	   struct stat *st, enum fnv_type type, unsigned char *basis)
+{
+    struct fnv_cache_ent *e;	/* slot being probed */
+    u_int32_t i;
+
+    for (i = cache_slot(st, type, basis, nslots); ;
+	 i = (i + 1) & (nslots - 1)) {
+	e = &ent[i];
+	if (e->type == FNV_NONE ||
+	    (e->type == (u_int32_t)type &&
+	     e->dev == (u_int64_t)st->st_dev &&
+	     e->ino == (u_int64_t)st->st_ino &&
+	     memcmp(e->basis, basis, sizeof(e->basis)) == 0)) {
+	    return e;
+	}
+    }
+    /*NOTREACHED*/
+}
+
+
+/*
+ * cache_grow - double the size of the table
+ *
+ * The caller must hold an exclusive lock on the cache file.
+ *
+ * The header nslots value is what other processes use to map the file,
+ * so it is written only after the larger table has been mapped and
+ * rebuilt.  An error part way leaves the file with its old nslots: at
+ * worst some entries are lost, which only costs cache misses later.
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error
+ */
+static int
+cache_grow(struct fnv_cache *c)
+{
+    struct fnv_cache_ent *old;	/* copy of the old table */
+    struct fnv_cache_ent *e;	/* new slot */
+    u_int32_t oslots;		/* old number of slots */
+    u_int32_t nslots;		/* new number of slots */
+    struct stat st;		/* key of an old entry */
+    u_int32_t i;
+
+    oslots = c->nslots;
+    nslots = oslots * 2;
+    old = malloc((size_t)oslots * sizeof(*old));
+    if (old == NULL) {
+	return -1;
+    }
+    memcpy(old, c->ent, (size_t)oslots * sizeof(*old));
+    if (ftruncate(c->fd, (off_t)(sizeof(struct fnv_cache_hdr) +
+				 (size_t)nslots * sizeof(*old))) < 0) {
+	free(old);
+	return -1;
+    }
+    if (cache_mmap(c, nslots) < 0) {
+	free(old);
+	return -1;
+    }
+    memset(c->ent, 0, (size_t)nslots * sizeof(*old));
+    for (i = 0; i < oslots; ++i) {
+	if (old[i].type == FNV_NONE) {
+	    continue;
+	}
+	memset(&st, 0, sizeof(st));
+	st.st_dev = (dev_t)old[i].dev;
+	st.st_ino = (ino_t)old[i].ino;
+	e = cache_find(c->ent, nslots, &st, (enum fnv_type)old[i].type,
+		       old[i].basis);
+	*e = old[i];
+    }
+    free(old);
+    c->hdr->nslots = nslots;
+    return 0;
+}
+
+
+/*
+ * fnv_cache_open - open, and if needed create, a hash cache file
+ *
+ * given:
+ *	path	cache filename
+ *
+ * returns:
+ *	open cache or NULL on error (with errno set)
+ */
+struct fnv_cache *
+fnv_cache_open(char *path)
+{
+    struct fnv_cache *c;	/* open cache */
+    struct fnv_cache_hdr hdr;	/* new cache header */
+    struct stat st;		/* cache file status */
+    int saved_errno;
+
+    c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+	return NULL;
+    }
+    c->fd = open(path, O_RDWR|O_CREAT, 0644);
+    if (c->fd < 0) {
+	free(c);
+	return NULL;
+    }
+
+    /*
+     * initialize a new (empty) cache file under an exclusive lock
+     */
+    if (flock(c->fd, LOCK_EX) < 0 || fstat(c->fd, &st) < 0) {
+	goto err;
+    }
+    if (st.st_size == 0) {
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, FNV_CACHE_MAGIC, sizeof(hdr.magic));
+	hdr.version = FNV_CACHE_VERSION;
+	hdr.entsize = sizeof(struct fnv_cache_ent);
+	hdr.nslots = FNV_CACHE_MIN_SLOTS;
+	if (ftruncate(c->fd, (off_t)(sizeof(hdr) + (size_t)hdr.nslots *
+				     sizeof(struct fnv_cache_ent))) < 0 ||
+	    pwrite(c->fd, &hdr, sizeof(hdr), 0) != sizeof(hdr)) {
+	    goto err;
+	}
+    }
+    if (cache_map(c) < 0) {
+	goto err;
+    }
+    flock(c->fd, LOCK_UN);
+    return c;
+
+err:
+    saved_errno = errno;
+    close(c->fd);
+    free(c);
+    errno = saved_errno;
+    return NULL;
+}
+
+
+/*
+ * fnv_cache_lookup - look for a cached hash of an unchanged file
+ *
+ * given:
+ *	c	open cache
+ *	st	stat of the file to look up
+ *	type	type of FNV hash
+ *	basis	hash value the file is to be hashed from
+ *	hval	where to store the hash value if found
+ *	hlen	size of basis and hval in octets
+ *		    (sizeof(Fnv32_t) or sizeof(Fnv64_t))
+ *
+ * returns:
+ *	1 ==> found, hval filled in
+ *	0 ==> not found or file changed since it was cached
+ *
+ * A cached hash is only returned when the file size, modification
+ * and inode change times all match those recorded when it was cached.
+ */
+int
+fnv_cache_lookup(struct fnv_cache *c, struct stat *st, enum fnv_type type,
+		 void *basis, void *hval, size_t hlen)
+{
+    struct fnv_cache_ent *e;	/* cache slot */
+    unsigned char key[8];	/* zero padded basis */
+    int found = 0;		/* 1 ==> cache hit */
+
+    ++c->stat.lookups;
+    if (hlen > sizeof(key) || cache_lock(c, LOCK_SH) < 0) {
+	++c->stat.misses;
+	return 0;
+    }
+    memset(key, 0, sizeof(key));
+    memcpy(key, basis, hlen);
+    e = cache_find(c->ent, c->nslots, st, type, key);
+    if (e->type == (u_int32_t)type &&
+	e->hlen == hlen &&
+	e->size == (u_int64_t)st->st_size &&
+	e->mtime_ns == ST_MTIME_NS(st) &&
+	e->ctime_ns == ST_CTIME_NS(st)) {
+	memcpy(hval, e->hval, hlen);
+	found = 1;
+    }
+    flock(c->fd, LOCK_UN);
+    if (found) {
+	++c->stat.hits;
+    } else {
+	++c->stat.misses;
+    }
+    return found;
+}
+
+
+/*
+ * fnv_cache_store - record the hash of a file
+ *
+ * given:
+ *	c	open cache
+ *	st	stat of the file taken before it was hashed
+ *	type	type of FNV hash
+ *	basis	hash value the file was hashed from
+ *	hval	hash value after hashing the entire file
+ *	hlen	size of basis and hval in octets
+ *		    (sizeof(Fnv32_t) or sizeof(Fnv64_t))
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error
+ *
+ * NOTE: Files modified within the last 2 seconds are not cached.
+ *	 A write that lands within the time stamp granularity of the
+ *	 filesystem would otherwise leave a stale hash in the cache.
+ */
+int
+fnv_cache_store(struct fnv_cache *c, struct stat *st, enum fnv_type type,
+		void *basis, void *hval, size_t hlen)
+{
+    struct fnv_cache_ent *e;	/* cache slot */
+    unsigned char key[8];	/* zero padded basis */
+    int64_t now_ns;		/* current time in nanoseconds */
+
+    if (hlen > sizeof(key)) {
+	errno = EINVAL;
+	return -1;
+    }
+    memset(key, 0, sizeof(key));
+    memcpy(key, basis, hlen);
+    now_ns = (int64_t)time(NULL) * 1000000000LL;
+    if (ST_MTIME_NS(st) >= now_ns - 2000000000LL) {
+	return 0;
+    }
+    if (cache_lock(c, LOCK_EX) < 0) {
+	return -1;
+    }
+    if ((c->hdr->nused + 1) > c->nslots / 4 * 3 && cache_grow(c) < 0) {
+	flock(c->fd, LOCK_UN);
+	return -1;
+    }
+    e = cache_find(c->ent, c->nslots, st, type, key);
+    if (e->type == FNV_NONE) {
+	++c->hdr->nused;
+    }
+    e->dev = (u_int64_t)st->st_dev;
+    e->ino = (u_int64_t)st->st_ino;
+    e->size = (u_int64_t)st->st_size;
+    e->mtime_ns = ST_MTIME_NS(st);
+    e->ctime_ns = ST_CTIME_NS(st);
+    e->hlen = (u_int32_t)hlen;
+    memset(e->hval, 0, sizeof(e->hval));
+    memcpy(e->hval, hval, hlen);
+    memcpy(e->basis, key, sizeof(e->basis));
+    e->type = (u_int32_t)type;
+    flock(c->fd, LOCK_UN);
+    ++c->stat.stores;
+    return 0;
+}
+
+
+/*
+ * fnv_cache_same - determine if a file is unchanged between two stats
+ *
+ * Used to detect a file that was modified while it was being hashed.
+ *
+ * returns:
+ *	1 ==> same size, inode and time stamps, 0 ==> file changed
+ */
+int
+fnv_cache_same(struct stat *a, struct stat *b)
+{
+    return a->st_dev == b->st_dev && a->st_ino == b->st_ino &&
+	   a->st_size == b->st_size &&
+	   ST_MTIME_NS(a) == ST_MTIME_NS(b) &&
+	   ST_CTIME_NS(a) == ST_CTIME_NS(b);
+}
+
+
+/*
+ * fnv_cache_getstat - return cache statistics for this process
+ */
+void
+fnv_cache_getstat(struct fnv_cache *c, struct fnv_cache_stat *stat)
+{
+    *stat = c->stat;
+}
+
+
+/*
+ * fnv_cache_close - close a cache file
+ */
+void
+fnv_cache_close(struct fnv_cache *c)
+{
+    if (c == NULL) {
+	return;
+    }
+    if (c->hdr != NULL) {
+	munmap(c->hdr, c->maplen);
+    }
+    close(c->fd);
+    free(c);
+}
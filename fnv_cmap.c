@@ -0,0 +1,904 @@
+/*
+ * fnv_cmap - concurrent hash table keyed by FNV-1a
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include "fnv.h"
+
+
+/*
+ * fnv_cmap is a hash table that many threads may use at once:
+ *
+ *	- lookups take no lock and never wait: a bucket is a singly linked
+ *	  chain of nodes that writers only ever change with single atomic
+ *	  pointer stores
+ *
+ *	- changes lock one of CMAP_STRIPES stripes, chosen by the low bits
+ *	  of the key hash, so writers of different stripes do not contend
+ *
+ *	- when the table grows, the new table is filled a few buckets at a
+ *	  time by every thread that changes the map: each old bucket is
+ *	  copied, under its stripe lock, into the two new buckets it splits
+ *	  into, and then replaced by a forwarding marker that sends lookups
+ *	  and changes to the new table.  No operation waits for the whole
+ *	  table to be copied.
+ *
+ *	- removed nodes and old tables are freed with epoch based
+ *	  reclamation: a thread announces the global epoch while it uses the
+ *	  map, and memory retired in epoch e is freed only once the global
+ *	  epoch reaches e + 2, by which time no thread can still see it
+ *
+ * The table has at least CMAP_STRIPES buckets, so bucket i of a table
+ * and the buckets i and i + n of the table that replaces it belong to
+ * the same stripe: one lock covers a key in every table.
+ *
+ * Keys are copied into the map.  Values are not: fnv_cmap_retire() may
+ * be used to free a value that other threads may still be reading.
+ */
+#define CMAP_STRIPES 256	/* stripe locks, a power of 2 */
+#define CMAP_MIGRATE 16		/* buckets copied by a thread at a time */
+#define CMAP_RETIRE_SCAN 64	/* retires between epoch advance attempts */
+
+struct retired {
+    struct retired *next;	/* next retired object */
+    void *ptr;			/* object to free */
+    void (*fn)(void *);		/* how to free it */
+    int own;			/* 1 ==> free this struct after ptr */
+};
+
+struct cnode {
+    struct cnode *next;		/* next node of the chain */
+    struct cnode *dead;		/* next removed node waiting to be freed */
+    size_t hash;		/* fnv_64a_mix() hash of key */
+    void *val;			/* value, changed atomically */
+    size_t len;			/* key length */
+    char key[1];		/* key octets */
+};
+
+struct ctable {
+    size_t nbucket;		/* number of buckets, a power of 2 */
+    struct cnode **bucket;	/* chain of each bucket */
+    struct ctable *next;	/* larger table being filled, or NULL */
+    size_t claim;		/* next bucket to copy into next */
+    size_t copied;		/* buckets copied into next */
+    struct retired dead;	/* waiting to be freed, once replaced */
+};
+
+struct stripe {
+    pthread_mutex_t lock;	/* protects changes to the stripe */
+    size_t count;		/* keys in the stripe */
+    char pad[64];		/* keep stripes on separate cache lines */
+};
+
+struct fnv_cmap {
+    struct ctable *table;	/* current table */
+    struct stripe stripe[CMAP_STRIPES];	/* stripe locks and counts */
+};
+
+/* forwarding marker of a bucket that was copied into the next table */
+static struct cnode moved_marker;
+#define MOVED (&moved_marker)
+
+
+/*
+ * epoch based reclamation
+ *
+ * Each thread that uses a map has a record in a global list.  Records
+ * are never freed; the record of a thread that exits is reused by the
+ * next new thread, together with any memory still waiting in it.
+ */
+struct limbo {
+    unsigned long epoch;	/* epoch the objects were retired in */
+    struct retired *list;	/* retired objects */
+    struct cnode *nodes;	/* retired nodes */
+};
+
+struct erec {
+    struct erec *next;		/* next record */
+    unsigned long epoch;	/* epoch announced by the thread */
+    int active;			/* 1 ==> thread is using a map */
+    int in_use;			/* 1 ==> record belongs to a live thread */
+    int nest;			/* fnv_cmap_enter() nesting depth */
+    unsigned int nretire;	/* retires since the last advance attempt */
+    struct limbo limbo[3];	/* retired objects by epoch modulo 3 */
+};
+
+static unsigned long global_epoch = 2;	/* global epoch */
+static struct erec *erecs = NULL;	/* all records */
+static pthread_key_t erec_key;		/* releases a record at thread exit */
+static pthread_once_t erec_once = PTHREAD_ONCE_INIT;
+static __thread struct erec *self = NULL;	/* record of this thread */
+
+
+/*
+ * release_erec - thread exit: let another thread reuse the record
+ */
+static void
+release_erec(void *arg)
+{
+    struct erec *r = arg;	/* record of the exiting thread */
+
+    __atomic_store_n(&r->active, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&r->in_use, 0, __ATOMIC_RELEASE);
+}
+
+
+/*
+ * init_erec_key - create the thread exit key, once
+ */
+static void
+init_erec_key(void)
+{
+    pthread_key_create(&erec_key, release_erec);
+}
+
+
+/*
+ * get_erec - return the record of this thread
+ *
+ * returns:
+ *	record, or NULL ==> out of memory
+ */
+static struct erec *
+get_erec(void)
+{
+    struct erec *r;		/* record */
+    int zero;			/* expected in_use */
+
+    if (self != NULL) {
+	return self;
+    }
+    pthread_once(&erec_once, init_erec_key);
+    for (r = __atomic_load_n(&erecs, __ATOMIC_ACQUIRE); r != NULL;
+	 r = r->next) {
+	zero = 0;
+	if (__atomic_compare_exchange_n(&r->in_use, &zero, 1, 0,
+					__ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+	    break;
+	}
+    }
+    if (r == NULL) {
+	r = calloc(1, sizeof(*r));
+	if (r == NULL) {
+	    return NULL;
+	}
+	r->in_use = 1;
+	r->next = __atomic_load_n(&erecs, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&erecs, &r->next, r, 0,
+					    __ATOMIC_RELEASE,
+					    __ATOMIC_RELAXED)) {
+	}
+    }
+    pthread_setspecific(erec_key, r);
+    self = r;
+    return r;
+}
+
+
+/*
+ * free_limbo - free the retired objects that no thread can still see
+ */
+static void
+free_limbo(struct erec *r, unsigned long epoch)
+{
+    struct retired *o;		/* retired object */
+    struct retired *next;	/* next retired object */
+    struct cnode *n;		/* retired node */
+    struct cnode *nn;		/* next retired node */
+    int i;
+
+    for (i = 0; i < 3; ++i) {
+	if (r->limbo[i].epoch + 2 > epoch) {
+	    continue;		/* a thread may still see them */
+	}
+	for (n = r->limbo[i].nodes; n != NULL; n = nn) {
+	    nn = n->dead;
+	    free(n);
+	}
+	r->limbo[i].nodes = NULL;
+	if (r->limbo[i].list != NULL) {
+	    for (o = r->limbo[i].list; o != NULL; o = next) {
+		next = o->next;
+		if (o->own) {
+		    o->fn(o->ptr);
+		    free(o);
+		} else {
+		    o->fn(o->ptr);	/* o is inside ptr */
+		}
+	    }
+	    r->limbo[i].list = NULL;
+	}
+    }
+}
+
+
+/*
+ * try_advance - advance the global epoch if every active thread has seen it
+ */
+static void
+try_advance(void)
+{
+    unsigned long e = __atomic_load_n(&global_epoch, __ATOMIC_SEQ_CST);
+    struct erec *r;		/* record being checked */
+
+    for (r = __atomic_load_n(&erecs, __ATOMIC_ACQUIRE); r != NULL;
+	 r = r->next) {
+	if (__atomic_load_n(&r->active, __ATOMIC_SEQ_CST) &&
+	    __atomic_load_n(&r->epoch, __ATOMIC_SEQ_CST) != e) {
+	    return;
+	}
+    }
+    __atomic_compare_exchange_n(&global_epoch, &e, e + 1, 0,
+				__ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+
+/*
+ * fnv_cmap_enter - start using maps, or values read from them
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ *
+ * Every fnv_cmap function enters by itself.  A thread that uses a value
+ * after fnv_cmap_get() returns it, while other threads may remove it and
+ * fnv_cmap_retire() it, must hold the value between fnv_cmap_enter() and
+ * fnv_cmap_exit().  Calls may nest.
+ */
+int
+fnv_cmap_enter(void)
+{
+    struct erec *r = get_erec();	/* record of this thread */
+    unsigned long e;		/* global epoch */
+
+    if (r == NULL) {
+	errno = ENOMEM;
+	return -1;
+    }
+    if (r->nest++ > 0) {
+	return 0;
+    }
+    e = __atomic_load_n(&global_epoch, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->epoch, e, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&r->active, 1, __ATOMIC_SEQ_CST);
+    /* announce before reading anything from a map */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    free_limbo(r, e);
+    return 0;
+}
+
+
+/*
+ * fnv_cmap_exit - stop using maps, see fnv_cmap_enter()
+ */
+void
+fnv_cmap_exit(void)
+{
+    struct erec *r = self;	/* record of this thread */
+
+    if (r != NULL && r->nest > 0 && --r->nest == 0) {
+	__atomic_store_n(&r->active, 0, __ATOMIC_RELEASE);
+    }
+}
+
+
+/*
+ * retire - free an object once no thread can still be using it
+ *
+ * input:
+ *	o	- retired object, or NULL
+ *	n	- retired node, if o is NULL
+ *
+ * The caller has entered.  Nodes are chained through their own dead
+ * links, so that removing a key allocates nothing.
+ */
+static void
+retire(struct retired *o, struct cnode *n)
+{
+    struct erec *r = self;	/* record of this thread */
+    struct limbo *l;		/* limbo list of the epoch */
+    unsigned long e;		/* global epoch */
+
+    e = __atomic_load_n(&global_epoch, __ATOMIC_SEQ_CST);
+    free_limbo(r, e);
+    /* free_limbo() emptied the lists if they held epoch e - 3 or earlier */
+    l = &r->limbo[e % 3];
+    l->epoch = e;
+    if (o != NULL) {
+	o->next = l->list;
+	l->list = o;
+    } else {
+	n->dead = l->nodes;
+	l->nodes = n;
+    }
+    if (++r->nretire >= CMAP_RETIRE_SCAN) {
+	r->nretire = 0;
+	try_advance();
+    }
+}
+
+
+/*
+ * fnv_cmap_retire - free an object once no thread can still be using it
+ *
+ * input:
+ *	ptr	- object, no longer reachable from any map
+ *	fn	- function that frees ptr, such as free()
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory (ptr was not freed)
+ */
+int
+fnv_cmap_retire(void *ptr, void (*fn)(void *))
+{
+    struct retired *o;		/* retired object */
+
+    if (fnv_cmap_enter() < 0) {
+	return -1;
+    }
+    o = malloc(sizeof(*o));
+    if (o == NULL) {
+	fnv_cmap_exit();
+	errno = ENOMEM;
+	return -1;
+    }
+    o->ptr = ptr;
+    o->fn = fn;
+    o->own = 1;
+    retire(o, NULL);
+    fnv_cmap_exit();
+    return 0;
+}
+
+
+/*
+ * new_table - allocate an empty table
+ */
+static struct ctable *
+new_table(size_t nbucket)
+{
+    struct ctable *t;		/* new table */
+
+    t = calloc(1, sizeof(*t));
+    if (t == NULL) {
+	return NULL;
+    }
+    t->bucket = calloc(nbucket, sizeof(t->bucket[0]));
+    if (t->bucket == NULL) {
+	free(t);
+	return NULL;
+    }
+    t->nbucket = nbucket;
+    return t;
+}
+
+
+/*
+ * free_table - free a table, but not its nodes
+ */
+static void
+free_table(void *arg)
+{
+    struct ctable *t = arg;	/* table to free */
+
+    free(t->bucket);
+    free(t);
+}
+
+
+/*
+ * fnv_cmap_new - create an empty concurrent map
+ *
+ * input:
+ *	hint	- expected number of keys, or 0
+ *
+ * returns:
+ *	new map, free with fnv_cmap_free(), or NULL ==> out of memory
+ */
+struct fnv_cmap *
+fnv_cmap_new(size_t hint)
+{
+    struct fnv_cmap *m;		/* new map */
+    size_t nbucket = CMAP_STRIPES;	/* number of buckets */
+    int i;
+
+    while (nbucket < hint) {
+	nbucket *= 2;
+    }
+    m = calloc(1, sizeof(*m));
+    if (m == NULL || (m->table = new_table(nbucket)) == NULL) {
+	free(m);
+	errno = ENOMEM;
+	return NULL;
+    }
+    for (i = 0; i < CMAP_STRIPES; ++i) {
+	pthread_mutex_init(&m->stripe[i].lock, NULL);
+    }
+    return m;
+}
+
+
+/*
+ * fnv_cmap_free - free a map that no thread is using, but not its values
+ */
+void
+fnv_cmap_free(struct fnv_cmap *m)
+{
+    struct ctable *t;		/* table */
+    struct ctable *next;	/* next table */
+    struct cnode *n;		/* node */
+    struct cnode *nn;		/* next node */
+    size_t i;
+
+    if (m == NULL) {
+	return;
+    }
+    for (t = m->table; t != NULL; t = next) {
+	next = t->next;
+	for (i = 0; i < t->nbucket; ++i) {
+	    for (n = t->bucket[i]; n != NULL && n != MOVED; n = nn) {
+		nn = n->next;
+		free(n);
+	    }
+	}
+	free_table(t);
+    }
+    for (i = 0; i < CMAP_STRIPES; ++i) {
+	pthread_mutex_destroy(&m->stripe[i].lock);
+    }
+    free(m);
+}
+
+
+/*
+ * fnv_cmap_count - return the number of keys in a map
+ *
+ * The count is exact only while no thread is changing the map.
+ */
+size_t
+fnv_cmap_count(struct fnv_cmap *m)
+{
+    size_t cnt = 0;		/* number of keys */
+    int i;
+
+    for (i = 0; i < CMAP_STRIPES; ++i) {
+	cnt += __atomic_load_n(&m->stripe[i].count, __ATOMIC_RELAXED);
+    }
+    return cnt;
+}
+
+
+/*
+ * new_node - allocate a node for a key
+ */
+static struct cnode *
+new_node(const void *key, size_t len, size_t hash, void *val)
+{
+    struct cnode *n;		/* new node */
+
+    n = malloc(sizeof(*n) + len);
+    if (n != NULL) {
+	n->next = NULL;
+	n->hash = hash;
+	n->val = val;
+	n->len = len;
+	memcpy(n->key, key, len);
+    }
+    return n;
+}
+
+
+/*
+ * find_node - find a key in a chain
+ */
+static struct cnode *
+find_node(struct cnode *n, const void *key, size_t len, size_t hash)
+{
+    for (; n != NULL; n = __atomic_load_n(&n->next, __ATOMIC_ACQUIRE)) {
+	if (n->hash == hash && n->len == len &&
+	    memcmp(n->key, key, len) == 0) {
+	    return n;
+	}
+    }
+    return NULL;
+}
+
+
+/*
+ * copy_bucket - copy old bucket i into the next table, its stripe locked
+ *
+ * returns:
+ *	1 ==> copied, 0 ==> already copied,
+ *	-1 ==> out of memory (the bucket is left as it was)
+ */
+static int
+copy_bucket(struct ctable *t, size_t i)
+{
+    struct ctable *nt = t->next;	/* table being filled */
+    struct cnode *head[2] = {NULL, NULL};	/* new chains i and i + n */
+    struct cnode *n;		/* old node */
+    struct cnode *c;		/* copy of n */
+    struct cnode *next;		/* next node */
+    int hi;			/* 1 ==> node goes to bucket i + n */
+
+    if (t->bucket[i] == MOVED) {
+	return 0;
+    }
+    for (n = t->bucket[i]; n != NULL; n = n->next) {
+	c = new_node(n->key, n->len, n->hash, n->val);
+	if (c == NULL) {
+	    for (hi = 0; hi < 2; ++hi) {
+		for (c = head[hi]; c != NULL; c = next) {
+		    next = c->next;
+		    free(c);
+		}
+	    }
+	    return -1;
+	}
+	hi = (n->hash & t->nbucket) != 0;
+	c->next = head[hi];
+	head[hi] = c;
+    }
+
+    /* publish the copies before the marker that sends readers to them */
+    __atomic_store_n(&nt->bucket[i], head[0], __ATOMIC_RELEASE);
+    __atomic_store_n(&nt->bucket[i + t->nbucket], head[1], __ATOMIC_RELEASE);
+    n = t->bucket[i];
+    __atomic_store_n(&t->bucket[i], MOVED, __ATOMIC_RELEASE);
+    for (; n != NULL; n = next) {
+	next = n->next;
+	retire(NULL, n);
+    }
+    return 1;
+}
+
+
+/*
+ * help_grow - copy the next few buckets of a growing table
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory (errno ENOMEM)
+ *
+ * When out of memory, the claim is released by moving t->claim back to
+ * the first bucket not copied, so that a later change copies it.  Claims
+ * made meanwhile by other threads are then walked again, but buckets
+ * already copied are skipped and not counted twice.
+ */
+static int
+help_grow(struct fnv_cmap *m, struct ctable *t)
+{
+    size_t first;		/* first bucket claimed */
+    size_t claim;		/* current t->claim */
+    size_t i;
+    size_t done = 0;		/* buckets copied */
+    struct stripe *s;		/* stripe of a bucket */
+    int ret = 0;		/* copy_bucket() return */
+
+    first = __atomic_fetch_add(&t->claim, CMAP_MIGRATE, __ATOMIC_ACQ_REL);
+    if (first >= t->nbucket) {
+	return 0;
+    }
+    for (i = first; i < first + CMAP_MIGRATE && i < t->nbucket; ++i) {
+	s = &m->stripe[i & (CMAP_STRIPES - 1)];
+	pthread_mutex_lock(&s->lock);
+	ret = copy_bucket(t, i);
+	pthread_mutex_unlock(&s->lock);
+	if (ret < 0) {
+	    claim = __atomic_load_n(&t->claim, __ATOMIC_ACQUIRE);
+	    while (claim > i &&
+		   !__atomic_compare_exchange_n(&t->claim, &claim, i, 0,
+						__ATOMIC_ACQ_REL,
+						__ATOMIC_ACQUIRE)) {
+	    }
+	    break;
+	}
+	done += (size_t)ret;
+    }
+    if (done > 0 && __atomic_add_fetch(&t->copied, done, __ATOMIC_ACQ_REL) ==
+	t->nbucket) {
+	/* every bucket is copied: the next table becomes current */
+	__atomic_store_n(&m->table, t->next, __ATOMIC_RELEASE);
+	t->dead.ptr = t;
+	t->dead.fn = free_table;
+	t->dead.own = 0;
+	retire(&t->dead, NULL);
+    }
+    if (ret < 0) {
+	errno = ENOMEM;
+	return -1;
+    }
+    return 0;
+}
+
+
+/*
+ * start_grow - start filling a table twice as large as t
+ */
+static void
+start_grow(struct fnv_cmap *m, struct ctable *t)
+{
+    struct ctable *nt;		/* larger table */
+    struct ctable *none = NULL;	/* expected t->next */
+
+    if (__atomic_load_n(&m->table, __ATOMIC_ACQUIRE) != t ||
+	__atomic_load_n(&t->next, __ATOMIC_ACQUIRE) != NULL) {
+	return;
+    }
+    nt = new_table(t->nbucket * 2);
+    if (nt == NULL) {
+	return;			/* try again at the next insert */
+    }
+    if (!__atomic_compare_exchange_n(&t->next, &none, nt, 0,
+				     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+	free_table(nt);
+    }
+}
+
+
+/*
+ * fnv_cmap_get - look up a key, without locking
+ *
+ * input:
+ *	m	- map
+ *	key	- key octets
+ *	len	- key length
+ *	val	- where to store the value, or NULL
+ *
+ * returns:
+ *	1 ==> found, 0 ==> not found
+ */
+int
+fnv_cmap_get(struct fnv_cmap *m, const void *key, size_t len, void **val)
+{
+    size_t hash = (size_t)fnv_64a_mix(key, len, 0);	/* hash of key */
+    struct ctable *t;		/* table */
+    struct cnode *head;		/* chain of the key's bucket */
+    struct cnode *n;		/* node of key */
+
+    if (fnv_cmap_enter() < 0) {
+	return 0;
+    }
+    t = __atomic_load_n(&m->table, __ATOMIC_ACQUIRE);
+    for (;;) {
+	head = __atomic_load_n(&t->bucket[hash & (t->nbucket - 1)],
+			       __ATOMIC_ACQUIRE);
+	if (head != MOVED) {
+	    break;
+	}
+	t = __atomic_load_n(&t->next, __ATOMIC_ACQUIRE);
+    }
+    n = find_node(head, key, len, hash);
+    if (n != NULL && val != NULL) {
+	*val = __atomic_load_n(&n->val, __ATOMIC_ACQUIRE);
+    }
+    fnv_cmap_exit();
+    return n != NULL;
+}
+
+
+/*
+ * lock_key - lock the stripe of a hash and find the table of its bucket
+ *
+ * given:
+ *	m	map
+ *	hash	hash of the key
+ *	sp	where to store the stripe of the key
+ *	fail	1 ==> fail when out of memory while helping the table grow,
+ *		0 ==> carry on, leaving the copy to a later change
+ *
+ * returns:
+ *	table whose bucket holds the key's chain, stripe locked,
+ *	or NULL ==> out of memory (errno ENOMEM), stripe not locked
+ */
+static struct ctable *
+lock_key(struct fnv_cmap *m, size_t hash, struct stripe **sp, int fail)
+{
+    struct ctable *t;		/* table */
+
+    *sp = &m->stripe[hash & (CMAP_STRIPES - 1)];
+    t = __atomic_load_n(&m->table, __ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&t->next, __ATOMIC_ACQUIRE) != NULL) {
+	if (help_grow(m, t) < 0 && fail) {
+	    return NULL;
+	}
+	t = __atomic_load_n(&m->table, __ATOMIC_ACQUIRE);
+    }
+    pthread_mutex_lock(&(*sp)->lock);
+    while (t->bucket[hash & (t->nbucket - 1)] == MOVED) {
+	t = t->next;
+    }
+    return t;
+}
+
+
+/*
+ * fnv_cmap_put - add a key to a map, or change its value
+ *
+ * input:
+ *	m	- map
+ *	key	- key octets, copied into the map
+ *	len	- key length
+ *	val	- value
+ *	old	- where to store the replaced value, or NULL
+ *
+ * returns:
+ *	0 ==> key added, 1 ==> value of an existing key replaced,
+ *	-1 ==> out of memory (errno ENOMEM)
+ */
+int
+fnv_cmap_put(struct fnv_cmap *m, const void *key, size_t len, void *val,
+	     void **old)
+{
+    size_t hash = (size_t)fnv_64a_mix(key, len, 0);	/* hash of key */
+    struct stripe *s;		/* stripe of key */
+    struct ctable *t;		/* table of key */
+    struct cnode **b;		/* bucket of key */
+    struct cnode *n;		/* node of key */
+    int ret = 0;		/* return value */
+    int grow = 0;		/* 1 ==> table is getting full */
+
+    if (fnv_cmap_enter() < 0) {
+	return -1;
+    }
+    t = lock_key(m, hash, &s, 1);
+    if (t == NULL) {
+	fnv_cmap_exit();
+	errno = ENOMEM;
+	return -1;
+    }
+    b = &t->bucket[hash & (t->nbucket - 1)];
+    n = find_node(*b, key, len, hash);
+    if (n != NULL) {
+	if (old != NULL) {
+	    *old = n->val;
+	}
+	__atomic_store_n(&n->val, val, __ATOMIC_RELEASE);
+	ret = 1;
+    } else {
+	n = new_node(key, len, hash, val);
+	if (n == NULL) {
+	    ret = -1;
+	} else {
+	    n->next = *b;
+	    __atomic_store_n(b, n, __ATOMIC_RELEASE);
+	    /* a stripe averaging over 1 key per bucket ==> grow */
+	    __atomic_store_n(&s->count, s->count + 1, __ATOMIC_RELAXED);
+	    grow = (s->count > t->nbucket / CMAP_STRIPES);
+	}
+    }
+    pthread_mutex_unlock(&s->lock);
+    if (grow) {
+	start_grow(m, t);
+    }
+    fnv_cmap_exit();
+    if (ret < 0) {
+	errno = ENOMEM;
+    }
+    return ret;
+}
+
+
+/*
+ * fnv_cmap_del - remove a key from a map
+ *
+ * input:
+ *	m	- map
+ *	key	- key octets
+ *	len	- key length
+ *	old	- where to store the removed value, or NULL
+ *
+ * returns:
+ *	1 ==> removed, 0 ==> not found
+ */
+int
+fnv_cmap_del(struct fnv_cmap *m, const void *key, size_t len, void **old)
+{
+    size_t hash = (size_t)fnv_64a_mix(key, len, 0);	/* hash of key */
+    struct stripe *s;		/* stripe of key */
+    struct ctable *t;		/* table of key */
+    struct cnode **prev;	/* link to the node */
+    struct cnode *n;		/* node of key */
+
+    if (fnv_cmap_enter() < 0) {
+	return 0;
+    }
+    /* a removal needs no memory, so it goes ahead without the help */
+    t = lock_key(m, hash, &s, 0);
+    for (prev = &t->bucket[hash & (t->nbucket - 1)]; (n = *prev) != NULL;
+	 prev = &n->next) {
+	if (n->hash == hash && n->len == len &&
+	    memcmp(n->key, key, len) == 0) {
+	    break;
+	}
+    }
+    if (n != NULL) {
+	if (old != NULL) {
+	    *old = n->val;
+	}
+	/* readers at n still find the rest of the chain through n->next */
+	__atomic_store_n(prev, n->next, __ATOMIC_RELEASE);
+	__atomic_store_n(&s->count, s->count - 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&s->lock);
+    if (n != NULL) {
+	retire(NULL, n);
+    }
+    fnv_cmap_exit();
+    return n != NULL;
+}
@@ -0,0 +1,502 @@
+/*
+ * fnv_cmap_bench - time fnv_cmap against a locked fnv_map
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * usage
+ */
+static const char * const usage =
+"usage: %s [-h] [-c] [-n keys] [-o ops] [-t threads]\n"
+"\n"
+"    -h           print help and exit\n"
+"    -c           check fnv_cmap from many threads at once, do not time\n"
+"    -n keys      number of keys (default 100000)\n"
+"    -o ops       operations per thread (default 1000000)\n"
+"    -t threads   most threads to time (default: number of CPUs, max 64)\n"
+"\n"
+"Times fnv_cmap against an fnv_map behind a mutex and behind a\n"
+"read/write lock, with 1, 2, 4, ... threads, for a read heavy mix\n"
+"(90%% get, 5%% put, 5%% del) and a write heavy mix (50%% get,\n"
+"25%% put, 25%% del).\n"
+"\n"
+"Exit codes:\n"
+"    0           all OK\n"
+"    2           -h and help string printed\n"
+"    3           command line error\n"
+"    5           -c found a difference\n"
+" >= 20          internal error\n";
+static const char *prog = NULL;	/* our name */
+
+#define MAX_THREADS 64		/* most threads */
+#define KEY_LEN 32		/* octets per key buffer */
+
+/*
+ * what the threads share
+ */
+enum kind { CMAP, MUTEX, RWLOCK };
+struct shared {
+    enum kind kind;		/* map being timed */
+    struct fnv_cmap *cmap;	/* CMAP map */
+    struct fnv_map *map;	/* MUTEX and RWLOCK map */
+    pthread_mutex_t mutex;	/* MUTEX lock */
+    pthread_rwlock_t rwlock;	/* RWLOCK lock */
+    char (*keys)[KEY_LEN];	/* keys */
+    size_t nkey;		/* number of keys */
+    size_t nop;			/* operations per thread */
+    int get_pct;		/* percent of operations that are gets */
+    int nthread;		/* number of threads */
+    int bad;			/* -c: 1 ==> a thread found a difference */
+};
+struct worker {
+    struct shared *sh;		/* what the threads share */
+    int id;			/* thread number */
+    pthread_t tid;		/* thread */
+};
+
+
+/*
+ * next_rand - xorshift64* step
+ */
+static unsigned long long
+next_rand(unsigned long long *s)
+{
+    *s ^= *s >> 12;
+    *s ^= *s << 25;
+    *s ^= *s >> 27;
+    return *s * 2685821657736338717ULL;
+}
+
+
+/*
+ * now_sec - monotonic time in seconds
+ */
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+ * bench_thread - perform a random mix of operations on the shared map
+ */
+static void *
+bench_thread(void *arg)
+{
+    struct worker *w = arg;	/* this thread */
+    struct shared *sh = w->sh;	/* what the threads share */
+    unsigned long long s = 0x9e3779b97f4a7c15ULL * (w->id + 1); /* rand */
+    unsigned long long r;	/* random value */
+    const char *key;		/* key */
+    size_t found = 0;		/* keys found */
+    size_t i;
+    int op;			/* percentile of operation */
+
+    for (i = 0; i < sh->nop; ++i) {
+	r = next_rand(&s);
+	key = sh->keys[(r >> 8) % sh->nkey];
+	op = (int)(r & 0xff) % 100;
+	if (op < sh->get_pct) {
+	    switch (sh->kind) {
+	    case CMAP:
+		found += fnv_cmap_get(sh->cmap, key, KEY_LEN, NULL);
+		break;
+	    case MUTEX:
+		pthread_mutex_lock(&sh->mutex);
+		found += fnv_map_get(sh->map, key, KEY_LEN, NULL);
+		pthread_mutex_unlock(&sh->mutex);
+		break;
+	    case RWLOCK:
+		pthread_rwlock_rdlock(&sh->rwlock);
+		found += fnv_map_get(sh->map, key, KEY_LEN, NULL);
+		pthread_rwlock_unlock(&sh->rwlock);
+		break;
+	    }
+	} else if ((op - sh->get_pct) % 2 == 0) {
+	    switch (sh->kind) {
+	    case CMAP:
+		fnv_cmap_put(sh->cmap, key, KEY_LEN, (void *)key, NULL);
+		break;
+	    case MUTEX:
+		pthread_mutex_lock(&sh->mutex);
+		fnv_map_put(sh->map, key, KEY_LEN, (void *)key);
+		pthread_mutex_unlock(&sh->mutex);
+		break;
+	    case RWLOCK:
+		pthread_rwlock_wrlock(&sh->rwlock);
+		fnv_map_put(sh->map, key, KEY_LEN, (void *)key);
+		pthread_rwlock_unlock(&sh->rwlock);
+		break;
+	    }
+	} else {
+	    switch (sh->kind) {
+	    case CMAP:
+		fnv_cmap_del(sh->cmap, key, KEY_LEN, NULL);
+		break;
+	    case MUTEX:
+		pthread_mutex_lock(&sh->mutex);
+		fnv_map_del(sh->map, key, KEY_LEN);
+		pthread_mutex_unlock(&sh->mutex);
+		break;
+	    case RWLOCK:
+		pthread_rwlock_wrlock(&sh->rwlock);
+		fnv_map_del(sh->map, key, KEY_LEN);
+		pthread_rwlock_unlock(&sh->rwlock);
+		break;
+	    }
+	}
+    }
+    return (void *)found;
+}
+
+
+/*
+ * run - start nthread threads running fn and wait for them
+ *
+ * returns:
+ *	elapsed seconds
+ */
+static double
+run(struct shared *sh, int nthread, void *(*fn)(void *))
+{
+    struct worker w[MAX_THREADS];	/* threads */
+    double start;		/* starting time */
+    int i;
+
+    sh->nthread = nthread;
+    start = now_sec();
+    for (i = 0; i < nthread; ++i) {
+	w[i].sh = sh;
+	w[i].id = i;
+	if (pthread_create(&w[i].tid, NULL, fn, &w[i]) != 0) {
+	    fprintf(stderr, "%s: cannot create thread\n", prog);
+	    exit(20);
+	}
+    }
+    for (i = 0; i < nthread; ++i) {
+	pthread_join(w[i].tid, NULL);
+    }
+    return now_sec() - start;
+}
+
+
+/*
+ * time_kind - time one map with one mix and one number of threads
+ */
+static void
+time_kind(struct shared *sh, enum kind kind, const char *name, int nthread)
+{
+    static const char * const kname[] = {"fnv_cmap", "fnv_map+mutex",
+					 "fnv_map+rwlock"};
+    double sec;			/* elapsed seconds */
+    size_t i;
+
+    sh->kind = kind;
+    if (kind == CMAP) {
+	sh->cmap = fnv_cmap_new(0);
+	if (sh->cmap == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+    } else {
+	sh->map = fnv_map_new(0);
+	if (sh->map == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+    }
+    /* start half full, as the mix of puts and dels keeps it */
+    for (i = 0; i < sh->nkey; i += 2) {
+	if ((kind == CMAP ?
+	     fnv_cmap_put(sh->cmap, sh->keys[i], KEY_LEN, sh->keys[i], NULL) :
+	     fnv_map_put(sh->map, sh->keys[i], KEY_LEN, sh->keys[i])) < 0) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+    }
+    sec = run(sh, nthread, bench_thread);
+    printf("%-12s %-16s %3d threads %9.2f Mops/s\n", name, kname[kind],
+	   nthread, (double)sh->nop * nthread / sec / 1e6);
+    if (kind == CMAP) {
+	fnv_cmap_free(sh->cmap);
+    } else {
+	fnv_map_free(sh->map);
+    }
+}
+
+
+/*
+ * check_thread - change keys of this thread, read keys no thread changes
+ *
+ * Key i belongs to thread i % (nthread + 1); those of the extra thread
+ * number nthread are put before the threads start and never change.
+ * Only the owner changes a key, so it knows what every lookup of its own
+ * keys must return, even while other threads make the map grow.
+ */
+static void *
+check_thread(void *arg)
+{
+    struct worker *w = arg;	/* this thread */
+    struct shared *sh = w->sh;	/* what the threads share */
+    size_t nown = (sh->nkey - w->id + sh->nthread) / (sh->nthread + 1);
+    void **want;		/* value of each own key, or NULL */
+    unsigned long long s = 0x9e3779b97f4a7c15ULL * (w->id + 1); /* rand */
+    unsigned long long r;	/* random value */
+    const char *key;		/* key */
+    void *val;			/* value found */
+    void *old;			/* value replaced */
+    size_t k;			/* key index */
+    size_t i;
+    int ret;			/* return value */
+
+    want = calloc(nown, sizeof(want[0]));
+    if (want == NULL) {
+	__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	return NULL;
+    }
+    for (i = 0; i < sh->nop && !__atomic_load_n(&sh->bad, __ATOMIC_RELAXED);
+	 ++i) {
+	r = next_rand(&s);
+	k = (r >> 8) % nown;
+	key = sh->keys[k * (sh->nthread + 1) + w->id];
+	switch (r % 4) {
+	case 0:
+	    val = (void *)(uintptr_t)(i + 1);
+	    ret = fnv_cmap_put(sh->cmap, key, KEY_LEN, val, &old);
+	    if (ret != (want[k] != NULL) || (ret == 1 && old != want[k])) {
+		__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	    }
+	    want[k] = val;
+	    break;
+	case 1:
+	    ret = fnv_cmap_del(sh->cmap, key, KEY_LEN, &old);
+	    if (ret != (want[k] != NULL) || (ret == 1 && old != want[k])) {
+		__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	    }
+	    want[k] = NULL;
+	    break;
+	case 2:
+	    ret = fnv_cmap_get(sh->cmap, key, KEY_LEN, &val);
+	    if (ret != (want[k] != NULL) || (ret == 1 && val != want[k])) {
+		__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	    }
+	    break;
+	default:
+	    /* a key that never changes */
+	    k = ((r >> 8) % (sh->nkey / (sh->nthread + 1))) *
+		(sh->nthread + 1) + sh->nthread;
+	    if (fnv_cmap_get(sh->cmap, sh->keys[k], KEY_LEN, &val) != 1 ||
+		val != sh->keys[k]) {
+		__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	    }
+	    break;
+	}
+    }
+    for (k = 0; k < nown; ++k) {
+	if (want[k] != NULL) {
+	    fnv_cmap_del(sh->cmap, sh->keys[k * (sh->nthread + 1) + w->id],
+			 KEY_LEN, NULL);
+	}
+    }
+    free(want);
+    return NULL;
+}
+
+
+/*
+ * check - change and read a map from many threads, starting small
+ *
+ * returns:
+ *	0 ==> every result was as expected, 1 ==> a difference was found
+ */
+static int
+check(struct shared *sh, int nthread)
+{
+    size_t nstable = 0;		/* keys that never change */
+    size_t i;
+
+    sh->cmap = fnv_cmap_new(0);
+    if (sh->cmap == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    for (i = nthread; i < sh->nkey; i += nthread + 1) {
+	if (fnv_cmap_put(sh->cmap, sh->keys[i], KEY_LEN, sh->keys[i],
+			 NULL) != 0) {
+	    return 1;
+	}
+	++nstable;
+    }
+    run(sh, nthread, check_thread);
+    if (fnv_cmap_count(sh->cmap) != nstable) {
+	return 1;
+    }
+    fnv_cmap_free(sh->cmap);
+    return sh->bad;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    static const char * const mix[] = {"read-heavy", "write-heavy"};
+    static const int get_pct[] = {90, 50};
+    struct shared sh;		/* what the threads share */
+    long ncpu;			/* number of CPUs */
+    int maxthread;		/* -t threads */
+    int c_flag = 0;		/* 1 ==> -c check mode */
+    int nthread;		/* threads timed */
+    int m;			/* mix */
+    size_t i;
+
+    prog = strrchr(argv[0], '/');
+    prog = (prog == NULL) ? argv[0] : prog + 1;
+    memset(&sh, 0, sizeof(sh));
+    sh.nkey = 100000;
+    sh.nop = 1000000;
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    maxthread = (ncpu < 1) ? 1 : (ncpu > MAX_THREADS) ? MAX_THREADS :
+		(int)ncpu;
+    while ((m = getopt(argc, argv, "hcn:o:t:")) != -1) {
+	switch (m) {
+	case 'h':
+	    fprintf(stderr, usage, prog);
+	    exit(2);
+	case 'c':
+	    c_flag = 1;
+	    break;
+	case 'n':
+	    sh.nkey = (size_t)strtoull(optarg, NULL, 0);
+	    break;
+	case 'o':
+	    sh.nop = (size_t)strtoull(optarg, NULL, 0);
+	    break;
+	case 't':
+	    maxthread = atoi(optarg);
+	    break;
+	default:
+	    fprintf(stderr, usage, prog);
+	    exit(3);
+	}
+    }
+    if (optind != argc || sh.nkey < 2 * MAX_THREADS || sh.nop == 0 ||
+	maxthread < 1 || maxthread > MAX_THREADS) {
+	fprintf(stderr, usage, prog);
+	exit(3);
+    }
+    sh.keys = calloc(sh.nkey, KEY_LEN);
+    if (sh.keys == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    for (i = 0; i < sh.nkey; ++i) {
+	snprintf(sh.keys[i], KEY_LEN, "key-%zu", i);
+    }
+    pthread_mutex_init(&sh.mutex, NULL);
+    pthread_rwlock_init(&sh.rwlock, NULL);
+
+    if (c_flag) {
+	/* at least 4 threads, so that they contend even on 1 CPU */
+	if (check(&sh, (maxthread < 4) ? 4 : maxthread) != 0) {
+	    printf("failed\n");
+	    exit(5);
+	}
+	printf("passed\n");
+	exit(0);
+    }
+    for (m = 0; m < 2; ++m) {
+	sh.get_pct = get_pct[m];
+	for (nthread = 1; nthread <= maxthread; nthread *= 2) {
+	    time_kind(&sh, CMAP, mix[m], nthread);
+	    time_kind(&sh, MUTEX, mix[m], nthread);
+	    time_kind(&sh, RWLOCK, mix[m], nthread);
+	}
+    }
+    exit(0);
+}
@@ -0,0 +1,830 @@
+/*
+ * fnv_cuckoo - cuckoo filter with deletion, hashed with one FNV-1a pass
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * A cuckoo filter (Fan, Andersen, Kaminsky and Mitzenmacher, "Cuckoo
+ * Filter: Practically Better Than Bloom", 2014).  Each key is stored as
+ * an f bit fingerprint, f = 8, 12 or 16, in one of two buckets of 4
+ * slots.  Unlike a Bloom filter, a key can be deleted by clearing its
+ * fingerprint.
+ *
+ * Each key is hashed once with fnv_64a_mix().  The upper 32 bits of the
+ * hash choose the first bucket i1 of n, and the top f bits of the lower
+ * 32 bits are the fingerprint fp, 0 being kept for an empty slot.  The
+ * other bucket is
+ *
+ *	i2 = (h(fp) - i1) mod n
+ *
+ * where h(fp) < n depends only on fp.  Since (h(fp) - i2) mod n = i1,
+ * either bucket and the fingerprint give the other, which is what lets
+ * a full bucket move a fingerprint to its other bucket.  The xor of
+ * the original paper does the same, but only when n is a power of 2,
+ * which would leave the filter as little as half full at its target
+ * load.
+ *
+ * A bucket is 4 fingerprints packed into 4, 6 or 8 octets, and the
+ * buckets are packed 16, 10 or 8 to a 64 octet cache line, never
+ * across two lines, so that a lookup costs at most two cache misses.
+ * A fingerprint is found in a bucket with one "has a zero field" test
+ * on the bucket xor the fingerprint in every field.
+ *
+ * An insert into two full buckets moves a random fingerprint of one of
+ * them to its other bucket, up to CUCKOO_KICKS times.  If that fails,
+ * the last fingerprint moved is kept aside as the victim, and the
+ * filter refuses further inserts until a deletion makes room for it.
+ * With 4 slots a bucket, inserts seldom fail below 95% load.
+ *
+ * The file form is a 64 octet header followed by the cache lines, so
+ * that a filter can be mapped and queried in place.  All fields are in
+ * the native byte order of the host.
+ */
+#define FNV_CUCKOO_MAGIC "FNVcko\0\1"	/* filter file magic */
+#define CUCKOO_LINE 64			/* octets in a cache line */
+#define CUCKOO_SLOTS 4			/* fingerprints in a bucket */
+#define CUCKOO_LOAD 0.95		/* load a new filter is sized for */
+#define CUCKOO_KICKS 500		/* moves tried by an insert */
+#define CUCKOO_BATCH 16			/* keys hashed and prefetched at once */
+
+struct cuckoo_hdr {
+    char magic[8];		/* FNV_CUCKOO_MAGIC */
+    Fnv32_t bits;		/* bits in a fingerprint: 8, 12 or 16 */
+    Fnv32_t victim;		/* fingerprint kept aside, 0 ==> none */
+    unsigned long long nbucket;	/* number of buckets */
+    unsigned long long nkey;	/* fingerprints stored */
+    unsigned long long vbucket;	/* a bucket of the victim */
+    char pad[24];		/* header is 64 octets */
+};
+
+struct fnv_cuckoo {
+    struct cuckoo_hdr *hdr;	/* header, followed by the lines */
+    unsigned char *line;	/* cache lines of buckets */
+    size_t len;			/* octets of header and lines */
+    int mapped;			/* 1 ==> mapped by fnv_cuckoo_open() */
+    int bits;			/* bits in a fingerprint */
+    uint64_t lo;		/* 1 in the low bit of every field */
+    uint64_t hi;		/* 1 in the high bit of every field */
+    uint64_t mask;		/* 1 in every bit of the 4 fields */
+    unsigned long long rand;	/* xorshift state for kicks */
+};
+
+
+/*
+ * where a key is
+ */
+struct cuckoo_pos {
+    unsigned long long i1;	/* first bucket */
+    unsigned long long i2;	/* other bucket */
+    uint64_t fp;		/* fingerprint, never 0 */
+};
+
+
+/*
+ * cuckoo_setup - set the field constants of a filter
+ */
+static void
+cuckoo_setup(struct fnv_cuckoo *c)
+{
+    int i;
+
+    c->bits = (int)c->hdr->bits;
+    c->lo = 0;
+    for (i = 0; i < CUCKOO_SLOTS; ++i) {
+	c->lo |= (uint64_t)1 << (i * c->bits);
+    }
+    c->hi = c->lo << (c->bits - 1);
+    c->mask = (c->bits == 16) ? ~(uint64_t)0 :
+	      ((uint64_t)1 << (CUCKOO_SLOTS * c->bits)) - 1;
+    c->line = (unsigned char *)(c->hdr + 1);
+    c->rand = 0x2545f4914f6cdd1dULL;
+}
+
+
+/*
+ * bucket_ptr - address of a bucket
+ *
+ * The constant divisors let the compiler divide by multiplying.
+ */
+static unsigned char *
+bucket_ptr(struct fnv_cuckoo *c, unsigned long long i)
+{
+    switch (c->bits) {
+    case 8:
+	return c->line + (size_t)(i / 16) * CUCKOO_LINE + (size_t)(i % 16) * 4;
+    case 12:
+	return c->line + (size_t)(i / 10) * CUCKOO_LINE + (size_t)(i % 10) * 6;
+    default:
+	return c->line + (size_t)(i / 8) * CUCKOO_LINE + (size_t)(i % 8) * 8;
+    }
+}
+
+
+/*
+ * bucket_get - the 4 fingerprints of a bucket as one word
+ *
+ * A 12 bit bucket is read with the 2 octets after it, which are in the
+ * same cache line, and masked.
+ */
+static uint64_t
+bucket_get(struct fnv_cuckoo *c, unsigned char *p)
+{
+    uint32_t w32;		/* 8 bit bucket */
+    uint64_t w;			/* 12 or 16 bit bucket */
+
+    if (c->bits == 8) {
+	memcpy(&w32, p, sizeof(w32));
+	return w32;
+    }
+    memcpy(&w, p, sizeof(w));
+    return w & c->mask;
+}
+
+
+/*
+ * bucket_put - store the 4 fingerprints of a bucket
+ */
+static void
+bucket_put(struct fnv_cuckoo *c, unsigned char *p, uint64_t w)
+{
+    uint32_t w32;		/* 8 bit bucket */
+    uint64_t old;		/* word holding a 12 bit bucket */
+
+    if (c->bits == 8) {
+	w32 = (uint32_t)w;
+	memcpy(p, &w32, sizeof(w32));
+    } else if (c->bits == 12) {
+	memcpy(&old, p, sizeof(old));
+	w = (old & ~c->mask) | w;
+	memcpy(p, &w, sizeof(w));
+    } else {
+	memcpy(p, &w, sizeof(w));
+    }
+}
+
+
+/*
+ * bucket_has - test whether a bucket word holds a fingerprint
+ */
+static int
+bucket_has(struct fnv_cuckoo *c, uint64_t w, uint64_t fp)
+{
+    uint64_t v = w ^ (fp * c->lo);	/* 0 in the fields holding fp */
+
+    return ((v - c->lo) & ~v & c->hi) != 0;
+}
+
+
+/*
+ * bucket_slot - slot of a bucket word holding a fingerprint
+ *
+ * input:
+ *	c	- filter
+ *	w	- bucket word
+ *	fp	- fingerprint, or 0 for an empty slot
+ *
+ * returns:
+ *	slot 0 .. 3, or -1 ==> fp not in the bucket
+ */
+static int
+bucket_slot(struct fnv_cuckoo *c, uint64_t w, uint64_t fp)
+{
+    uint64_t field = ((uint64_t)1 << c->bits) - 1;	/* one field */
+    int i;
+
+    for (i = 0; i < CUCKOO_SLOTS; ++i) {
+	if (((w >> (i * c->bits)) & field) == fp) {
+	    return i;
+	}
+    }
+    return -1;
+}
+
+
+/*
+ * alt_bucket - the other bucket of a fingerprint
+ */
+static unsigned long long
+alt_bucket(struct fnv_cuckoo *c, unsigned long long i, uint64_t fp)
+{
+    unsigned long long h;	/* h(fp), 0 .. nbucket-1 */
+
+    h = (((fp * 0x5bd1e995ULL) & 0xffffffffULL) * c->hdr->nbucket) >> 32;
+    return (h >= i) ? h - i : h + c->hdr->nbucket - i;
+}
+
+
+/*
+ * cuckoo_pos - hash a key and find its buckets and fingerprint
+ */
+static void
+cuckoo_pos(struct fnv_cuckoo *c, const void *key, size_t len,
+	   struct cuckoo_pos *p)
+{
+    unsigned long long x;	/* hash of key */
+
+    x = fnv_64a_mix(key, len, 0);
+    /* hi * nbucket / 2^32 maps hi onto the buckets without a division */
+    p->i1 = ((x >> 32) * c->hdr->nbucket) >> 32;
+    p->fp = (x & 0xffffffffULL) >> (32 - c->bits);
+    if (p->fp == 0) {
+	p->fp = 1;
+    }
+    p->i2 = alt_bucket(c, p->i1, p->fp);
+}
+
+
+/*
+ * cuckoo_test - test whether a key's fingerprint is stored
+ */
+static int
+cuckoo_test(struct fnv_cuckoo *c, struct cuckoo_pos *p)
+{
+    if (bucket_has(c, bucket_get(c, bucket_ptr(c, p->i1)), p->fp) ||
+	bucket_has(c, bucket_get(c, bucket_ptr(c, p->i2)), p->fp)) {
+	return 1;
+    }
+    return c->hdr->victim == p->fp &&
+	   (c->hdr->vbucket == p->i1 || c->hdr->vbucket == p->i2);
+}
+
+
+/*
+ * bucket_add - put a fingerprint in an empty slot of a bucket
+ *
+ * returns:
+ *	1 ==> stored, 0 ==> bucket full
+ */
+static int
+bucket_add(struct fnv_cuckoo *c, unsigned long long i, uint64_t fp)
+{
+    unsigned char *p = bucket_ptr(c, i);	/* the bucket */
+    uint64_t w = bucket_get(c, p);		/* its fingerprints */
+    int slot;			/* empty slot */
+
+    slot = bucket_slot(c, w, 0);
+    if (slot < 0) {
+	return 0;
+    }
+    bucket_put(c, p, w | (fp << (slot * c->bits)));
+    return 1;
+}
+
+
+/*
+ * cuckoo_insert - store a fingerprint in one of its buckets
+ *
+ * returns:
+ *	0 ==> stored, -1 ==> filter full, a fingerprint is now the victim
+ */
+static int
+cuckoo_insert(struct fnv_cuckoo *c, unsigned long long i1,
+	      unsigned long long i2, uint64_t fp)
+{
+    uint64_t field = ((uint64_t)1 << c->bits) - 1;	/* one field */
+    unsigned long long i;	/* bucket a fingerprint is moved from */
+    unsigned char *p;		/* that bucket */
+    uint64_t w;			/* its fingerprints */
+    uint64_t old;		/* fingerprint moved out */
+    int slot;			/* slot of old */
+    int kick;
+
+    if (bucket_add(c, i1, fp) || bucket_add(c, i2, fp)) {
+	return 0;
+    }
+    c->rand ^= c->rand << 13;
+    c->rand ^= c->rand >> 7;
+    c->rand ^= c->rand << 17;
+    i = (c->rand & 1) ? i1 : i2;
+    for (kick = 0; kick < CUCKOO_KICKS; ++kick) {
+	/* swap fp with a random fingerprint of bucket i */
+	c->rand ^= c->rand << 13;
+	c->rand ^= c->rand >> 7;
+	c->rand ^= c->rand << 17;
+	slot = (int)((c->rand >> 32) % CUCKOO_SLOTS);
+	p = bucket_ptr(c, i);
+	w = bucket_get(c, p);
+	old = (w >> (slot * c->bits)) & field;
+	w = (w & ~(field << (slot * c->bits))) | (fp << (slot * c->bits));
+	bucket_put(c, p, w);
+	fp = old;
+
+	/* move the old fingerprint to its other bucket */
+	i = alt_bucket(c, i, fp);
+	if (bucket_add(c, i, fp)) {
+	    return 0;
+	}
+    }
+    c->hdr->victim = (Fnv32_t)fp;
+    c->hdr->vbucket = i;
+    return -1;
+}
+
+
+/*
+ * fnv_cuckoo_new - create an empty cuckoo filter
+ *
+ * input:
+ *	nkey	- number of keys the filter is sized for, > 0
+ *	bits	- bits in a fingerprint: 8, 12 or 16
+ *
+ * returns:
+ *	new filter, free with fnv_cuckoo_free(), or NULL ==> error, errno set
+ *
+ * The filter holds nkey keys at 95% load.  Its false positive rate is
+ * about 8 * load / 2^bits: 3% for 8 bits, 0.19% for 12 and 0.012% for 16.
+ */
+struct fnv_cuckoo *
+fnv_cuckoo_new(unsigned long long nkey, int bits)
+{
+    struct fnv_cuckoo *c;	/* new filter */
+    unsigned long long nbucket;	/* number of buckets */
+    unsigned long long nline;	/* number of cache lines */
+    unsigned long long per;	/* buckets in a line */
+
+    if (nkey == 0 || (bits != 8 && bits != 12 && bits != 16)) {
+	errno = EINVAL;
+	return NULL;
+    }
+    per = CUCKOO_LINE * 8 / (CUCKOO_SLOTS * (unsigned long long)bits);
+    nbucket = (unsigned long long)((double)nkey /
+				   (CUCKOO_SLOTS * CUCKOO_LOAD)) + 1;
+    nline = (nbucket + per - 1) / per;
+    nbucket = nline * per;
+    if (nbucket > 0xffffffffULL ||
+	nline > (SIZE_MAX - sizeof(struct cuckoo_hdr)) / CUCKOO_LINE) {
+	errno = EFBIG;
+	return NULL;
+    }
+    c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    c->len = sizeof(struct cuckoo_hdr) + (size_t)nline * CUCKOO_LINE;
+    if (posix_memalign((void **)&c->hdr, CUCKOO_LINE, c->len) != 0) {
+	free(c);
+	errno = ENOMEM;
+	return NULL;
+    }
+    memset(c->hdr, 0, c->len);
+    memcpy(c->hdr->magic, FNV_CUCKOO_MAGIC, sizeof(c->hdr->magic));
+    c->hdr->bits = (Fnv32_t)bits;
+    c->hdr->nbucket = nbucket;
+    cuckoo_setup(c);
+    return c;
+}
+
+
+/*
+ * fnv_cuckoo_open - map a filter saved by fnv_cuckoo_save()
+ *
+ * input:
+ *	path	- filter file
+ *
+ * returns:
+ *	open filter, or NULL ==> error, errno set (EINVAL ==> not a filter)
+ *
+ * The file is mapped private: lookups read the page cache in place,
+ * and keys added or deleted change only this process's copy until it
+ * is saved.
+ */
+struct fnv_cuckoo *
+fnv_cuckoo_open(char *path)
+{
+    struct fnv_cuckoo *c;	/* opened filter */
+    struct stat st;		/* file status */
+    void *map;			/* mapped file */
+    unsigned long long per;	/* buckets in a line */
+    int fd;			/* open filter */
+    int err;			/* saved errno */
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+	return NULL;
+    }
+    if (fstat(fd, &st) < 0) {
+	err = errno;
+	close(fd);
+	errno = err;
+	return NULL;
+    }
+    if (st.st_size < (off_t)(sizeof(struct cuckoo_hdr) + CUCKOO_LINE) ||
+	(unsigned long long)st.st_size > SIZE_MAX) {
+	close(fd);
+	errno = EINVAL;
+	return NULL;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE,
+	       fd, 0);
+    err = errno;
+    close(fd);
+    if (map == MAP_FAILED) {
+	errno = err;
+	return NULL;
+    }
+    c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+	munmap(map, (size_t)st.st_size);
+	errno = ENOMEM;
+	return NULL;
+    }
+    c->hdr = (struct cuckoo_hdr *)map;
+    c->len = (size_t)st.st_size;
+    c->mapped = 1;
+    if (memcmp(c->hdr->magic, FNV_CUCKOO_MAGIC, sizeof(c->hdr->magic)) != 0 ||
+	(c->hdr->bits != 8 && c->hdr->bits != 12 && c->hdr->bits != 16)) {
+	fnv_cuckoo_free(c);
+	errno = EINVAL;
+	return NULL;
+    }
+    per = CUCKOO_LINE * 8 / (CUCKOO_SLOTS * (unsigned long long)c->hdr->bits);
+    if (c->hdr->nbucket == 0 || c->hdr->nbucket > 0xffffffffULL ||
+	c->hdr->nbucket % per != 0 ||
+	c->hdr->vbucket >= c->hdr->nbucket ||
+	c->len != sizeof(struct cuckoo_hdr) +
+		  (size_t)(c->hdr->nbucket / per) * CUCKOO_LINE) {
+	fnv_cuckoo_free(c);
+	errno = EINVAL;
+	return NULL;
+    }
+    cuckoo_setup(c);
+    return c;
+}
+
+
+/*
+ * fnv_cuckoo_save - write a filter to a file
+ *
+ * input:
+ *	c	- filter
+ *	path	- file to create or replace
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ *
+ * The filter is written to path.tmp and renamed to path, so that a
+ * process mapping the old file keeps a whole filter.
+ */
+int
+fnv_cuckoo_save(struct fnv_cuckoo *c, char *path)
+{
+    char *tmp;			/* temporary file name */
+    const char *p;		/* octets left to write */
+    size_t left;		/* number of octets left */
+    ssize_t n;			/* octets written */
+    int fd;			/* open temporary file */
+    int err;			/* saved errno */
+
+    tmp = malloc(strlen(path) + sizeof(".tmp"));
+    if (tmp == NULL) {
+	errno = ENOMEM;
+	return -1;
+    }
+    sprintf(tmp, "%s.tmp", path);
+    fd = open(tmp, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+	err = errno;
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    for (p = (const char *)c->hdr, left = c->len; left > 0;
+	 p += n, left -= (size_t)n) {
+	n = write(fd, p, left);
+	if (n < 0 && errno == EINTR) {
+	    n = 0;
+	} else if (n <= 0) {
+	    goto error;
+	}
+    }
+    if (close(fd) < 0) {
+	fd = -1;
+	goto error;
+    }
+    if (rename(tmp, path) < 0) {
+	fd = -1;
+	goto error;
+    }
+    free(tmp);
+    return 0;
+
+error:
+    err = (errno == 0) ? EIO : errno;
+    if (fd >= 0) {
+	close(fd);
+    }
+    unlink(tmp);
+    free(tmp);
+    errno = err;
+    return -1;
+}
+
+
+/*
+ * fnv_cuckoo_free - free or unmap a filter
+ */
+void
+fnv_cuckoo_free(struct fnv_cuckoo *c)
+{
+    if (c == NULL) {
+	return;
+    }
+    if (c->mapped) {
+	munmap(c->hdr, c->len);
+    } else {
+	free(c->hdr);
+    }
+    free(c);
+}
+
+
+/*
+ * fnv_cuckoo_info - describe a filter
+ *
+ * input:
+ *	c	- filter
+ *	nbit	- where to store the number of bits of the table, or NULL
+ *	bits	- where to store the bits in a fingerprint, or NULL
+ *	nkey	- where to store the number of keys stored, or NULL
+ *
+ * returns:
+ *	load factor: keys stored over the slots of the table
+ */
+double
+fnv_cuckoo_info(struct fnv_cuckoo *c, unsigned long long *nbit, int *bits,
+		unsigned long long *nkey)
+{
+    if (nbit != NULL) {
+	*nbit = (unsigned long long)(c->len - sizeof(struct cuckoo_hdr)) * 8;
+    }
+    if (bits != NULL) {
+	*bits = c->bits;
+    }
+    if (nkey != NULL) {
+	*nkey = c->hdr->nkey;
+    }
+    return (double)c->hdr->nkey / (double)(c->hdr->nbucket * CUCKOO_SLOTS);
+}
+
+
+/*
+ * fnv_cuckoo_add - add a key to a filter
+ *
+ * returns:
+ *	0 ==> added, -1 ==> filter full, key not added
+ *
+ * A key added twice is stored twice, and must be deleted twice.
+ */
+int
+fnv_cuckoo_add(struct fnv_cuckoo *c, const void *key, size_t len)
+{
+    struct cuckoo_pos p;	/* buckets of key */
+
+    if (c->hdr->victim != 0) {
+	return -1;
+    }
+    cuckoo_pos(c, key, len, &p);
+    /* a failed insert stores fp, moving another fingerprint aside */
+    cuckoo_insert(c, p.i1, p.i2, p.fp);
+    ++c->hdr->nkey;
+    return 0;
+}
+
+
+/*
+ * fnv_cuckoo_has - test whether a key may have been added to a filter
+ *
+ * returns:
+ *	1 ==> key may have been added, 0 ==> key was not added
+ */
+int
+fnv_cuckoo_has(struct fnv_cuckoo *c, const void *key, size_t len)
+{
+    struct cuckoo_pos p;	/* buckets of key */
+
+    cuckoo_pos(c, key, len, &p);
+    return cuckoo_test(c, &p);
+}
+
+
+/*
+ * fnv_cuckoo_del - delete a key from a filter
+ *
+ * returns:
+ *	1 ==> deleted, 0 ==> key's fingerprint not found
+ *
+ * Only keys that were added may be deleted: deleting a key that was
+ * not added, but shares a fingerprint and bucket with one that was,
+ * deletes that other key.
+ */
+int
+fnv_cuckoo_del(struct fnv_cuckoo *c, const void *key, size_t len)
+{
+    struct cuckoo_pos p;	/* buckets of key */
+    uint64_t field = ((uint64_t)1 << c->bits) - 1;	/* one field */
+    unsigned long long vi;	/* a bucket of the victim */
+    uint64_t vfp;		/* the victim */
+    unsigned char *b;		/* bucket holding the fingerprint */
+    uint64_t w;			/* its fingerprints */
+    int slot;			/* slot of the fingerprint */
+
+    cuckoo_pos(c, key, len, &p);
+    if (c->hdr->victim == p.fp &&
+	(c->hdr->vbucket == p.i1 || c->hdr->vbucket == p.i2)) {
+	c->hdr->victim = 0;
+	c->hdr->vbucket = 0;
+	--c->hdr->nkey;
+	return 1;
+    }
+    b = bucket_ptr(c, p.i1);
+    w = bucket_get(c, b);
+    slot = bucket_slot(c, w, p.fp);
+    if (slot < 0) {
+	b = bucket_ptr(c, p.i2);
+	w = bucket_get(c, b);
+	slot = bucket_slot(c, w, p.fp);
+	if (slot < 0) {
+	    return 0;
+	}
+    }
+    bucket_put(c, b, w & ~(field << (slot * c->bits)));
+    --c->hdr->nkey;
+
+    /* there is now room for the victim */
+    if (c->hdr->victim != 0) {
+	vfp = c->hdr->victim;
+	vi = c->hdr->vbucket;
+	c->hdr->victim = 0;
+	c->hdr->vbucket = 0;
+	cuckoo_insert(c, vi, alt_bucket(c, vi, vfp), vfp);
+    }
+    return 1;
+}
+
+
+/*
+ * fnv_cuckoo_add_batch - add many keys to a filter
+ *
+ * input:
+ *	c	- filter
+ *	n	- number of keys
+ *	key	- key octets of each key
+ *	len	- length of each key
+ *
+ * returns:
+ *	number of keys added, < n ==> filter full after that many
+ *
+ * The buckets of CUCKOO_BATCH keys are prefetched before any is
+ * changed, so that their cache misses overlap.
+ */
+size_t
+fnv_cuckoo_add_batch(struct fnv_cuckoo *c, size_t n, const void * const *key,
+		     const size_t *len)
+{
+    struct cuckoo_pos p[CUCKOO_BATCH];	/* buckets of each key of a batch */
+    size_t first;		/* first key of the batch */
+    size_t cnt;			/* keys in the batch */
+    size_t i;
+
+    for (first = 0; first < n; first += cnt) {
+	cnt = (n - first < CUCKOO_BATCH) ? n - first : CUCKOO_BATCH;
+	for (i = 0; i < cnt; ++i) {
+	    cuckoo_pos(c, key[first + i], len[first + i], &p[i]);
+	    FNV_PREFETCH(bucket_ptr(c, p[i].i1));
+	    FNV_PREFETCH(bucket_ptr(c, p[i].i2));
+	}
+	for (i = 0; i < cnt; ++i) {
+	    if (c->hdr->victim != 0) {
+		return first + i;
+	    }
+	    cuckoo_insert(c, p[i].i1, p[i].i2, p[i].fp);
+	    ++c->hdr->nkey;
+	}
+    }
+    return n;
+}
+
+
+/*
+ * fnv_cuckoo_has_batch - test many keys
+ *
+ * input:
+ *	c	- filter
+ *	n	- number of keys
+ *	key	- key octets of each key
+ *	len	- length of each key
+ *	out	- where to store 1 (may have been added) or 0 for each key
+ *
+ * returns:
+ *	number of keys that may have been added
+ */
+size_t
+fnv_cuckoo_has_batch(struct fnv_cuckoo *c, size_t n, const void * const *key,
+		     const size_t *len, unsigned char *out)
+{
+    struct cuckoo_pos p[CUCKOO_BATCH];	/* buckets of each key of a batch */
+    size_t first;		/* first key of the batch */
+    size_t cnt;			/* keys in the batch */
+    size_t found = 0;		/* keys that may have been added */
+    size_t i;
+
+    for (first = 0; first < n; first += cnt) {
+	cnt = (n - first < CUCKOO_BATCH) ? n - first : CUCKOO_BATCH;
+	for (i = 0; i < cnt; ++i) {
+	    cuckoo_pos(c, key[first + i], len[first + i], &p[i]);
+	    FNV_PREFETCH(bucket_ptr(c, p[i].i1));
+	    FNV_PREFETCH(bucket_ptr(c, p[i].i2));
+	}
+	for (i = 0; i < cnt; ++i) {
+	    out[first + i] = (unsigned char)cuckoo_test(c, &p[i]);
+	    found += out[first + i];
+	}
+    }
+    return found;
+}
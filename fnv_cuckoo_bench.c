@@ -0,0 +1,469 @@
+/*
+ * fnv_cuckoo_bench - compare fnv_cuckoo with a Bloom filter of the same size
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * usage
+ */
+static const char * const usage =
+"usage: %s [-h] [-c] [-n keys] [-b bits]\n"
+"\n"
+"    -h         print help and exit\n"
+"    -c         check fnv_cuckoo, do not time\n"
+"    -n keys    number of keys (default 1000000)\n"
+"    -b bits    fingerprint bits: 8, 12 or 16 (default: all three)\n"
+"\n"
+"Fills a cuckoo filter sized for the keys to its 95%% target load and a\n"
+"blocked Bloom filter of the same size, and prints, for each, the bits\n"
+"per key, the false positive rate measured on as many other keys, and\n"
+"the millions of keys a second added, tested one at a time, tested in\n"
+"batches, and, for the cuckoo filter, deleted.\n"
+"\n"
+"Exit codes:\n"
+"    0           all OK\n"
+"    2           -h and help string printed\n"
+"    3           command line error\n"
+"    5           -c found a difference\n"
+" >= 20          internal error\n";
+static const char *prog = NULL;	/* our name */
+
+/*
+ * keys
+ */
+struct keys {
+    const void **str;		/* start of each key */
+    size_t *len;		/* length of each key */
+    size_t n;			/* number of keys */
+};
+
+
+/*
+ * now_sec - monotonic time in seconds
+ */
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+ * make_keys - make n keys from a format with one %zu
+ */
+static void
+make_keys(struct keys *k, const char *fmt, size_t n)
+{
+    char *buf;			/* the keys */
+    size_t off = 0;		/* octets in buf */
+    size_t i;
+
+    buf = malloc(n * 32);
+    k->str = malloc(n * sizeof(k->str[0]));
+    k->len = malloc(n * sizeof(k->len[0]));
+    if (buf == NULL || k->str == NULL || k->len == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    for (i = 0; i < n; ++i) {
+	k->str[i] = buf + off;
+	k->len[i] = (size_t)snprintf(buf + off, 32, fmt, i);
+	off += k->len[i] + 1;
+    }
+    k->n = n;
+}
+
+
+/*
+ * bloom_like - a Bloom filter of at most nbit bits for nkey keys
+ *
+ * The Bloom filter is sized by its false positive rate, so the rate
+ * is bisected for the largest filter that is no larger.
+ */
+static struct fnv_bloom *
+bloom_like(unsigned long long nkey, unsigned long long nbit)
+{
+    struct fnv_bloom *b;	/* filter tried */
+    unsigned long long bbit;	/* its bits */
+    double lo = -30.0;		/* log of a rate giving too many bits */
+    double hi = -0.01;		/* log of a rate giving few enough */
+    double mid;			/* log of the rate tried */
+    int i;
+
+    for (i = 0; i < 40; ++i) {
+	mid = (lo + hi) / 2.0;
+	b = fnv_bloom_new(nkey, exp(mid));
+	if (b == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(21);
+	}
+	fnv_bloom_info(b, &bbit, NULL, NULL);
+	fnv_bloom_free(b);
+	if (bbit > nbit) {
+	    lo = mid;
+	} else {
+	    hi = mid;
+	}
+    }
+    b = fnv_bloom_new(nkey, exp(hi));
+    if (b == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(21);
+    }
+    return b;
+}
+
+
+/*
+ * print_line - print one line of results
+ */
+static void
+print_line(const char *name, double bpk, double fpr, size_t n,
+	   double add, double has, double batch, double del)
+{
+    printf("%-10s %8.2f %9.5f%% %9.2f %9.2f %9.2f ", name, bpk, fpr * 100.0,
+	   (double)n / add / 1e6, (double)n / has / 1e6,
+	   (double)n / batch / 1e6);
+    if (del > 0.0) {
+	printf("%9.2f\n", (double)n / del / 1e6);
+    } else {
+	printf("%9s\n", "-");
+    }
+}
+
+
+/*
+ * bench - time a cuckoo filter and a Bloom filter of the same size
+ */
+static void
+bench(struct keys *in, struct keys *out, int bits)
+{
+    struct fnv_cuckoo *c;	/* cuckoo filter */
+    struct fnv_bloom *b;	/* Bloom filter */
+    unsigned char *res;		/* batch results */
+    unsigned long long nbit;	/* bits of the cuckoo filter */
+    unsigned long long bbit;	/* bits of the Bloom filter */
+    char name[16];		/* filter name */
+    double t_add, t_has, t_batch, t_del;	/* timings */
+    double start;		/* starting time */
+    size_t fp;			/* false positives */
+    size_t i;
+
+    res = malloc(out->n);
+    c = fnv_cuckoo_new(in->n, bits);
+    if (res == NULL || c == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    start = now_sec();
+    for (i = 0; i < in->n; ++i) {
+	if (fnv_cuckoo_add(c, in->str[i], in->len[i]) < 0) {
+	    fprintf(stderr, "%s: cuckoo filter full after %zu keys\n",
+		    prog, i);
+	    exit(22);
+	}
+    }
+    t_add = now_sec() - start;
+    fnv_cuckoo_info(c, &nbit, NULL, NULL);
+    start = now_sec();
+    for (i = 0, fp = 0; i < out->n; ++i) {
+	fp += (size_t)fnv_cuckoo_has(c, out->str[i], out->len[i]);
+    }
+    t_has = now_sec() - start;
+    start = now_sec();
+    fnv_cuckoo_has_batch(c, out->n, out->str, out->len, res);
+    t_batch = now_sec() - start;
+    start = now_sec();
+    for (i = 0; i < in->n; ++i) {
+	fnv_cuckoo_del(c, in->str[i], in->len[i]);
+    }
+    t_del = now_sec() - start;
+    snprintf(name, sizeof(name), "cuckoo-%d", bits);
+    print_line(name, (double)nbit / (double)in->n, (double)fp /
+	       (double)out->n, in->n, t_add, t_has, t_batch, t_del);
+    fnv_cuckoo_free(c);
+
+    b = bloom_like(in->n, nbit);
+    start = now_sec();
+    for (i = 0; i < in->n; ++i) {
+	fnv_bloom_add(b, in->str[i], in->len[i]);
+    }
+    t_add = now_sec() - start;
+    fnv_bloom_info(b, &bbit, NULL, NULL);
+    start = now_sec();
+    for (i = 0, fp = 0; i < out->n; ++i) {
+	fp += (size_t)fnv_bloom_has(b, out->str[i], out->len[i]);
+    }
+    t_has = now_sec() - start;
+    start = now_sec();
+    fnv_bloom_has_batch(b, out->n, out->str, out->len, res);
+    t_batch = now_sec() - start;
+    print_line("bloom", (double)bbit / (double)in->n, (double)fp /
+	       (double)out->n, in->n, t_add, t_has, t_batch, 0.0);
+    fnv_bloom_free(b);
+    free(res);
+}
+
+
+/*
+ * check - check a cuckoo filter
+ *
+ * returns:
+ *	0 ==> passed, 1 ==> failed
+ */
+static int
+check(struct keys *in, struct keys *out, int bits)
+{
+    struct fnv_cuckoo *c;	/* filter */
+    struct fnv_cuckoo *m;	/* filter saved and opened */
+    unsigned char *res;		/* batch results */
+    char path[] = "/tmp/fnv_cuckoo.XXXXXX";	/* saved filter */
+    char fill[32];		/* key added to fill the filter */
+    double load;		/* load factor */
+    double most;		/* most false positives allowed */
+    size_t half = in->n / 2;	/* keys deleted */
+    size_t fp;			/* false positives */
+    size_t i;
+    int fd;			/* open saved filter */
+
+    res = malloc(in->n + out->n);
+    c = fnv_cuckoo_new(in->n, bits);
+    if (res == NULL || c == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(23);
+    }
+
+    /* add half one at a time and half in batches, then find them all */
+    for (i = 0; i < half; ++i) {
+	if (fnv_cuckoo_add(c, in->str[i], in->len[i]) != 0) {
+	    return 1;
+	}
+    }
+    if (fnv_cuckoo_add_batch(c, in->n - half, in->str + half,
+			     in->len + half) != in->n - half) {
+	return 1;
+    }
+    if (fnv_cuckoo_has_batch(c, in->n, in->str, in->len, res) != in->n) {
+	return 1;
+    }
+    for (i = 0; i < in->n; ++i) {
+	if (!fnv_cuckoo_has(c, in->str[i], in->len[i])) {
+	    return 1;
+	}
+    }
+
+    /* the false positive rate is about 8 * load / 2^bits */
+    load = fnv_cuckoo_info(c, NULL, NULL, NULL);
+    most = 2.0 * 8.0 * load / (double)(1 << bits) * (double)out->n + 10.0;
+    fp = fnv_cuckoo_has_batch(c, out->n, out->str, out->len, res);
+    for (i = 0; i < out->n; ++i) {
+	if (res[i] != fnv_cuckoo_has(c, out->str[i], out->len[i])) {
+	    return 1;
+	}
+    }
+    if ((double)fp > most) {
+	return 1;
+    }
+
+    /* a saved filter answers the same */
+    fd = mkstemp(path);
+    if (fd < 0) {
+	return 1;
+    }
+    close(fd);
+    if (fnv_cuckoo_save(c, path) != 0) {
+	unlink(path);
+	return 1;
+    }
+    m = fnv_cuckoo_open(path);
+    unlink(path);
+    if (m == NULL ||
+	fnv_cuckoo_has_batch(m, in->n, in->str, in->len, res) != in->n ||
+	fnv_cuckoo_has_batch(m, out->n, out->str, out->len, res) != fp) {
+	return 1;
+    }
+    fnv_cuckoo_free(m);
+
+    /* delete half: the rest are all still found */
+    for (i = 0; i < half; ++i) {
+	if (fnv_cuckoo_del(c, in->str[i], in->len[i]) != 1) {
+	    return 1;
+	}
+    }
+    if (fnv_cuckoo_has_batch(c, in->n - half, in->str + half,
+			     in->len + half, res) != in->n - half ||
+	(double)fnv_cuckoo_has_batch(c, half, in->str, in->len, res) > most) {
+	return 1;
+    }
+
+    /* fill to the target load, and past it until an add fails */
+    for (i = 0; ; ++i) {
+	snprintf(fill, sizeof(fill), "fill-%zu", i);
+	if (fnv_cuckoo_add(c, fill, strlen(fill)) != 0) {
+	    break;
+	}
+    }
+    if (fnv_cuckoo_info(c, NULL, NULL, NULL) < 0.95 ||
+	fnv_cuckoo_has_batch(c, in->n - half, in->str + half,
+			     in->len + half, res) != in->n - half ||
+	fnv_cuckoo_has(c, fill, strlen(fill))) {
+	return 1;
+    }
+
+    /* a deletion makes room again */
+    if (fnv_cuckoo_del(c, in->str[half], in->len[half]) != 1 ||
+	fnv_cuckoo_add(c, fill, strlen(fill)) != 0 ||
+	!fnv_cuckoo_has(c, fill, strlen(fill))) {
+	return 1;
+    }
+    fnv_cuckoo_free(c);
+    free(res);
+    return 0;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    struct keys in;		/* keys added */
+    struct keys out;		/* other keys */
+    size_t n = 1000000;		/* -n keys */
+    int bits = 0;		/* -b bits, 0 ==> all */
+    int c_flag = 0;		/* 1 ==> -c check mode */
+    int b;			/* fingerprint bits */
+    int c;
+
+    prog = strrchr(argv[0], '/');
+    prog = (prog == NULL) ? argv[0] : prog + 1;
+    while ((c = getopt(argc, argv, "hcn:b:")) != -1) {
+	switch (c) {
+	case 'h':
+	    fprintf(stderr, usage, prog);
+	    exit(2);
+	case 'c':
+	    c_flag = 1;
+	    break;
+	case 'n':
+	    n = (size_t)strtoull(optarg, NULL, 0);
+	    break;
+	case 'b':
+	    bits = atoi(optarg);
+	    break;
+	default:
+	    fprintf(stderr, usage, prog);
+	    exit(3);
+	}
+    }
+    if (optind != argc || n < 2 ||
+	(bits != 0 && bits != 8 && bits != 12 && bits != 16)) {
+	fprintf(stderr, usage, prog);
+	exit(3);
+    }
+    make_keys(&in, "key-%zu", n);
+    make_keys(&out, "other-%zu", n);
+
+    if (c_flag) {
+	for (b = 8; b <= 16; b += 4) {
+	    if ((bits == 0 || bits == b) && check(&in, &out, b) != 0) {
+		printf("failed\n");
+		exit(5);
+	    }
+	}
+	printf("passed\n");
+	exit(0);
+    }
+
+    printf("%-10s %8s %10s %9s %9s %9s %9s\n", "filter", "bits/key",
+	   "fpr", "add", "has", "has_batch", "del");
+    for (b = 8; b <= 16; b += 4) {
+	if (bits == 0 || bits == b) {
+	    bench(&in, &out, b);
+	}
+    }
+    exit(0);
+}
@@ -0,0 +1,375 @@
+/*
+ * fnv_file - FNV hash byte ranges and samples of open files
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <ctype.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "fnv.h"
+
+#define FNV_FILE_BUF_SIZE (64*1024)	/* octets to read at a time */
+
+
+/*
+ * fnv_buf_64 - perform a 64 bit FNV hash of a given type on a buffer
+ *
+ * input:
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	buf	- start of buffer to hash
+ *	len	- length of buffer in octets
+ *	hval	- previous hash value or the initial basis if first call
+ *
+ * returns:
+ *	64 bit hash, or hval unchanged if type is not a 64 bit FNV hash type
+ */
+Fnv64_t
+fnv_buf_64(enum fnv_type type, void *buf, size_t len, Fnv64_t hval)
+{
+    switch (type) {
+    case FNV0_64:
+    case FNV1_64:
+	return fnv_64_buf(buf, len, hval);
+    case FNV1a_64:
+	return fnv_64a_buf(buf, len, hval);
+    default:
+	break;
+    }
+    return hval;
+}
+
+
+/*
+ * fnv_zeros_64 - perform a 64 bit FNV hash of a given type on zero octets
+ *
+ * input:
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	n	- number of zero octets, <= 0 ==> none
+ *	hval	- previous hash value or the initial basis if first call
+ *
+ * returns:
+ *	64 bit hash, or hval unchanged if type is not a 64 bit FNV hash type
+ */
+Fnv64_t
+fnv_zeros_64(enum fnv_type type, off_t n, Fnv64_t hval)
+{
+    switch (type) {
+    case FNV0_64:
+    case FNV1_64:
+	return fnv_64_zeros(hval, n);
+    case FNV1a_64:
+	return fnv_64a_zeros(hval, n);
+    default:
+	break;
+    }
+    return hval;
+}
+
+
+/*
+ * fnv_range_64 - 64 bit FNV hash a byte range of an open file
+ *
+ * input:
+ *	fd	- open file descriptor, must support pread(2)
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	offset	- first octet of the range
+ *	length	- length of the range in octets, < 0 ==> until EOF
+ *	hval	- pointer to previous hash value or the initial basis,
+ *		  updated with the hash of the range
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error with errno set
+ *
+ * A range that extends beyond EOF is hashed up to EOF.  The file offset
+ * of fd is not changed.
+ */
+int
+fnv_range_64(int fd, enum fnv_type type, off_t offset, off_t length,
+	     Fnv64_t *hval)
+{
+    char *buf;			/* read buffer */
+    ssize_t readcnt;		/* octets read */
+    size_t want;		/* octets to read next */
+    Fnv64_t h;			/* running hash value */
+
+    if (offset < 0 || (type != FNV0_64 && type != FNV1_64 &&
+		       type != FNV1a_64)) {
+	errno = EINVAL;
+	return -1;
+    }
+    buf = malloc(FNV_FILE_BUF_SIZE);
+    if (buf == NULL) {
+	return -1;
+    }
+#if defined(POSIX_FADV_SEQUENTIAL)
+    (void) posix_fadvise(fd, offset, (length < 0) ? 0 : length,
+			 POSIX_FADV_SEQUENTIAL);
+#endif /* POSIX_FADV_SEQUENTIAL */
+
+    h = *hval;
+    while (length != 0) {
+	want = FNV_FILE_BUF_SIZE;
+	if (length > 0 && (off_t)want > length) {
+	    want = (size_t)length;
+	}
+	readcnt = pread(fd, buf, want, offset);
+	if (readcnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    free(buf);
+	    return -1;
+	}
+	if (readcnt == 0) {
+	    break;
+	}
+	h = fnv_buf_64(type, buf, (size_t)readcnt, h);
+	offset += readcnt;
+	if (length > 0) {
+	    length -= readcnt;
+	}
+    }
+    free(buf);
+    *hval = h;
+    return 0;
+}
+
+
+/*
+ * fnv_sample_64 - 64 bit FNV hash sampled blocks of an open file
+ *
+ * input:
+ *	fd	- open file descriptor, must support pread(2) and fstat(2)
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	nblock	- number of blocks to sample, > 0
+ *	blksize	- size of each block in octets, > 0
+ *	hval	- pointer to previous hash value or the initial basis,
+ *		  updated with the sampled fingerprint
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error with errno set
+ *
+ * The fingerprint is the hash of the file size, as 8 octets in little
+ * endian order, followed by nblock blocks evenly spaced from the start
+ * to the end of the file.  Files no larger than nblock*blksize are hashed
+ * in full after the size.  Equal files have equal fingerprints, but
+ * unequal files may collide: the fingerprint is only a prefilter.
+ *
+ * All block reads are announced to the kernel with posix_fadvise(2)
+ * before the first one is issued, so that the reads proceed concurrently
+ * and are sorted by the I/O scheduler instead of costing one seek and
+ * one rotational delay at a time.
+ */
+int
+fnv_sample_64(int fd, enum fnv_type type, int nblock, size_t blksize,
+	      Fnv64_t *hval)
+{
+    struct stat st;		/* file status */
+    unsigned char size[8];	/* file size in little endian order */
+    off_t *off;			/* offset of each block */
+    unsigned long long span;	/* distance from first to last block */
+    Fnv64_t h;			/* running hash value */
+    int i;
+
+    if (nblock <= 0 || blksize == 0) {
+	errno = EINVAL;
+	return -1;
+    }
+    if (fstat(fd, &st) < 0) {
+	return -1;
+    }
+
+    /*
+     * hash the file size
+     */
+    for (i = 0; i < 8; ++i) {
+	size[i] = (unsigned char)(((unsigned long long)st.st_size) >> (8*i));
+    }
+    h = fnv_buf_64(type, size, sizeof(size), *hval);
+
+    /*
+     * small files are hashed in full
+     */
+    if ((unsigned long long)st.st_size <=
+	(unsigned long long)nblock * (unsigned long long)blksize) {
+	if (fnv_range_64(fd, type, 0, st.st_size, &h) < 0) {
+	    return -1;
+	}
+	*hval = h;
+	return 0;
+    }
+
+    /*
+     * compute the evenly spaced block offsets
+     */
+    off = malloc(sizeof(off_t) * (size_t)nblock);
+    if (off == NULL) {
+	return -1;
+    }
+    span = (unsigned long long)st.st_size - (unsigned long long)blksize;
+    for (i = 0; i < nblock; ++i) {
+	if (nblock == 1) {
+	    off[i] = 0;
+	} else {
+	    off[i] = (off_t)(span / (unsigned long long)(nblock - 1) *
+			     (unsigned long long)i);
+	}
+    }
+    if (nblock > 1) {
+	off[nblock-1] = (off_t)span;
+    }
+
+    /*
+     * queue all of the reads before we wait on the first one
+     */
+#if defined(POSIX_FADV_WILLNEED)
+    for (i = 0; i < nblock; ++i) {
+	(void) posix_fadvise(fd, off[i], (off_t)blksize, POSIX_FADV_WILLNEED);
+    }
+#endif /* POSIX_FADV_WILLNEED */
+
+    /*
+     * hash the blocks in file order
+     */
+    for (i = 0; i < nblock; ++i) {
+	if (fnv_range_64(fd, type, off[i], (off_t)blksize, &h) < 0) {
+	    free(off);
+	    return -1;
+	}
+    }
+    free(off);
+    *hval = h;
+    return 0;
+}
+
+
+/*
+ * fnv_parse_size - parse a size argument such as 4096, 64k, 1M or 2G
+ *
+ * input:
+ *	str	- size string: decimal digits with an optional k, m, g or t
+ *		  suffix (upper or lower case) for powers of 1024
+ *	size	- where to store the parsed size
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> malformed or negative size
+ */
+int
+fnv_parse_size(char *str, off_t *size)
+{
+    char *end;			/* first character beyond the digits */
+    unsigned long long val;	/* parsed value */
+    int shift = 0;		/* suffix power of 2 */
+
+    if (str == NULL || !isdigit((unsigned char)*str)) {
+	return -1;
+    }
+    errno = 0;
+    val = strtoull(str, &end, 10);
+    if (errno != 0) {
+	return -1;
+    }
+    switch (*end) {
+    case '\0':
+	break;
+    case 'k': case 'K':
+	shift = 10;
+	break;
+    case 'm': case 'M':
+	shift = 20;
+	break;
+    case 'g': case 'G':
+	shift = 30;
+	break;
+    case 't': case 'T':
+	shift = 40;
+	break;
+    default:
+	return -1;
+    }
+    if (*end != '\0' && end[1] != '\0') {
+	return -1;
+    }
+    if (val > (0x7fffffffffffffffULL >> shift)) {
+	return -1;
+    }
+    *size = (off_t)(val << shift);
+    return 0;
+}
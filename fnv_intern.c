@@ -0,0 +1,635 @@
+/*
+ * fnv_intern - string interning pool keyed by FNV-1a 64
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * A string interning pool: each distinct string is stored once and is
+ * known by a 32 bit id, 0, 1, 2, ... in the order first interned.
+ *
+ * Strings are copied, NUL terminated, one after another into arena
+ * chunks of at least INTERN_CHUNK octets with a bump pointer, so a
+ * million short strings take a few allocations rather than a million.
+ * Chunks are never moved or freed before the pool, so a string's
+ * address is as stable as its id.
+ *
+ * An open addressing table with linear probing maps strings to ids.
+ * Each slot holds an id and 32 bits of the string's hash, so most
+ * probes that do not match are rejected without touching the string.
+ * The full hash of each id is kept, so the table grows without hashing
+ * any string again.  Hashes are fnv_64a_mix(), since the table is
+ * indexed by the low bits.
+ *
+ * The id of a string is found through pages of 1024, 2048, 4096, ...
+ * entries that never move, so fnv_intern_str() takes no lock.  All
+ * other calls take the pool's mutex, except that a struct
+ * fnv_intern_local, a small direct mapped cache of recent strings owned
+ * by one thread, answers repeated strings without the lock.
+ */
+#define INTERN_CHUNK (1024*1024)	/* least octets in an arena chunk */
+#define INTERN_PAGE0 1024		/* entries in the first id page */
+#define INTERN_PAGES 23			/* id pages for 2^32 - 1024 ids */
+#define INTERN_BATCH 32			/* strings hashed before probing */
+
+struct intern_entry {
+    const char *str;		/* the string, NUL terminated */
+    size_t len;			/* length of str */
+    unsigned long long hash;	/* finalized hash of str */
+};
+
+struct intern_slot {
+    uint32_t id1;		/* id + 1, 0 ==> empty */
+    uint32_t tag;		/* upper 32 bits of the hash */
+};
+
+struct intern_chunk {
+    struct intern_chunk *next;	/* previous chunk */
+};
+
+struct fnv_intern {
+    pthread_mutex_t lock;	/* guards all but the id pages */
+    struct intern_slot *slot;	/* hash table */
+    size_t mask;		/* number of slots - 1 */
+    uint32_t count;		/* number of strings */
+    struct intern_entry *page[INTERN_PAGES];	/* entries by id */
+    struct intern_chunk *chunk;	/* current arena chunk */
+    char *next;			/* free space in chunk */
+    char *end;			/* end of chunk */
+    unsigned long long bytes;	/* octets of strings, with NULs */
+    unsigned long long arena;	/* octets of arena chunks */
+    unsigned long long index;	/* octets of id pages */
+    unsigned long long allocs;	/* memory allocations made */
+};
+
+struct fnv_intern_local {
+    struct fnv_intern *pool;	/* pool in front of which we cache */
+    size_t mask;		/* number of cache entries - 1 */
+    struct intern_entry *ent;	/* cached strings */
+    uint32_t *id;		/* id of each cached string */
+};
+
+
+/*
+ * top_bit - index of the highest set bit of a non-zero value
+ */
+static int
+top_bit(unsigned long long v)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(v);
+#else /* __GNUC__ */
+    int hi = 63;
+
+    while ((v >> hi) == 0) {
+	--hi;
+    }
+    return hi;
+#endif /* __GNUC__ */
+}
+
+
+/*
+ * entry - the entry of an id
+ *
+ * Page k holds the 1024 * 2^k ids from 1024 * (2^k - 1).
+ */
+static struct intern_entry *
+entry(struct fnv_intern *p, uint32_t id)
+{
+    unsigned long long v = (unsigned long long)id + INTERN_PAGE0;
+    int hi = top_bit(v);	/* page + 10 */
+
+    return &p->page[hi - 10][v - (1ULL << hi)];
+}
+
+
+/*
+ * fnv_intern_new - create an empty pool
+ *
+ * input:
+ *	hint	- number of distinct strings expected, 0 ==> unknown
+ *
+ * returns:
+ *	new pool, free with fnv_intern_free(), or NULL ==> error, errno set
+ */
+struct fnv_intern *
+fnv_intern_new(size_t hint)
+{
+    struct fnv_intern *p;	/* new pool */
+    size_t nslot = 1024;	/* initial slots */
+
+    while (nslot < hint * 2 && nslot < ((size_t)1 << 31)) {
+	nslot *= 2;
+    }
+    p = calloc(1, sizeof(*p));
+    if (p == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    p->slot = calloc(nslot, sizeof(p->slot[0]));
+    if (p->slot == NULL) {
+	free(p);
+	errno = ENOMEM;
+	return NULL;
+    }
+    p->mask = nslot - 1;
+    p->allocs = 2;
+    pthread_mutex_init(&p->lock, NULL);
+    return p;
+}
+
+
+/*
+ * fnv_intern_free - free a pool and all its strings
+ */
+void
+fnv_intern_free(struct fnv_intern *p)
+{
+    struct intern_chunk *c;	/* arena chunk */
+    int i;
+
+    if (p == NULL) {
+	return;
+    }
+    while (p->chunk != NULL) {
+	c = p->chunk;
+	p->chunk = c->next;
+	free(c);
+    }
+    for (i = 0; i < INTERN_PAGES; ++i) {
+	free(p->page[i]);
+    }
+    free(p->slot);
+    pthread_mutex_destroy(&p->lock);
+    free(p);
+}
+
+
+/*
+ * grow - double the number of slots
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+grow(struct fnv_intern *p)
+{
+    struct intern_slot *slot;	/* new table */
+    size_t mask = p->mask * 2 + 1;	/* new number of slots - 1 */
+    unsigned long long h;	/* hash of a string */
+    size_t i;
+    uint32_t id;
+
+    slot = calloc(mask + 1, sizeof(slot[0]));
+    if (slot == NULL) {
+	return -1;
+    }
+    ++p->allocs;
+    for (id = 0; id < p->count; ++id) {
+	h = entry(p, id)->hash;
+	for (i = (size_t)h & mask; slot[i].id1 != 0; i = (i + 1) & mask) {
+	}
+	slot[i].id1 = id + 1;
+	slot[i].tag = (uint32_t)(h >> 32);
+    }
+    free(p->slot);
+    p->slot = slot;
+    p->mask = mask;
+    return 0;
+}
+
+
+/*
+ * copy_str - copy a string into the arena
+ *
+ * returns:
+ *	the copy, NUL terminated, or NULL ==> out of memory
+ */
+static char *
+copy_str(struct fnv_intern *p, const void *str, size_t len)
+{
+    struct intern_chunk *c;	/* new chunk */
+    size_t size;		/* octets in new chunk */
+    char *s;			/* the copy */
+
+    if ((size_t)(p->end - p->next) < len + 1) {
+	size = sizeof(*c) + len + 1;
+	size = (size < INTERN_CHUNK) ? INTERN_CHUNK : size;
+	c = malloc(size);
+	if (c == NULL) {
+	    return NULL;
+	}
+	++p->allocs;
+	p->arena += size;
+	if (p->chunk != NULL && len + 1 > INTERN_CHUNK / 4) {
+	    /* a long string gets a chunk of its own, keeping the current */
+	    c->next = p->chunk->next;
+	    p->chunk->next = c;
+	    s = (char *)(c + 1);
+	    memcpy(s, str, len);
+	    s[len] = '\0';
+	    p->bytes += len + 1;
+	    return s;
+	}
+	c->next = p->chunk;
+	p->chunk = c;
+	p->next = (char *)(c + 1);
+	p->end = (char *)c + size;
+    }
+    s = p->next;
+    memcpy(s, str, len);
+    s[len] = '\0';
+    p->next += len + 1;
+    p->bytes += len + 1;
+    return s;
+}
+
+
+/*
+ * intern_locked - intern a hashed string with the lock held
+ *
+ * returns:
+ *	id, or FNV_INTERN_NONE ==> out of memory or out of ids
+ */
+static uint32_t
+intern_locked(struct fnv_intern *p, unsigned long long h, const void *str,
+	      size_t len)
+{
+    struct intern_entry *e;	/* entry of an id */
+    size_t i;			/* slot */
+    uint32_t tag = (uint32_t)(h >> 32);	/* upper hash bits */
+    uint32_t id;		/* new id */
+    unsigned long long v;	/* id + INTERN_PAGE0 */
+
+    /* keep the table at most 3/4 full, and never full */
+    if (((size_t)p->count + 1) * 4 > p->mask * 3 && grow(p) < 0 &&
+	(size_t)p->count + 2 > p->mask) {
+	return FNV_INTERN_NONE;
+    }
+    for (i = (size_t)h & p->mask; p->slot[i].id1 != 0; i = (i + 1) & p->mask) {
+	if (p->slot[i].tag == tag) {
+	    e = entry(p, p->slot[i].id1 - 1);
+	    if (e->len == len && memcmp(e->str, str, len) == 0) {
+		return p->slot[i].id1 - 1;
+	    }
+	}
+    }
+
+    /* a new string */
+    id = p->count;
+    if (id == FNV_INTERN_NONE - INTERN_PAGE0) {
+	return FNV_INTERN_NONE;
+    }
+    v = (unsigned long long)id + INTERN_PAGE0;
+    if ((v & (v - 1)) == 0) {
+	/* the first id of a new page */
+	e = malloc((size_t)v * sizeof(e[0]));
+	if (e == NULL) {
+	    return FNV_INTERN_NONE;
+	}
+	++p->allocs;
+	p->index += v * sizeof(e[0]);
+	p->page[top_bit(v) - 10] = e;
+    }
+    e = entry(p, id);
+    e->str = copy_str(p, str, len);
+    if (e->str == NULL) {
+	return FNV_INTERN_NONE;
+    }
+    e->len = len;
+    e->hash = h;
+    p->slot[i].id1 = id + 1;
+    p->slot[i].tag = tag;
+    ++p->count;
+    return id;
+}
+
+
+/*
+ * fnv_intern - intern a string
+ *
+ * input:
+ *	p	- pool
+ *	str	- string, need not be NUL terminated
+ *	len	- length of str
+ *
+ * returns:
+ *	id of the string, or FNV_INTERN_NONE ==> error (errno ENOMEM)
+ *
+ * Interning a string again returns the same id.
+ */
+uint32_t
+fnv_intern(struct fnv_intern *p, const void *str, size_t len)
+{
+    unsigned long long h = fnv_64a_mix(str, len, 0);	/* hash of str */
+    uint32_t id;		/* id of str */
+
+    pthread_mutex_lock(&p->lock);
+    id = intern_locked(p, h, str, len);
+    pthread_mutex_unlock(&p->lock);
+    if (id == FNV_INTERN_NONE) {
+	errno = ENOMEM;
+    }
+    return id;
+}
+
+
+/*
+ * fnv_intern_batch - intern many strings
+ *
+ * input:
+ *	p	- pool
+ *	n	- number of strings
+ *	str	- the strings
+ *	len	- length of each string
+ *	id	- where to store the id of each string
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error (errno ENOMEM), some ids FNV_INTERN_NONE
+ *
+ * The strings are hashed INTERN_BATCH at a time, and their first slots
+ * prefetched, before the lock is taken to probe for any of them.
+ */
+int
+fnv_intern_batch(struct fnv_intern *p, size_t n, const void * const *str,
+		 const size_t *len, uint32_t *id)
+{
+    unsigned long long h[INTERN_BATCH];	/* hashes of a batch */
+    size_t b;			/* first string of batch */
+    size_t m;			/* strings in batch */
+    size_t i;
+    int ret = 0;		/* return value */
+
+    for (b = 0; b < n; b += m) {
+	m = (n - b < INTERN_BATCH) ? n - b : INTERN_BATCH;
+	for (i = 0; i < m; ++i) {
+	    h[i] = fnv_64a_mix(str[b+i], len[b+i], 0);
+	}
+	pthread_mutex_lock(&p->lock);
+	for (i = 0; i < m; ++i) {
+	    FNV_PREFETCH(&p->slot[(size_t)h[i] & p->mask]);
+	}
+	for (i = 0; i < m; ++i) {
+	    id[b+i] = intern_locked(p, h[i], str[b+i], len[b+i]);
+	    if (id[b+i] == FNV_INTERN_NONE) {
+		ret = -1;
+	    }
+	}
+	pthread_mutex_unlock(&p->lock);
+    }
+    if (ret < 0) {
+	errno = ENOMEM;
+    }
+    return ret;
+}
+
+
+/*
+ * fnv_intern_find - find the id of a string without interning it
+ *
+ * returns:
+ *	id of the string, or FNV_INTERN_NONE ==> not in the pool
+ */
+uint32_t
+fnv_intern_find(struct fnv_intern *p, const void *str, size_t len)
+{
+    unsigned long long h = fnv_64a_mix(str, len, 0);	/* hash of str */
+    uint32_t tag = (uint32_t)(h >> 32);	/* upper hash bits */
+    struct intern_entry *e;	/* entry of an id */
+    uint32_t id = FNV_INTERN_NONE;	/* id of str */
+    size_t i;			/* slot */
+
+    pthread_mutex_lock(&p->lock);
+    for (i = (size_t)h & p->mask; p->slot[i].id1 != 0; i = (i + 1) & p->mask) {
+	if (p->slot[i].tag == tag) {
+	    e = entry(p, p->slot[i].id1 - 1);
+	    if (e->len == len && memcmp(e->str, str, len) == 0) {
+		id = p->slot[i].id1 - 1;
+		break;
+	    }
+	}
+    }
+    pthread_mutex_unlock(&p->lock);
+    return id;
+}
+
+
+/*
+ * fnv_intern_str - the string of an id
+ *
+ * input:
+ *	p	- pool
+ *	id	- id returned by this pool
+ *	len	- where to store the string length, or NULL
+ *
+ * returns:
+ *	the string, NUL terminated, valid until the pool is freed
+ *
+ * No lock is taken: any thread may look up an id that it, or a thread
+ * that passed it the id, obtained from the pool.
+ */
+const char *
+fnv_intern_str(struct fnv_intern *p, uint32_t id, size_t *len)
+{
+    struct intern_entry *e = entry(p, id);	/* entry of id */
+
+    if (len != NULL) {
+	*len = e->len;
+    }
+    return e->str;
+}
+
+
+/*
+ * fnv_intern_stats - number of strings and memory use of a pool
+ */
+void
+fnv_intern_stats(struct fnv_intern *p, struct fnv_intern_stat *st)
+{
+    pthread_mutex_lock(&p->lock);
+    st->count = p->count;
+    st->bytes = p->bytes;
+    st->arena = p->arena;
+    st->table = (unsigned long long)(p->mask + 1) * sizeof(p->slot[0]) +
+		p->index;
+    st->allocs = p->allocs;
+    pthread_mutex_unlock(&p->lock);
+}
+
+
+/*
+ * fnv_intern_local_new - create a front cache for one thread
+ *
+ * input:
+ *	p	- pool
+ *	size	- cached strings, rounded up to a power of 2, 0 ==> 4096
+ *
+ * returns:
+ *	new cache, free with fnv_intern_local_free() before the pool,
+ *	or NULL ==> error, errno set
+ *
+ * A cache must only be used by one thread at a time.
+ */
+struct fnv_intern_local *
+fnv_intern_local_new(struct fnv_intern *p, size_t size)
+{
+    struct fnv_intern_local *l;	/* new cache */
+    size_t n = 16;		/* entries */
+
+    if (size == 0) {
+	size = 4096;
+    }
+    while (n < size && n < ((size_t)1 << 24)) {
+	n *= 2;
+    }
+    l = calloc(1, sizeof(*l));
+    if (l == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    l->pool = p;
+    l->mask = n - 1;
+    l->ent = calloc(n, sizeof(l->ent[0]));
+    l->id = calloc(n, sizeof(l->id[0]));
+    if (l->ent == NULL || l->id == NULL) {
+	fnv_intern_local_free(l);
+	errno = ENOMEM;
+	return NULL;
+    }
+    return l;
+}
+
+
+/*
+ * fnv_intern_local_free - free a front cache
+ */
+void
+fnv_intern_local_free(struct fnv_intern_local *l)
+{
+    if (l != NULL) {
+	free(l->ent);
+	free(l->id);
+	free(l);
+    }
+}
+
+
+/*
+ * fnv_intern_local - intern a string through a front cache
+ *
+ * input:
+ *	l	- cache of the calling thread
+ *	str	- string, need not be NUL terminated
+ *	len	- length of str
+ *
+ * returns:
+ *	id of the string, or FNV_INTERN_NONE ==> error (errno ENOMEM)
+ *
+ * A string found in the cache costs a hash and a compare, and no lock.
+ * Others are interned in the pool and replace a cache entry.
+ */
+uint32_t
+fnv_intern_local(struct fnv_intern_local *l, const void *str, size_t len)
+{
+    unsigned long long h = fnv_64a_mix(str, len, 0);	/* hash of str */
+    struct intern_entry *e = &l->ent[(size_t)h & l->mask];	/* cached */
+    struct fnv_intern *p = l->pool;	/* pool */
+    uint32_t id;		/* id of str */
+
+    if (e->str != NULL && e->hash == h && e->len == len &&
+	memcmp(e->str, str, len) == 0) {
+	return l->id[(size_t)h & l->mask];
+    }
+    pthread_mutex_lock(&p->lock);
+    id = intern_locked(p, h, str, len);
+    pthread_mutex_unlock(&p->lock);
+    if (id == FNV_INTERN_NONE) {
+	errno = ENOMEM;
+	return id;
+    }
+    *e = *entry(p, id);
+    l->id[(size_t)h & l->mask] = id;
+    return id;
+}
@@ -0,0 +1,517 @@
+/*
+ * fnv_intern_bench - time fnv_intern against strdup
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * usage
+ */
+static const char * const usage =
+"usage: %s [-h] [-c] [-n strings] [-d distinct] [-t threads]\n"
+"\n"
+"    -h           print help and exit\n"
+"    -c           check fnv_intern from many threads at once, do not time\n"
+"    -n strings   number of strings in the stream (default 2000000)\n"
+"    -d distinct  number of distinct strings (default 10000)\n"
+"    -t threads   threads for fnv_intern_local (default: number of CPUs,\n"
+"                 max 64)\n"
+"\n"
+"Makes a stream of log field strings, each a separate copy as a parser\n"
+"would find them, and times copying each with strdup() against\n"
+"interning them with fnv_intern(), fnv_intern_batch() and per-thread\n"
+"fnv_intern_local() caches, printing the memory allocations made and\n"
+"the memory used by each.\n"
+"\n"
+"Exit codes:\n"
+"    0           all OK\n"
+"    2           -h and help string printed\n"
+"    3           command line error\n"
+"    5           -c found a difference\n"
+" >= 20          internal error\n";
+static const char *prog = NULL;	/* our name */
+
+#define MAX_THREADS 64		/* most threads */
+
+/*
+ * what the threads share
+ */
+struct shared {
+    struct fnv_intern *pool;	/* pool */
+    const void **str;		/* the stream */
+    size_t *len;		/* length of each string */
+    size_t nstr;		/* strings in the stream */
+    size_t ndistinct;		/* distinct strings */
+    uint32_t **ids;		/* -c: ids found by each thread */
+    int nthread;		/* number of threads */
+    int bad;			/* -c: 1 ==> a thread found a difference */
+};
+struct worker {
+    struct shared *sh;		/* what the threads share */
+    int id;			/* thread number */
+    pthread_t tid;		/* thread */
+};
+
+
+/*
+ * next_rand - xorshift64* step
+ */
+static unsigned long long
+next_rand(unsigned long long *s)
+{
+    *s ^= *s >> 12;
+    *s ^= *s << 25;
+    *s ^= *s >> 27;
+    return *s * 2685821657736338717ULL;
+}
+
+
+/*
+ * now_sec - monotonic time in seconds
+ */
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+ * make_stream - write the strings of the stream one after another
+ *
+ * Half the strings are drawn from all the distinct strings and half
+ * from the first 1%, so that a few are very common, as field names
+ * and status values are.
+ */
+static void
+make_stream(struct shared *sh)
+{
+    static const char * const fmt[] = {
+	"user-%zu", "/api/v1/items/%zu/detail", "host%zu.example.com",
+	"session=%zx", "GET", "content-type", "x-request-id-%zu"
+    };
+    unsigned long long s = 0x9e3779b97f4a7c15ULL;	/* rand state */
+    unsigned long long r;	/* random value */
+    char *buf;			/* the stream */
+    size_t off = 0;		/* octets in buf */
+    size_t v;			/* distinct string */
+    size_t i;
+
+    buf = malloc(sh->nstr * 48);
+    sh->str = malloc(sh->nstr * sizeof(sh->str[0]));
+    sh->len = malloc(sh->nstr * sizeof(sh->len[0]));
+    if (buf == NULL || sh->str == NULL || sh->len == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    for (i = 0; i < sh->nstr; ++i) {
+	r = next_rand(&s);
+	v = (size_t)(r >> 8) % ((r & 1) ? sh->ndistinct :
+				sh->ndistinct / 100 + 1);
+	sh->str[i] = buf + off;
+	sh->len[i] = (size_t)snprintf(buf + off, 48, fmt[v % 7], v);
+	off += sh->len[i] + 1;
+    }
+}
+
+
+/*
+ * print_line - print one line of timings
+ */
+static void
+print_line(const char *name, int nthread, double sec, size_t nstr,
+	   unsigned long long allocs, unsigned long long bytes)
+{
+    printf("%-18s %3d threads %8.3f s %8.2f Mstr/s %10llu allocs "
+	   "%9.2f MB\n", name, nthread, sec, (double)nstr / sec / 1e6,
+	   allocs, (double)bytes / (1024.0 * 1024.0));
+}
+
+
+/*
+ * local_thread - intern a slice of the stream through a front cache
+ */
+static void *
+local_thread(void *arg)
+{
+    struct worker *w = arg;	/* this thread */
+    struct shared *sh = w->sh;	/* what the threads share */
+    struct fnv_intern_local *l;	/* our front cache */
+    size_t lo = sh->nstr * (size_t)w->id / (size_t)sh->nthread;
+    size_t hi = sh->nstr * (size_t)(w->id + 1) / (size_t)sh->nthread;
+    size_t i;
+
+    l = fnv_intern_local_new(sh->pool, 0);
+    if (l == NULL) {
+	__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	return NULL;
+    }
+    for (i = lo; i < hi; ++i) {
+	if (fnv_intern_local(l, sh->str[i], sh->len[i]) == FNV_INTERN_NONE) {
+	    __atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	}
+    }
+    fnv_intern_local_free(l);
+    return NULL;
+}
+
+
+/*
+ * check_thread - intern the whole stream, mixing batch and cached calls
+ *
+ * A tiny front cache makes strings leave the cache and come back while
+ * other threads add to the pool.
+ */
+static void *
+check_thread(void *arg)
+{
+    struct worker *w = arg;	/* this thread */
+    struct shared *sh = w->sh;	/* what the threads share */
+    struct fnv_intern_local *l;	/* our front cache */
+    uint32_t *id = sh->ids[w->id];	/* ids we find */
+    size_t b;			/* first string of a chunk */
+    size_t m;			/* strings in chunk */
+    size_t i;
+
+    l = fnv_intern_local_new(sh->pool, 16);
+    if (l == NULL) {
+	__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	return NULL;
+    }
+    for (b = 0; b < sh->nstr; b += m) {
+	m = (sh->nstr - b < 100) ? sh->nstr - b : 100;
+	if (((b / 100) + (size_t)w->id) % 2 == 0) {
+	    if (fnv_intern_batch(sh->pool, m, sh->str + b, sh->len + b,
+				 id + b) < 0) {
+		__atomic_store_n(&sh->bad, 1, __ATOMIC_RELAXED);
+	    }
+	} else {
+	    for (i = b; i < b + m; ++i) {
+		id[i] = fnv_intern_local(l, sh->str[i], sh->len[i]);
+	    }
+	}
+    }
+    fnv_intern_local_free(l);
+    return NULL;
+}
+
+
+/*
+ * run - run nthread threads and wait for them
+ *
+ * returns:
+ *	elapsed seconds
+ */
+static double
+run(struct shared *sh, int nthread, void *(*fn)(void *))
+{
+    struct worker w[MAX_THREADS];	/* threads */
+    double start;		/* starting time */
+    int i;
+
+    sh->nthread = nthread;
+    start = now_sec();
+    for (i = 0; i < nthread; ++i) {
+	w[i].sh = sh;
+	w[i].id = i;
+	if (pthread_create(&w[i].tid, NULL, fn, &w[i]) != 0) {
+	    fprintf(stderr, "%s: cannot create thread\n", prog);
+	    exit(20);
+	}
+    }
+    for (i = 0; i < nthread; ++i) {
+	pthread_join(w[i].tid, NULL);
+    }
+    return now_sec() - start;
+}
+
+
+/*
+ * check - intern the stream from many threads and check the ids
+ *
+ * returns:
+ *	0 ==> passed, 1 ==> failed
+ */
+static int
+check(struct shared *sh, int nthread)
+{
+    struct fnv_intern_stat st;	/* pool statistics */
+    const char *s;		/* string of an id */
+    size_t len;			/* length of s */
+    size_t i;
+    int t;
+
+    sh->pool = fnv_intern_new(0);
+    sh->ids = calloc((size_t)nthread, sizeof(sh->ids[0]));
+    if (sh->pool == NULL || sh->ids == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(21);
+    }
+    for (t = 0; t < nthread; ++t) {
+	sh->ids[t] = malloc(sh->nstr * sizeof(sh->ids[t][0]));
+	if (sh->ids[t] == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(21);
+	}
+    }
+    run(sh, nthread, check_thread);
+    if (sh->bad) {
+	return 1;
+    }
+
+    /* every thread must find the same id for each string */
+    for (i = 0; i < sh->nstr; ++i) {
+	for (t = 1; t < nthread; ++t) {
+	    if (sh->ids[t][i] != sh->ids[0][i]) {
+		return 1;
+	    }
+	}
+	s = fnv_intern_str(sh->pool, sh->ids[0][i], &len);
+	if (len != sh->len[i] || memcmp(s, sh->str[i], len) != 0 ||
+	    s[len] != '\0' ||
+	    fnv_intern_find(sh->pool, sh->str[i], len) != sh->ids[0][i]) {
+	    return 1;
+	}
+    }
+    fnv_intern_stats(sh->pool, &st);
+    if (st.count == 0 || st.count > sh->ndistinct ||
+	fnv_intern_find(sh->pool, "not-in-pool", 11) != FNV_INTERN_NONE ||
+	fnv_intern(sh->pool, "", 0) != st.count) {
+	return 1;
+    }
+    for (t = 0; t < nthread; ++t) {
+	free(sh->ids[t]);
+    }
+    free(sh->ids);
+    fnv_intern_free(sh->pool);
+    return 0;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    struct shared sh;		/* what the threads share */
+    struct fnv_intern_stat st;	/* pool statistics */
+    uint32_t *id;		/* fnv_intern_batch() ids */
+    char **copy;		/* strdup() copies */
+    unsigned long long bytes = 0;	/* strdup() octets */
+    double start;		/* starting time */
+    double sec;			/* elapsed seconds */
+    long ncpu;			/* number of CPUs */
+    int maxthread;		/* -t threads */
+    int c_flag = 0;		/* 1 ==> -c check mode */
+    int c;
+    size_t i;
+
+    prog = strrchr(argv[0], '/');
+    prog = (prog == NULL) ? argv[0] : prog + 1;
+    memset(&sh, 0, sizeof(sh));
+    sh.nstr = 2000000;
+    sh.ndistinct = 10000;
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    maxthread = (ncpu < 1) ? 1 : (ncpu > MAX_THREADS) ? MAX_THREADS :
+		(int)ncpu;
+    while ((c = getopt(argc, argv, "hcn:d:t:")) != -1) {
+	switch (c) {
+	case 'h':
+	    fprintf(stderr, usage, prog);
+	    exit(2);
+	case 'c':
+	    c_flag = 1;
+	    break;
+	case 'n':
+	    sh.nstr = (size_t)strtoull(optarg, NULL, 0);
+	    break;
+	case 'd':
+	    sh.ndistinct = (size_t)strtoull(optarg, NULL, 0);
+	    break;
+	case 't':
+	    maxthread = atoi(optarg);
+	    break;
+	default:
+	    fprintf(stderr, usage, prog);
+	    exit(3);
+	}
+    }
+    if (optind != argc || sh.nstr == 0 || sh.ndistinct == 0 ||
+	maxthread < 1 || maxthread > MAX_THREADS) {
+	fprintf(stderr, usage, prog);
+	exit(3);
+    }
+    make_stream(&sh);
+
+    if (c_flag) {
+	/* at least 4 threads, so that they contend even on 1 CPU */
+	if (check(&sh, (maxthread < 4) ? 4 : maxthread) != 0) {
+	    printf("failed\n");
+	    exit(5);
+	}
+	printf("passed\n");
+	exit(0);
+    }
+
+    /* a copy of every string */
+    copy = malloc(sh.nstr * sizeof(copy[0]));
+    if (copy == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    start = now_sec();
+    for (i = 0; i < sh.nstr; ++i) {
+	copy[i] = malloc(sh.len[i] + 1);
+	if (copy[i] == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+	memcpy(copy[i], sh.str[i], sh.len[i] + 1);
+	bytes += sh.len[i] + 1;
+    }
+    sec = now_sec() - start;
+    print_line("strdup", 1, sec, sh.nstr, sh.nstr, bytes);
+    for (i = 0; i < sh.nstr; ++i) {
+	free(copy[i]);
+    }
+    free(copy);
+
+    /* one string at a time */
+    sh.pool = fnv_intern_new(0);
+    if (sh.pool == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    start = now_sec();
+    for (i = 0; i < sh.nstr; ++i) {
+	if (fnv_intern(sh.pool, sh.str[i], sh.len[i]) == FNV_INTERN_NONE) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+    }
+    sec = now_sec() - start;
+    fnv_intern_stats(sh.pool, &st);
+    print_line("fnv_intern", 1, sec, sh.nstr, st.allocs,
+	       st.arena + st.table);
+    fnv_intern_free(sh.pool);
+
+    /* all strings in one call */
+    sh.pool = fnv_intern_new(0);
+    id = malloc(sh.nstr * sizeof(id[0]));
+    if (sh.pool == NULL || id == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    start = now_sec();
+    if (fnv_intern_batch(sh.pool, sh.nstr, sh.str, sh.len, id) < 0) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    sec = now_sec() - start;
+    fnv_intern_stats(sh.pool, &st);
+    print_line("fnv_intern_batch", 1, sec, sh.nstr, st.allocs,
+	       st.arena + st.table);
+    fnv_intern_free(sh.pool);
+    free(id);
+
+    /* per-thread front caches */
+    for (c = 1; c <= maxthread; c *= 2) {
+	sh.pool = fnv_intern_new(0);
+	if (sh.pool == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+	sec = run(&sh, c, local_thread);
+	if (sh.bad) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+	fnv_intern_stats(sh.pool, &st);
+	print_line("fnv_intern_local", c, sec, sh.nstr, st.allocs,
+		   st.arena + st.table);
+	fnv_intern_free(sh.pool);
+    }
+    exit(0);
+}
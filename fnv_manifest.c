@@ -0,0 +1,881 @@
+/*
+ * fnv_manifest - memory mapped table of file hashes
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sched.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "fnv.h"
+
+
+/*
+ * A manifest is a file of fixed size slots that is mapped into memory
+ * by a single writer and any number of readers.  It maps a path, relative
+ * to the watched directory, to the FNV hash, size and modification time
+ * of the file.
+ *
+ * The file is a header followed by nslot slots, nslot a power of 2, and
+ * then a string area that holds the NUL terminated paths.  A slot holds
+ * the offset and length of its path in the string area, so paths of any
+ * length fit.  A path is found by linear probing from the slot given by
+ * the low bits of its FNV-1a 32 bit hash.  Removed paths leave a tombstone
+ * so that the probe sequences of other paths are not broken.
+ *
+ * The string area is only appended to: a path is written beyond strused
+ * before the slot that refers to it is changed, and the octets of a path
+ * never change while the slot that refers to them can be read.
+ *
+ * Each slot is protected by a sequence lock: the writer makes the
+ * sequence number odd, changes the slot, then makes it even again.  A
+ * reader copies the slot and retries if the sequence number was odd or
+ * changed meanwhile, so a reader never waits on, nor blocks, the writer.
+ *
+ * When the slots or the string area fill up, the writer builds a larger manifest in a
+ * temporary file, renames it over the old one and then sets the moved
+ * flag in the old header.  A reader that sees the moved flag opens the
+ * manifest again.
+ *
+ * All fields are in the native byte order of the host: a manifest is
+ * only meant to be shared between processes on the same host.
+ */
+#define FNV_MANIFEST_MAGIC "FNVman\0\2"	/* manifest file magic */
+#define MANIFEST_MIN_SLOTS 1024		/* smallest number of slots */
+#define MANIFEST_PATH_AVG 64		/* string area octets per slot */
+
+#define SLOT_EMPTY 0			/* slot was never used */
+#define SLOT_USED 1			/* slot holds a path */
+#define SLOT_REMOVED 2			/* tombstone of a removed path */
+
+struct manifest_hdr {
+    char magic[8];		/* FNV_MANIFEST_MAGIC */
+    Fnv32_t type;		/* enum fnv_type */
+    Fnv32_t nslot;		/* number of slots, a power of 2 */
+    Fnv32_t nused;		/* slots holding a path */
+    Fnv32_t nremoved;		/* tombstones */
+    Fnv32_t moved;		/* 1 ==> replaced by a larger manifest */
+    Fnv32_t pad1;		/* align strsize */
+    long long strsize;		/* octets in the string area */
+    long long strused;		/* octets of the string area in use */
+    char pad[16];		/* header is 64 octets */
+};
+
+struct manifest_slot {
+    Fnv32_t seq;		/* sequence lock, odd ==> being changed */
+    Fnv32_t state;		/* SLOT_EMPTY, SLOT_USED or SLOT_REMOVED */
+    Fnv32_t hval[2];		/* hash, low 32 bits first */
+    long long size;		/* file size */
+    long long mtime_ns;		/* file modification time in nanoseconds */
+    Fnv32_t key;		/* FNV-1a 32 bit hash of path */
+    Fnv32_t len;		/* length of path, without the NUL */
+    long long off;		/* offset of path in the string area */
+};
+
+struct fnv_manifest {
+    char *path;			/* manifest file name */
+    int writable;		/* 1 ==> opened by fnv_manifest_create() */
+    struct manifest_hdr *hdr;	/* mapped header */
+    struct manifest_slot *slot;	/* mapped slots */
+    char *str;			/* mapped string area */
+    size_t strsize;		/* octets in the string area */
+    size_t maplen;		/* octets mapped */
+    dev_t dev;			/* st_dev of the manifest file */
+    ino_t ino;			/* st_ino of the manifest file */
+};
+
+
+/*
+ * map_manifest - create or map a manifest file
+ *
+ * given:
+ *	m	manifest to fill in
+ *	path	file to map
+ *	type	FNV hash type of a new manifest
+ *	nslot	slots in a new manifest, 0 ==> map an existing manifest
+ *	strsize	string area octets in a new manifest
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ */
+static int
+map_manifest(struct fnv_manifest *m, char *path, enum fnv_type type,
+	     Fnv32_t nslot, size_t strsize)
+{
+    struct stat st;		/* manifest status */
+    void *map;			/* mapped file */
+    int fd;			/* open manifest */
+    int err;			/* saved errno */
+
+    fd = open(path, nslot > 0 ? O_RDWR|O_CREAT|O_TRUNC : O_RDONLY, 0644);
+    if (fd < 0) {
+	return -1;
+    }
+    if (nslot > 0) {
+	m->maplen = sizeof(struct manifest_hdr) +
+		    (size_t)nslot * sizeof(struct manifest_slot) + strsize;
+	if (ftruncate(fd, (off_t)m->maplen) < 0) {
+	    goto error;
+	}
+    }
+    if (fstat(fd, &st) < 0) {
+	goto error;
+    }
+    if (nslot == 0) {
+	m->maplen = (size_t)st.st_size;
+	if (m->maplen < sizeof(struct manifest_hdr)) {
+	    errno = EINVAL;
+	    goto error;
+	}
+    }
+    map = mmap(NULL, m->maplen, nslot > 0 ? PROT_READ|PROT_WRITE : PROT_READ,
+	       MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+	goto error;
+    }
+    close(fd);
+    m->hdr = (struct manifest_hdr *)map;
+    m->slot = (struct manifest_slot *)(m->hdr + 1);
+    m->dev = st.st_dev;
+    m->ino = st.st_ino;
+    if (nslot > 0) {
+	/* a new file is all zero, so every slot is already SLOT_EMPTY */
+	memcpy(m->hdr->magic, FNV_MANIFEST_MAGIC, sizeof(m->hdr->magic));
+	m->hdr->type = (Fnv32_t)type;
+	m->hdr->nslot = nslot;
+	m->hdr->strsize = (long long)strsize;
+    } else if (memcmp(m->hdr->magic, FNV_MANIFEST_MAGIC,
+		      sizeof(m->hdr->magic)) != 0 ||
+	       m->hdr->nslot == 0 ||
+	       (m->hdr->nslot & (m->hdr->nslot - 1)) != 0 ||
+	       m->hdr->strsize < 0 ||
+	       m->maplen != sizeof(struct manifest_hdr) +
+			    (size_t)m->hdr->nslot *
+			    sizeof(struct manifest_slot) +
+			    (size_t)m->hdr->strsize) {
+	munmap(map, m->maplen);
+	m->hdr = NULL;
+	errno = EINVAL;
+	return -1;
+    }
+    m->str = (char *)(m->slot + m->hdr->nslot);
+    m->strsize = (size_t)m->hdr->strsize;
+    return 0;
+
+error:
+    err = errno;
+    close(fd);
+    errno = err;
+    return -1;
+}
+
+
+/*
+ * tmp_path - return the malloc-ed temporary file name of a manifest
+ */
+static char *
+tmp_path(char *path)
+{
+    char *tmp;			/* temporary file name */
+
+    tmp = malloc(strlen(path) + sizeof(".tmp"));
+    if (tmp == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    sprintf(tmp, "%s.tmp", path);
+    return tmp;
+}
+
+
+/*
+ * create_manifest - create an empty manifest of a given size
+ *
+ * given:
+ *	path	manifest file to create or replace
+ *	type	FNV hash type
+ *	nslot	number of slots, a power of 2
+ *	strsize	octets in the string area
+ *
+ * returns:
+ *	open manifest, or NULL ==> error, errno set
+ *
+ * The manifest is created as path.tmp and is not yet visible to readers:
+ * the caller fills it in and then calls install_manifest().
+ */
+static struct fnv_manifest *
+create_manifest(char *path, enum fnv_type type, Fnv32_t nslot,
+		size_t strsize)
+{
+    struct fnv_manifest *m;	/* new manifest */
+    char *tmp;			/* temporary file name */
+    int err;			/* saved errno */
+
+    m = calloc(1, sizeof(*m));
+    if (m == NULL || (m->path = strdup(path)) == NULL) {
+	free(m);
+	errno = ENOMEM;
+	return NULL;
+    }
+    tmp = tmp_path(path);
+    if (tmp == NULL) {
+	fnv_manifest_close(m);
+	return NULL;
+    }
+    if (map_manifest(m, tmp, type, nslot, strsize) < 0) {
+	err = errno;
+	unlink(tmp);
+	free(tmp);
+	fnv_manifest_close(m);
+	errno = err;
+	return NULL;
+    }
+    free(tmp);
+    m->writable = 1;
+    return m;
+}
+
+
+/*
+ * install_manifest - rename a manifest from create_manifest() into place
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set and path.tmp removed
+ */
+static int
+install_manifest(struct fnv_manifest *m)
+{
+    char *tmp;			/* temporary file name */
+    int err;			/* saved errno */
+
+    tmp = tmp_path(m->path);
+    if (tmp == NULL) {
+	return -1;
+    }
+    if (rename(tmp, m->path) < 0) {
+	err = errno;
+	unlink(tmp);
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    free(tmp);
+    return 0;
+}
+
+
+/*
+ * slots_for - number of slots for a given number of paths
+ */
+static Fnv32_t
+slots_for(size_t nfile)
+{
+    Fnv32_t nslot = MANIFEST_MIN_SLOTS;	/* number of slots */
+
+    /* keep the table at most half full */
+    while (nslot < 0x40000000 && (size_t)nslot < nfile * 2) {
+	nslot *= 2;
+    }
+    return nslot;
+}
+
+
+/*
+ * fnv_manifest_create - create an empty manifest for a writer
+ *
+ * input:
+ *	path	- manifest file to create or replace
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	nfile	- expected number of files, or 0
+ *
+ * returns:
+ *	open manifest, or NULL ==> error, errno set
+ *
+ * The manifest is built in path.tmp and renamed to path, so a reader
+ * never sees a partly initialized header.  There must be only one
+ * writer of a manifest, and its fnv_manifest_update() and
+ * fnv_manifest_remove() calls must not overlap.
+ */
+struct fnv_manifest *
+fnv_manifest_create(char *path, enum fnv_type type, size_t nfile)
+{
+    struct fnv_manifest *m;	/* new manifest */
+    Fnv32_t nslot;		/* number of slots */
+    int err;			/* saved errno */
+
+    if (type < FNV0_64 || type > FNV1a_64) {
+	errno = EINVAL;
+	return NULL;
+    }
+    nslot = slots_for(nfile);
+    m = create_manifest(path, type, nslot,
+			(size_t)nslot * MANIFEST_PATH_AVG);
+    if (m != NULL && install_manifest(m) < 0) {
+	err = errno;
+	fnv_manifest_close(m);
+	errno = err;
+	return NULL;
+    }
+    return m;
+}
+
+
+/*
+ * fnv_manifest_open - open a manifest for a reader
+ *
+ * input:
+ *	path	- manifest file created by fnv_manifest_create()
+ *
+ * returns:
+ *	open manifest, or NULL ==> error, errno set
+ *	(EINVAL ==> not a manifest)
+ */
+struct fnv_manifest *
+fnv_manifest_open(char *path)
+{
+    struct fnv_manifest *m;	/* opened manifest */
+    int err;			/* saved errno */
+
+    m = calloc(1, sizeof(*m));
+    if (m == NULL || (m->path = strdup(path)) == NULL) {
+	free(m);
+	errno = ENOMEM;
+	return NULL;
+    }
+    if (map_manifest(m, path, FNV_NONE, 0, 0) < 0) {
+	err = errno;
+	fnv_manifest_close(m);
+	errno = err;
+	return NULL;
+    }
+    return m;
+}
+
+
+/*
+ * fnv_manifest_close - unmap and free a manifest
+ */
+void
+fnv_manifest_close(struct fnv_manifest *m)
+{
+    if (m == NULL) {
+	return;
+    }
+    if (m->hdr != NULL) {
+	if (m->writable) {
+	    msync(m->hdr, m->maplen, MS_ASYNC);
+	}
+	munmap(m->hdr, m->maplen);
+    }
+    free(m->path);
+    free(m);
+}
+
+
+/*
+ * fnv_manifest_hash_type - return the FNV hash type of a manifest
+ */
+enum fnv_type
+fnv_manifest_hash_type(struct fnv_manifest *m)
+{
+    return (enum fnv_type)m->hdr->type;
+}
+
+
+/*
+ * fnv_manifest_same_file - determine if a stat(2) is of the manifest file
+ *
+ * returns:
+ *	1 ==> st is the manifest file itself, 0 ==> it is not
+ */
+int
+fnv_manifest_same_file(struct fnv_manifest *m, struct stat *st)
+{
+    return st->st_dev == m->dev && st->st_ino == m->ino;
+}
+
+
+/*
+ * slot_begin - start changing a slot
+ */
+static void
+slot_begin(struct manifest_slot *s)
+{
+    __atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+
+/*
+ * slot_end - finish changing a slot
+ */
+static void
+slot_end(struct manifest_slot *s)
+{
+    __atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELEASE);
+}
+
+
+/*
+ * find_slot - find the slot of a path, or where to put it
+ *
+ * given:
+ *	m	manifest
+ *	path	relative path
+ *	key	FNV-1a 32 bit hash of path
+ *	copy	where to copy the slot that holds path, or NULL (writer)
+ *
+ * returns:
+ *	index of the slot holding path, or (Fnv32_t)-1 ==> not found
+ *	*free_slot is set to the first empty or removed slot probed
+ */
+static Fnv32_t
+find_slot(struct fnv_manifest *m, char *path, Fnv32_t key,
+	  struct manifest_slot *copy, Fnv32_t *free_slot)
+{
+    struct manifest_slot tmp;	/* consistent copy of a slot */
+    struct manifest_slot *s;	/* slot being probed */
+    Fnv32_t mask = m->hdr->nslot - 1;	/* slot index mask */
+    Fnv32_t i;			/* slot index */
+    Fnv32_t n;			/* slots probed */
+    Fnv32_t seq;		/* sequence number before the copy */
+    size_t len = strlen(path);	/* length of path */
+
+    *free_slot = (Fnv32_t)-1;
+    for (i = key & mask, n = 0; n <= mask; i = (i + 1) & mask, ++n) {
+	s = &m->slot[i];
+	if (m->writable) {
+	    /* the only writer needs no lock */
+	    tmp.state = s->state;
+	    tmp.key = s->key;
+	    tmp.len = s->len;
+	    tmp.off = s->off;
+	} else {
+	    for (;;) {
+		seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1) {
+		    sched_yield();
+		    continue;
+		}
+		memcpy(&tmp, s, sizeof(tmp));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&s->seq, __ATOMIC_RELAXED) == seq) {
+		    break;
+		}
+	    }
+	}
+	if (tmp.state == SLOT_EMPTY) {
+	    if (*free_slot == (Fnv32_t)-1) {
+		*free_slot = i;
+	    }
+	    return (Fnv32_t)-1;
+	}
+	if (tmp.state == SLOT_REMOVED) {
+	    if (*free_slot == (Fnv32_t)-1) {
+		*free_slot = i;
+	    }
+	    continue;
+	}
+	/* a path once written to the string area does not change */
+	if (tmp.key == key && tmp.len == len && tmp.off >= 0 &&
+	    (size_t)tmp.off + len < m->strsize &&
+	    memcmp(m->str + tmp.off, path, len) == 0) {
+	    if (copy != NULL) {
+		*copy = tmp;
+	    }
+	    return i;
+	}
+    }
+    return (Fnv32_t)-1;
+}
+
+
+/*
+ * reopen - map the replacement of a moved manifest
+ */
+static int
+reopen(struct fnv_manifest *m)
+{
+    struct fnv_manifest n;	/* replacement */
+
+    memset(&n, 0, sizeof(n));
+    if (map_manifest(&n, m->path, FNV_NONE, 0, 0) < 0) {
+	return -1;
+    }
+    munmap(m->hdr, m->maplen);
+    m->hdr = n.hdr;
+    m->slot = n.slot;
+    m->str = n.str;
+    m->strsize = n.strsize;
+    m->maplen = n.maplen;
+    m->dev = n.dev;
+    m->ino = n.ino;
+    return 0;
+}
+
+
+/*
+ * fnv_manifest_lookup - find the hash of a path in a manifest
+ *
+ * input:
+ *	m	- manifest from fnv_manifest_open()
+ *	path	- path relative to the watched directory
+ *	hval	- where to store the hash
+ *	size	- where to store the file size, or NULL
+ *	mtime_ns - where to store the modification time in ns, or NULL
+ *
+ * returns:
+ *	0 ==> found, -1 ==> not found (errno ENOENT) or error (errno set)
+ *
+ * A lookup never waits on the writer, except to retry a slot that is
+ * changed while it is being read.
+ */
+int
+fnv_manifest_lookup(struct fnv_manifest *m, char *path, Fnv64_t *hval,
+		    off_t *size, long long *mtime_ns)
+{
+    struct manifest_slot s;	/* copy of the path's slot */
+    Fnv32_t key;		/* FNV-1a 32 bit hash of path */
+    Fnv32_t free_slot;		/* unused */
+
+    if (__atomic_load_n(&m->hdr->moved, __ATOMIC_ACQUIRE) &&
+	reopen(m) < 0) {
+	return -1;
+    }
+    key = fnv_32a_str(path, FNV1_32A_INIT);
+    if (find_slot(m, path, key, &s, &free_slot) == (Fnv32_t)-1) {
+	errno = ENOENT;
+	return -1;
+    }
+#if defined(HAVE_64BIT_LONG_LONG)
+    *hval = ((Fnv64_t)s.hval[1] << 32) | (Fnv64_t)s.hval[0];
+#else /* HAVE_64BIT_LONG_LONG */
+    hval->w32[0] = s.hval[0];
+    hval->w32[1] = s.hval[1];
+#endif /* HAVE_64BIT_LONG_LONG */
+    if (size != NULL) {
+	*size = (off_t)s.size;
+    }
+    if (mtime_ns != NULL) {
+	*mtime_ns = s.mtime_ns;
+    }
+    return 0;
+}
+
+
+/*
+ * add_path - append a path to the string area, there must be room
+ *
+ * returns:
+ *	offset of the path in the string area
+ */
+static long long
+add_path(struct fnv_manifest *m, char *path, size_t len)
+{
+    long long off = m->hdr->strused;	/* where path goes */
+
+    memcpy(m->str + off, path, len + 1);
+    m->hdr->strused += (long long)(len + 1);
+    return off;
+}
+
+
+/*
+ * grow - move the paths of a full manifest into a larger one
+ *
+ * given:
+ *	m	manifest
+ *	len	length of a path about to be added
+ */
+static int
+grow(struct fnv_manifest *m, size_t len)
+{
+    struct fnv_manifest *n;	/* larger manifest */
+    struct manifest_slot *s;	/* old slot */
+    Fnv32_t i;
+    Fnv32_t j;			/* new slot */
+    Fnv32_t mask;		/* new slot index mask */
+    Fnv32_t nslot;		/* new number of slots */
+    size_t need = len + 1;	/* string octets of the paths to keep */
+    size_t strsize;		/* new string area size */
+
+    for (i = 0; i < m->hdr->nslot; ++i) {
+	if (m->slot[i].state == SLOT_USED) {
+	    need += (size_t)m->slot[i].len + 1;
+	}
+    }
+    nslot = slots_for((size_t)m->hdr->nused * 2);
+    strsize = (size_t)nslot * MANIFEST_PATH_AVG;
+    if (strsize < need * 2) {
+	strsize = need * 2;
+    }
+    n = create_manifest(m->path, (enum fnv_type)m->hdr->type, nslot,
+			strsize);
+    if (n == NULL) {
+	return -1;
+    }
+    mask = n->hdr->nslot - 1;
+    for (i = 0; i < m->hdr->nslot; ++i) {
+	s = &m->slot[i];
+	if (s->state != SLOT_USED) {
+	    continue;
+	}
+	for (j = s->key & mask; n->slot[j].state != SLOT_EMPTY;
+	     j = (j + 1) & mask) {
+	}
+	memcpy(&n->slot[j], s, sizeof(*s));
+	n->slot[j].seq = 0;
+	n->slot[j].off = add_path(n, m->str + s->off, s->len);
+	++n->hdr->nused;
+    }
+    if (install_manifest(n) < 0) {
+	fnv_manifest_close(n);
+	return -1;
+    }
+
+    /* readers of the old mapping switch to the new file */
+    __atomic_store_n(&m->hdr->moved, 1, __ATOMIC_RELEASE);
+    munmap(m->hdr, m->maplen);
+    m->hdr = n->hdr;
+    m->slot = n->slot;
+    m->str = n->str;
+    m->strsize = n->strsize;
+    m->maplen = n->maplen;
+    m->dev = n->dev;
+    m->ino = n->ino;
+    n->hdr = NULL;
+    fnv_manifest_close(n);
+    return 0;
+}
+
+
+/*
+ * fnv_manifest_update - record the hash of a path in a manifest
+ *
+ * input:
+ *	m	- manifest from fnv_manifest_create()
+ *	path	- path relative to the watched directory
+ *	hval	- hash of the file
+ *	size	- file size
+ *	mtime_ns - file modification time in nanoseconds
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ */
+int
+fnv_manifest_update(struct fnv_manifest *m, char *path, Fnv64_t hval,
+		    off_t size, long long mtime_ns)
+{
+    struct manifest_slot *s;	/* slot to change */
+    Fnv32_t key;		/* FNV-1a 32 bit hash of path */
+    Fnv32_t i;			/* slot index */
+    Fnv32_t free_slot;		/* first reusable slot */
+    int is_new = 0;		/* 1 ==> path was not in the manifest */
+    size_t len;			/* length of path */
+    long long off = 0;		/* offset of a new path in the string area */
+
+    if (!m->writable) {
+	errno = EBADF;
+	return -1;
+    }
+    len = strlen(path);
+    key = fnv_32a_str(path, FNV1_32A_INIT);
+    i = find_slot(m, path, key, NULL, &free_slot);
+    if (i == (Fnv32_t)-1) {
+	/* keep at least a quarter of the slots empty */
+	if ((m->hdr->nused + m->hdr->nremoved + 1) * 4 > m->hdr->nslot * 3 ||
+	    (size_t)m->hdr->strused + len + 1 > m->strsize) {
+	    if (grow(m, len) < 0) {
+		return -1;
+	    }
+	    i = find_slot(m, path, key, NULL, &free_slot);
+	}
+	i = free_slot;
+	is_new = 1;
+	off = add_path(m, path, len);
+    }
+    s = &m->slot[i];
+    slot_begin(s);
+    if (is_new) {
+	if (s->state == SLOT_REMOVED) {
+	    --m->hdr->nremoved;
+	}
+	++m->hdr->nused;
+	s->key = key;
+	s->len = (Fnv32_t)len;
+	s->off = off;
+	s->state = SLOT_USED;
+    }
+#if defined(HAVE_64BIT_LONG_LONG)
+    s->hval[0] = (Fnv32_t)hval;
+    s->hval[1] = (Fnv32_t)(hval >> 32);
+#else /* HAVE_64BIT_LONG_LONG */
+    s->hval[0] = hval.w32[0];
+    s->hval[1] = hval.w32[1];
+#endif /* HAVE_64BIT_LONG_LONG */
+    s->size = (long long)size;
+    s->mtime_ns = mtime_ns;
+    slot_end(s);
+    return 0;
+}
+
+
+/*
+ * remove_slot - replace a used slot with a tombstone
+ */
+static void
+remove_slot(struct fnv_manifest *m, struct manifest_slot *s)
+{
+    slot_begin(s);
+    s->state = SLOT_REMOVED;
+    slot_end(s);
+    --m->hdr->nused;
+    ++m->hdr->nremoved;
+}
+
+
+/*
+ * fnv_manifest_remove - remove paths from a manifest
+ *
+ * input:
+ *	m	- manifest from fnv_manifest_create()
+ *	path	- path relative to the watched directory
+ *	subtree	- 1 ==> also remove every path below directory path
+ *
+ * returns:
+ *	number of paths removed
+ *
+ * Removing a subtree looks at every slot.
+ */
+unsigned long
+fnv_manifest_remove(struct fnv_manifest *m, char *path, int subtree)
+{
+    struct manifest_slot *s;	/* slot to remove */
+    size_t len = strlen(path);	/* length of path */
+    unsigned long cnt = 0;	/* paths removed */
+    Fnv32_t i;
+    Fnv32_t free_slot;		/* unused */
+
+    if (!m->writable) {
+	return 0;
+    }
+    i = find_slot(m, path, fnv_32a_str(path, FNV1_32A_INIT), NULL,
+		  &free_slot);
+    if (i != (Fnv32_t)-1) {
+	remove_slot(m, &m->slot[i]);
+	++cnt;
+    }
+    if (subtree) {
+	for (i = 0; i < m->hdr->nslot; ++i) {
+	    s = &m->slot[i];
+	    if (s->state == SLOT_USED && s->len > len &&
+		strncmp(m->str + s->off, path, len) == 0 &&
+		m->str[s->off + len] == '/') {
+		remove_slot(m, s);
+		++cnt;
+	    }
+	}
+    }
+    return cnt;
+}
+
+
+/*
+ * fnv_manifest_walk - call a function for each path in a manifest
+ *
+ * input:
+ *	m	- manifest from fnv_manifest_create()
+ *	fn	- function to call with each path and arg
+ *	arg	- argument to pass to fn
+ *
+ * The manifest must not be changed by fn.
+ */
+void
+fnv_manifest_walk(struct fnv_manifest *m, void (*fn)(char *path, void *arg),
+		  void *arg)
+{
+    Fnv32_t i;
+
+    for (i = 0; i < m->hdr->nslot; ++i) {
+	if (m->slot[i].state == SLOT_USED) {
+	    fn(m->str + m->slot[i].off, arg);
+	}
+    }
+}
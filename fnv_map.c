@@ -0,0 +1,640 @@
+/*
+ * fnv_map - open addressing hash table keyed by FNV-1a
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+#include "fnv.h"
+
+
+/*
+ * fnv_map is an open addressing hash table in the style of the Swiss
+ * table: the slots are divided into groups of MAP_GROUP, and a separate
+ * array of control octets holds, for each slot, either a 7 bit tag taken
+ * from the fnv_64a_mix() hash of its key, or MAP_EMPTY or MAP_DELETED.
+ *
+ * A lookup hashes the key once: the low bits select the first group to
+ * probe and the high 7 bits are the tag.  The control octets of a whole
+ * group are compared with the tag at once (with SSE2, or 8 octets at a
+ * time in a 64 bit word otherwise), so a key is compared only in the
+ * slots whose tag matches, which on average is one.  Probing stops at
+ * the first group that has an empty slot.
+ *
+ * The keys (with their lengths) and the values are kept in separate
+ * arrays, so probing touches only the control octets until a tag
+ * matches, and a lookup touches the value only once the key is found.  The
+ * first MAP_GROUP-1 control octets are repeated after the last one, so
+ * that a group may start at any slot.
+ *
+ * The map does not copy keys: a key must stay unchanged while it is in
+ * the map.
+ */
+#define MAP_GROUP 16		/* slots probed at once */
+#define MAP_MIN_SLOTS 16	/* smallest table */
+#define MAP_BATCH 16		/* keys hashed and prefetched at once */
+
+#define MAP_EMPTY ((unsigned char)0x80)	/* slot never used */
+#define MAP_DELETED ((unsigned char)0xfe)	/* slot of a deleted key */
+
+struct map_key {
+    const void *ptr;		/* key octets */
+    size_t len;			/* key length */
+};
+
+struct fnv_map {
+    unsigned char *ctrl;	/* nslot + MAP_GROUP - 1 control octets */
+    struct map_key *key;	/* key of each slot */
+    void **val;			/* value of each slot */
+    size_t nslot;		/* number of slots, a power of 2 */
+    size_t count;		/* number of keys */
+    size_t growth_left;	/* keys that may be added before a rehash */
+};
+
+/* the top 7 bits of a hash is its tag, the rest selects the group */
+#define H2(h) ((unsigned char)(((h) >> (sizeof(size_t)*8 - 7)) & 0x7f))
+#define H1(h) (h)
+
+
+/*
+ * match - bit mask of the slots of a group whose control octet is c
+ */
+static unsigned int
+match(const unsigned char *g, unsigned char c)
+{
+#if defined(__SSE2__)
+    __m128i grp = _mm_loadu_si128((const __m128i *)g);	/* group */
+
+    return (unsigned int)_mm_movemask_epi8(
+	_mm_cmpeq_epi8(grp, _mm_set1_epi8((char)c)));
+#elif defined(HAVE_64BIT_LONG_LONG)
+    unsigned int mask = 0;	/* matching slots */
+    u_int64_t w;		/* 8 control octets */
+    u_int64_t x;		/* zero octets where w equals c */
+    u_int64_t z;		/* high bit set in each zero octet of x */
+    int i;
+    int j;
+
+    for (i = 0; i < MAP_GROUP; i += 8) {
+	memcpy(&w, g + i, 8);
+	x = w ^ (0x0101010101010101ULL * c);
+	/* exact zero octet test: no false positives from borrows */
+	z = ~(((x & 0x7f7f7f7f7f7f7f7fULL) + 0x7f7f7f7f7f7f7f7fULL) | x |
+	      0x7f7f7f7f7f7f7f7fULL);
+	for (j = 0; j < 8; ++j) {
+	    /* z is in native byte order, so test each octet in memory */
+	    if (((unsigned char *)&z)[j] & 0x80) {
+		mask |= 1U << (i + j);
+	    }
+	}
+    }
+    return mask;
+#else /* HAVE_64BIT_LONG_LONG */
+    unsigned int mask = 0;	/* matching slots */
+    int i;
+
+    for (i = 0; i < MAP_GROUP; ++i) {
+	if (g[i] == c) {
+	    mask |= 1U << i;
+	}
+    }
+    return mask;
+#endif /* __SSE2__ */
+}
+
+
+/*
+ * match_free - bit mask of the slots of a group that are empty or deleted
+ */
+static unsigned int
+match_free(const unsigned char *g)
+{
+#if defined(__SSE2__)
+    /* MAP_EMPTY and MAP_DELETED are the only control octets >= 0x80 */
+    return (unsigned int)_mm_movemask_epi8(
+	_mm_loadu_si128((const __m128i *)g));
+#else /* __SSE2__ */
+    return match(g, MAP_EMPTY) | match(g, MAP_DELETED);
+#endif /* __SSE2__ */
+}
+
+
+/*
+ * lowest - index of the lowest set bit of a non-zero mask
+ */
+static int
+lowest(unsigned int mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else /* __GNUC__ */
+    int i = 0;
+
+    while ((mask & 1) == 0) {
+	mask >>= 1;
+	++i;
+    }
+    return i;
+#endif /* __GNUC__ */
+}
+
+
+/*
+ * highest - index of the highest set bit of a non-zero mask
+ */
+static int
+highest(unsigned int mask)
+{
+#if defined(__GNUC__)
+    return (int)(sizeof(mask)*8) - 1 - __builtin_clz(mask);
+#else /* __GNUC__ */
+    int i = -1;
+
+    while (mask != 0) {
+	mask >>= 1;
+	++i;
+    }
+    return i;
+#endif /* __GNUC__ */
+}
+
+
+/*
+ * set_ctrl - set the control octet of a slot, and its mirror
+ */
+static void
+set_ctrl(struct fnv_map *m, size_t i, unsigned char c)
+{
+    m->ctrl[i] = c;
+    if (i < MAP_GROUP - 1) {
+	m->ctrl[m->nslot + i] = c;
+    }
+}
+
+
+/*
+ * max_load - number of keys a table of nslot slots may hold (7/8 full)
+ */
+static size_t
+max_load(size_t nslot)
+{
+    return nslot - nslot / 8;
+}
+
+
+/*
+ * alloc_table - allocate an empty table of nslot slots
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+alloc_table(struct fnv_map *m, size_t nslot)
+{
+    m->ctrl = malloc(nslot + MAP_GROUP - 1);
+    m->key = malloc(nslot * sizeof(m->key[0]));
+    m->val = malloc(nslot * sizeof(m->val[0]));
+    if (m->ctrl == NULL || m->key == NULL || m->val == NULL) {
+	free(m->ctrl);
+	free(m->key);
+	free(m->val);
+	return -1;
+    }
+    memset(m->ctrl, MAP_EMPTY, nslot + MAP_GROUP - 1);
+    m->nslot = nslot;
+    m->count = 0;
+    m->growth_left = max_load(nslot);
+    return 0;
+}
+
+
+/*
+ * fnv_map_new - create an empty map
+ *
+ * input:
+ *	hint	- expected number of keys, or 0
+ *
+ * returns:
+ *	new map, free with fnv_map_free(), or NULL ==> out of memory
+ */
+struct fnv_map *
+fnv_map_new(size_t hint)
+{
+    struct fnv_map *m;		/* new map */
+    size_t nslot = MAP_MIN_SLOTS;	/* number of slots */
+
+    while (max_load(nslot) < hint) {
+	nslot *= 2;
+    }
+    m = calloc(1, sizeof(*m));
+    if (m == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    if (alloc_table(m, nslot) < 0) {
+	free(m);
+	errno = ENOMEM;
+	return NULL;
+    }
+    return m;
+}
+
+
+/*
+ * fnv_map_free - free a map, but not its keys or values
+ */
+void
+fnv_map_free(struct fnv_map *m)
+{
+    if (m == NULL) {
+	return;
+    }
+    free(m->ctrl);
+    free(m->key);
+    free(m->val);
+    free(m);
+}
+
+
+/*
+ * fnv_map_count - return the number of keys in a map
+ */
+size_t
+fnv_map_count(struct fnv_map *m)
+{
+    return m->count;
+}
+
+
+/*
+ * find - probe for a key whose hash is h
+ *
+ * returns:
+ *	slot of the key, or (size_t)-1 ==> not found
+ */
+static size_t
+find(struct fnv_map *m, const void *key, size_t len, size_t h)
+{
+    size_t mask = m->nslot - 1;	/* slot index mask */
+    size_t pos = H1(h) & mask;	/* first slot of the group */
+    size_t step = 0;		/* probe distance */
+    size_t i;			/* candidate slot */
+    unsigned int bits;		/* slots whose tag matches */
+    unsigned char tag = H2(h);	/* tag of key */
+
+    for (;;) {
+	bits = match(m->ctrl + pos, tag);
+	while (bits != 0) {
+	    i = (pos + (size_t)lowest(bits)) & mask;
+	    if (m->key[i].len == len &&
+		memcmp(m->key[i].ptr, key, len) == 0) {
+		return i;
+	    }
+	    bits &= bits - 1;
+	}
+	if (match(m->ctrl + pos, MAP_EMPTY) != 0) {
+	    return (size_t)-1;
+	}
+	/* triangular probing visits every group of a power of 2 table */
+	step += MAP_GROUP;
+	pos = (pos + step) & mask;
+    }
+}
+
+
+/*
+ * find_free - find the first empty or deleted slot for a hash
+ */
+static size_t
+find_free(struct fnv_map *m, size_t h)
+{
+    size_t mask = m->nslot - 1;	/* slot index mask */
+    size_t pos = H1(h) & mask;	/* first slot of the group */
+    size_t step = 0;		/* probe distance */
+    unsigned int bits;		/* empty or deleted slots */
+
+    for (;;) {
+	bits = match_free(m->ctrl + pos);
+	if (bits != 0) {
+	    return (pos + (size_t)lowest(bits)) & mask;
+	}
+	step += MAP_GROUP;
+	pos = (pos + step) & mask;
+    }
+}
+
+
+/*
+ * rehash - move every key into a new table of nslot slots
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+rehash(struct fnv_map *m, size_t nslot)
+{
+    struct fnv_map old = *m;	/* current table */
+    size_t h;			/* hash of a key */
+    size_t i;
+    size_t j;			/* slot in the new table */
+
+    if (alloc_table(m, nslot) < 0) {
+	*m = old;
+	return -1;
+    }
+    for (i = 0; i < old.nslot; ++i) {
+	if (old.ctrl[i] & 0x80) {
+	    continue;		/* empty or deleted */
+	}
+	h = (size_t)fnv_64a_mix(old.key[i].ptr, old.key[i].len, 0);
+	j = find_free(m, h);
+	set_ctrl(m, j, H2(h));
+	m->key[j] = old.key[i];
+	m->val[j] = old.val[i];
+    }
+    m->count = old.count;
+    m->growth_left = max_load(nslot) - old.count;
+    free(old.ctrl);
+    free(old.key);
+    free(old.val);
+    return 0;
+}
+
+
+/*
+ * fnv_map_put - add a key to a map, or change its value
+ *
+ * input:
+ *	m	- map
+ *	key	- key octets, not copied: must not change while in the map
+ *	len	- key length
+ *	val	- value
+ *
+ * returns:
+ *	0 ==> key added, 1 ==> value of an existing key replaced,
+ *	-1 ==> out of memory (errno ENOMEM)
+ */
+int
+fnv_map_put(struct fnv_map *m, const void *key, size_t len, void *val)
+{
+    size_t h = (size_t)fnv_64a_mix(key, len, 0);	/* hash of key */
+    size_t i;			/* slot */
+
+    i = find(m, key, len, h);
+    if (i != (size_t)-1) {
+	m->val[i] = val;
+	return 1;
+    }
+    if (m->growth_left == 0) {
+	/* grow unless most of the used slots are deleted ones */
+	if (rehash(m, (m->count * 2 > max_load(m->nslot)) ?
+		      m->nslot * 2 : m->nslot) < 0) {
+	    errno = ENOMEM;
+	    return -1;
+	}
+    }
+    i = find_free(m, h);
+    if (m->ctrl[i] == MAP_EMPTY) {
+	--m->growth_left;
+    }
+    set_ctrl(m, i, H2(h));
+    m->key[i].ptr = key;
+    m->key[i].len = len;
+    m->val[i] = val;
+    ++m->count;
+    return 0;
+}
+
+
+/*
+ * fnv_map_get - look up a key
+ *
+ * input:
+ *	m	- map
+ *	key	- key octets
+ *	len	- key length
+ *	val	- where to store the value, or NULL
+ *
+ * returns:
+ *	1 ==> found, 0 ==> not found
+ */
+int
+fnv_map_get(struct fnv_map *m, const void *key, size_t len, void **val)
+{
+    size_t i;			/* slot */
+
+    i = find(m, key, len, (size_t)fnv_64a_mix(key, len, 0));
+    if (i == (size_t)-1) {
+	return 0;
+    }
+    if (val != NULL) {
+	*val = m->val[i];
+    }
+    return 1;
+}
+
+
+/*
+ * fnv_map_get_batch - look up several keys
+ *
+ * input:
+ *	m	- map
+ *	n	- number of keys
+ *	key	- key octets of each key
+ *	len	- length of each key
+ *	val	- where to store the value of each key, NULL if not found
+ *
+ * returns:
+ *	number of keys found
+ *
+ * Keys are hashed MAP_BATCH at a time and the first group of control
+ * octets of each is prefetched before any is probed, so that the cache
+ * misses of a batch overlap instead of following one another.
+ */
+size_t
+fnv_map_get_batch(struct fnv_map *m, size_t n, const void * const *key,
+		  const size_t *len, void **val)
+{
+    size_t h[MAP_BATCH];	/* hashes of a batch */
+    size_t mask = m->nslot - 1;	/* slot index mask */
+    size_t found = 0;		/* keys found */
+    size_t b;			/* first key of a batch */
+    size_t nb;			/* keys in a batch */
+    size_t i;
+    size_t s;			/* slot of a key */
+
+    for (b = 0; b < n; b += nb) {
+	nb = (n - b < MAP_BATCH) ? n - b : MAP_BATCH;
+	for (i = 0; i < nb; ++i) {
+	    h[i] = (size_t)fnv_64a_mix(key[b+i], len[b+i], 0);
+	    FNV_PREFETCH(m->ctrl + (H1(h[i]) & mask));
+	    FNV_PREFETCH(&m->key[H1(h[i]) & mask]);
+	}
+	for (i = 0; i < nb; ++i) {
+	    s = find(m, key[b+i], len[b+i], h[i]);
+	    if (s == (size_t)-1) {
+		val[b+i] = NULL;
+	    } else {
+		val[b+i] = m->val[s];
+		++found;
+	    }
+	}
+    }
+    return found;
+}
+
+
+/*
+ * fnv_map_del - remove a key from a map
+ *
+ * returns:
+ *	1 ==> removed, 0 ==> not found
+ */
+int
+fnv_map_del(struct fnv_map *m, const void *key, size_t len)
+{
+    size_t mask = m->nslot - 1;	/* slot index mask */
+    size_t before;		/* first slot of the group ending at i */
+    size_t i;			/* slot */
+    unsigned int after;		/* empty slots at or after i */
+    unsigned int prior;		/* empty slots before i */
+
+    i = find(m, key, len, (size_t)fnv_64a_mix(key, len, 0));
+    if (i == (size_t)-1) {
+	return 0;
+    }
+
+    /*
+     * If every MAP_GROUP slot window that contains slot i also has an
+     * empty slot, no probe can have passed slot i: it can become empty
+     * again rather than deleted.
+     */
+    before = (i - MAP_GROUP) & mask;
+    after = match(m->ctrl + i, MAP_EMPTY);
+    prior = match(m->ctrl + before, MAP_EMPTY);
+    --m->count;
+    if (after != 0 && prior != 0 &&
+	lowest(after) + (MAP_GROUP - 1 - highest(prior)) < MAP_GROUP) {
+	set_ctrl(m, i, MAP_EMPTY);
+	++m->growth_left;
+    } else {
+	set_ctrl(m, i, MAP_DELETED);
+    }
+    return 1;
+}
+
+
+/*
+ * fnv_map_next - step through the keys of a map
+ *
+ * input:
+ *	m	- map
+ *	iter	- iterator, set to 0 before the first call
+ *	key	- where to store the key
+ *	len	- where to store the key length
+ *	val	- where to store the value, or NULL
+ *
+ * returns:
+ *	1 ==> a key was stored, 0 ==> no more keys
+ *
+ * Keys are returned in no particular order.  The map must not be changed
+ * while stepping through it, except with fnv_map_put() of a key that is
+ * already in the map.
+ */
+int
+fnv_map_next(struct fnv_map *m, size_t *iter, const void **key, size_t *len,
+	     void **val)
+{
+    size_t i;
+
+    for (i = *iter; i < m->nslot; ++i) {
+	if ((m->ctrl[i] & 0x80) == 0) {
+	    *key = m->key[i].ptr;
+	    *len = m->key[i].len;
+	    if (val != NULL) {
+		*val = m->val[i];
+	    }
+	    *iter = i + 1;
+	    return 1;
+	}
+    }
+    *iter = m->nslot;
+    return 0;
+}
@@ -0,0 +1,415 @@
+/*
+ * fnv_map_bench - compare fnv_map with std::unordered_map
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+extern "C" {
+#include "longlong.h"
+#include "fnv.h"
+}
+
+
+/*
+ * usage
+ */
+static const char * const usage =
+"usage: %s [-h] [-c] [-n keys] [-s seed]\n"
+"\n"
+"    -h         print help and exit\n"
+"    -c         check fnv_map against std::unordered_map, do not time\n"
+"    -n keys    number of keys (default 1000000)\n"
+"    -s seed    random seed (default 1)\n"
+"\n"
+"Times fnv_map put, get, fnv_map_get_batch and del against\n"
+"std::unordered_map with std::hash and with an FNV-1a hash.\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed\n"
+"    3         command line error\n"
+"    5         -c found a difference\n"
+" >= 20        internal error\n";
+static const char *prog = NULL;	/* our name */
+
+
+/*
+ * fnv_hasher - std::unordered_map hash of a string with FNV-1a
+ */
+struct fnv_hasher {
+    size_t operator()(std::string_view s) const {
+	Fnv64_t h = fnv_64a_buf((void *)s.data(), s.size(), FNV1A_64_INIT);
+
+#if defined(HAVE_64BIT_LONG_LONG)
+	return (size_t)h;
+#else /* HAVE_64BIT_LONG_LONG */
+	return (size_t)(h.w32[0] ^ h.w32[1]);
+#endif /* HAVE_64BIT_LONG_LONG */
+    }
+};
+
+
+/*
+ * make_keys - n distinct keys of 8 to 40 printable octets
+ */
+static std::vector<std::string>
+make_keys(size_t n, unsigned int seed, const char *prefix)
+{
+    std::vector<std::string> keys;
+    char buf[64];
+
+    keys.reserve(n);
+    srandom(seed);
+    for (size_t i = 0; i < n; ++i) {
+	int pad = (int)(random() % 24);
+
+	snprintf(buf, sizeof(buf), "%s%zu-%.*s", prefix, i, pad,
+		 "abcdefghijklmnopqrstuvwxyz");
+	keys.push_back(buf);
+    }
+    /* shuffle so that lookups are not in insertion order */
+    for (size_t i = n; i > 1; --i) {
+	std::swap(keys[i-1], keys[(size_t)random() % i]);
+    }
+    return keys;
+}
+
+
+/*
+ * now_ns - monotonic time in nanoseconds
+ */
+static double
+now_ns(void)
+{
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+	std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/*
+ * report - print the time per operation
+ */
+static void
+report(const char *what, double start, size_t n, size_t found)
+{
+    printf("%-40s %8.1f ns/op  (%zu found)\n", what,
+	   (now_ns() - start) / (double)n, found);
+}
+
+
+/*
+ * check - compare fnv_map with std::unordered_map over random operations
+ *
+ * returns:	0 ==> same results, 1 ==> a difference was found
+ */
+static int
+check(size_t n, unsigned int seed)
+{
+    std::vector<std::string> keys = make_keys(n, seed, "k");
+    std::unordered_map<std::string_view, void *> ref;
+    struct fnv_map *m = fnv_map_new(0);
+    std::vector<const void *> bkey(n);
+    std::vector<size_t> blen(n);
+    std::vector<void *> bval(n);
+    size_t iter = 0;
+    const void *key;
+    size_t len;
+    void *val;
+    size_t cnt;
+
+    if (m == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    srandom(seed);
+    for (size_t op = 0; op < n * 8; ++op) {
+	size_t k = (size_t)random() % n;
+	std::string_view s(keys[k]);
+	void *v = (void *)(op + 1);
+	int r;
+
+	switch (random() % 3) {
+	case 0:
+	    r = fnv_map_put(m, s.data(), s.size(), v);
+	    if (r != (ref.count(s) ? 1 : 0)) {
+		return 1;
+	    }
+	    ref[s] = v;
+	    break;
+	case 1:
+	    r = fnv_map_get(m, s.data(), s.size(), &val);
+	    if (r != (int)ref.count(s) || (r && val != ref[s])) {
+		return 1;
+	    }
+	    break;
+	default:
+	    r = fnv_map_del(m, s.data(), s.size());
+	    if (r != (int)ref.erase(s)) {
+		return 1;
+	    }
+	    break;
+	}
+	if (fnv_map_count(m) != ref.size()) {
+	    return 1;
+	}
+    }
+    for (size_t i = 0; i < n; ++i) {
+	bkey[i] = keys[i].data();
+	blen[i] = keys[i].size();
+    }
+    if (fnv_map_get_batch(m, n, bkey.data(), blen.data(), bval.data()) !=
+	ref.size()) {
+	return 1;
+    }
+    for (size_t i = 0; i < n; ++i) {
+	auto it = ref.find(keys[i]);
+
+	if (bval[i] != (it == ref.end() ? NULL : it->second)) {
+	    return 1;
+	}
+    }
+    for (cnt = 0; fnv_map_next(m, &iter, &key, &len, &val); ++cnt) {
+	auto it = ref.find(std::string_view((const char *)key, len));
+
+	if (it == ref.end() || it->second != val) {
+	    return 1;
+	}
+    }
+    if (cnt != ref.size()) {
+	return 1;
+    }
+    fnv_map_free(m);
+    return 0;
+}
+
+
+/*
+ * bench_std - time a std::unordered_map
+ */
+template <class Map>
+static void
+bench_std(const char *name, std::vector<std::string> &keys,
+	  std::vector<std::string> &miss)
+{
+    Map map;
+    size_t found = 0;
+    double start;
+    std::string label;
+
+    start = now_ns();
+    for (size_t i = 0; i < keys.size(); ++i) {
+	map[keys[i]] = (void *)(i + 1);
+    }
+    report((label = std::string(name) + " insert").c_str(), start,
+	   keys.size(), map.size());
+    start = now_ns();
+    for (auto &k : keys) {
+	found += map.count(k);
+    }
+    report((label = std::string(name) + " get hit").c_str(), start,
+	   keys.size(), found);
+    found = 0;
+    start = now_ns();
+    for (auto &k : miss) {
+	found += map.count(k);
+    }
+    report((label = std::string(name) + " get miss").c_str(), start,
+	   miss.size(), found);
+    found = 0;
+    start = now_ns();
+    for (auto &k : keys) {
+	found += map.erase(k);
+    }
+    report((label = std::string(name) + " delete").c_str(), start,
+	   keys.size(), found);
+}
+
+
+/*
+ * bench_fnv_map - time an fnv_map
+ */
+static void
+bench_fnv_map(std::vector<std::string> &keys, std::vector<std::string> &miss)
+{
+    struct fnv_map *m = fnv_map_new(0);
+    std::vector<const void *> bkey(keys.size());
+    std::vector<size_t> blen(keys.size());
+    std::vector<void *> bval(keys.size());
+    size_t found = 0;
+    double start;
+
+    if (m == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    start = now_ns();
+    for (size_t i = 0; i < keys.size(); ++i) {
+	if (fnv_map_put(m, keys[i].data(), keys[i].size(),
+			(void *)(i + 1)) < 0) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+    }
+    report("fnv_map insert", start, keys.size(), fnv_map_count(m));
+    start = now_ns();
+    for (auto &k : keys) {
+	found += (size_t)fnv_map_get(m, k.data(), k.size(), NULL);
+    }
+    report("fnv_map get hit", start, keys.size(), found);
+    for (size_t i = 0; i < keys.size(); ++i) {
+	bkey[i] = keys[i].data();
+	blen[i] = keys[i].size();
+    }
+    start = now_ns();
+    found = fnv_map_get_batch(m, keys.size(), bkey.data(), blen.data(),
+			      bval.data());
+    report("fnv_map get_batch hit", start, keys.size(), found);
+    found = 0;
+    start = now_ns();
+    for (auto &k : miss) {
+	found += (size_t)fnv_map_get(m, k.data(), k.size(), NULL);
+    }
+    report("fnv_map get miss", start, miss.size(), found);
+    found = 0;
+    start = now_ns();
+    for (auto &k : keys) {
+	found += (size_t)fnv_map_del(m, k.data(), k.size());
+    }
+    report("fnv_map delete", start, keys.size(), found);
+    fnv_map_free(m);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    size_t n = 1000000;		/* number of keys */
+    unsigned int seed = 1;	/* random seed */
+    int c_flag = 0;		/* 1 ==> -c check mode */
+    int i;
+
+    prog = strrchr(argv[0], '/');
+    prog = (prog == NULL) ? argv[0] : prog + 1;
+    while ((i = getopt(argc, argv, "hcn:s:")) != -1) {
+	switch (i) {
+	case 'h':
+	    fprintf(stderr, usage, prog);
+	    exit(2);
+	case 'c':
+	    c_flag = 1;
+	    break;
+	case 'n':
+	    n = (size_t)strtoull(optarg, NULL, 0);
+	    break;
+	case 's':
+	    seed = (unsigned int)strtoul(optarg, NULL, 0);
+	    break;
+	default:
+	    fprintf(stderr, usage, prog);
+	    exit(3);
+	}
+    }
+    if (optind != argc || n == 0) {
+	fprintf(stderr, usage, prog);
+	exit(3);
+    }
+
+    if (c_flag) {
+	if (check(n, seed) != 0) {
+	    printf("failed\n");
+	    exit(5);
+	}
+	printf("passed\n");
+	exit(0);
+    }
+
+    std::vector<std::string> keys = make_keys(n, seed, "k");
+    std::vector<std::string> miss = make_keys(n, seed + 1, "m");
+
+    printf("%zu keys\n", n);
+    bench_fnv_map(keys, miss);
+    bench_std<std::unordered_map<std::string_view, void *, fnv_hasher>>(
+	"std::unordered_map FNV-1a", keys, miss);
+    bench_std<std::unordered_map<std::string_view, void *>>(
+	"std::unordered_map std::hash", keys, miss);
+    exit(0);
+}
@@ -0,0 +1,722 @@
+/*
+ * fnv_minhash - MinHash, SimHash and LSH near-duplicate detection on FNV shingles
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * Near-duplicate detection: shingles, MinHash, SimHash and an LSH
+ * banding index.
+ *
+ * A text is cut into words, runs of octets other than ASCII white
+ * space, with ASCII letters folded to lower case.  Its shingles are
+ * the runs of w words in a row, each hashed with FNV-1a 64 as the words
+ * joined by single spaces, from a basis that is the FNV-1a 64 hash of
+ * the 8 octets of a seed.  Two texts with many shingles in common have
+ * much text in common, in much the same order.
+ *
+ * A MinHash signature is the least value, over the shingles, of each
+ * of k hash functions.  The chance that two texts have the same least
+ * value of a function is the Jaccard similarity of their shingle sets,
+ * so the fraction of equal values estimates it.  Rather than hash each
+ * shingle k times, its FNV hash is finalized once with fnv_mix64() and
+ * function i is a cheap 32 bit permutation of it:
+ *
+ *	v = lo * a[i] + hi * b[i], then v ^= v >> 15, v *= C, v ^= v >> 13
+ *
+ * with lo and hi the halves of the mixed hash and a[i], b[i] random
+ * odd numbers.  The k functions of one shingle are a loop of the same
+ * 32 bit operations over arrays, which compilers turn into SIMD code,
+ * and all k minima are kept in a single pass over the shingles.
+ *
+ * A SimHash fingerprint is 64 bits, bit j being set when bit j is set
+ * in more than half of the mixed shingle hashes.  Similar texts have
+ * fingerprints a small Hamming distance apart: 8 bytes a text, against
+ * 4k for a MinHash signature.
+ *
+ * The LSH banding index cuts a signature into b bands of r values,
+ * hashes each band, and keeps for each band a table from band hash to
+ * text ids.  Two texts are candidates when any band is equal, which
+ * for a Jaccard similarity s happens with a chance of 1 - (1 - s^r)^b,
+ * an S curve rising near s = (1/b)^(1/r).  Each band table is an open
+ * addressing table with one slot per distinct 64 bit band hash.  A slot
+ * points to the head of a list of the ids sharing that band, so many
+ * texts with an equal band cost one probe and not a probe each.
+ */
+#define MINHASH_MAX 4096	/* most hash functions */
+#define MINHASH_ALIGN 64	/* alignment of the lane arrays */
+#define MINHASH_C 0x2c1b3c6dU	/* multiplier of the permutations */
+#define LSH_MIN 64		/* smallest band table */
+#define LSH_NONE ((uint32_t)-1)	/* end of an id list */
+
+struct fnv_minhash {
+    int k;			/* number of hash functions */
+    uint32_t *a;		/* multiplier of lo for each function */
+    uint32_t *b;		/* multiplier of hi for each function */
+};
+
+struct lsh_slot {
+    unsigned long long key;	/* band hash, 0 ==> empty */
+    uint32_t head;		/* last id added with this key */
+};
+
+struct lsh_id {
+    uint32_t id;		/* text id */
+    uint32_t next;		/* previous id with the same key, or LSH_NONE */
+};
+
+struct lsh_band {
+    struct lsh_slot *slot;	/* open addressing table */
+    size_t cap;			/* slots, a power of 2 */
+    size_t count;		/* slots used */
+    struct lsh_id *ids;		/* id lists of all slots */
+    size_t nids;		/* ids added */
+    size_t maxids;		/* allocated ids */
+};
+
+struct fnv_lsh {
+    int bands;			/* number of bands */
+    int rows;			/* signature values in a band */
+    struct lsh_band *band;	/* table of each band */
+    uint32_t *found;		/* ids found by a query */
+    size_t nfound;		/* ids in found */
+    size_t maxfound;		/* allocated ids in found */
+};
+
+
+/*
+ * is_space - ASCII white space
+ */
+static int
+is_space(unsigned char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+/*
+ * hash_words - FNV-1a 64 of w words joined by single spaces
+ */
+static unsigned long long
+hash_words(const unsigned char **word, const size_t *len, int w,
+	   unsigned long long basis)
+{
+    unsigned long long h = basis;	/* hash so far */
+    const unsigned char *p;	/* octet of a word */
+    const unsigned char *end;	/* end of a word */
+    unsigned char c;		/* octet, folded */
+    int i;
+
+    for (i = 0; i < w; ++i) {
+	if (i > 0) {
+	    h ^= ' ';
+	    h *= 0x100000001b3ULL;
+	}
+	for (p = word[i], end = p + len[i]; p < end; ++p) {
+	    c = *p;
+	    if (c >= 'A' && c <= 'Z') {
+		c += 'a' - 'A';
+	    }
+	    h ^= c;
+	    h *= 0x100000001b3ULL;
+	}
+    }
+    return h;
+}
+
+
+/*
+ * fnv_shingle - hash the word shingles of a text
+ *
+ * input:
+ *	text	- text octets
+ *	len	- length of text
+ *	w	- words in a shingle, 1 to 64
+ *	seed	- hash seed, 0 ==> plain FNV-1a 64
+ *	out	- where to store the shingle hashes
+ *	max	- most hashes to store: len / 2 + 1 is always enough
+ *
+ * returns:
+ *	number of shingle hashes stored: 1 for a text of 1 to w words,
+ *	0 for a text of no words
+ */
+size_t
+fnv_shingle(const void *text, size_t len, int w, unsigned long long seed,
+	    unsigned long long *out, size_t max)
+{
+    const unsigned char *p = (const unsigned char *)text;	/* text */
+    const unsigned char *end = p + len;	/* end of text */
+    const unsigned char *word[64];	/* the last w words */
+    size_t wlen[64];		/* their lengths */
+    unsigned long long basis;	/* seeded basis */
+    int nword = 0;		/* words in word[] */
+    size_t n = 0;		/* shingles stored */
+    int i;
+
+    if (w < 1 || w > 64 || max == 0) {
+	return 0;
+    }
+    basis = 0xcbf29ce484222325ULL;	/* FNV-1a 64 basis */
+    if (seed != 0) {
+	/* FNV-1a 64 of the 8 seed octets, low first */
+	for (i = 0; i < 8; ++i) {
+	    basis ^= (seed >> (8 * i)) & 0xff;
+	    basis *= 0x100000001b3ULL;
+	}
+    }
+    for (;;) {
+	while (p < end && is_space(*p)) {
+	    ++p;
+	}
+	if (p == end) {
+	    break;
+	}
+	if (nword == w) {
+	    /* slide the window by one word */
+	    memmove(word, word + 1, (size_t)(w - 1) * sizeof(word[0]));
+	    memmove(wlen, wlen + 1, (size_t)(w - 1) * sizeof(wlen[0]));
+	    --nword;
+	}
+	word[nword] = p;
+	while (p < end && !is_space(*p)) {
+	    ++p;
+	}
+	wlen[nword] = (size_t)(p - word[nword]);
+	if (++nword == w) {
+	    out[n++] = hash_words(word, wlen, w, basis);
+	    if (n == max) {
+		return n;
+	    }
+	}
+    }
+    if (n == 0 && nword > 0) {
+	out[n++] = hash_words(word, wlen, nword, basis);
+    }
+    return n;
+}
+
+
+/*
+ * fnv_minhash_new - create k MinHash functions
+ *
+ * input:
+ *	k	- number of functions, 1 to 4096
+ *	seed	- seed of the functions: signatures are comparable only
+ *		  when made with the same k and seed
+ *
+ * returns:
+ *	new functions, free with fnv_minhash_free(), or NULL ==> error,
+ *	errno set
+ */
+struct fnv_minhash *
+fnv_minhash_new(int k, unsigned long long seed)
+{
+    struct fnv_minhash *m;	/* new functions */
+    unsigned long long s = seed;	/* splitmix64 state */
+    unsigned long long r;	/* random value */
+    size_t size;		/* octets of a lane array */
+    int i;
+
+    if (k < 1 || k > MINHASH_MAX) {
+	errno = EINVAL;
+	return NULL;
+    }
+    m = calloc(1, sizeof(*m));
+    if (m == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    size = ((size_t)k * sizeof(uint32_t) + MINHASH_ALIGN - 1) /
+	   MINHASH_ALIGN * MINHASH_ALIGN;
+    if (posix_memalign((void **)&m->a, MINHASH_ALIGN, size) != 0 ||
+	posix_memalign((void **)&m->b, MINHASH_ALIGN, size) != 0) {
+	fnv_minhash_free(m);
+	errno = ENOMEM;
+	return NULL;
+    }
+    m->k = k;
+    for (i = 0; i < k; ++i) {
+	s += 0x9e3779b97f4a7c15ULL;
+	r = fnv_mix64(s);
+	m->a[i] = (uint32_t)r | 1;
+	m->b[i] = (uint32_t)(r >> 32) | 1;
+    }
+    return m;
+}
+
+
+/*
+ * fnv_minhash_free - free MinHash functions
+ */
+void
+fnv_minhash_free(struct fnv_minhash *m)
+{
+    if (m == NULL) {
+	return;
+    }
+    free(m->a);
+    free(m->b);
+    free(m);
+}
+
+
+/*
+ * fnv_minhash_sig - MinHash signature of a set of shingles
+ *
+ * input:
+ *	m	- MinHash functions
+ *	shingle	- shingle hashes, as from fnv_shingle()
+ *	n	- number of shingles
+ *	sig	- where to store the k values of the signature
+ *
+ * An empty set has every value 0xffffffff.
+ */
+void
+fnv_minhash_sig(struct fnv_minhash *m, const unsigned long long *shingle,
+		size_t n, uint32_t *sig)
+{
+    const uint32_t *a = m->a;	/* multipliers of lo */
+    const uint32_t *b = m->b;	/* multipliers of hi */
+    unsigned long long x;	/* mixed shingle hash */
+    uint32_t lo, hi;		/* halves of x */
+    uint32_t v;			/* value of a function */
+    int k = m->k;
+    size_t j;
+    int i;
+
+    for (i = 0; i < k; ++i) {
+	sig[i] = 0xffffffffU;
+    }
+    for (j = 0; j < n; ++j) {
+	x = fnv_mix64(shingle[j]);
+	lo = (uint32_t)x;
+	hi = (uint32_t)(x >> 32);
+	/* the same operations on every lane: compiled to SIMD code */
+	for (i = 0; i < k; ++i) {
+	    v = lo * a[i] + hi * b[i];
+	    v ^= v >> 15;
+	    v *= MINHASH_C;
+	    v ^= v >> 13;
+	    sig[i] = (v < sig[i]) ? v : sig[i];
+	}
+    }
+}
+
+
+/*
+ * fnv_minhash_sim - estimated Jaccard similarity of two signatures
+ *
+ * returns:
+ *	fraction of the k values that are equal
+ */
+double
+fnv_minhash_sim(const uint32_t *a, const uint32_t *b, int k)
+{
+    int same = 0;		/* equal values */
+    int i;
+
+    for (i = 0; i < k; ++i) {
+	same += (a[i] == b[i]);
+    }
+    return (k > 0) ? (double)same / (double)k : 0.0;
+}
+
+
+/*
+ * fnv_simhash - 64 bit SimHash fingerprint of a set of shingles
+ *
+ * input:
+ *	shingle	- shingle hashes, as from fnv_shingle()
+ *	n	- number of shingles
+ *
+ * returns:
+ *	fingerprint, 0 for an empty set
+ */
+unsigned long long
+fnv_simhash(const unsigned long long *shingle, size_t n)
+{
+    uint32_t ones[64];		/* hashes with each bit set */
+    unsigned long long x;	/* mixed shingle hash */
+    unsigned long long fp = 0;	/* fingerprint */
+    size_t j;
+    int i;
+
+    memset(ones, 0, sizeof(ones));
+    for (j = 0; j < n; ++j) {
+	x = fnv_mix64(shingle[j]);
+	for (i = 0; i < 64; ++i) {
+	    ones[i] += (uint32_t)((x >> i) & 1);
+	}
+    }
+    for (i = 0; i < 64; ++i) {
+	if (2 * (unsigned long long)ones[i] > n) {
+	    fp |= 1ULL << i;
+	}
+    }
+    return fp;
+}
+
+
+/*
+ * fnv_simhash_dist - Hamming distance of two SimHash fingerprints
+ */
+int
+fnv_simhash_dist(unsigned long long a, unsigned long long b)
+{
+    unsigned long long x = a ^ b;	/* differing bits */
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else /* __GNUC__ */
+    int n = 0;			/* bits counted */
+
+    for (; x != 0; x &= x - 1) {
+	++n;
+    }
+    return n;
+#endif /* __GNUC__ */
+}
+
+
+/*
+ * fnv_lsh_new - create an empty LSH banding index
+ *
+ * input:
+ *	bands	- number of bands, > 0
+ *	rows	- signature values in a band, > 0: signatures added must
+ *		  have at least bands * rows values
+ *
+ * returns:
+ *	new index, free with fnv_lsh_free(), or NULL ==> error, errno set
+ */
+struct fnv_lsh *
+fnv_lsh_new(int bands, int rows)
+{
+    struct fnv_lsh *l;		/* new index */
+    int i;
+
+    if (bands < 1 || rows < 1 || bands > MINHASH_MAX ||
+	rows > MINHASH_MAX / bands) {
+	errno = EINVAL;
+	return NULL;
+    }
+    l = calloc(1, sizeof(*l));
+    if (l == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    l->bands = bands;
+    l->rows = rows;
+    l->band = calloc((size_t)bands, sizeof(l->band[0]));
+    if (l->band == NULL) {
+	free(l);
+	errno = ENOMEM;
+	return NULL;
+    }
+    for (i = 0; i < bands; ++i) {
+	l->band[i].cap = LSH_MIN;
+	l->band[i].slot = calloc(LSH_MIN, sizeof(struct lsh_slot));
+	if (l->band[i].slot == NULL) {
+	    fnv_lsh_free(l);
+	    errno = ENOMEM;
+	    return NULL;
+	}
+    }
+    return l;
+}
+
+
+/*
+ * fnv_lsh_free - free an LSH banding index
+ */
+void
+fnv_lsh_free(struct fnv_lsh *l)
+{
+    int i;
+
+    if (l == NULL) {
+	return;
+    }
+    for (i = 0; i < l->bands; ++i) {
+	free(l->band[i].slot);
+	free(l->band[i].ids);
+    }
+    free(l->band);
+    free(l->found);
+    free(l);
+}
+
+
+/*
+ * band_key - hash of band i of a signature, never 0
+ */
+static unsigned long long
+band_key(struct fnv_lsh *l, int i, const uint32_t *sig)
+{
+    unsigned long long key;	/* band hash */
+
+    key = fnv_64a_mix(sig + (size_t)i * (size_t)l->rows,
+		      (size_t)l->rows * sizeof(sig[0]), (unsigned long long)i);
+    return (key == 0) ? 1 : key;
+}
+
+
+/*
+ * band_grow - double a band table
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+band_grow(struct lsh_band *t)
+{
+    struct lsh_slot *slot;	/* new table */
+    size_t cap = t->cap * 2;	/* its slots */
+    size_t i, j;
+
+    slot = calloc(cap, sizeof(slot[0]));
+    if (slot == NULL) {
+	return -1;
+    }
+    for (i = 0; i < t->cap; ++i) {
+	if (t->slot[i].key != 0) {
+	    for (j = (size_t)t->slot[i].key & (cap - 1); slot[j].key != 0;
+		 j = (j + 1) & (cap - 1)) {
+	    }
+	    slot[j] = t->slot[i];
+	}
+    }
+    free(t->slot);
+    t->slot = slot;
+    t->cap = cap;
+    return 0;
+}
+
+
+/*
+ * band_find - find the slot of a key, or the empty slot where it goes
+ */
+static struct lsh_slot *
+band_find(struct lsh_band *t, unsigned long long key)
+{
+    size_t j;
+
+    for (j = (size_t)key & (t->cap - 1);
+	 t->slot[j].key != 0 && t->slot[j].key != key;
+	 j = (j + 1) & (t->cap - 1)) {
+    }
+    return &t->slot[j];
+}
+
+
+/*
+ * fnv_lsh_add - add a signature to an index
+ *
+ * input:
+ *	l	- index
+ *	id	- id of the signature's text
+ *	sig	- signature, at least bands * rows values
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory, errno set
+ */
+int
+fnv_lsh_add(struct fnv_lsh *l, uint32_t id, const uint32_t *sig)
+{
+    struct lsh_band *t;		/* table of a band */
+    struct lsh_slot *s;		/* slot of the band hash */
+    struct lsh_id *grow;	/* larger id array */
+    size_t maxgrow;		/* allocated ids in grow */
+    unsigned long long key;	/* band hash */
+    int i;
+
+    for (i = 0; i < l->bands; ++i) {
+	t = &l->band[i];
+	if (t->nids == t->maxids) {
+	    maxgrow = (t->maxids == 0) ? LSH_MIN : t->maxids * 2;
+	    grow = (maxgrow > LSH_NONE) ? NULL :
+		   realloc(t->ids, maxgrow * sizeof(grow[0]));
+	    if (grow == NULL) {
+		errno = ENOMEM;
+		return -1;
+	    }
+	    t->ids = grow;
+	    t->maxids = maxgrow;
+	}
+	if ((t->count + 1) * 4 > t->cap * 3 && band_grow(t) != 0) {
+	    errno = ENOMEM;
+	    return -1;
+	}
+	key = band_key(l, i, sig);
+	s = band_find(t, key);
+	if (s->key == 0) {
+	    s->key = key;
+	    s->head = LSH_NONE;
+	    ++t->count;
+	}
+	t->ids[t->nids].id = id;
+	t->ids[t->nids].next = s->head;
+	s->head = (uint32_t)t->nids++;
+    }
+    return 0;
+}
+
+
+/*
+ * cmp_id - qsort() order of ids
+ */
+static int
+cmp_id(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+/*
+ * fnv_lsh_query - find the candidates of a signature
+ *
+ * input:
+ *	l	- index
+ *	sig	- signature, at least bands * rows values
+ *	id	- where to store the ids of the candidates, in increasing
+ *		  order
+ *	nband	- where to store the bands each candidate shares, or NULL
+ *	max	- most candidates to store
+ *
+ * returns:
+ *	number of candidates stored, or (size_t)-1 ==> out of memory
+ *
+ * A candidate is an added signature sharing at least one band.
+ * Queries and adds on one index must not run at once.
+ */
+size_t
+fnv_lsh_query(struct fnv_lsh *l, const uint32_t *sig, uint32_t *id,
+	      unsigned int *nband, size_t max)
+{
+    struct lsh_band *t;		/* table of a band */
+    struct lsh_slot *s;		/* slot of the band hash */
+    unsigned long long key;	/* band hash */
+    uint32_t *grow;		/* larger found array */
+    size_t maxgrow;		/* allocated ids in grow */
+    size_t n = 0;		/* candidates stored */
+    size_t j, r;
+    uint32_t e;			/* id list entry */
+    int i;
+
+    l->nfound = 0;
+    for (i = 0; i < l->bands; ++i) {
+	t = &l->band[i];
+	key = band_key(l, i, sig);
+	s = band_find(t, key);
+	for (e = (s->key != 0) ? s->head : LSH_NONE; e != LSH_NONE;
+	     e = t->ids[e].next) {
+	    if (l->nfound == l->maxfound) {
+		maxgrow = (l->maxfound == 0) ? 64 : l->maxfound * 2;
+		grow = realloc(l->found, maxgrow * sizeof(grow[0]));
+		if (grow == NULL) {
+		    errno = ENOMEM;
+		    return (size_t)-1;
+		}
+		l->found = grow;
+		l->maxfound = maxgrow;
+	    }
+	    l->found[l->nfound++] = t->ids[e].id;
+	}
+    }
+
+    /* one candidate per run of equal ids */
+    if (l->nfound > 1) {
+	qsort(l->found, l->nfound, sizeof(l->found[0]), cmp_id);
+    }
+    for (j = 0; j < l->nfound && n < max; j = r) {
+	for (r = j + 1; r < l->nfound && l->found[r] == l->found[j]; ++r) {
+	}
+	id[n] = l->found[j];
+	if (nband != NULL) {
+	    nband[n] = (unsigned int)(r - j);
+	}
+	++n;
+    }
+    return n;
+}
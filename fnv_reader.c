@@ -0,0 +1,475 @@
+/*
+ * fnv_reader - read ahead thread to overlap file I/O with hashing
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+#if defined(__linux__)
+#define _GNU_SOURCE		/* for SEEK_DATA and SEEK_HOLE */
+#endif /* __linux__ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "fnv.h"
+
+#define FNV_READER_ALIGN 4096		/* buffer alignment */
+
+
+/*
+ * The reader thread fills a ring of nbuf buffers in order while the
+ * caller hashes them in the same order.  Each ring slot is either
+ * empty (owned by the reader thread) or full (owned by the caller).
+ * A full slot with len == 0 marks EOF and one with len < 0 marks a
+ * read error.
+ *
+ * The holes of a regular file, as found by SEEK_DATA and SEEK_HOLE,
+ * are not read: a hole is handed to the caller as a full slot of len
+ * zero octets with no data, which the caller hashes without a buffer.
+ */
+struct fnv_reader_buf {
+    char *data;			/* aligned buffer */
+    ssize_t len;		/* octets in a full buffer, 0 ==> EOF */
+    int err;			/* errno when len < 0 */
+    int full;			/* 1 ==> owned by the caller */
+    int hole;			/* 1 ==> len zero octets of a hole, no data */
+};
+
+struct fnv_reader {
+    int fd;			/* file being read */
+    int nbuf;			/* number of ring buffers */
+    size_t bufsize;		/* size of each buffer */
+    struct fnv_reader_buf *buf;	/* ring of buffers */
+    int head;			/* next slot the reader thread fills */
+    int tail;			/* next slot the caller consumes */
+    int stop;			/* 1 ==> caller is done, reader must exit */
+    int done;			/* 1 ==> reader thread saw EOF or an error */
+    unsigned long long reads;	/* read(2) calls made */
+    int sparse;			/* 1 ==> skip the holes of a regular file */
+    off_t pos;			/* file offset of the next octet */
+    off_t end;			/* file size when the reader started */
+    off_t data;			/* start of the next data region */
+    off_t hole;			/* end of that data region */
+    pthread_t tid;		/* reader thread */
+    pthread_mutex_t lock;	/* protects all of the above */
+    pthread_cond_t filled;	/* signaled when a slot becomes full */
+    pthread_cond_t emptied;	/* signaled when a slot becomes empty */
+};
+
+
+/*
+ * find_data - find the next hole and data region of a sparse read
+ *
+ * Sets r->data and r->hole and positions the file at r->data, or turns
+ * hole skipping off past the initial EOF or when SEEK_DATA fails.
+ */
+static void
+find_data(struct fnv_reader *r)
+{
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    off_t data;			/* start of the next data region */
+    off_t hole;			/* end of the data region */
+
+    if (r->pos >= r->end) {
+	/* read whatever the file grew by */
+	r->sparse = 0;
+	return;
+    }
+    data = lseek(r->fd, r->pos, SEEK_DATA);
+    if (data < 0) {
+	if (errno != ENXIO) {
+	    /* SEEK_DATA is not supported, read the rest */
+	    r->sparse = 0;
+	    (void) lseek(r->fd, r->pos, SEEK_SET);
+	    return;
+	}
+	/* the rest of the file is a hole */
+	data = r->end;
+    }
+    hole = (data < r->end) ? lseek(r->fd, data, SEEK_HOLE) : r->end;
+    if (hole <= data || hole > r->end) {
+	hole = r->end;
+    }
+    r->data = data;
+    r->hole = hole;
+    if (lseek(r->fd, data, SEEK_SET) < 0) {
+	r->sparse = 0;
+	(void) lseek(r->fd, r->pos, SEEK_SET);
+    }
+#else /* SEEK_DATA && SEEK_HOLE */
+    r->sparse = 0;
+#endif /* SEEK_DATA && SEEK_HOLE */
+}
+
+
+/*
+ * reader_thread - fill ring buffers until EOF, error or stop
+ */
+static void *
+reader_thread(void *arg)
+{
+    struct fnv_reader *r = (struct fnv_reader *)arg;	/* reader */
+    struct fnv_reader_buf *b;	/* slot being filled */
+    ssize_t cnt;		/* octets read */
+    size_t len;			/* octets in the buffer so far */
+    size_t want;		/* octets to read into the buffer */
+    off_t n;			/* octets of a hole */
+    int hole;			/* 1 ==> the buffer is a hole */
+    int err;			/* errno of a failed read */
+    unsigned long long reads;	/* read(2) calls for this buffer */
+    struct stat st;		/* file status */
+
+    /*
+     * fnv_reader_finish() may cancel us, but only while we are in read(2)
+     * and do not hold the lock.
+     */
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    (void) posix_fadvise(r->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif /* POSIX_FADV_SEQUENTIAL */
+    if (fstat(r->fd, &st) == 0 && S_ISREG(st.st_mode)) {
+	r->pos = lseek(r->fd, 0, SEEK_CUR);
+	r->end = st.st_size;
+	r->data = r->pos;
+	r->hole = r->pos;
+	r->sparse = (r->pos >= 0);
+    }
+    for (;;) {
+
+	/* wait for the next slot to become empty */
+	pthread_mutex_lock(&r->lock);
+	b = &r->buf[r->head];
+	while (b->full && !r->stop) {
+	    pthread_cond_wait(&r->emptied, &r->lock);
+	}
+	if (r->stop) {
+	    pthread_mutex_unlock(&r->lock);
+	    break;
+	}
+	pthread_mutex_unlock(&r->lock);
+
+	/*
+	 * Fill the buffer without holding the lock.  Pipes and sockets
+	 * return short reads, so keep reading until the buffer is full
+	 * to hand the caller large buffers.
+	 */
+	len = 0;
+	err = 0;
+	reads = 0;
+	hole = 0;
+	want = r->bufsize;
+	if (r->sparse && r->pos >= r->hole) {
+	    find_data(r);
+	}
+	if (r->sparse && r->pos < r->data) {
+	    n = r->data - r->pos;
+	    if (n > SSIZE_MAX) {
+		n = SSIZE_MAX;
+	    }
+	    len = (size_t)n;
+	    hole = 1;
+	    want = 0;
+	    r->pos += n;
+	} else if (r->sparse && r->hole - r->pos < (off_t)want) {
+	    want = (size_t)(r->hole - r->pos);
+	}
+	while (len < want) {
+	    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+	    cnt = read(r->fd, b->data + len, want - len);
+	    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+	    ++reads;
+	    if (cnt < 0) {
+		if (errno == EINTR) {
+		    continue;
+		}
+		err = errno;
+		break;
+	    }
+	    if (cnt == 0) {
+		break;
+	    }
+	    len += (size_t)cnt;
+	    if (r->sparse) {
+		r->pos += cnt;
+	    }
+	}
+
+	/* hand the buffer to the caller */
+	pthread_mutex_lock(&r->lock);
+	r->reads += reads;
+	b->hole = hole;
+	if (len > 0) {
+	    b->len = (ssize_t)len;
+	} else if (err != 0) {
+	    b->len = -1;
+	    b->err = err;
+	} else {
+	    b->len = 0;
+	}
+	b->full = 1;
+	r->head = (r->head + 1) % r->nbuf;
+	pthread_cond_signal(&r->filled);
+	if (b->len <= 0) {
+	    r->done = 1;
+	    pthread_mutex_unlock(&r->lock);
+	    break;
+	}
+	/*
+	 * A read error after a partial buffer is reported with the
+	 * next buffer.
+	 */
+	if (err != 0) {
+	    b = &r->buf[r->head];
+	    while (b->full && !r->stop) {
+		pthread_cond_wait(&r->emptied, &r->lock);
+	    }
+	    if (!r->stop) {
+		b->len = -1;
+		b->err = err;
+		b->full = 1;
+		r->head = (r->head + 1) % r->nbuf;
+		pthread_cond_signal(&r->filled);
+	    }
+	    r->done = 1;
+	    pthread_mutex_unlock(&r->lock);
+	    break;
+	}
+	pthread_mutex_unlock(&r->lock);
+    }
+    return NULL;
+}
+
+
+/*
+ * fnv_reader_start - start a reader thread on an open file
+ *
+ * given:
+ *	fd	open file to read until EOF
+ *	nbuf	number of ring buffers, >= 2
+ *	bufsize	size of each buffer in octets, > 0
+ *
+ * returns:
+ *	reader or NULL on error (with errno set)
+ *
+ * While the caller hashes one buffer, the reader thread fills the
+ * others, so that hashing a file takes about the greater of the read
+ * time and the hash time instead of their sum.
+ */
+struct fnv_reader *
+fnv_reader_start(int fd, int nbuf, size_t bufsize)
+{
+    struct fnv_reader *r;	/* new reader */
+    void *p;			/* aligned buffer */
+    int ret;			/* pthread return */
+    int i;
+
+    if (nbuf < 2 || bufsize == 0) {
+	errno = EINVAL;
+	return NULL;
+    }
+    r = calloc(1, sizeof(*r));
+    if (r == NULL) {
+	return NULL;
+    }
+    r->buf = calloc((size_t)nbuf, sizeof(r->buf[0]));
+    if (r->buf == NULL) {
+	free(r);
+	return NULL;
+    }
+    r->fd = fd;
+    r->nbuf = nbuf;
+    r->bufsize = bufsize;
+    for (i = 0; i < nbuf; ++i) {
+	if (posix_memalign(&p, FNV_READER_ALIGN, bufsize) != 0) {
+	    while (--i >= 0) {
+		free(r->buf[i].data);
+	    }
+	    free(r->buf);
+	    free(r);
+	    errno = ENOMEM;
+	    return NULL;
+	}
+	r->buf[i].data = (char *)p;
+    }
+    pthread_mutex_init(&r->lock, NULL);
+    pthread_cond_init(&r->filled, NULL);
+    pthread_cond_init(&r->emptied, NULL);
+    ret = pthread_create(&r->tid, NULL, reader_thread, r);
+    if (ret != 0) {
+	for (i = 0; i < nbuf; ++i) {
+	    free(r->buf[i].data);
+	}
+	pthread_mutex_destroy(&r->lock);
+	pthread_cond_destroy(&r->filled);
+	pthread_cond_destroy(&r->emptied);
+	free(r->buf);
+	free(r);
+	errno = ret;
+	return NULL;
+    }
+    return r;
+}
+
+
+/*
+ * fnv_reader_next - wait for the next full buffer
+ *
+ * given:
+ *	r	reader
+ *	data	where to store the start of the buffer
+ *
+ * returns:
+ *	> 0 ==> octets in *data, call fnv_reader_release() when done with it
+ *		(*data is NULL for a hole of that many zero octets)
+ *	0 ==> EOF
+ *	-1 ==> read error, errno set
+ */
+ssize_t
+fnv_reader_next(struct fnv_reader *r, char **data)
+{
+    struct fnv_reader_buf *b;	/* next slot to consume */
+    ssize_t len;		/* octets in the slot */
+
+    pthread_mutex_lock(&r->lock);
+    b = &r->buf[r->tail];
+    while (!b->full) {
+	pthread_cond_wait(&r->filled, &r->lock);
+    }
+    len = b->len;
+    if (len < 0) {
+	errno = b->err;
+    }
+    pthread_mutex_unlock(&r->lock);
+    *data = b->hole ? NULL : b->data;
+    return len;
+}
+
+
+/*
+ * fnv_reader_release - return the buffer from fnv_reader_next() to the ring
+ */
+void
+fnv_reader_release(struct fnv_reader *r)
+{
+    pthread_mutex_lock(&r->lock);
+    r->buf[r->tail].full = 0;
+    r->tail = (r->tail + 1) % r->nbuf;
+    pthread_cond_signal(&r->emptied);
+    pthread_mutex_unlock(&r->lock);
+}
+
+
+/*
+ * fnv_reader_finish - stop the reader thread and free the reader
+ *
+ * given:
+ *	r	reader
+ *
+ * returns:
+ *	number of read(2) calls made by the reader thread
+ *
+ * When called before EOF was returned, the reader thread is cancelled
+ * and the file offset of fd is undefined.
+ */
+unsigned long long
+fnv_reader_finish(struct fnv_reader *r)
+{
+    unsigned long long reads;	/* read(2) calls */
+    int i;
+
+    pthread_mutex_lock(&r->lock);
+    r->stop = 1;
+    pthread_cond_broadcast(&r->emptied);
+    if (!r->done) {
+	/* the reader thread may be blocked in read(2) */
+	pthread_cancel(r->tid);
+    }
+    pthread_mutex_unlock(&r->lock);
+    pthread_join(r->tid, NULL);
+    reads = r->reads;
+    for (i = 0; i < r->nbuf; ++i) {
+	free(r->buf[i].data);
+    }
+    pthread_mutex_destroy(&r->lock);
+    pthread_cond_destroy(&r->filled);
+    pthread_cond_destroy(&r->emptied);
+    free(r->buf);
+    free(r);
+    return reads;
+}
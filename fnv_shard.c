@@ -0,0 +1,569 @@
+/*
+ * fnv_shard - consistent hashing of keys to nodes with FNV-1a 64
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * Consistent hashing: map keys to a changing set of nodes so that
+ * adding or removing a node moves few keys, unlike hval % n, which
+ * moves almost all of them.
+ *
+ * Three methods are offered behind one set of nodes:
+ *
+ * FNV_SHARD_JUMP	Lamping and Veach jump consistent hash.  No memory,
+ *			O(log n) time and a near perfect balance, but the
+ *			nodes are numbered 0 .. n-1: only removing the last
+ *			node added moves as few keys as possible, and
+ *			weights are ignored.
+ *
+ * FNV_SHARD_HRW	weighted rendezvous (highest random weight) hash.
+ *			Each node scores a key with -w / ln(u), u the hash
+ *			of the key and node in (0, 1), and the highest
+ *			score wins.  Any node may be added or removed and
+ *			weights are exact, but a lookup is O(n).
+ *
+ * FNV_SHARD_RING	a ring of virtual nodes: each node of weight w
+ *			has about vnodes * w points on a 64 bit circle,
+ *			and a key goes to the node of the first point at
+ *			or after its hash.  A lookup is a binary search,
+ *			O(log n), and the balance improves with vnodes.
+ *
+ * Keys and node names are hashed with fnv_64a_mix().  A node is known
+ * by its name and by the id that fnv_shard_add() returned.  A removed
+ * node keeps its id, and adding its name again brings it back with the
+ * same id and the same ring points.
+ */
+#define SHARD_BATCH 64		/* keys routed at once by a batch lookup */
+#define SHARD_GOLDEN 0x9e3779b97f4a7c15ULL	/* 2^64 / phi */
+
+struct shard_node {
+    char *name;			/* node name */
+    double weight;		/* relative weight, > 0 */
+    unsigned long long seed;	/* hash of name */
+    int live;			/* 1 ==> node is in the set */
+};
+
+struct ring_point {
+    unsigned long long point;	/* position on the ring */
+    int node;			/* node id */
+};
+
+struct fnv_shard {
+    enum fnv_shard_type type;	/* consistent hash method */
+    unsigned int vnodes;	/* ring points of a node of weight 1 */
+    struct shard_node *node;	/* nodes by id */
+    int nnode;			/* node ids used */
+    int maxnode;		/* node ids allocated */
+    int *live;			/* ids of live nodes, in order added */
+    int nlive;			/* number of live nodes */
+    struct ring_point *ring;	/* ring points, sorted */
+    size_t nring;		/* number of ring points */
+};
+
+
+/*
+ * jump - Lamping and Veach jump consistent hash of a 64 bit key
+ */
+static int
+jump(unsigned long long h, int nbucket)
+{
+    long long b = -1;		/* bucket */
+    long long j = 0;		/* next bucket the key jumps to */
+
+    while (j < nbucket) {
+	b = j;
+	h = h * 2862933555777941757ULL + 1;
+	j = (long long)((double)(b + 1) *
+			((double)(1LL << 31) / (double)((h >> 33) + 1)));
+    }
+    return (int)b;
+}
+
+
+/*
+ * fnv_jump - jump consistent hash of a key
+ *
+ * input:
+ *	key	- key
+ *	len	- key length
+ *	nbucket	- number of buckets, > 0
+ *
+ * returns:
+ *	bucket 0 .. nbucket-1, or -1 ==> nbucket < 1
+ *
+ * Growing nbucket by one moves only 1 / (nbucket + 1) of the keys, all
+ * to the new bucket.
+ */
+int
+fnv_jump(const void *key, size_t len, int nbucket)
+{
+    if (nbucket < 1) {
+	return -1;
+    }
+    return jump(fnv_64a_mix(key, len, 0), nbucket);
+}
+
+
+/*
+ * fnv_shard_new - create an empty set of nodes
+ *
+ * input:
+ *	type	- consistent hash method
+ *	vnodes	- FNV_SHARD_RING points of a node of weight 1, 0 ==> 160
+ *
+ * returns:
+ *	new set, free with fnv_shard_free(), or NULL ==> error, errno set
+ */
+struct fnv_shard *
+fnv_shard_new(enum fnv_shard_type type, unsigned int vnodes)
+{
+    struct fnv_shard *s;	/* new set */
+
+    if (type != FNV_SHARD_JUMP && type != FNV_SHARD_HRW &&
+	type != FNV_SHARD_RING) {
+	errno = EINVAL;
+	return NULL;
+    }
+    s = calloc(1, sizeof(*s));
+    if (s == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    s->type = type;
+    s->vnodes = (vnodes > 0) ? vnodes : 160;
+    return s;
+}
+
+
+/*
+ * fnv_shard_free - free a set of nodes
+ */
+void
+fnv_shard_free(struct fnv_shard *s)
+{
+    int i;
+
+    if (s == NULL) {
+	return;
+    }
+    for (i = 0; i < s->nnode; ++i) {
+	free(s->node[i].name);
+    }
+    free(s->node);
+    free(s->live);
+    free(s->ring);
+    free(s);
+}
+
+
+/*
+ * cmp_point - qsort() order of ring points
+ */
+static int
+cmp_point(const void *a, const void *b)
+{
+    const struct ring_point *x = a;	/* first point */
+    const struct ring_point *y = b;	/* second point */
+
+    if (x->point != y->point) {
+	return (x->point > y->point) ? 1 : -1;
+    }
+    return x->node - y->node;
+}
+
+
+/*
+ * ring_points - number of ring points of a node
+ */
+static size_t
+ring_points(struct fnv_shard *s, struct shard_node *n)
+{
+    double v = (double)s->vnodes * n->weight + 0.5;	/* points wanted */
+
+    return (v < 1.0) ? 1 : (size_t)v;
+}
+
+
+/*
+ * build_ring - place the points of the live nodes on the ring
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+build_ring(struct fnv_shard *s)
+{
+    struct ring_point *ring;	/* new ring */
+    struct shard_node *n;	/* a live node */
+    size_t nring = 0;		/* points in ring */
+    size_t np;			/* points of n */
+    size_t j;
+    int i;
+
+    for (i = 0; i < s->nlive; ++i) {
+	nring += ring_points(s, &s->node[s->live[i]]);
+    }
+    ring = malloc((nring > 0 ? nring : 1) * sizeof(ring[0]));
+    if (ring == NULL) {
+	return -1;
+    }
+    for (i = 0, nring = 0; i < s->nlive; ++i) {
+	n = &s->node[s->live[i]];
+	np = ring_points(s, n);
+	for (j = 0; j < np; ++j, ++nring) {
+	    ring[nring].point = fnv_mix64(n->seed + (j + 1) * SHARD_GOLDEN);
+	    ring[nring].node = s->live[i];
+	}
+    }
+    qsort(ring, nring, sizeof(ring[0]), cmp_point);
+    free(s->ring);
+    s->ring = ring;
+    s->nring = nring;
+    return 0;
+}
+
+
+/*
+ * find_node - id of the node with a name, or -1
+ */
+static int
+find_node(struct fnv_shard *s, const char *name)
+{
+    int i;
+
+    for (i = 0; i < s->nnode; ++i) {
+	if (strcmp(s->node[i].name, name) == 0) {
+	    return i;
+	}
+    }
+    return -1;
+}
+
+
+/*
+ * fnv_shard_add - add a node
+ *
+ * input:
+ *	s	- set of nodes
+ *	name	- node name
+ *	weight	- relative share of the keys, > 0 (FNV_SHARD_JUMP: ignored)
+ *
+ * returns:
+ *	node id >= 0, or -1 ==> error (errno EINVAL, EEXIST or ENOMEM)
+ */
+int
+fnv_shard_add(struct fnv_shard *s, const char *name, double weight)
+{
+    struct shard_node *n;	/* new node */
+    int *live;			/* grown live list */
+    int id;			/* node id */
+
+    if (!(weight > 0.0)) {
+	errno = EINVAL;
+	return -1;
+    }
+    id = find_node(s, name);
+    if (id >= 0 && s->node[id].live) {
+	errno = EEXIST;
+	return -1;
+    }
+    if (id < 0 && s->nnode == s->maxnode) {
+	n = realloc(s->node, (size_t)(s->maxnode + 16) * sizeof(n[0]));
+	if (n == NULL) {
+	    errno = ENOMEM;
+	    return -1;
+	}
+	s->node = n;
+	live = realloc(s->live, (size_t)(s->maxnode + 16) * sizeof(live[0]));
+	if (live == NULL) {
+	    errno = ENOMEM;
+	    return -1;
+	}
+	s->live = live;
+	s->maxnode += 16;
+    }
+    if (id < 0) {
+	id = s->nnode;
+	n = &s->node[id];
+	n->name = strdup(name);
+	if (n->name == NULL) {
+	    errno = ENOMEM;
+	    return -1;
+	}
+	n->seed = fnv_64a_mix(name, strlen(name), 0);
+	++s->nnode;
+    }
+    n = &s->node[id];
+    n->weight = weight;
+    n->live = 1;
+    s->live[s->nlive++] = id;
+    if (s->type == FNV_SHARD_RING && build_ring(s) < 0) {
+	n->live = 0;
+	--s->nlive;
+	errno = ENOMEM;
+	return -1;
+    }
+    return id;
+}
+
+
+/*
+ * fnv_shard_del - remove a node
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error (errno ENOENT or ENOMEM)
+ *
+ * Only the keys of the removed node move, except with FNV_SHARD_JUMP,
+ * where the nodes added after it shift down by one bucket.
+ */
+int
+fnv_shard_del(struct fnv_shard *s, const char *name)
+{
+    int id;			/* node id */
+    int i;
+
+    id = find_node(s, name);
+    if (id < 0 || !s->node[id].live) {
+	errno = ENOENT;
+	return -1;
+    }
+    s->node[id].live = 0;
+    for (i = 0; s->live[i] != id; ++i) {
+    }
+    memmove(&s->live[i], &s->live[i+1],
+	    (size_t)(s->nlive - i - 1) * sizeof(s->live[0]));
+    --s->nlive;
+    if (s->type == FNV_SHARD_RING && build_ring(s) < 0) {
+	errno = ENOMEM;
+	return -1;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_shard_name - name of a node id, or NULL
+ */
+const char *
+fnv_shard_name(struct fnv_shard *s, int id)
+{
+    if (id < 0 || id >= s->nnode) {
+	return NULL;
+    }
+    return s->node[id].name;
+}
+
+
+/*
+ * fnv_shard_ids - number of node ids ever returned, live or removed
+ */
+int
+fnv_shard_ids(struct fnv_shard *s)
+{
+    return s->nnode;
+}
+
+
+/*
+ * hrw_u - map a hash to a uniform value in (0, 1)
+ */
+static double
+hrw_u(unsigned long long h)
+{
+    return ((double)(h >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+
+/*
+ * route - node of a finalized key hash
+ */
+static int
+route(struct fnv_shard *s, unsigned long long h)
+{
+    struct shard_node *n;	/* a live node */
+    double best = -1.0;		/* highest HRW score */
+    double score;		/* HRW score of n */
+    int id = -1;		/* best node */
+    size_t lo;			/* first ring point that may follow h */
+    size_t hi;			/* beyond the last */
+    size_t mid;			/* point being compared */
+    int i;
+
+    if (s->nlive == 0) {
+	return -1;
+    }
+    switch (s->type) {
+    case FNV_SHARD_JUMP:
+	return s->live[jump(h, s->nlive)];
+    case FNV_SHARD_HRW:
+	for (i = 0; i < s->nlive; ++i) {
+	    n = &s->node[s->live[i]];
+	    score = -n->weight / log(hrw_u(fnv_mix64(h ^ n->seed)));
+	    if (score > best) {
+		best = score;
+		id = s->live[i];
+	    }
+	}
+	return id;
+    case FNV_SHARD_RING:
+    default:
+	for (lo = 0, hi = s->nring; lo < hi; ) {
+	    mid = lo + (hi - lo) / 2;
+	    if (s->ring[mid].point < h) {
+		lo = mid + 1;
+	    } else {
+		hi = mid;
+	    }
+	}
+	return s->ring[(lo < s->nring) ? lo : 0].node;
+    }
+}
+
+
+/*
+ * fnv_shard_lookup - node of a key
+ *
+ * returns:
+ *	node id, or -1 ==> no live nodes
+ */
+int
+fnv_shard_lookup(struct fnv_shard *s, const void *key, size_t len)
+{
+    return route(s, fnv_64a_mix(key, len, 0));
+}
+
+
+/*
+ * fnv_shard_lookup_batch - nodes of many keys
+ *
+ * input:
+ *	s	- set of nodes
+ *	n	- number of keys
+ *	key	- the keys
+ *	len	- length of each key
+ *	out	- where to store the node id of each key, -1 ==> no nodes
+ *
+ * The keys are hashed SHARD_BATCH at a time before any is routed.  With
+ * FNV_SHARD_HRW each node scores the whole batch in turn, so the inner
+ * loop runs over keys with the node fixed.
+ */
+void
+fnv_shard_lookup_batch(struct fnv_shard *s, size_t n,
+		       const void * const *key, const size_t *len, int *out)
+{
+    unsigned long long h[SHARD_BATCH];	/* key hashes */
+    double best[SHARD_BATCH];	/* highest HRW score of each key */
+    struct shard_node *nd;	/* a live node */
+    double score;		/* HRW score */
+    size_t b;			/* first key of batch */
+    size_t m;			/* keys in batch */
+    size_t i;
+    int j;
+
+    for (b = 0; b < n; b += m) {
+	m = (n - b < SHARD_BATCH) ? n - b : SHARD_BATCH;
+	for (i = 0; i < m; ++i) {
+	    h[i] = fnv_64a_mix(key[b+i], len[b+i], 0);
+	}
+	if (s->type != FNV_SHARD_HRW || s->nlive == 0) {
+	    for (i = 0; i < m; ++i) {
+		out[b+i] = route(s, h[i]);
+	    }
+	    continue;
+	}
+	for (i = 0; i < m; ++i) {
+	    best[i] = -1.0;
+	}
+	for (j = 0; j < s->nlive; ++j) {
+	    nd = &s->node[s->live[j]];
+	    for (i = 0; i < m; ++i) {
+		score = -nd->weight / log(hrw_u(fnv_mix64(h[i] ^ nd->seed)));
+		if (score > best[i]) {
+		    best[i] = score;
+		    out[b+i] = s->live[j];
+		}
+	    }
+	}
+    }
+}
@@ -0,0 +1,666 @@
+/*
+ * fnv_sidecar - per-block FNV hash sidecar files
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "fnv.h"
+
+
+/*
+ * A sidecar file is a FNV_SIDECAR_HDR_SIZE octet header followed by
+ * one 8 octet hash per block.  All integers are little endian:
+ *
+ *	octets 0-7	FNV_SIDECAR_MAGIC
+ *	octet 8		hash type (enum fnv_type, a 64 bit type)
+ *	octets 9-15	reserved, 0
+ *	octets 16-23	block size in octets
+ *	octets 24-31	file size in octets
+ *	octets 32-39	file modification time, seconds
+ *	octets 40-43	file modification time, nanoseconds
+ *	octets 44-47	reserved, 0
+ *	octets 48-55	hash of the whole file
+ *	octets 56-59	FNV-1a 32 bit hash of octets 0-55 and the block hashes
+ *	octets 60-63	reserved, 0
+ *
+ * Each block is hashed independently starting with the initial basis
+ * of the hash type.  There are ceil(file size / block size) blocks, the
+ * last of which may be short.
+ */
+#define FNV_SIDECAR_MAGIC "FNVblk\0\1"	/* 8 octet magic, format version 1 */
+#define FNV_SIDECAR_HDR_SIZE 64		/* octets in the header */
+#define FNV_SIDECAR_BUF_SIZE (256*1024)	/* octets to read at a time */
+
+
+/*
+ * verify_job - the blocks one verify thread checks
+ */
+struct verify_job {
+    int fd;			/* open file to verify */
+    struct fnv_sidecar *sc;	/* sidecar to verify against */
+    off_t first;		/* first block to check */
+    off_t last;			/* beyond the last block to check */
+    unsigned char *bad;		/* 1 ==> block mismatch, or NULL */
+    off_t nbad;			/* number of mismatched blocks */
+    int err;			/* errno of a read error, or 0 */
+};
+
+
+/*
+ * put_le - store a value as 8 little endian octets
+ */
+static void
+put_le(unsigned char *buf, off_t val)
+{
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+	buf[i] = (unsigned char)(val & 0xff);
+	val >>= 8;
+    }
+}
+
+
+/*
+ * get_le - load a value from 8 little endian octets
+ */
+static off_t
+get_le(unsigned char *buf)
+{
+    off_t val = 0;
+    int i;
+
+    for (i = 7; i >= 0; --i) {
+	val = (val << 8) | buf[i];
+    }
+    return val;
+}
+
+
+/*
+ * put_hash - store a hash value as 8 little endian octets
+ */
+static void
+put_hash(unsigned char *buf, Fnv64_t hval)
+{
+    int i;
+
+#if defined(HAVE_64BIT_LONG_LONG)
+    for (i = 0; i < 8; ++i) {
+	buf[i] = (unsigned char)(hval >> (8*i));
+    }
+#else /* HAVE_64BIT_LONG_LONG */
+    for (i = 0; i < 4; ++i) {
+	buf[i] = (unsigned char)(hval.w32[0] >> (8*i));
+	buf[4+i] = (unsigned char)(hval.w32[1] >> (8*i));
+    }
+#endif /* HAVE_64BIT_LONG_LONG */
+}
+
+
+/*
+ * get_hash - load a hash value from 8 little endian octets
+ */
+static Fnv64_t
+get_hash(unsigned char *buf)
+{
+    Fnv64_t hval;		/* hash value */
+    int i;
+
+#if defined(HAVE_64BIT_LONG_LONG)
+    hval = 0;
+    for (i = 7; i >= 0; --i) {
+	hval = (hval << 8) | buf[i];
+    }
+#else /* HAVE_64BIT_LONG_LONG */
+    hval.w32[0] = 0;
+    hval.w32[1] = 0;
+    for (i = 3; i >= 0; --i) {
+	hval.w32[0] = (hval.w32[0] << 8) | buf[i];
+	hval.w32[1] = (hval.w32[1] << 8) | buf[4+i];
+    }
+#endif /* HAVE_64BIT_LONG_LONG */
+    return hval;
+}
+
+
+/*
+ * init_hval - initial basis of a 64 bit hash type
+ */
+static Fnv64_t
+init_hval(enum fnv_type type)
+{
+    switch (type) {
+    case FNV1_64:
+	return FNV1_64_INIT;
+    case FNV1a_64:
+	return FNV1A_64_INIT;
+    default:
+	break;
+    }
+    return FNV0_64_INIT;
+}
+
+
+/*
+ * same_hash - compare two hash values
+ */
+static int
+same_hash(Fnv64_t a, Fnv64_t b)
+{
+#if defined(HAVE_64BIT_LONG_LONG)
+    return a == b;
+#else /* HAVE_64BIT_LONG_LONG */
+    return a.w32[0] == b.w32[0] && a.w32[1] == b.w32[1];
+#endif /* HAVE_64BIT_LONG_LONG */
+}
+
+
+/*
+ * fnv_sidecar_create - hash a file into per-block and whole file hashes
+ *
+ * input:
+ *	fd	- open regular file, read from its start with pread(2)
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	blksize	- block size in octets, > 0
+ *	sc	- where to store the sidecar, free with fnv_sidecar_free()
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ *
+ * The file is read once.  Each buffer is hashed into the current block
+ * hash and into the whole file hash, so the whole file hash is the
+ * same as that of fnv_64_buf() or fnv_64a_buf() on the entire file.
+ */
+int
+fnv_sidecar_create(int fd, enum fnv_type type, off_t blksize,
+		   struct fnv_sidecar *sc)
+{
+    struct stat st;		/* file status */
+    char *buf;			/* read buffer */
+    off_t pos = 0;		/* octets hashed */
+    off_t blk;			/* current block */
+    Fnv64_t bval;		/* current block hash */
+    size_t want;		/* octets to read */
+    ssize_t cnt;		/* octets read */
+    int err;			/* saved errno */
+
+    memset(sc, 0, sizeof(*sc));
+    if (type < FNV0_64 || type > FNV1a_64 || blksize <= 0) {
+	errno = EINVAL;
+	return -1;
+    }
+    if (fstat(fd, &st) < 0) {
+	return -1;
+    }
+    if (!S_ISREG(st.st_mode)) {
+	errno = EINVAL;
+	return -1;
+    }
+    sc->type = type;
+    sc->blksize = blksize;
+    sc->size = st.st_size;
+    sc->mtime = st.st_mtime;
+#if defined(__APPLE__)
+    sc->mtime_nsec = st.st_mtimespec.tv_nsec;
+#else /* __APPLE__ */
+    sc->mtime_nsec = st.st_mtim.tv_nsec;
+#endif /* __APPLE__ */
+    sc->nblock = (st.st_size + blksize - 1) / blksize;
+    sc->hval = init_hval(type);
+    sc->block = malloc((sc->nblock > 0 ? (size_t)sc->nblock : 1) *
+		       sizeof(Fnv64_t));
+    buf = malloc(FNV_SIDECAR_BUF_SIZE);
+    if (sc->block == NULL || buf == NULL) {
+	free(buf);
+	fnv_sidecar_free(sc);
+	errno = ENOMEM;
+	return -1;
+    }
+
+    /*
+     * hash each block and the whole file
+     */
+    for (blk = 0; blk < sc->nblock; ++blk) {
+	off_t end = pos + blksize;	/* beyond the end of this block */
+
+	if (end > sc->size) {
+	    end = sc->size;
+	}
+	bval = init_hval(type);
+	while (pos < end) {
+	    want = (end - pos < FNV_SIDECAR_BUF_SIZE) ?
+		   (size_t)(end - pos) : FNV_SIDECAR_BUF_SIZE;
+	    cnt = pread(fd, buf, want, pos);
+	    if (cnt < 0 && errno == EINTR) {
+		continue;
+	    }
+	    if (cnt <= 0) {
+		/* a read error, or the file shrank while we read it */
+		err = (cnt < 0) ? errno : EIO;
+		free(buf);
+		fnv_sidecar_free(sc);
+		errno = err;
+		return -1;
+	    }
+	    bval = fnv_buf_64(type, buf, (size_t)cnt, bval);
+	    sc->hval = fnv_buf_64(type, buf, (size_t)cnt, sc->hval);
+	    pos += cnt;
+	}
+	sc->block[blk] = bval;
+    }
+    free(buf);
+    return 0;
+}
+
+
+/*
+ * fnv_sidecar_write - atomically write a sidecar file
+ *
+ * input:
+ *	sc	- sidecar from fnv_sidecar_create()
+ *	path	- file to write
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ *
+ * The sidecar is written to path.tmp, flushed to stable storage and
+ * renamed over path.
+ */
+int
+fnv_sidecar_write(struct fnv_sidecar *sc, char *path)
+{
+    unsigned char hdr[FNV_SIDECAR_HDR_SIZE];	/* header */
+    unsigned char ent[8];	/* one block hash */
+    Fnv32_t sum;		/* checksum */
+    char *tmp;			/* temporary file name */
+    FILE *f;			/* open temporary file */
+    off_t blk;			/* current block */
+    int err;			/* saved errno */
+
+    /*
+     * form the header and checksum
+     */
+    memset(hdr, 0, sizeof(hdr));
+    memcpy(hdr, FNV_SIDECAR_MAGIC, 8);
+    hdr[8] = (unsigned char)sc->type;
+    put_le(hdr+16, sc->blksize);
+    put_le(hdr+24, sc->size);
+    put_le(hdr+32, (off_t)sc->mtime);
+    put_le(hdr+40, (off_t)sc->mtime_nsec);
+    memset(hdr+44, 0, 4);
+    put_hash(hdr+48, sc->hval);
+    sum = fnv_32a_buf(hdr, 56, FNV1_32A_INIT);
+    for (blk = 0; blk < sc->nblock; ++blk) {
+	put_hash(ent, sc->block[blk]);
+	sum = fnv_32a_buf(ent, sizeof(ent), sum);
+    }
+    hdr[56] = (unsigned char)sum;
+    hdr[57] = (unsigned char)(sum >> 8);
+    hdr[58] = (unsigned char)(sum >> 16);
+    hdr[59] = (unsigned char)(sum >> 24);
+
+    /*
+     * write the temporary file
+     */
+    tmp = malloc(strlen(path) + sizeof(".tmp"));
+    if (tmp == NULL) {
+	return -1;
+    }
+    sprintf(tmp, "%s.tmp", path);
+    f = fopen(tmp, "w");
+    if (f == NULL) {
+	err = errno;
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    errno = 0;
+    if (fwrite(hdr, sizeof(hdr), 1, f) != 1) {
+	goto fail;
+    }
+    for (blk = 0; blk < sc->nblock; ++blk) {
+	put_hash(ent, sc->block[blk]);
+	if (fwrite(ent, sizeof(ent), 1, f) != 1) {
+	    goto fail;
+	}
+    }
+    if (fflush(f) != 0 || fsync(fileno(f)) < 0) {
+	goto fail;
+    }
+    if (fclose(f) != 0) {
+	f = NULL;
+	goto fail;
+    }
+    f = NULL;
+    if (rename(tmp, path) < 0) {
+	goto fail;
+    }
+    free(tmp);
+    return 0;
+
+fail:
+    err = (errno != 0) ? errno : EIO;
+    if (f != NULL) {
+	fclose(f);
+    }
+    unlink(tmp);
+    free(tmp);
+    errno = err;
+    return -1;
+}
+
+
+/*
+ * fnv_sidecar_read - read a sidecar file
+ *
+ * input:
+ *	sc	- where to store the sidecar, free with fnv_sidecar_free()
+ *	path	- file written by fnv_sidecar_write()
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set (EINVAL ==> not a valid sidecar)
+ */
+int
+fnv_sidecar_read(struct fnv_sidecar *sc, char *path)
+{
+    unsigned char hdr[FNV_SIDECAR_HDR_SIZE];	/* header */
+    unsigned char ent[8];	/* one block hash */
+    Fnv32_t sum;		/* checksum */
+    FILE *f;			/* open sidecar file */
+    off_t blk;			/* current block */
+
+    memset(sc, 0, sizeof(*sc));
+    f = fopen(path, "r");
+    if (f == NULL) {
+	return -1;
+    }
+    if (fread(hdr, sizeof(hdr), 1, f) != 1 ||
+	memcmp(hdr, FNV_SIDECAR_MAGIC, 8) != 0 ||
+	hdr[8] < FNV0_64 || hdr[8] > FNV1a_64) {
+	goto invalid;
+    }
+    sc->type = (enum fnv_type)hdr[8];
+    sc->blksize = get_le(hdr+16);
+    sc->size = get_le(hdr+24);
+    sc->mtime = (time_t)get_le(hdr+32);
+    sc->mtime_nsec = (long)(get_le(hdr+40) & 0xffffffff);
+    sc->hval = get_hash(hdr+48);
+    if (sc->blksize <= 0 || sc->size < 0) {
+	goto invalid;
+    }
+    sc->nblock = (sc->size + sc->blksize - 1) / sc->blksize;
+    sc->block = malloc((sc->nblock > 0 ? (size_t)sc->nblock : 1) *
+		       sizeof(Fnv64_t));
+    if (sc->block == NULL) {
+	fclose(f);
+	errno = ENOMEM;
+	return -1;
+    }
+    sum = fnv_32a_buf(hdr, 56, FNV1_32A_INIT);
+    for (blk = 0; blk < sc->nblock; ++blk) {
+	if (fread(ent, sizeof(ent), 1, f) != 1) {
+	    goto invalid;
+	}
+	sum = fnv_32a_buf(ent, sizeof(ent), sum);
+	sc->block[blk] = get_hash(ent);
+    }
+    if (getc(f) != EOF ||
+	sum != ((Fnv32_t)hdr[56] | ((Fnv32_t)hdr[57] << 8) |
+		((Fnv32_t)hdr[58] << 16) | ((Fnv32_t)hdr[59] << 24))) {
+	goto invalid;
+    }
+    fclose(f);
+    return 0;
+
+invalid:
+    fclose(f);
+    fnv_sidecar_free(sc);
+    errno = EINVAL;
+    return -1;
+}
+
+
+/*
+ * fnv_sidecar_free - free the block hashes of a sidecar
+ */
+void
+fnv_sidecar_free(struct fnv_sidecar *sc)
+{
+    free(sc->block);
+    sc->block = NULL;
+    sc->nblock = 0;
+}
+
+
+/*
+ * verify_blocks - check a run of blocks, the body of a verify thread
+ */
+static void *
+verify_blocks(void *arg)
+{
+    struct verify_job *job = (struct verify_job *)arg;	/* our blocks */
+    struct fnv_sidecar *sc = job->sc;	/* sidecar to verify against */
+    char *buf;			/* read buffer */
+    off_t blk;			/* current block */
+
+    buf = malloc(FNV_SIDECAR_BUF_SIZE);
+    if (buf == NULL) {
+	job->err = ENOMEM;
+	return NULL;
+    }
+    for (blk = job->first; blk < job->last; ++blk) {
+	off_t pos = blk * sc->blksize;	/* next octet to hash */
+	off_t end = pos + sc->blksize;	/* beyond the end of this block */
+	Fnv64_t bval = init_hval(sc->type);	/* block hash */
+	ssize_t cnt;		/* octets read */
+
+	if (end > sc->size) {
+	    end = sc->size;
+	}
+	while (pos < end) {
+	    cnt = pread(job->fd, buf, (end - pos < FNV_SIDECAR_BUF_SIZE) ?
+				      (size_t)(end - pos) :
+				      FNV_SIDECAR_BUF_SIZE, pos);
+	    if (cnt < 0) {
+		if (errno == EINTR) {
+		    continue;
+		}
+		job->err = errno;
+		free(buf);
+		return NULL;
+	    }
+	    if (cnt == 0) {
+		/* the file is now shorter, so this block differs */
+		break;
+	    }
+	    bval = fnv_buf_64(sc->type, buf, (size_t)cnt, bval);
+	    pos += cnt;
+	}
+	if (pos < end || !same_hash(bval, sc->block[blk])) {
+	    ++job->nbad;
+	    if (job->bad != NULL) {
+		job->bad[blk] = 1;
+	    }
+	}
+    }
+    free(buf);
+    return NULL;
+}
+
+
+/*
+ * fnv_sidecar_verify - check a byte range of a file against a sidecar
+ *
+ * input:
+ *	fd	- open file to verify, read with pread(2)
+ *	sc	- sidecar from fnv_sidecar_read()
+ *	offset	- first octet of the range
+ *	length	- length of the range in octets, < 0 ==> until the end
+ *	nthread	- number of threads to check blocks with, < 1 ==> 1
+ *	bad	- NULL, or sc->nblock flags set to 1 for each mismatched block
+ *
+ * returns:
+ *	number of mismatched blocks, or -1 ==> error, errno set
+ *
+ * Every block that overlaps the range is read and hashed in full.  The
+ * blocks are divided into nthread contiguous runs that are checked
+ * concurrently.  A block that the file no longer covers is a mismatch.
+ */
+off_t
+fnv_sidecar_verify(int fd, struct fnv_sidecar *sc, off_t offset,
+		   off_t length, int nthread, unsigned char *bad)
+{
+    struct verify_job *job;	/* per thread work */
+    pthread_t *tid;		/* thread ids */
+    off_t first;		/* first block in the range */
+    off_t last;			/* beyond the last block in the range */
+    off_t per;			/* blocks per thread */
+    off_t nbad = 0;		/* mismatched blocks */
+    int err = 0;		/* first error */
+    int i;
+
+    if (offset < 0) {
+	errno = EINVAL;
+	return -1;
+    }
+    first = offset / sc->blksize;
+    if (length < 0 || offset + length > sc->size) {
+	last = sc->nblock;
+    } else if (length == 0) {
+	last = first;
+    } else {
+	last = (offset + length + sc->blksize - 1) / sc->blksize;
+    }
+    if (first >= last) {
+	return 0;
+    }
+    if (nthread < 1) {
+	nthread = 1;
+    }
+    if ((off_t)nthread > last - first) {
+	nthread = (int)(last - first);
+    }
+    job = calloc((size_t)nthread, sizeof(*job));
+    tid = calloc((size_t)nthread, sizeof(*tid));
+    if (job == NULL || tid == NULL) {
+	free(job);
+	free(tid);
+	errno = ENOMEM;
+	return -1;
+    }
+
+    /*
+     * give each thread a contiguous run of blocks
+     */
+    per = (last - first + nthread - 1) / nthread;
+    for (i = 0; i < nthread; ++i) {
+	job[i].fd = fd;
+	job[i].sc = sc;
+	job[i].first = first + i * per;
+	job[i].last = (job[i].first + per < last) ? job[i].first + per : last;
+	job[i].bad = bad;
+	if (i > 0 && pthread_create(&tid[i], NULL, verify_blocks,
+				    &job[i]) != 0) {
+	    /* check this run ourselves */
+	    verify_blocks(&job[i]);
+	    job[i].fd = -1;
+	}
+    }
+    verify_blocks(&job[0]);
+    for (i = 0; i < nthread; ++i) {
+	if (i > 0 && job[i].fd >= 0) {
+	    pthread_join(tid[i], NULL);
+	}
+	nbad += job[i].nbad;
+	if (err == 0) {
+	    err = job[i].err;
+	}
+    }
+    free(job);
+    free(tid);
+    if (err != 0) {
+	errno = err;
+	return -1;
+    }
+    return nbad;
+}
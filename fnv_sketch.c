@@ -0,0 +1,673 @@
+/*
+ * fnv_sketch - count-min sketch and Space-Saving top-K keyed by FNV-1a
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * count-min sketch
+ *
+ * depth rows of width counters, width a power of 2.  A key is hashed
+ * once with fnv_64a_mix(), and its counter in row i is given by the top
+ * bits of hash * seed[i] (multiply-shift hashing), where seed[i] is the
+ * fnv_64a_mix() hash of the row number, made odd.  Each add increments one
+ * counter per row, and the estimate of a key is its smallest counter:
+ * it is never below the true count, and with probability 1 - delta it
+ * is at most eps * total above it.
+ *
+ * Sketches of the same width and depth use the same seeds, so the
+ * sketches of separate threads or hosts are merged by adding their
+ * counters.
+ */
+#define CMS_MAX_DEPTH 32	/* most rows */
+#define CMS_E 2.718281828459045	/* e, without needing libm */
+
+struct fnv_cms {
+    unsigned int depth;		/* number of rows */
+    unsigned int shift;		/* 64 - log2(width) */
+    size_t width;		/* counters per row, a power of 2 */
+    unsigned long long seed[CMS_MAX_DEPTH];	/* odd multiplier of each row */
+    unsigned long long total;	/* sum of all counts added */
+    unsigned long long *count;	/* depth * width counters */
+};
+
+
+/*
+ * fnv_cms_new - create an empty count-min sketch
+ *
+ * input:
+ *	eps	- error as a fraction of the total count, 0 < eps < 1
+ *	delta	- probability of a larger error, 0 < delta < 1
+ *
+ * returns:
+ *	new sketch, free with fnv_cms_free(), or NULL ==> error, errno set
+ *
+ * The sketch has ceil(ln(1 / delta)) rows of e / eps counters, rounded
+ * up to a power of 2.
+ */
+struct fnv_cms *
+fnv_cms_new(double eps, double delta)
+{
+    struct fnv_cms *c;		/* new sketch */
+    unsigned long long row;	/* row number */
+    double want;		/* counters per row wanted */
+    double p;			/* failure probability of depth rows */
+    unsigned int i;
+
+    if (!(eps > 0.0 && eps < 1.0 && delta > 0.0 && delta < 1.0)) {
+	errno = EINVAL;
+	return NULL;
+    }
+    c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    for (c->depth = 1, p = 1.0 / CMS_E; p > delta &&
+	 c->depth < CMS_MAX_DEPTH; ++c->depth, p /= CMS_E) {
+    }
+    want = CMS_E / eps;
+    for (c->width = 2, c->shift = 63; (double)c->width < want &&
+	 c->shift > 40; c->width *= 2, --c->shift) {
+    }
+    c->count = calloc((size_t)c->depth * c->width, sizeof(c->count[0]));
+    if (c->count == NULL) {
+	free(c);
+	errno = ENOMEM;
+	return NULL;
+    }
+    for (i = 0; i < c->depth; ++i) {
+	row = i;
+	c->seed[i] = fnv_64a_mix(&row, sizeof(row), 0) | 1;
+    }
+    return c;
+}
+
+
+/*
+ * fnv_cms_free - free a count-min sketch
+ */
+void
+fnv_cms_free(struct fnv_cms *c)
+{
+    if (c != NULL) {
+	free(c->count);
+	free(c);
+    }
+}
+
+
+/*
+ * fnv_cms_add - add n to the count of a key
+ */
+void
+fnv_cms_add(struct fnv_cms *c, const void *key, size_t len,
+	    unsigned long long n)
+{
+    unsigned long long h = fnv_64a_mix(key, len, 0);	/* hash of key */
+    unsigned long long *row = c->count;	/* counters of row i */
+    unsigned int i;
+
+    for (i = 0; i < c->depth; ++i, row += c->width) {
+	row[(h * c->seed[i]) >> c->shift] += n;
+    }
+    c->total += n;
+}
+
+
+/*
+ * fnv_cms_count - estimate the count of a key
+ *
+ * returns:
+ *	estimate, never below the true count
+ */
+unsigned long long
+fnv_cms_count(struct fnv_cms *c, const void *key, size_t len)
+{
+    unsigned long long h = fnv_64a_mix(key, len, 0);	/* hash of key */
+    unsigned long long *row = c->count;	/* counters of row i */
+    unsigned long long min = ~0ULL;	/* smallest counter */
+    unsigned long long v;	/* counter of row i */
+    unsigned int i;
+
+    for (i = 0; i < c->depth; ++i, row += c->width) {
+	v = row[(h * c->seed[i]) >> c->shift];
+	if (v < min) {
+	    min = v;
+	}
+    }
+    return min;
+}
+
+
+/*
+ * fnv_cms_total - return the sum of all counts added to a sketch
+ */
+unsigned long long
+fnv_cms_total(struct fnv_cms *c)
+{
+    return c->total;
+}
+
+
+/*
+ * fnv_cms_merge - add the counts of one sketch to another
+ *
+ * input:
+ *	dst	- sketch to add to
+ *	src	- sketch created with the same eps and delta
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> sketches differ in size (errno EINVAL)
+ */
+int
+fnv_cms_merge(struct fnv_cms *dst, struct fnv_cms *src)
+{
+    size_t n;			/* number of counters */
+    size_t i;
+
+    if (dst->depth != src->depth || dst->width != src->width) {
+	errno = EINVAL;
+	return -1;
+    }
+    n = (size_t)dst->depth * dst->width;
+    for (i = 0; i < n; ++i) {
+	dst->count[i] += src->count[i];
+    }
+    dst->total += src->total;
+    return 0;
+}
+
+
+/*
+ * Space-Saving heavy hitters
+ *
+ * At most m keys are counted.  A key that is not counted while all m
+ * counters are in use takes over the counter with the smallest count c,
+ * starting from c + n, and c is recorded as the most its count may be
+ * over.  Every key whose true count exceeds total / m is counted, and
+ * each count is over by at most total / m.
+ *
+ * The counters form a binary min-heap by count, so the smallest is
+ * found at once and an add costs O(log m).  An fnv_map finds the
+ * counter of a key.
+ */
+struct topk_entry {
+    char *key;			/* copy of the key */
+    size_t len;			/* key length */
+    unsigned long long count;	/* count, over by at most err */
+    unsigned long long err;	/* most count may be over */
+    size_t pos;			/* index in heap */
+};
+
+struct fnv_topk {
+    size_t m;			/* number of counters */
+    size_t used;		/* counters in use */
+    unsigned long long total;	/* sum of all counts added */
+    struct topk_entry *entry;	/* counters */
+    size_t *heap;		/* entry indexes, a min-heap by count */
+    struct fnv_map *map;	/* key to entry index + 1 */
+};
+
+
+/*
+ * fnv_topk_new - create an empty Space-Saving summary
+ *
+ * input:
+ *	m	- number of counters, > 0
+ *
+ * returns:
+ *	new summary, free with fnv_topk_free(), or NULL ==> error, errno set
+ */
+struct fnv_topk *
+fnv_topk_new(size_t m)
+{
+    struct fnv_topk *t;		/* new summary */
+
+    if (m == 0) {
+	errno = EINVAL;
+	return NULL;
+    }
+    t = calloc(1, sizeof(*t));
+    if (t == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    t->m = m;
+    t->entry = calloc(m, sizeof(t->entry[0]));
+    t->heap = calloc(m, sizeof(t->heap[0]));
+    t->map = fnv_map_new(m);
+    if (t->entry == NULL || t->heap == NULL || t->map == NULL) {
+	fnv_topk_free(t);
+	errno = ENOMEM;
+	return NULL;
+    }
+    return t;
+}
+
+
+/*
+ * fnv_topk_free - free a Space-Saving summary
+ */
+void
+fnv_topk_free(struct fnv_topk *t)
+{
+    size_t i;
+
+    if (t == NULL) {
+	return;
+    }
+    if (t->entry != NULL) {
+	for (i = 0; i < t->used; ++i) {
+	    free(t->entry[i].key);
+	}
+    }
+    free(t->entry);
+    free(t->heap);
+    fnv_map_free(t->map);
+    free(t);
+}
+
+
+/*
+ * heap_swap - swap two heap positions
+ */
+static void
+heap_swap(struct fnv_topk *t, size_t a, size_t b)
+{
+    size_t e = t->heap[a];	/* entry at a */
+
+    t->heap[a] = t->heap[b];
+    t->heap[b] = e;
+    t->entry[t->heap[a]].pos = a;
+    t->entry[t->heap[b]].pos = b;
+}
+
+
+/*
+ * heap_down - move a heap position whose count grew down the heap
+ */
+static void
+heap_down(struct fnv_topk *t, size_t i)
+{
+    size_t c;			/* smaller child */
+
+    for (;;) {
+	c = 2 * i + 1;
+	if (c >= t->used) {
+	    return;
+	}
+	if (c + 1 < t->used && t->entry[t->heap[c + 1]].count <
+			       t->entry[t->heap[c]].count) {
+	    ++c;
+	}
+	if (t->entry[t->heap[i]].count <= t->entry[t->heap[c]].count) {
+	    return;
+	}
+	heap_swap(t, i, c);
+	i = c;
+    }
+}
+
+
+/*
+ * heap_up - move a new heap position up the heap
+ */
+static void
+heap_up(struct fnv_topk *t, size_t i)
+{
+    size_t p;			/* parent */
+
+    while (i > 0) {
+	p = (i - 1) / 2;
+	if (t->entry[t->heap[p]].count <= t->entry[t->heap[i]].count) {
+	    return;
+	}
+	heap_swap(t, i, p);
+	i = p;
+    }
+}
+
+
+/*
+ * set_key - give a counter a key
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+set_key(struct fnv_topk *t, size_t e, const void *key, size_t len)
+{
+    struct topk_entry *ent = &t->entry[e];	/* counter */
+    char *copy;			/* copy of key */
+
+    copy = realloc(ent->key, len > 0 ? len : 1);
+    if (copy == NULL) {
+	return -1;
+    }
+    memcpy(copy, key, len);
+    ent->key = copy;
+    ent->len = len;
+    if (fnv_map_put(t->map, copy, len, (void *)(e + 1)) < 0) {
+	return -1;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_topk_add - add n to the count of a key
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory (errno ENOMEM)
+ */
+int
+fnv_topk_add(struct fnv_topk *t, const void *key, size_t len,
+	     unsigned long long n)
+{
+    void *val;			/* entry index + 1 */
+    struct topk_entry *ent;	/* counter of key */
+    size_t e;			/* entry index */
+
+    t->total += n;
+    if (fnv_map_get(t->map, key, len, &val)) {
+	ent = &t->entry[(size_t)val - 1];
+	ent->count += n;
+	heap_down(t, ent->pos);
+	return 0;
+    }
+    if (t->used < t->m) {
+	/* a free counter */
+	e = t->used;
+	if (set_key(t, e, key, len) < 0) {
+	    errno = ENOMEM;
+	    return -1;
+	}
+	ent = &t->entry[e];
+	ent->count = n;
+	ent->err = 0;
+	ent->pos = t->used;
+	t->heap[t->used++] = e;
+	heap_up(t, ent->pos);
+	return 0;
+    }
+
+    /* take over the counter with the smallest count */
+    e = t->heap[0];
+    ent = &t->entry[e];
+    fnv_map_del(t->map, ent->key, ent->len);
+    if (set_key(t, e, key, len) < 0) {
+	errno = ENOMEM;
+	return -1;
+    }
+    ent->err = ent->count;
+    ent->count += n;
+    heap_down(t, 0);
+    return 0;
+}
+
+
+/*
+ * fnv_topk_lines - add 1 to the count of each line of a buffer
+ *
+ * input:
+ *	t	- summary
+ *	buf	- lines, each ending in a newline except perhaps the last
+ *	len	- octets in buf
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory (errno ENOMEM)
+ *
+ * The newlines are not part of the keys.
+ */
+int
+fnv_topk_lines(struct fnv_topk *t, const char *buf, size_t len)
+{
+    const char *end = buf + len;	/* end of buf */
+    const char *nl;		/* end of a line */
+
+    while (buf < end) {
+	nl = memchr(buf, '\n', (size_t)(end - buf));
+	if (nl == NULL) {
+	    nl = end;
+	}
+	if (fnv_topk_add(t, buf, (size_t)(nl - buf), 1) < 0) {
+	    return -1;
+	}
+	buf = nl + 1;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_topk_total - return the sum of all counts added to a summary
+ */
+unsigned long long
+fnv_topk_total(struct fnv_topk *t)
+{
+    return t->total;
+}
+
+
+/*
+ * cmp_item - qsort() order of items: highest count first, then by key
+ */
+static int
+cmp_item(const void *a, const void *b)
+{
+    const struct fnv_topk_item *x = a;	/* first item */
+    const struct fnv_topk_item *y = b;	/* second item */
+    int r;			/* key order */
+
+    if (x->count != y->count) {
+	return (x->count > y->count) ? -1 : 1;
+    }
+    r = memcmp(x->key, y->key, (x->len < y->len) ? x->len : y->len);
+    if (r != 0) {
+	return r;
+    }
+    return (x->len > y->len) - (x->len < y->len);
+}
+
+
+/*
+ * fnv_topk_list - list the counted keys with the highest counts
+ *
+ * input:
+ *	t	- summary
+ *	k	- most keys to list
+ *	out	- where to store up to k items, highest count first
+ *
+ * returns:
+ *	number of items stored, 0 ==> out of memory or no keys
+ *
+ * The items point to keys inside the summary: they are valid until the
+ * summary is next changed.
+ */
+size_t
+fnv_topk_list(struct fnv_topk *t, size_t k, struct fnv_topk_item *out)
+{
+    struct fnv_topk_item *all;	/* every counter */
+    size_t i;
+
+    if (k > t->used) {
+	k = t->used;
+    }
+    all = malloc((t->used > 0 ? t->used : 1) * sizeof(all[0]));
+    if (all == NULL) {
+	errno = ENOMEM;
+	return 0;
+    }
+    for (i = 0; i < t->used; ++i) {
+	all[i].key = t->entry[i].key;
+	all[i].len = t->entry[i].len;
+	all[i].count = t->entry[i].count;
+	all[i].err = t->entry[i].err;
+    }
+    qsort(all, t->used, sizeof(all[0]), cmp_item);
+    memcpy(out, all, k * sizeof(out[0]));
+    free(all);
+    return k;
+}
+
+
+/*
+ * fnv_topk_merge - merge one summary into another
+ *
+ * input:
+ *	dst	- summary to merge into
+ *	src	- summary to merge from, unchanged
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory (errno ENOMEM, dst unchanged)
+ *
+ * A key counted by only one summary may have been counted up to the
+ * smallest count of the other, if the other is full, so that count is
+ * added to both its count and its error.  The dst->m keys with the
+ * highest merged counts are kept (Agarwal et al., Mergeable Summaries).
+ */
+int
+fnv_topk_merge(struct fnv_topk *dst, struct fnv_topk *src)
+{
+    struct fnv_topk_item *all;	/* merged counts */
+    struct fnv_topk *t;		/* merged summary */
+    unsigned long long dmin;	/* most a key missing from dst was counted */
+    unsigned long long smin;	/* most a key missing from src was counted */
+    struct fnv_topk tmp;	/* for swapping dst and t */
+    void *val;			/* entry index + 1 */
+    struct topk_entry *ent;	/* counter */
+    size_t n = 0;		/* merged keys */
+    size_t i;
+
+    dmin = (dst->used == dst->m) ? dst->entry[dst->heap[0]].count : 0;
+    smin = (src->used == src->m) ? src->entry[src->heap[0]].count : 0;
+    all = malloc((dst->used + src->used + 1) * sizeof(all[0]));
+    t = fnv_topk_new(dst->m);
+    if (all == NULL || t == NULL) {
+	free(all);
+	fnv_topk_free(t);
+	errno = ENOMEM;
+	return -1;
+    }
+    for (i = 0; i < dst->used; ++i, ++n) {
+	ent = &dst->entry[i];
+	all[n].key = ent->key;
+	all[n].len = ent->len;
+	if (fnv_map_get(src->map, ent->key, ent->len, &val)) {
+	    all[n].count = ent->count + src->entry[(size_t)val - 1].count;
+	    all[n].err = ent->err + src->entry[(size_t)val - 1].err;
+	} else {
+	    all[n].count = ent->count + smin;
+	    all[n].err = ent->err + smin;
+	}
+    }
+    for (i = 0; i < src->used; ++i) {
+	ent = &src->entry[i];
+	if (!fnv_map_get(dst->map, ent->key, ent->len, NULL)) {
+	    all[n].key = ent->key;
+	    all[n].len = ent->len;
+	    all[n].count = ent->count + dmin;
+	    all[n].err = ent->err + dmin;
+	    ++n;
+	}
+    }
+    qsort(all, n, sizeof(all[0]), cmp_item);
+    for (i = 0; i < n && i < t->m; ++i) {
+	if (fnv_topk_add(t, all[i].key, all[i].len, all[i].count) < 0) {
+	    free(all);
+	    fnv_topk_free(t);
+	    errno = ENOMEM;
+	    return -1;
+	}
+	t->entry[i].err = all[i].err;
+    }
+    t->total = dst->total + src->total;
+    free(all);
+
+    /* dst becomes the merged summary */
+    tmp = *dst;
+    *dst = *t;
+    *t = tmp;
+    fnv_topk_free(t);
+    return 0;
+}
@@ -0,0 +1,569 @@
+/*
+ * fnv_tar - hash the members of a tar archive without extracting
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "fnv.h"
+
+
+/*
+ * A tar archive is a sequence of 512 octet blocks: each member is a
+ * header block followed by its data, padded to a whole block, and the
+ * archive ends with two zero blocks.  Both the POSIX ustar format and
+ * the pax extensions to it are understood:
+ *
+ *	- a 'x' pax extended header sets the path and size of the next
+ *	  member, overriding the 100 octet name and the 12 octet size
+ *	- a 'g' pax global header is skipped
+ *	- a GNU 'L' long name member sets the path of the next member
+ *	- a GNU 'K' long link name member is skipped
+ *	- a size field may be octal or GNU base-256
+ *
+ * Only regular members ('0', '7' or NUL type) are hashed.  The data of
+ * other members, and all padding, is skipped with lseek(2) when the
+ * input is seekable, and read and discarded otherwise.
+ */
+#define TAR_BLOCK 512			/* tar block size */
+#define TAR_BUF_SIZE (1024*1024)	/* input buffer size */
+#define TAR_EXT_MAX (16*1024*1024)	/* largest pax header or GNU long name */
+
+struct tar_in {
+    int fd;			/* input */
+    int seekable;		/* 1 ==> fd supports lseek(2) */
+    off_t end;			/* size of a regular file input, or -1 */
+    char *buf;			/* input buffer */
+    size_t pos;			/* next unused octet in buf */
+    size_t len;			/* octets in buf */
+};
+
+
+/*
+ * fill - make sure that some input is buffered
+ *
+ * returns:
+ *	octets buffered, 0 ==> EOF, -1 ==> error with errno set
+ */
+static ssize_t
+fill(struct tar_in *in)
+{
+    ssize_t cnt;		/* octets read */
+
+    if (in->pos < in->len) {
+	return (ssize_t)(in->len - in->pos);
+    }
+    do {
+	cnt = read(in->fd, in->buf, TAR_BUF_SIZE);
+    } while (cnt < 0 && errno == EINTR);
+    if (cnt < 0) {
+	return -1;
+    }
+    in->pos = 0;
+    in->len = (size_t)cnt;
+    return cnt;
+}
+
+
+/*
+ * get - copy len octets of input
+ *
+ * returns:
+ *	0 ==> OK, 1 ==> EOF before the first octet, -1 ==> error, errno set
+ *	(EINVAL ==> EOF after the first octet)
+ */
+static int
+get(struct tar_in *in, char *out, size_t len)
+{
+    size_t done = 0;		/* octets copied */
+    size_t n;			/* octets to copy next */
+    ssize_t avail;		/* octets buffered */
+
+    while (done < len) {
+	avail = fill(in);
+	if (avail <= 0) {
+	    if (avail == 0 && done == 0) {
+		return 1;
+	    }
+	    if (avail == 0) {
+		errno = EINVAL;
+	    }
+	    return -1;
+	}
+	n = len - done;
+	if (n > (size_t)avail) {
+	    n = (size_t)avail;
+	}
+	memcpy(out + done, in->buf + in->pos, n);
+	in->pos += n;
+	done += n;
+    }
+    return 0;
+}
+
+
+/*
+ * skip - skip octets of input
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set (EINVAL ==> EOF)
+ */
+static int
+skip(struct tar_in *in, off_t len)
+{
+    ssize_t avail;		/* octets buffered */
+
+    if ((off_t)(in->len - in->pos) >= len) {
+	in->pos += (size_t)len;
+	return 0;
+    }
+    len -= (off_t)(in->len - in->pos);
+    in->pos = in->len = 0;
+    if (in->seekable) {
+	off_t off = lseek(in->fd, len, SEEK_CUR);	/* new offset */
+
+	if (off < 0) {
+	    return -1;
+	}
+	if (in->end >= 0 && off > in->end) {
+	    errno = EINVAL;
+	    return -1;
+	}
+	return 0;
+    }
+    while (len > 0) {
+	avail = fill(in);
+	if (avail <= 0) {
+	    if (avail == 0) {
+		errno = EINVAL;
+	    }
+	    return -1;
+	}
+	if ((off_t)avail > len) {
+	    avail = (ssize_t)len;
+	}
+	in->pos += (size_t)avail;
+	len -= avail;
+    }
+    return 0;
+}
+
+
+/*
+ * hash_data - hash octets of input
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set (EINVAL ==> EOF)
+ */
+static int
+hash_data(struct tar_in *in, enum fnv_type type, off_t len, Fnv64_t *hval)
+{
+    ssize_t avail;		/* octets buffered */
+
+    while (len > 0) {
+	avail = fill(in);
+	if (avail <= 0) {
+	    if (avail == 0) {
+		errno = EINVAL;
+	    }
+	    return -1;
+	}
+	if ((off_t)avail > len) {
+	    avail = (ssize_t)len;
+	}
+	*hval = fnv_buf_64(type, in->buf + in->pos, (size_t)avail, *hval);
+	in->pos += (size_t)avail;
+	len -= avail;
+    }
+    return 0;
+}
+
+
+/*
+ * parse_num - parse an octal or base-256 header number field
+ *
+ * returns:
+ *	value, or -1 ==> invalid
+ */
+static off_t
+parse_num(unsigned char *p, size_t len)
+{
+    off_t val = 0;		/* parsed value */
+    size_t i;
+
+    if (p[0] & 0x80) {
+	/* GNU base-256: big endian, high bit of the first octet is a flag */
+	if (p[0] & 0x40) {
+	    return -1;		/* negative */
+	}
+	val = p[0] & 0x3f;
+	for (i = 1; i < len; ++i) {
+	    if (val > ((off_t)1 << (sizeof(off_t)*8 - 10))) {
+		return -1;
+	    }
+	    val = (val << 8) | p[i];
+	}
+	return val;
+    }
+    for (i = 0; i < len && p[i] == ' '; ++i) {
+    }
+    for (; i < len && p[i] >= '0' && p[i] <= '7'; ++i) {
+	val = (val << 3) | (p[i] - '0');
+    }
+    if (i < len && p[i] != ' ' && p[i] != '\0') {
+	return -1;
+    }
+    return val;
+}
+
+
+/*
+ * check_header - verify the checksum of a header block
+ *
+ * returns:
+ *	1 ==> valid, 0 ==> invalid
+ */
+static int
+check_header(unsigned char *h)
+{
+    long sum = 0;		/* unsigned sum */
+    long ssum = 0;		/* signed sum, used by some old tars */
+    off_t want;			/* recorded checksum */
+    int i;
+
+    want = parse_num(h + 148, 8);
+    for (i = 0; i < TAR_BLOCK; ++i) {
+	int c = (i >= 148 && i < 156) ? ' ' : h[i];	/* octet */
+
+	sum += c;
+	ssum += (i >= 148 && i < 156) ? ' ' : (signed char)h[i];
+    }
+    return want == sum || want == ssum;
+}
+
+
+/*
+ * parse_pax - take the path and size from a pax extended header
+ *
+ * given:
+ *	data	extended header records
+ *	len	octets of data
+ *	path	where to store a malloc-ed path, if any
+ *	size	where to store the size, if any
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> invalid (errno EINVAL) or out of memory
+ *
+ * A size must be a non-negative decimal number that fits in an off_t.
+ */
+static int
+parse_pax(char *data, size_t len, char **path, off_t *size)
+{
+    char *p = data;		/* current record */
+    char *end = data + len;	/* end of the records */
+    char *key;			/* record keyword */
+    char *val;			/* record value */
+    char *next;			/* next record */
+    char *num_end;		/* end of a size value */
+    long rlen;			/* record length */
+    long long num;		/* size value */
+
+    while (p < end && *p != '\0') {
+	rlen = strtol(p, &key, 10);
+	if (rlen <= 0 || rlen > end - p || *key != ' ' || p[rlen-1] != '\n') {
+	    errno = EINVAL;
+	    return -1;
+	}
+	next = p + rlen;
+	++key;
+	val = memchr(key, '=', (size_t)(next - key));
+	if (val == NULL) {
+	    errno = EINVAL;
+	    return -1;
+	}
+	*val++ = '\0';
+	next[-1] = '\0';
+	if (strcmp(key, "path") == 0) {
+	    free(*path);
+	    *path = strdup(val);
+	    if (*path == NULL) {
+		errno = ENOMEM;
+		return -1;
+	    }
+	} else if (strcmp(key, "size") == 0) {
+	    errno = 0;
+	    num = strtoll(val, &num_end, 10);
+	    if (*val < '0' || *val > '9' || *num_end != '\0' ||
+		errno == ERANGE || (long long)(off_t)num != num) {
+		errno = EINVAL;
+		return -1;
+	    }
+	    *size = (off_t)num;
+	}
+	p = next;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_tar_hash - hash each regular member of a tar archive
+ *
+ * input:
+ *	fd	- tar archive, read sequentially from its current offset
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	fn	- function called with the path, hash and size of each member
+ *	arg	- argument to pass to fn
+ *
+ * returns:
+ *	number of members hashed, or -1 ==> error with errno set
+ *	(EINVAL ==> not a tar archive, or truncated)
+ *
+ * The archive is read once, with no temporary files.
+ */
+long long
+fnv_tar_hash(int fd, enum fnv_type type,
+	     void (*fn)(char *path, Fnv64_t hval, off_t size, void *arg),
+	     void *arg)
+{
+    struct tar_in in;		/* buffered input */
+    struct stat st;		/* input status */
+    unsigned char h[TAR_BLOCK];	/* header block */
+    char *pax_path = NULL;	/* path from a pax header or GNU long name */
+    off_t pax_size = -1;	/* size from a pax header, -1 ==> none */
+    char *ext = NULL;		/* extended header data */
+    char name[100+1+155+1];	/* ustar prefix/name */
+    Fnv64_t hval;		/* member hash */
+    Fnv64_t basis;		/* initial basis of type */
+    long long cnt = 0;		/* members hashed */
+    off_t size;			/* member data size */
+    int zeros = 0;		/* consecutive zero blocks */
+    int ret;			/* get() return */
+    int err;			/* saved errno */
+
+    switch (type) {
+    case FNV0_64:
+	basis = FNV0_64_INIT;
+	break;
+    case FNV1_64:
+	basis = FNV1_64_INIT;
+	break;
+    case FNV1a_64:
+	basis = FNV1A_64_INIT;
+	break;
+    default:
+	errno = EINVAL;
+	return -1;
+    }
+    memset(&in, 0, sizeof(in));
+    in.fd = fd;
+    in.seekable = (lseek(fd, 0, SEEK_CUR) >= 0);
+    in.end = (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) ? st.st_size : -1;
+    in.buf = malloc(TAR_BUF_SIZE);
+    if (in.buf == NULL) {
+	errno = ENOMEM;
+	return -1;
+    }
+
+    for (;;) {
+	ret = get(&in, (char *)h, TAR_BLOCK);
+	if (ret != 0) {
+	    if (ret > 0 && cnt == 0 && zeros == 0) {
+		/* an empty input is not an archive */
+		errno = EINVAL;
+	    } else if (ret > 0) {
+		/* some tars omit the end of archive blocks */
+		break;
+	    }
+	    goto error;
+	}
+	if (h[0] == '\0' && memcmp(h, h + 1, TAR_BLOCK - 1) == 0) {
+	    if (++zeros == 2) {
+		break;
+	    }
+	    continue;
+	}
+	zeros = 0;
+	size = parse_num(h + 124, 12);
+	if (!check_header(h) || size < 0) {
+	    errno = EINVAL;
+	    goto error;
+	}
+
+	switch (h[156]) {
+	case 'x':		/* pax extended header for the next member */
+	case 'L':		/* GNU long name of the next member */
+	    if (size > TAR_EXT_MAX) {
+		errno = EINVAL;
+		goto error;
+	    }
+	    ext = malloc((size_t)size + 1);
+	    if (ext == NULL) {
+		errno = ENOMEM;
+		goto error;
+	    }
+	    if (get(&in, ext, (size_t)size) != 0) {
+		errno = EINVAL;
+		goto error;
+	    }
+	    ext[size] = '\0';
+	    if (h[156] == 'L') {
+		free(pax_path);
+		pax_path = ext;
+		ext = NULL;
+	    } else {
+		pax_size = -1;
+		if (parse_pax(ext, (size_t)size, &pax_path, &pax_size) < 0) {
+		    goto error;
+		}
+		free(ext);
+		ext = NULL;
+	    }
+	    if (skip(&in, (TAR_BLOCK - size % TAR_BLOCK) % TAR_BLOCK) < 0) {
+		goto error;
+	    }
+	    continue;
+
+	case '0':		/* regular file */
+	case '\0':		/* regular file, old tar */
+	case '7':		/* contiguous file */
+	    if (pax_size >= 0) {
+		size = pax_size;
+	    }
+	    if (pax_path == NULL) {
+		if (memcmp(h + 257, "ustar", 6) == 0 && h[345] != '\0') {
+		    snprintf(name, sizeof(name), "%.155s/%.100s",
+			     (char *)h + 345, (char *)h);
+		} else {
+		    snprintf(name, sizeof(name), "%.100s", (char *)h);
+		}
+	    }
+	    hval = basis;
+	    if (hash_data(&in, type, size, &hval) < 0) {
+		goto error;
+	    }
+	    fn(pax_path != NULL ? pax_path : name, hval, size, arg);
+	    ++cnt;
+	    break;
+
+	case 'g':		/* pax global header */
+	case 'K':		/* GNU long link name of the next member */
+	    /* the pending 'x' or 'L' state is for the next member */
+	    if (skip(&in, size) < 0 ||
+		skip(&in, (TAR_BLOCK - size % TAR_BLOCK) % TAR_BLOCK) < 0) {
+		goto error;
+	    }
+	    continue;
+
+	case '1':		/* hard link, no data */
+	case '2':		/* symbolic link */
+	case '3':		/* character device */
+	case '4':		/* block device */
+	case '5':		/* directory */
+	case '6':		/* FIFO */
+	    size = 0;
+	    /*FALLTHRU*/
+	default:		/* vendor types: skip */
+	    if (pax_size >= 0) {
+		size = pax_size;
+	    }
+	    if (skip(&in, size) < 0) {
+		goto error;
+	    }
+	    break;
+	}
+	if (skip(&in, (TAR_BLOCK - size % TAR_BLOCK) % TAR_BLOCK) < 0) {
+	    goto error;
+	}
+	free(pax_path);
+	pax_path = NULL;
+	pax_size = -1;
+    }
+    free(pax_path);
+    free(in.buf);
+    return cnt;
+
+error:
+    err = errno;
+    free(ext);
+    free(pax_path);
+    free(in.buf);
+    errno = err;
+    return -1;
+}
@@ -0,0 +1,807 @@
+/*
+ * fnv_watch - keep a manifest of file hashes current with inotify
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#endif /* __linux__ */
+#include "fnv.h"
+
+
+#if defined(__linux__)
+
+/*
+ * The watcher hashes every file below a directory into a manifest (see
+ * fnv_manifest.c) and then keeps the manifest current from inotify(7)
+ * events:
+ *
+ *	- every directory has an inotify watch, added before the directory
+ *	  is read so that no file created meanwhile is missed
+ *
+ *	- an event on a file makes it pending; the file is hashed once no
+ *	  event has been seen for the debounce time, or once it has been
+ *	  pending for WATCH_MAX_DEBOUNCE debounce times, whichever is sooner
+ *
+ *	- pending files are hashed by a pool of threads; a file that is
+ *	  changed while it is being hashed is hashed again afterwards, so
+ *	  the last hash recorded is never older than the last change
+ *
+ *	- a thread that finds a pending file gone removes it from the
+ *	  manifest, so deletes and renames need no special handling
+ *
+ *	- if the kernel event queue overflows, every file in the tree and
+ *	  in the manifest is made pending
+ *
+ * The manifest has a single writer, so its updates are serialized by a
+ * mutex; readers of the manifest never take it.
+ */
+#define WATCH_MASK (IN_CLOSE_WRITE|IN_MODIFY|IN_ATTRIB|IN_CREATE|IN_DELETE| \
+		    IN_MOVED_FROM|IN_MOVED_TO|IN_DELETE_SELF|IN_MOVE_SELF)
+#define WATCH_MAX_DEBOUNCE 10	/* longest pending time, in debounce times */
+#define WATCH_BUCKETS 4096	/* pending path hash table buckets */
+#define WATCH_EVENT_BUF (64*1024)	/* inotify read buffer size */
+
+struct pend {
+    char *path;			/* path relative to the watched directory */
+    long long first_ms;		/* when the path became pending */
+    long long due_ms;		/* when to hash the path */
+    int busy;			/* 1 ==> being hashed */
+    int again;			/* 1 ==> changed while being hashed */
+    struct pend *hnext;		/* next in the hash bucket */
+    struct pend *next;		/* next pending path */
+    struct pend *prev;		/* previous pending path */
+    struct pend *qnext;		/* next in the work queue */
+};
+
+struct watch {
+    char *root;			/* watched directory */
+    enum fnv_type type;		/* type of FNV hash */
+    int debounce_ms;		/* debounce time */
+    FILE *log;			/* where to print changes, or NULL */
+    struct fnv_watch_stat *stat;	/* statistics, errors is atomic */
+    int ifd;			/* inotify file descriptor */
+    char **wdpath;		/* directory path of each watch descriptor */
+    int nwd;			/* size of wdpath */
+
+    struct fnv_manifest *m;	/* manifest being kept current */
+    pthread_mutex_t mlock;	/* serializes manifest updates and log */
+
+    pthread_mutex_t lock;	/* protects the fields below */
+    pthread_cond_t cond;	/* signals work or quit */
+    struct pend *bucket[WATCH_BUCKETS];	/* pending paths by hash */
+    struct pend *head;		/* all pending paths */
+    struct pend *qhead;		/* work queue head */
+    struct pend *qtail;		/* work queue tail */
+    int quit;			/* 1 ==> threads should exit */
+};
+
+
+/*
+ * now_ms - monotonic time in milliseconds
+ */
+static long long
+now_ms(void)
+{
+    struct timespec ts;		/* current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+
+/*
+ * join_path - join a relative directory path and a name
+ *
+ * returns:
+ *	malloc-ed path, or NULL ==> out of memory
+ */
+static char *
+join_path(char *dir, char *name)
+{
+    char *p;			/* joined path */
+
+    p = malloc(strlen(dir) + 1 + strlen(name) + 1);
+    if (p != NULL) {
+	if (dir[0] == '\0') {
+	    strcpy(p, name);
+	} else {
+	    sprintf(p, "%s/%s", dir, name);
+	}
+    }
+    return p;
+}
+
+
+/*
+ * schedule - make a path pending, w->lock must be held
+ *
+ * given:
+ *	w	watcher
+ *	path	path relative to the watched directory
+ *	now	current time, or 0 ==> hash as soon as possible
+ */
+static void
+schedule(struct watch *w, char *path, long long now)
+{
+    Fnv32_t b = fnv_32a_str(path, FNV1_32A_INIT) % WATCH_BUCKETS;
+    struct pend *p;		/* pending path */
+    long long cap;		/* latest due time */
+
+    for (p = w->bucket[b]; p != NULL; p = p->hnext) {
+	if (strcmp(p->path, path) == 0) {
+	    break;
+	}
+    }
+    if (p == NULL) {
+	p = calloc(1, sizeof(*p));
+	if (p == NULL || (p->path = strdup(path)) == NULL) {
+	    free(p);
+	    __atomic_add_fetch(&w->stat->errors, 1, __ATOMIC_RELAXED);
+	    return;
+	}
+	p->hnext = w->bucket[b];
+	w->bucket[b] = p;
+	p->next = w->head;
+	if (w->head != NULL) {
+	    w->head->prev = p;
+	}
+	w->head = p;
+    } else if (p->busy) {
+	p->again = 1;
+    }
+    if (p->first_ms == 0) {
+	p->first_ms = now;
+    }
+    p->due_ms = (now == 0) ? 0 : now + w->debounce_ms;
+    cap = p->first_ms + (long long)w->debounce_ms * WATCH_MAX_DEBOUNCE;
+    if (p->first_ms > 0 && p->due_ms > cap) {
+	p->due_ms = cap;
+    }
+}
+
+
+/*
+ * unpend - forget a pending path, w->lock must be held
+ */
+static void
+unpend(struct watch *w, struct pend *p)
+{
+    Fnv32_t b = fnv_32a_str(p->path, FNV1_32A_INIT) % WATCH_BUCKETS;
+    struct pend **pp;		/* link to p in its bucket */
+
+    for (pp = &w->bucket[b]; *pp != p; pp = &(*pp)->hnext) {
+    }
+    *pp = p->hnext;
+    if (p->prev != NULL) {
+	p->prev->next = p->next;
+    } else {
+	w->head = p->next;
+    }
+    if (p->next != NULL) {
+	p->next->prev = p->prev;
+    }
+    free(p->path);
+    free(p);
+}
+
+
+/*
+ * dispatch - queue the pending paths that are due, w->lock must be held
+ *
+ * returns:
+ *	milliseconds until the next path is due, or -1 ==> none pending
+ *
+ * A path being hashed may be due again as soon as it is hashed, so
+ * while any path is busy, the wait is at most the debounce time.
+ */
+static int
+dispatch(struct watch *w, long long now)
+{
+    struct pend *p;		/* pending path */
+    long long wait = -1;	/* time until the next due path */
+
+    for (p = w->head; p != NULL; p = p->next) {
+	if (p->busy) {
+	    if (wait < 0 || w->debounce_ms < wait) {
+		wait = w->debounce_ms;
+	    }
+	    continue;
+	}
+	if (p->due_ms <= now) {
+	    p->busy = 1;
+	    p->again = 0;
+	    p->qnext = NULL;
+	    if (w->qtail != NULL) {
+		w->qtail->qnext = p;
+	    } else {
+		w->qhead = p;
+	    }
+	    w->qtail = p;
+	    pthread_cond_signal(&w->cond);
+	} else if (wait < 0 || p->due_ms - now < wait) {
+	    wait = p->due_ms - now;
+	}
+    }
+    return (int)wait;
+}
+
+
+/*
+ * print_hash - print a manifest change on the log, w->mlock must be held
+ */
+static void
+print_hash(struct watch *w, Fnv64_t *hval, char *path)
+{
+    if (w->log == NULL) {
+	return;
+    }
+    if (hval == NULL) {
+	fprintf(w->log, "- %s\n", path);
+    } else {
+#if defined(HAVE_64BIT_LONG_LONG)
+	fprintf(w->log, "0x%016llx %s\n", (unsigned long long)*hval, path);
+#else /* HAVE_64BIT_LONG_LONG */
+	fprintf(w->log, "0x%08lx%08lx %s\n", (unsigned long)hval->w32[1],
+		(unsigned long)hval->w32[0], path);
+#endif /* HAVE_64BIT_LONG_LONG */
+    }
+    fflush(w->log);
+}
+
+
+/*
+ * hash_pending - hash, or remove from the manifest, one pending path
+ */
+static void
+hash_pending(struct watch *w, char *path)
+{
+    struct stat st;		/* file status */
+    Fnv64_t hval;		/* file hash */
+    char *full;			/* path including the watched directory */
+    int fd = -1;		/* open file */
+
+    full = join_path(w->root, path);
+    if (full == NULL) {
+	__atomic_add_fetch(&w->stat->errors, 1, __ATOMIC_RELAXED);
+	return;
+    }
+    if (lstat(full, &st) < 0 || !S_ISREG(st.st_mode)) {
+	/* gone, or no longer a regular file */
+	pthread_mutex_lock(&w->mlock);
+	if (fnv_manifest_remove(w->m, path, 0) > 0) {
+	    ++w->stat->removed;
+	    print_hash(w, NULL, path);
+	}
+	pthread_mutex_unlock(&w->mlock);
+	free(full);
+	return;
+    }
+    if (fnv_manifest_same_file(w->m, &st)) {
+	free(full);
+	return;
+    }
+    switch (w->type) {
+    case FNV0_64:
+	hval = FNV0_64_INIT;
+	break;
+    case FNV1_64:
+	hval = FNV1_64_INIT;
+	break;
+    default:
+	hval = FNV1A_64_INIT;
+	break;
+    }
+    fd = open(full, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) < 0 ||
+	fnv_range_64(fd, w->type, 0, -1, &hval) < 0) {
+	/* unreadable, or removed meanwhile: a later event will tell */
+	if (fd >= 0) {
+	    close(fd);
+	}
+	__atomic_add_fetch(&w->stat->errors, 1, __ATOMIC_RELAXED);
+	free(full);
+	return;
+    }
+    close(fd);
+    free(full);
+    pthread_mutex_lock(&w->mlock);
+#if defined(__APPLE__)
+    if (fnv_manifest_update(w->m, path, hval, st.st_size,
+			    (long long)st.st_mtimespec.tv_sec * 1000000000LL +
+			    st.st_mtimespec.tv_nsec) < 0) {
+#else /* __APPLE__ */
+    if (fnv_manifest_update(w->m, path, hval, st.st_size,
+			    (long long)st.st_mtim.tv_sec * 1000000000LL +
+			    st.st_mtim.tv_nsec) < 0) {
+#endif /* __APPLE__ */
+	__atomic_add_fetch(&w->stat->errors, 1, __ATOMIC_RELAXED);
+    } else {
+	++w->stat->hashed;
+	print_hash(w, &hval, path);
+    }
+    pthread_mutex_unlock(&w->mlock);
+}
+
+
+/*
+ * worker - hash the queued pending paths until told to quit
+ */
+static void *
+worker(void *arg)
+{
+    struct watch *w = arg;	/* watcher */
+    struct pend *p;		/* path to hash */
+
+    pthread_mutex_lock(&w->lock);
+    for (;;) {
+	while (w->qhead == NULL && !w->quit) {
+	    pthread_cond_wait(&w->cond, &w->lock);
+	}
+	if (w->quit) {
+	    break;
+	}
+	p = w->qhead;
+	w->qhead = p->qnext;
+	if (w->qhead == NULL) {
+	    w->qtail = NULL;
+	}
+	pthread_mutex_unlock(&w->lock);
+
+	/* p->path does not change while p is busy */
+	hash_pending(w, p->path);
+
+	pthread_mutex_lock(&w->lock);
+	p->busy = 0;
+	if (p->again) {
+	    p->first_ms = now_ms();
+	} else {
+	    unpend(w, p);
+	}
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+
+/*
+ * add_dir - watch a directory and make the files below it pending
+ *
+ * given:
+ *	w	watcher
+ *	dir	directory path relative to the watched directory
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set and w->stat->errpath set
+ */
+static int
+add_dir(struct watch *w, char *dir)
+{
+    struct dirent *d;		/* directory entry */
+    struct stat st;		/* entry status */
+    char *full;			/* directory including the watched directory */
+    char *sub;			/* relative path of an entry */
+    char *fsub;			/* full path of an entry */
+    DIR *dp;			/* open directory */
+    int wd;			/* watch descriptor */
+    int ret = 0;		/* return value */
+
+    full = (dir[0] == '\0') ? strdup(w->root) : join_path(w->root, dir);
+    if (full == NULL) {
+	errno = ENOMEM;
+	return -1;
+    }
+    wd = inotify_add_watch(w->ifd, full, WATCH_MASK|IN_ONLYDIR|IN_DONT_FOLLOW);
+    if (wd < 0) {
+	snprintf(w->stat->errpath, sizeof(w->stat->errpath), "%s", full);
+	free(full);
+	return -1;
+    }
+    if (wd >= w->nwd) {
+	char **grown;		/* grown watch descriptor table */
+	int n = (wd + 1) * 2;	/* new size */
+
+	grown = realloc(w->wdpath, (size_t)n * sizeof(w->wdpath[0]));
+	if (grown == NULL) {
+	    free(full);
+	    errno = ENOMEM;
+	    return -1;
+	}
+	memset(grown + w->nwd, 0, (size_t)(n - w->nwd) * sizeof(grown[0]));
+	w->wdpath = grown;
+	w->nwd = n;
+    }
+    /* a directory moved within the tree keeps its watch descriptor */
+    free(w->wdpath[wd]);
+    w->wdpath[wd] = strdup(dir);
+    ++w->stat->dirs;
+
+    dp = opendir(full);
+    if (dp == NULL) {
+	/* removed meanwhile, the watch will be dropped by the kernel */
+	free(full);
+	return 0;
+    }
+    while (ret == 0 && (d = readdir(dp)) != NULL) {
+	if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0) {
+	    continue;
+	}
+	sub = join_path(dir, d->d_name);
+	fsub = join_path(full, d->d_name);
+	if (sub == NULL || fsub == NULL) {
+	    errno = ENOMEM;
+	    ret = -1;
+	} else if (lstat(fsub, &st) == 0) {
+	    if (S_ISDIR(st.st_mode)) {
+		ret = add_dir(w, sub);
+	    } else if (S_ISREG(st.st_mode)) {
+		pthread_mutex_lock(&w->lock);
+		schedule(w, sub, 0);
+		pthread_mutex_unlock(&w->lock);
+	    }
+	}
+	free(sub);
+	free(fsub);
+    }
+    closedir(dp);
+    free(full);
+    return ret;
+}
+
+
+/*
+ * forget_dirs - drop the watches of a directory moved out of the tree
+ */
+static void
+forget_dirs(struct watch *w, char *dir)
+{
+    size_t len = strlen(dir);	/* length of dir */
+    int wd;
+
+    for (wd = 0; wd < w->nwd; ++wd) {
+	if (w->wdpath[wd] != NULL && strncmp(w->wdpath[wd], dir, len) == 0 &&
+	    (w->wdpath[wd][len] == '\0' || w->wdpath[wd][len] == '/')) {
+	    inotify_rm_watch(w->ifd, wd);
+	    free(w->wdpath[wd]);
+	    w->wdpath[wd] = NULL;
+	}
+    }
+}
+
+
+/*
+ * pend_path - fnv_manifest_walk() callback that makes a path pending
+ */
+static void
+pend_path(char *path, void *arg)
+{
+    schedule((struct watch *)arg, path, 0);
+}
+
+
+/*
+ * handle_event - act on one inotify event
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ */
+static int
+handle_event(struct watch *w, struct inotify_event *ev, long long now)
+{
+    char *path;			/* relative path of the event */
+
+    ++w->stat->events;
+    if (ev->mask & IN_Q_OVERFLOW) {
+	/* events were lost: look at everything again */
+	++w->stat->overflows;
+	pthread_mutex_lock(&w->mlock);
+	pthread_mutex_lock(&w->lock);
+	fnv_manifest_walk(w->m, pend_path, w);
+	pthread_mutex_unlock(&w->lock);
+	pthread_mutex_unlock(&w->mlock);
+	return add_dir(w, "");
+    }
+    if (ev->wd < 0 || ev->wd >= w->nwd || w->wdpath[ev->wd] == NULL) {
+	return 0;
+    }
+    if (ev->mask & IN_IGNORED) {
+	free(w->wdpath[ev->wd]);
+	w->wdpath[ev->wd] = NULL;
+	return 0;
+    }
+    if (ev->len == 0) {
+	/* IN_DELETE_SELF and IN_MOVE_SELF are seen from the parent */
+	return 0;
+    }
+    path = join_path(w->wdpath[ev->wd], ev->name);
+    if (path == NULL) {
+	errno = ENOMEM;
+	return -1;
+    }
+    if (ev->mask & IN_ISDIR) {
+	if (ev->mask & (IN_DELETE|IN_MOVED_FROM)) {
+	    forget_dirs(w, path);
+	    pthread_mutex_lock(&w->mlock);
+	    w->stat->removed += fnv_manifest_remove(w->m, path, 1);
+	    pthread_mutex_unlock(&w->mlock);
+	} else if ((ev->mask & (IN_CREATE|IN_MOVED_TO)) &&
+		   add_dir(w, path) < 0 && errno != ENOENT) {
+	    free(path);
+	    return -1;
+	}
+    } else {
+	pthread_mutex_lock(&w->lock);
+	schedule(w, path, now);
+	pthread_mutex_unlock(&w->lock);
+    }
+    free(path);
+    return 0;
+}
+
+
+/*
+ * fnv_watch - keep a manifest of the file hashes below a directory current
+ *
+ * input:
+ *	dir	- directory to watch
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	mpath	- manifest file to create, see fnv_manifest.c
+ *	nthread	- number of hashing threads, < 1 ==> one per online CPU
+ *	debounce_ms - quiet time before a changed file is hashed
+ *	log	- where to print each manifest change, or NULL
+ *	stop	- watching stops once *stop is non-zero
+ *	stat	- where to store statistics, and the path of an error
+ *
+ * returns:
+ *	0 ==> stopped, -1 ==> error, errno set
+ *	(ENOSYS ==> not supported on this system)
+ *
+ * Every file is hashed once, then files are hashed again as they change.
+ * Changes are printed on log as "0x<hash> path" or "- path".
+ *
+ * Symbolic links and other non-regular files are not recorded.  Setting
+ * *stop from a signal handler interrupts the wait for events.
+ */
+int
+fnv_watch(char *dir, enum fnv_type type, char *mpath, int nthread,
+	  int debounce_ms, FILE *log, volatile sig_atomic_t *stop,
+	  struct fnv_watch_stat *stat)
+{
+    struct watch *w;		/* watcher */
+    pthread_t *tid;		/* hashing threads */
+    char *buf;			/* inotify event buffer */
+    struct pollfd pfd;		/* inotify poll */
+    struct inotify_event *ev;	/* event being handled */
+    ssize_t len;		/* octets of events read */
+    ssize_t off;		/* offset of an event */
+    int wait;			/* poll(2) timeout */
+    int ret = 0;		/* return value */
+    int err = 0;		/* saved errno */
+    int i;
+
+    memset(stat, 0, sizeof(*stat));
+    if (type < FNV0_64 || type > FNV1a_64) {
+	errno = EINVAL;
+	return -1;
+    }
+    if (nthread < 1) {
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);	/* online CPUs */
+
+	nthread = (ncpu > 0) ? (int)ncpu : 1;
+    }
+    w = calloc(1, sizeof(*w));
+    tid = calloc((size_t)nthread, sizeof(*tid));
+    buf = malloc(WATCH_EVENT_BUF);
+    if (w == NULL || tid == NULL || buf == NULL) {
+	free(w);
+	free(tid);
+	free(buf);
+	errno = ENOMEM;
+	return -1;
+    }
+    w->root = dir;
+    w->type = type;
+    w->debounce_ms = debounce_ms;
+    w->log = log;
+    w->stat = stat;
+    pthread_mutex_init(&w->mlock, NULL);
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->cond, NULL);
+    w->ifd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+    w->m = (w->ifd < 0) ? NULL : fnv_manifest_create(mpath, type, 0);
+    if (w->m == NULL) {
+	err = errno;
+	snprintf(stat->errpath, sizeof(stat->errpath), "%s",
+		 w->ifd < 0 ? dir : mpath);
+	ret = -1;
+	nthread = 0;
+    }
+    for (i = 0; i < nthread; ++i) {
+	if (pthread_create(&tid[i], NULL, worker, w) != 0) {
+	    nthread = i;
+	    err = EAGAIN;
+	    ret = -1;
+	    break;
+	}
+    }
+
+    /*
+     * hash everything once, then follow the events
+     */
+    if (ret == 0 && add_dir(w, "") < 0) {
+	err = errno;
+	ret = -1;
+    }
+    pfd.fd = w->ifd;
+    pfd.events = POLLIN;
+    while (ret == 0 && !*stop) {
+	pthread_mutex_lock(&w->lock);
+	wait = dispatch(w, now_ms());
+	pthread_mutex_unlock(&w->lock);
+	if (wait < 0 || wait > 1000) {
+	    wait = 1000;
+	}
+	if (poll(&pfd, 1, wait) < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    err = errno;
+	    ret = -1;
+	    break;
+	}
+	for (;;) {
+	    len = read(w->ifd, buf, WATCH_EVENT_BUF);
+	    if (len <= 0) {
+		break;
+	    }
+	    for (off = 0; off < len && ret == 0;
+		 off += (ssize_t)sizeof(*ev) + ev->len) {
+		ev = (struct inotify_event *)(buf + off);
+		if (handle_event(w, ev, now_ms()) < 0) {
+		    err = errno;
+		    ret = -1;
+		}
+	    }
+	}
+    }
+
+    /*
+     * stop the threads and release everything
+     */
+    pthread_mutex_lock(&w->lock);
+    w->quit = 1;
+    pthread_cond_broadcast(&w->cond);
+    pthread_mutex_unlock(&w->lock);
+    for (i = 0; i < nthread; ++i) {
+	pthread_join(tid[i], NULL);
+    }
+    while (w->head != NULL) {
+	unpend(w, w->head);
+    }
+    for (i = 0; i < w->nwd; ++i) {
+	free(w->wdpath[i]);
+    }
+    free(w->wdpath);
+    fnv_manifest_close(w->m);
+    if (w->ifd >= 0) {
+	close(w->ifd);
+    }
+    pthread_mutex_destroy(&w->mlock);
+    pthread_mutex_destroy(&w->lock);
+    pthread_cond_destroy(&w->cond);
+    free(w);
+    free(tid);
+    free(buf);
+    errno = err;
+    return ret;
+}
+
+#else /* __linux__ */
+
+/*
+ * fnv_watch - keep a manifest of the file hashes below a directory current
+ *
+ * There is no inotify(7) on this system.
+ */
+int
+fnv_watch(char *dir, enum fnv_type type, char *mpath, int nthread,
+	  int debounce_ms, FILE *log, volatile sig_atomic_t *stop,
+	  struct fnv_watch_stat *stat)
+{
+    (void) dir;
+    (void) type;
+    (void) mpath;
+    (void) nthread;
+    (void) debounce_ms;
+    (void) log;
+    (void) stop;
+    memset(stat, 0, sizeof(*stat));
+    errno = ENOSYS;
+    return -1;
+}
+
+#endif /* __linux__ */
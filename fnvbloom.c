@@ -0,0 +1,374 @@
+/*
+ * fnvbloom - build and query FNV-1a Bloom filters
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+#define DEF_FPR 0.01		/* default -p false positive rate */
+#define QUERY_BATCH 4096	/* keys tested by one fnv_bloom_has_batch() */
+
+static const char * const usage =
+"usage: %s [-h] [-V] [-v] [-n keys] [-p fpr] -b filter [keyfile ...]\n"
+"       %s [-h] [-V] [-v] [-x] -q filter [keyfile ...]\n"
+"\n"
+"    -h         print help and exit\n"
+"    -V         print version and exit\n"
+"    -v         print the filter size and false positive rate on stderr\n"
+"\n"
+"    -b filter  build filter from the keys\n"
+"    -n keys    size the filter for keys keys (default: number of keys)\n"
+"    -p fpr     false positive rate wanted (default 0.01)\n"
+"\n"
+"    -q filter  print the keys that may be in filter\n"
+"    -x         with -q, print the keys that are not in filter instead\n"
+"\n"
+"    keyfile    file of keys, one per line (default or -: stdin)\n"
+"\n"
+"The filter is a blocked Bloom filter that hashes each key once with\n"
+"FNV-1a 64.  It is saved in a form that -q and fnv_bloom_open() map\n"
+"in place.\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening, reading or writing a file\n"
+"    5         -q: some key is not in filter\n"
+" >= 20        internal error\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+
+/*
+ * keys read from the key files
+ */
+static const void **key = NULL;	/* start of each key */
+static size_t *keylen = NULL;	/* length of each key */
+static size_t nkey = 0;		/* number of keys */
+static size_t maxkey = 0;	/* allocated keys */
+
+
+/*
+ * read_keys - read the lines of a key file as keys
+ *
+ * input:
+ *	file	- key file, or "-" for stdin
+ *
+ * The file contents are kept for as long as the keys are used.
+ */
+static void
+read_keys(char *file)
+{
+    FILE *stream;		/* open key file */
+    char *buf = NULL;		/* file contents */
+    size_t len = 0;		/* octets read */
+    size_t size = 0;		/* octets allocated */
+    size_t n;			/* octets read by fread() */
+    char *p;			/* start of a line */
+    char *nl;			/* end of a line */
+
+    stream = (strcmp(file, "-") == 0) ? stdin : fopen(file, "r");
+    if (stream == NULL) {
+	fprintf(stderr, "%s: unable to open: %s: %s\n",
+		prog, file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    do {
+	if (len == size) {
+	    size = (size == 0) ? 65536 : size * 2;
+	    buf = realloc(buf, size);
+	    if (buf == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(20);
+	    }
+	}
+	n = fread(buf + len, 1, size - len, stream);
+	len += n;
+    } while (n > 0);
+    if (ferror(stream)) {
+	fprintf(stderr, "%s: error reading: %s: %s\n",
+		prog, file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    if (stream != stdin) {
+	fclose(stream);
+    }
+    for (p = buf; p < buf + len; p = nl + 1) {
+	nl = memchr(p, '\n', (size_t)(buf + len - p));
+	if (nl == NULL) {
+	    nl = buf + len;	/* last line without a newline */
+	}
+	if (nkey == maxkey) {
+	    maxkey = (maxkey == 0) ? 4096 : maxkey * 2;
+	    key = realloc(key, maxkey * sizeof(key[0]));
+	    keylen = realloc(keylen, maxkey * sizeof(keylen[0]));
+	    if (key == NULL || keylen == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(21);
+	    }
+	}
+	key[nkey] = p;
+	keylen[nkey] = (size_t)(nl - p);
+	++nkey;
+    }
+}
+
+
+/*
+ * print_info - print the size and false positive rate of a filter
+ */
+static void
+print_info(struct fnv_bloom *b, char *filter)
+{
+    unsigned long long nbit;	/* bits in the filter */
+    unsigned long long n;	/* keys added */
+    double fpr;			/* expected false positive rate */
+    int k;			/* bits set per key */
+
+    fpr = fnv_bloom_info(b, &nbit, &k, &n);
+    fprintf(stderr, "%s: %s: %llu keys, %llu bits, %.2f bits/key, k %d, "
+	    "expected false positive rate %.4g\n", prog, filter, n, nbit,
+	    (n > 0) ? (double)nbit / (double)n : 0.0, k, fpr);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    char *build = NULL;		/* -b filter or NULL */
+    char *query = NULL;		/* -q filter or NULL */
+    unsigned long long size = 0;	/* -n keys, 0 ==> number of keys */
+    double fpr = DEF_FPR;	/* -p fpr */
+    int v_flag = 0;		/* 1 ==> -v print filter info */
+    int x_flag = 0;		/* 1 ==> -x print keys not in filter */
+    struct fnv_bloom *b;	/* filter */
+    unsigned char *in;		/* 1 ==> key may be in filter */
+    size_t missing = 0;		/* keys not in filter */
+    size_t i;
+    char *end;			/* end of a number */
+    int c;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    while ((c = getopt(argc, argv, "hVvb:n:p:q:x")) != -1) {
+	switch (c) {
+
+	case 'h':	/* -h - print help and exit */
+	    fprintf(stderr, usage, prog, prog, prog, FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'v':	/* -v - print filter info */
+	    v_flag = 1;
+	    break;
+
+	case 'b':	/* -b filter - build a filter */
+	    build = optarg;
+	    break;
+
+	case 'n':	/* -n keys - number of keys to size for */
+	    errno = 0;
+	    size = strtoull(optarg, &end, 10);
+	    if (errno != 0 || *end != '\0' || size == 0) {
+		fprintf(stderr, "%s: -n keys must be > 0\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'p':	/* -p fpr - false positive rate */
+	    fpr = strtod(optarg, &end);
+	    if (*end != '\0' || !(fpr > 0.0 && fpr < 1.0)) {
+		fprintf(stderr, "%s: -p fpr must be > 0 and < 1\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'q':	/* -q filter - query a filter */
+	    query = optarg;
+	    break;
+
+	case 'x':	/* -x - print keys not in filter */
+	    x_flag = 1;
+	    break;
+
+	default:
+	    fprintf(stderr, usage, prog, prog, prog, FNV_VERSION);
+	    exit(3); /*ooo*/
+	}
+    }
+    if ((build == NULL) == (query == NULL)) {
+	fprintf(stderr, "%s: use exactly one of -b and -q\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (x_flag && query == NULL) {
+	fprintf(stderr, "%s: -x requires -q\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (query != NULL && (size > 0 || fpr != DEF_FPR)) {
+	fprintf(stderr, "%s: -n and -p require -b\n", prog);
+	exit(3); /*ooo*/
+    }
+
+    /*
+     * read the keys
+     */
+    if (optind == argc) {
+	read_keys("-");
+    }
+    for (; optind < argc; ++optind) {
+	read_keys(argv[optind]);
+    }
+
+    /*
+     * build a filter
+     */
+    if (build != NULL) {
+	b = fnv_bloom_new((size > 0) ? size : (nkey > 0) ? nkey : 1, fpr);
+	if (b == NULL) {
+	    fprintf(stderr, "%s: cannot create filter: %s\n",
+		    prog, strerror(errno));
+	    exit(22);
+	}
+	fnv_bloom_add_batch(b, nkey, key, keylen);
+	if (fnv_bloom_save(b, build) < 0) {
+	    fprintf(stderr, "%s: unable to write: %s: %s\n",
+		    prog, build, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+	if (v_flag) {
+	    print_info(b, build);
+	}
+	fnv_bloom_free(b);
+	exit(0); /*ooo*/
+    }
+
+    /*
+     * query a filter
+     */
+    b = fnv_bloom_open(query);
+    if (b == NULL) {
+	fprintf(stderr, "%s: unable to open filter: %s: %s\n", prog, query,
+		(errno == EINVAL) ? "not a filter file" : strerror(errno));
+	exit(4); /*ooo*/
+    }
+    if (v_flag) {
+	print_info(b, query);
+    }
+    in = malloc(QUERY_BATCH);
+    if (in == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(23);
+    }
+    for (i = 0; i < nkey; ++i) {
+	if (i % QUERY_BATCH == 0) {
+	    fnv_bloom_has_batch(b, (nkey - i < QUERY_BATCH) ?
+				nkey - i : QUERY_BATCH,
+				key + i, keylen + i, in);
+	}
+	if (!in[i % QUERY_BATCH]) {
+	    ++missing;
+	}
+	if (in[i % QUERY_BATCH] != x_flag) {
+	    fwrite(key[i], 1, keylen[i], stdout);
+	    putchar('\n');
+	}
+    }
+    fnv_bloom_free(b);
+    if (fflush(stdout) != 0 || ferror(stdout)) {
+	fprintf(stderr, "%s: error writing output\n", prog);
+	exit(4); /*ooo*/
+    }
+    exit(missing > 0 ? 5 : 0); /*ooo*/
+}
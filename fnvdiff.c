@@ -0,0 +1,491 @@
+/*
+ * fnvdiff - find the differing blocks of two files
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "longlong.h"
+#include "fnv.h"
+
+#define BLOCK_SIZE (1024*1024)	/* default -b block size */
+#define BUF_SIZE (128*1024)	/* octets to read at a time */
+#define MAX_THREADS 256		/* most -j threads we will start */
+#define CHUNK 16		/* blocks handed to a thread at a time */
+
+static const char * const usage =
+"usage: %s [-h] [-V] [-b blksize] [-f fine] [-j threads] [-s] file1 file2\n"
+"\n"
+"    -h            print help and exit\n"
+"    -V            print version and exit\n"
+"\n"
+"    -b blksize    size of the blocks compared (default 1m)\n"
+"    -f fine       rehash each differing block in blocks of this size to\n"
+"                  narrow down the differing ranges (must divide blksize)\n"
+"    -j threads    number of reading threads (default: online CPUs)\n"
+"    -s            print a summary of each pass on stderr\n"
+"\n"
+"    blksize and fine may end in k, m, g or t for powers of 1024\n"
+"\n"
+"Each aligned block of both files is FNV-1a 64 hashed, the blocks being\n"
+"read concurrently by several threads, and the ranges of differing\n"
+"blocks are printed.  Octets beyond the end of the shorter file differ.\n"
+"\n"
+"Exit codes:\n"
+"    0         files are the same\n"
+"    1         files differ\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening or reading file\n"
+" >= 20        internal error\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+static char *name[2];		/* files to compare */
+static int fd[2];		/* open files */
+static off_t size[2];		/* file sizes */
+static int read_err = 0;	/* 1 ==> a file could not be read */
+
+
+/*
+ * a pass over a list of blocks of both files
+ *
+ * Task t hashes block blk[t/2] of file t%2, so that the two files are
+ * read concurrently and each file is read by several threads at once.
+ */
+struct pass {
+    pthread_mutex_t lock;	/* protects next and octets */
+    size_t next;		/* next task to hand out */
+    off_t blksize;		/* block size */
+    off_t *blk;			/* block numbers to hash, ascending */
+    size_t nblk;		/* number of blocks */
+    Fnv64_t *hval;		/* hash of each task */
+    off_t *len;			/* octets hashed by each task */
+    unsigned long long octets;	/* total octets read */
+};
+
+
+/*
+ * hash_block - FNV-1a 64 hash one block of one file
+ *
+ * given:
+ *	p	pass the block belongs to
+ *	t	task number
+ *	buf	read buffer of BUF_SIZE octets
+ *
+ * returns:	octets read
+ */
+static off_t
+hash_block(struct pass *p, size_t t, char *buf)
+{
+    int f = (int)(t & 1);	/* which file */
+    off_t pos = p->blk[t >> 1] * p->blksize;	/* next octet to read */
+    off_t end = pos + p->blksize;	/* beyond the end of the block */
+    Fnv64_t hval = FNV1A_64_INIT;	/* block hash */
+    off_t len = 0;		/* octets hashed */
+    ssize_t cnt;		/* octets read */
+
+    if (end > size[f]) {
+	end = size[f];
+    }
+    while (pos < end) {
+	cnt = pread(fd[f], buf, (end - pos < BUF_SIZE) ? (size_t)(end - pos) :
+						       BUF_SIZE, pos);
+	if (cnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    fprintf(stderr, "%s: error reading file: %s: %s\n",
+		    prog, name[f], strerror(errno));
+	    read_err = 1;
+	    break;
+	}
+	if (cnt == 0) {
+	    break;
+	}
+	hval = fnv_64a_buf(buf, (size_t)cnt, hval);
+	pos += cnt;
+	len += cnt;
+    }
+    p->hval[t] = hval;
+    p->len[t] = len;
+    return len;
+}
+
+
+/*
+ * worker - hash blocks until there are none left
+ */
+static void *
+worker(void *arg)
+{
+    struct pass *p = (struct pass *)arg;	/* pass to work on */
+    size_t ntask = 2 * p->nblk;		/* number of tasks */
+    unsigned long long octets = 0;	/* octets we read */
+    size_t t;				/* first task of our chunk */
+    size_t i;
+    char *buf;				/* read buffer */
+
+    buf = malloc(BUF_SIZE);
+    if (buf == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    for (;;) {
+	pthread_mutex_lock(&p->lock);
+	t = p->next;
+	p->next += CHUNK;
+	pthread_mutex_unlock(&p->lock);
+	if (t >= ntask) {
+	    break;
+	}
+	for (i = t; i < t + CHUNK && i < ntask; ++i) {
+	    octets += (unsigned long long)hash_block(p, i, buf);
+	}
+    }
+    free(buf);
+    pthread_mutex_lock(&p->lock);
+    p->octets += octets;
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+
+/*
+ * run_pass - hash the blocks of a pass of both files using nthread threads
+ */
+static void
+run_pass(struct pass *p, int nthread)
+{
+    pthread_t tid[MAX_THREADS];		/* worker threads */
+    int started;			/* threads started */
+    int i;
+
+    p->next = 0;
+    p->octets = 0;
+    p->hval = malloc((2 * p->nblk + 1) * sizeof(p->hval[0]));
+    p->len = malloc((2 * p->nblk + 1) * sizeof(p->len[0]));
+    if (p->hval == NULL || p->len == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(21);
+    }
+    pthread_mutex_init(&p->lock, NULL);
+    if ((size_t)nthread > (2 * p->nblk + CHUNK - 1) / CHUNK) {
+	nthread = (int)((2 * p->nblk + CHUNK - 1) / CHUNK);
+    }
+    for (started = 0; started < nthread; ++started) {
+	if (pthread_create(&tid[started], NULL, worker, p) != 0) {
+	    break;
+	}
+    }
+    if (started == 0) {
+	worker(p);
+    }
+    for (i = 0; i < started; ++i) {
+	pthread_join(tid[i], NULL);
+    }
+    pthread_mutex_destroy(&p->lock);
+}
+
+
+/*
+ * block_differs - 1 ==> the k-th block of a pass differs between the files
+ */
+static int
+block_differs(struct pass *p, size_t k)
+{
+#if defined(HAVE_64BIT_LONG_LONG)
+    return p->len[2*k] != p->len[2*k+1] || p->hval[2*k] != p->hval[2*k+1];
+#else /* HAVE_64BIT_LONG_LONG */
+    return p->len[2*k] != p->len[2*k+1] ||
+	   p->hval[2*k].w32[0] != p->hval[2*k+1].w32[0] ||
+	   p->hval[2*k].w32[1] != p->hval[2*k+1].w32[1];
+#endif /* HAVE_64BIT_LONG_LONG */
+}
+
+
+/*
+ * open_input - open a file to compare and find its size
+ *
+ * Block devices report a zero st_size, so the size is found with lseek(2).
+ */
+static void
+open_input(int f)
+{
+    fd[f] = open(name[f], O_RDONLY);
+    if (fd[f] < 0) {
+	fprintf(stderr, "%s: unable to open file: %s: %s\n",
+		prog, name[f], strerror(errno));
+	exit(4); /*ooo*/
+    }
+    size[f] = lseek(fd[f], 0, SEEK_END);
+    if (size[f] < 0) {
+	fprintf(stderr, "%s: unable to find the size of file: %s: %s\n",
+		prog, name[f], strerror(errno));
+	exit(4); /*ooo*/
+    }
+}
+
+
+/*
+ * main - the main function
+ *
+ * See the above usage for details.
+ */
+int
+main(int argc, char *argv[])
+{
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    off_t blksize = BLOCK_SIZE;	/* -b blksize */
+    off_t fine = 0;		/* -f fine, 0 ==> no second pass */
+    int s_flag = 0;		/* 1 ==> -s print pass summary */
+    int nthread;		/* -j threads */
+    struct pass coarse;		/* 1st pass over all blocks */
+    struct pass narrow;		/* 2nd pass over differing blocks */
+    struct pass *last;		/* pass whose blocks are printed */
+    off_t maxsize;		/* size of the larger file */
+    off_t ratio;		/* fine blocks per coarse block */
+    off_t first;		/* first octet of a differing range */
+    off_t end;			/* beyond the last octet of the range */
+    size_t ndiff = 0;		/* differing blocks of the last pass */
+    size_t k, j;
+    off_t b;
+    long ncpu;			/* online CPUs */
+    int c;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    nthread = (ncpu > 0) ? (int)ncpu : 1;
+    while ((c = getopt(argc, argv, "hVb:f:j:s")) != -1) {
+	switch (c) {
+
+	case 'h':	/* -h - print help and exit */
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'b':	/* -b blksize - block size */
+	    if (fnv_parse_size(optarg, &blksize) < 0 || blksize <= 0) {
+		fprintf(stderr, "%s: invalid -b blksize: %s\n", prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'f':	/* -f fine - second pass block size */
+	    if (fnv_parse_size(optarg, &fine) < 0 || fine <= 0) {
+		fprintf(stderr, "%s: invalid -f fine: %s\n", prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'j':	/* -j threads - number of threads */
+	    nthread = atoi(optarg);
+	    if (nthread < 1 || nthread > MAX_THREADS) {
+		fprintf(stderr, "%s: -j threads must be >= 1 and <= %d\n",
+			prog, MAX_THREADS);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 's':	/* -s - print pass summary */
+	    s_flag = 1;
+	    break;
+
+	default:
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(3); /*ooo*/
+	}
+    }
+    if (argc - optind != 2) {
+	fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	exit(3); /*ooo*/
+    }
+    if (fine > 0 && (fine >= blksize || blksize % fine != 0)) {
+	fprintf(stderr, "%s: -f fine must be smaller than and divide -b "
+		"blksize\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (nthread > MAX_THREADS) {
+	nthread = MAX_THREADS;
+    }
+    name[0] = argv[optind];
+    name[1] = argv[optind+1];
+    open_input(0);
+    open_input(1);
+    maxsize = (size[0] > size[1]) ? size[0] : size[1];
+
+    /*
+     * pass 1: hash every block of both files
+     */
+    coarse.blksize = blksize;
+    coarse.nblk = (size_t)((maxsize + blksize - 1) / blksize);
+    coarse.blk = malloc((coarse.nblk + 1) * sizeof(coarse.blk[0]));
+    if (coarse.blk == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    for (k = 0; k < coarse.nblk; ++k) {
+	coarse.blk[k] = (off_t)k;
+    }
+    run_pass(&coarse, nthread);
+    last = &coarse;
+    for (k = 0; k < coarse.nblk; ++k) {
+	ndiff += block_differs(&coarse, k);
+    }
+    if (s_flag) {
+	fprintf(stderr, "%s: pass 1: %llu blocks of %lld octets, %llu differ, "
+		"%llu octets read\n", prog, (unsigned long long)coarse.nblk,
+		(long long)blksize, (unsigned long long)ndiff, coarse.octets);
+    }
+
+    /*
+     * pass 2: rehash the differing blocks in smaller blocks
+     */
+    if (fine > 0 && ndiff > 0) {
+	ratio = blksize / fine;
+	narrow.blksize = fine;
+	narrow.nblk = 0;
+	narrow.blk = malloc((ndiff * (size_t)ratio + 1) *
+			    sizeof(narrow.blk[0]));
+	if (narrow.blk == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(23);
+	}
+	for (k = 0; k < coarse.nblk; ++k) {
+	    if (!block_differs(&coarse, k)) {
+		continue;
+	    }
+	    for (b = coarse.blk[k] * ratio;
+		 b < (coarse.blk[k] + 1) * ratio && b * fine < maxsize; ++b) {
+		narrow.blk[narrow.nblk++] = b;
+	    }
+	}
+	run_pass(&narrow, nthread);
+	last = &narrow;
+	ndiff = 0;
+	for (k = 0; k < narrow.nblk; ++k) {
+	    ndiff += block_differs(&narrow, k);
+	}
+	if (s_flag) {
+	    fprintf(stderr, "%s: pass 2: %llu blocks of %lld octets, "
+		    "%llu differ, %llu octets read\n",
+		    prog, (unsigned long long)narrow.nblk, (long long)fine,
+		    (unsigned long long)ndiff, narrow.octets);
+	}
+    }
+    if (read_err) {
+	exit(4); /*ooo*/
+    }
+
+    /*
+     * print runs of adjacent differing blocks as octet ranges
+     */
+    for (k = 0; k < last->nblk; k = j) {
+	if (!block_differs(last, k)) {
+	    j = k + 1;
+	    continue;
+	}
+	for (j = k + 1; j < last->nblk && block_differs(last, j) &&
+			last->blk[j] == last->blk[j-1] + 1; ++j) {
+	}
+	first = last->blk[k] * last->blksize;
+	end = (last->blk[j-1] + 1) * last->blksize;
+	if (end > maxsize) {
+	    end = maxsize;
+	}
+	printf("%s %s differ: octets %lld-%lld\n", name[0], name[1],
+	       (long long)first, (long long)(end - 1));
+    }
+    exit(ndiff > 0 ? 1 : 0); /*ooo*/
+}
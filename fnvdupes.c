@@ -0,0 +1,827 @@
+/*
+ * fnvdupes - find duplicate files using staged FNV hashes
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "longlong.h"
+#include "fnv.h"
+
+#define PREFIX_SIZE (4*1024)	/* default octets hashed in stage 2 */
+#define BUF_SIZE (128*1024)	/* octets to read at a time */
+#define MAX_THREADS 256		/* most -j threads we will start */
+
+static const char * const usage =
+"usage: %s [-h] [-V] [-c] [-j threads] [-p prefix] [-s] path ...\n"
+"\n"
+"    -h            print help and exit\n"
+"    -V            print version and exit\n"
+"\n"
+"    -c            compare the bytes of files with equal hashes\n"
+"    -j threads    number of hashing threads (default: online CPUs)\n"
+"    -p prefix     octets hashed by the prefix stage (default 4k)\n"
+"    -s            print a summary of each stage on stderr\n"
+"\n"
+"    path          file or directory to search (directories are searched\n"
+"                  recursively without following symbolic links)\n"
+"\n"
+"Duplicates are printed one path per line, each set followed by an\n"
+"empty line.  Hard links to the same file are only listed once.\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening or reading file\n"
+" >= 20        internal error\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+
+
+/*
+ * 128 bit FNV-1a hash, when the compiler has a 128 bit integer type
+ *
+ * Otherwise the full hash stage uses both the 64 bit FNV-1a and the
+ * 64 bit FNV-1 hash of the file, which also yields 128 bits.
+ */
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 Fnv128_t;
+#define FNV1A_128_INIT ((((Fnv128_t)0x6c62272e07bb0142ULL) << 64) | \
+			(Fnv128_t)0x62b821756295c58dULL)
+#define FNV_128_PRIME ((((Fnv128_t)0x0000000001000000ULL) << 64) | \
+		       (Fnv128_t)0x000000000000013bULL)
+#endif /* __SIZEOF_INT128__ */
+
+
+/*
+ * a file that may have duplicates
+ */
+struct file {
+    char *path;			/* path to the file */
+    off_t size;			/* file size */
+    dev_t dev;			/* device of the file */
+    ino_t ino;			/* inode of the file */
+    Fnv64_t prefix;		/* FNV-1a hash of the first prefix octets */
+    unsigned char full[16];	/* 128 bit hash of the whole file */
+    int err;			/* 1 ==> file could not be read */
+    size_t leader;		/* 1st file of the duplicate set */
+    int same;			/* 1 ==> same bytes as the leader */
+};
+
+static struct file *file = NULL;	/* files found */
+static size_t nfile = 0;		/* number of files found */
+static size_t maxfile = 0;		/* allocated files */
+static off_t prefix_size = PREFIX_SIZE;	/* -p prefix */
+static int read_err = 0;		/* 1 ==> a file could not be read */
+
+
+/*
+ * parallel work queue
+ *
+ * Each stage hands out items by index to a pool of threads.
+ */
+struct work {
+    pthread_mutex_t lock;	/* protects next */
+    size_t next;		/* next item to hand out */
+    size_t nitem;		/* number of items */
+    size_t *item;		/* items to process, indexes into file[] */
+    void (*func)(size_t);	/* process one item */
+};
+
+
+/*
+ * worker - process work queue items until there are none left
+ */
+static void *
+worker(void *arg)
+{
+    struct work *w = (struct work *)arg;	/* work queue */
+    size_t i;					/* item to process */
+
+    for (;;) {
+	pthread_mutex_lock(&w->lock);
+	i = w->next++;
+	pthread_mutex_unlock(&w->lock);
+	if (i >= w->nitem) {
+	    break;
+	}
+	w->func(w->item[i]);
+    }
+    return NULL;
+}
+
+
+/*
+ * run_parallel - apply func to each item using nthread threads
+ */
+static void
+run_parallel(size_t *item, size_t nitem, void (*func)(size_t), int nthread)
+{
+    struct work w;			/* work queue */
+    pthread_t tid[MAX_THREADS];		/* worker threads */
+    int started;			/* threads started */
+    int i;
+
+    w.next = 0;
+    w.nitem = nitem;
+    w.item = item;
+    w.func = func;
+    pthread_mutex_init(&w.lock, NULL);
+    if ((size_t)nthread > nitem) {
+	nthread = (int)nitem;
+    }
+    for (started = 0; started < nthread; ++started) {
+	if (pthread_create(&tid[started], NULL, worker, &w) != 0) {
+	    break;
+	}
+    }
+    if (started == 0) {
+	worker(&w);
+    }
+    for (i = 0; i < started; ++i) {
+	pthread_join(tid[i], NULL);
+    }
+    pthread_mutex_destroy(&w.lock);
+}
+
+
+/*
+ * open_file - open a file for reading, noting a failure
+ *
+ * returns:
+ *	open file descriptor or -1 (and f->err set)
+ */
+static int
+open_file(struct file *f)
+{
+    int fd;			/* open file */
+
+    fd = open(f->path, O_RDONLY);
+    if (fd < 0) {
+	fprintf(stderr, "%s: unable to open file: %s: %s\n",
+		prog, f->path, strerror(errno));
+	f->err = 1;
+	read_err = 1;
+    }
+    return fd;
+}
+
+
+/*
+ * read_failed - note a read error
+ */
+static void
+read_failed(struct file *f)
+{
+    fprintf(stderr, "%s: error reading file: %s: %s\n",
+	    prog, f->path, strerror(errno));
+    f->err = 1;
+    read_err = 1;
+}
+
+
+/*
+ * hash_prefix - stage 2: hash the first prefix_size octets of a file
+ */
+static void
+hash_prefix(size_t i)
+{
+    struct file *f = &file[i];	/* file to hash */
+    int fd;			/* open file */
+
+    f->prefix = FNV1A_64_INIT;
+    fd = open_file(f);
+    if (fd < 0) {
+	return;
+    }
+    if (fnv_range_64(fd, FNV1a_64, 0, prefix_size, &f->prefix) < 0) {
+	read_failed(f);
+    }
+    close(fd);
+}
+
+
+/*
+ * hash_full - stage 3: 128 bit hash of the whole file
+ */
+static void
+hash_full(size_t i)
+{
+    struct file *f = &file[i];	/* file to hash */
+    unsigned char *buf;		/* read buffer */
+    ssize_t readcnt;		/* octets read */
+    int fd;			/* open file */
+#if defined(__SIZEOF_INT128__)
+    Fnv128_t h = FNV1A_128_INIT;	/* FNV-1a 128 bit hash */
+    ssize_t j;
+#else /* __SIZEOF_INT128__ */
+    Fnv64_t h1a = FNV1A_64_INIT;	/* FNV-1a 64 bit hash */
+    Fnv64_t h1 = FNV1_64_INIT;		/* FNV-1 64 bit hash */
+#endif /* __SIZEOF_INT128__ */
+
+    fd = open_file(f);
+    if (fd < 0) {
+	return;
+    }
+    buf = malloc(BUF_SIZE);
+    if (buf == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+#if defined(POSIX_FADV_SEQUENTIAL)
+    (void) posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif /* POSIX_FADV_SEQUENTIAL */
+    while ((readcnt = read(fd, buf, BUF_SIZE)) != 0) {
+	if (readcnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    read_failed(f);
+	    break;
+	}
+#if defined(__SIZEOF_INT128__)
+	for (j = 0; j < readcnt; ++j) {
+	    h ^= (Fnv128_t)buf[j];
+	    h *= FNV_128_PRIME;
+	}
+#else /* __SIZEOF_INT128__ */
+	h1a = fnv_64a_buf(buf, (size_t)readcnt, h1a);
+	h1 = fnv_64_buf(buf, (size_t)readcnt, h1);
+#endif /* __SIZEOF_INT128__ */
+    }
+    free(buf);
+    close(fd);
+#if defined(__SIZEOF_INT128__)
+    memcpy(f->full, &h, sizeof(f->full));
+#else /* __SIZEOF_INT128__ */
+    memcpy(f->full, &h1a, sizeof(h1a));
+    memcpy(f->full + sizeof(h1a), &h1, sizeof(h1));
+#endif /* __SIZEOF_INT128__ */
+}
+
+
+/*
+ * same_bytes - stage 4: compare two files octet for octet
+ *
+ * returns:
+ *	1 ==> same contents, 0 ==> different or unreadable
+ */
+static int
+same_bytes(struct file *a, struct file *b)
+{
+    unsigned char *abuf;	/* read buffer for a */
+    unsigned char *bbuf;	/* read buffer for b */
+    ssize_t acnt;		/* octets read from a */
+    ssize_t bcnt;		/* octets read from b */
+    off_t off = 0;		/* offset being compared */
+    int afd, bfd;		/* open files */
+    int same = 0;		/* 1 ==> files are the same */
+
+    afd = open_file(a);
+    if (afd < 0) {
+	return 0;
+    }
+    bfd = open_file(b);
+    if (bfd < 0) {
+	close(afd);
+	return 0;
+    }
+    abuf = malloc(BUF_SIZE);
+    bbuf = malloc(BUF_SIZE);
+    if (abuf == NULL || bbuf == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(21);
+    }
+    for (;;) {
+	acnt = pread(afd, abuf, BUF_SIZE, off);
+	bcnt = pread(bfd, bbuf, BUF_SIZE, off);
+	if (acnt < 0 || bcnt < 0) {
+	    read_failed((acnt < 0) ? a : b);
+	    break;
+	}
+	if (acnt != bcnt || memcmp(abuf, bbuf, (size_t)acnt) != 0) {
+	    break;
+	}
+	if (acnt == 0) {
+	    same = 1;
+	    break;
+	}
+	off += acnt;
+    }
+    free(abuf);
+    free(bbuf);
+    close(afd);
+    close(bfd);
+    return same;
+}
+
+
+/*
+ * compare_leader - stage 4: compare a file with the 1st file of its set
+ */
+static void
+compare_leader(size_t i)
+{
+    file[i].same = same_bytes(&file[file[i].leader], &file[i]);
+}
+
+
+/*
+ * add_file - record a regular file
+ */
+static void
+add_file(char *path, struct stat *st)
+{
+    if (nfile >= maxfile) {
+	maxfile = (maxfile == 0) ? 1024 : maxfile * 2;
+	file = realloc(file, maxfile * sizeof(file[0]));
+	if (file == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(22);
+	}
+    }
+    memset(&file[nfile], 0, sizeof(file[0]));
+    file[nfile].path = strdup(path);
+    if (file[nfile].path == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(23);
+    }
+    file[nfile].size = st->st_size;
+    file[nfile].dev = st->st_dev;
+    file[nfile].ino = st->st_ino;
+    ++nfile;
+}
+
+
+/*
+ * walk - record the non-empty regular files under a path
+ *
+ * Symbolic links are not followed.
+ */
+static void
+walk(char *path)
+{
+    struct stat st;		/* path status */
+    DIR *dir;			/* open directory */
+    struct dirent *d;		/* directory entry */
+    char *sub;			/* path of a directory entry */
+    size_t len;			/* length of path */
+
+    if (lstat(path, &st) < 0) {
+	fprintf(stderr, "%s: unable to access: %s\n", prog, path);
+	read_err = 1;
+	return;
+    }
+    if (S_ISREG(st.st_mode)) {
+	if (st.st_size > 0) {
+	    add_file(path, &st);
+	}
+	return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+	return;
+    }
+    dir = opendir(path);
+    if (dir == NULL) {
+	fprintf(stderr, "%s: unable to open directory: %s\n", prog, path);
+	read_err = 1;
+	return;
+    }
+    len = strlen(path);
+    while ((d = readdir(dir)) != NULL) {
+	if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0) {
+	    continue;
+	}
+	sub = malloc(len + 1 + strlen(d->d_name) + 1);
+	if (sub == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(27);
+	}
+	if (len > 0 && path[len-1] == '/') {
+	    sprintf(sub, "%s%s", path, d->d_name);
+	} else {
+	    sprintf(sub, "%s/%s", path, d->d_name);
+	}
+	walk(sub);
+	free(sub);
+    }
+    closedir(dir);
+}
+
+
+/*
+ * cmp_size - order files by size, then by inode so hard links are adjacent
+ */
+static int
+cmp_size(const void *a, const void *b)
+{
+    const struct file *fa = (const struct file *)a;
+    const struct file *fb = (const struct file *)b;
+
+    if (fa->size != fb->size) {
+	return (fa->size < fb->size) ? -1 : 1;
+    }
+    if (fa->dev != fb->dev) {
+	return (fa->dev < fb->dev) ? -1 : 1;
+    }
+    if (fa->ino != fb->ino) {
+	return (fa->ino < fb->ino) ? -1 : 1;
+    }
+    return strcmp(fa->path, fb->path);
+}
+
+
+/*
+ * cmp_index_prefix - order file indexes by size and then prefix hash
+ */
+static int
+cmp_index_prefix(const void *a, const void *b)
+{
+    const struct file *fa = &file[*(const size_t *)a];
+    const struct file *fb = &file[*(const size_t *)b];
+    int ret;
+
+    if (fa->size != fb->size) {
+	return (fa->size < fb->size) ? -1 : 1;
+    }
+    ret = memcmp(&fa->prefix, &fb->prefix, sizeof(fa->prefix));
+    if (ret != 0) {
+	return ret;
+    }
+    return strcmp(fa->path, fb->path);
+}
+
+
+/*
+ * cmp_index_full - order file indexes by size, prefix and full hash
+ */
+static int
+cmp_index_full(const void *a, const void *b)
+{
+    const struct file *fa = &file[*(const size_t *)a];
+    const struct file *fb = &file[*(const size_t *)b];
+    int ret;
+
+    if (fa->size != fb->size) {
+	return (fa->size < fb->size) ? -1 : 1;
+    }
+    ret = memcmp(fa->full, fb->full, sizeof(fa->full));
+    if (ret != 0) {
+	return ret;
+    }
+    return strcmp(fa->path, fb->path);
+}
+
+
+/*
+ * same_prefix - determine if two files are equal through stage 2
+ */
+static int
+same_prefix(size_t a, size_t b)
+{
+    return file[a].size == file[b].size && !file[a].err && !file[b].err &&
+	   memcmp(&file[a].prefix, &file[b].prefix,
+		  sizeof(file[a].prefix)) == 0;
+}
+
+
+/*
+ * same_full - determine if two files are equal through stage 3
+ */
+static int
+same_full(size_t a, size_t b)
+{
+    return same_prefix(a, b) &&
+	   memcmp(file[a].full, file[b].full, sizeof(file[a].full)) == 0;
+}
+
+
+/*
+ * keep_groups - keep only items in runs of 2 or more equal items
+ *
+ * given:
+ *	item	items sorted so that equal items are adjacent
+ *	nitem	number of items
+ *	same	1 ==> two items are equal
+ *
+ * returns:	number of items kept at the front of item[]
+ */
+static size_t
+keep_groups(size_t *item, size_t nitem, int (*same)(size_t, size_t))
+{
+    size_t kept = 0;		/* items kept */
+    size_t i, j;
+
+    for (i = 0; i < nitem; i = j) {
+	for (j = i + 1; j < nitem && same(item[i], item[j]); ++j) {
+	}
+	if (j - i >= 2) {
+	    memmove(&item[kept], &item[i], (j - i) * sizeof(item[0]));
+	    kept += j - i;
+	}
+    }
+    return kept;
+}
+
+
+/*
+ * main - the main function
+ *
+ * See the above usage for details.
+ */
+int
+main(int argc, char *argv[])
+{
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    int c_flag = 0;		/* 1 ==> -c compare bytes */
+    int s_flag = 0;		/* 1 ==> -s print stage summary */
+    int nthread;		/* -j threads */
+    size_t *item;		/* candidate file indexes */
+    size_t nitem;		/* number of candidates */
+    size_t i, j, k;
+    int c;
+    int first;			/* 1 ==> first file of a printed set */
+    long ncpu;			/* online CPUs */
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    nthread = (ncpu > 0) ? (int)ncpu : 1;
+    while ((c = getopt(argc, argv, "hVcj:p:s")) != -1) {
+	switch (c) {
+
+	case 'h':	/* -h - print help and exit */
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'c':	/* -c - compare bytes */
+	    c_flag = 1;
+	    break;
+
+	case 'j':	/* -j threads - number of threads */
+	    nthread = atoi(optarg);
+	    if (nthread < 1 || nthread > MAX_THREADS) {
+		fprintf(stderr, "%s: -j threads must be >= 1 and <= %d\n",
+			prog, MAX_THREADS);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'p':	/* -p prefix - prefix stage size */
+	    if (fnv_parse_size(optarg, &prefix_size) < 0 || prefix_size <= 0) {
+		fprintf(stderr, "%s: invalid -p prefix: %s\n", prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 's':	/* -s - print stage summary */
+	    s_flag = 1;
+	    break;
+
+	default:
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(3); /*ooo*/
+	}
+    }
+    if (optind >= argc) {
+	fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	exit(3); /*ooo*/
+    }
+    if (nthread > MAX_THREADS) {
+	nthread = MAX_THREADS;
+    }
+
+    /*
+     * stage 0: find all non-empty regular files
+     */
+    for (i = optind; i < (size_t)argc; ++i) {
+	walk(argv[i]);
+    }
+
+    /*
+     * stage 1: keep files whose size is shared by another file,
+     *		listing each hard linked inode only once
+     */
+    if (nfile > 0) {
+	qsort(file, nfile, sizeof(file[0]), cmp_size);
+    }
+    item = malloc((nfile + 1) * sizeof(item[0]));
+    if (item == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(24);
+    }
+    nitem = 0;
+    for (i = 0; i < nfile; ++i) {
+	if (i > 0 && file[i].dev == file[i-1].dev &&
+	    file[i].ino == file[i-1].ino) {
+	    continue;
+	}
+	item[nitem++] = i;
+    }
+    for (i = 0, k = 0; i < nitem; i = j) {
+	for (j = i + 1; j < nitem && file[item[j]].size == file[item[i]].size;
+	     ++j) {
+	}
+	if (j - i >= 2) {
+	    memmove(&item[k], &item[i], (j - i) * sizeof(item[0]));
+	    k += j - i;
+	}
+    }
+    if (s_flag) {
+	fprintf(stderr, "%s: size stage: %llu files, %llu candidates\n",
+		prog, (unsigned long long)nfile, (unsigned long long)k);
+    }
+    nitem = k;
+
+    /*
+     * stage 2: FNV-1a hash the prefix of each candidate
+     */
+    run_parallel(item, nitem, hash_prefix, nthread);
+    if (nitem > 0) {
+	qsort(item, nitem, sizeof(item[0]), cmp_index_prefix);
+    }
+    nitem = keep_groups(item, nitem, same_prefix);
+    if (s_flag) {
+	fprintf(stderr, "%s: prefix stage: %llu candidates\n",
+		prog, (unsigned long long)nitem);
+    }
+
+    /*
+     * stage 3: 128 bit hash of files larger than the prefix
+     *
+     * Files no larger than the prefix were hashed in full by stage 2.
+     */
+    {
+	size_t *big;		/* candidates larger than the prefix */
+	size_t nbig = 0;	/* number of such candidates */
+
+	big = malloc((nitem + 1) * sizeof(big[0]));
+	if (big == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(25);
+	}
+	for (i = 0; i < nitem; ++i) {
+	    if (file[item[i]].size > prefix_size) {
+		big[nbig++] = item[i];
+	    }
+	}
+	run_parallel(big, nbig, hash_full, nthread);
+	free(big);
+    }
+    if (nitem > 0) {
+	qsort(item, nitem, sizeof(item[0]), cmp_index_full);
+    }
+    nitem = keep_groups(item, nitem, same_full);
+    if (s_flag) {
+	fprintf(stderr, "%s: full hash stage: %llu duplicates\n",
+		prog, (unsigned long long)nitem);
+    }
+
+    /*
+     * stage 4: compare the bytes of each file with the 1st of its set
+     */
+    for (i = 0; i < nitem; i = j) {
+	for (j = i; j < nitem && same_full(item[i], item[j]); ++j) {
+	    file[item[j]].leader = item[i];
+	    file[item[j]].same = 1;
+	}
+    }
+    if (c_flag) {
+	size_t *rest;		/* files other than the 1st of each set */
+	size_t nrest = 0;	/* number of such files */
+
+	rest = malloc((nitem + 1) * sizeof(rest[0]));
+	if (rest == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(26);
+	}
+	for (i = 0; i < nitem; ++i) {
+	    if (file[item[i]].leader != item[i]) {
+		rest[nrest++] = item[i];
+	    }
+	}
+	run_parallel(rest, nrest, compare_leader, nthread);
+	free(rest);
+    }
+
+    /*
+     * print each set of duplicates
+     */
+    for (i = 0; i < nitem; i = j) {
+	for (j = i + 1; j < nitem && file[item[j]].leader == item[i]; ++j) {
+	}
+	first = 1;
+	for (k = i + 1; k < j; ++k) {
+	    if (!file[item[k]].same) {
+		continue;
+	    }
+	    if (first) {
+		printf("%s\n", file[item[i]].path);
+		first = 0;
+	    }
+	    printf("%s\n", file[item[k]].path);
+	}
+	if (!first) {
+	    printf("\n");
+	}
+    }
+
+    /*
+     * report any read errors
+     */
+    exit(read_err ? 4 : 0); /*ooo*/
+}
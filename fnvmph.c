@@ -0,0 +1,947 @@
+/*
+ * fnvmph - generate a minimal perfect hash of keys as a C header
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+#define DEF_LAMBDA 5.0		/* default -l average keys per bucket */
+#define DEF_ALPHA 0.99		/* default -a load factor */
+#define PART_KEYS 4096		/* average keys per partition */
+#define MAX_PILOT (1U << 20)	/* pilots tried before a new seed */
+#define MAX_SEEDS 64		/* seeds tried before giving up */
+#define MAX_THREADS 256		/* most -j threads */
+#define PILOT_MIX 0x9e3779b97f4a7c15ULL	/* added to a pilot before mixing */
+
+static const char * const usage =
+"usage: %s [-h] [-V] [-v] [-n] [-j threads] [-p prefix] [-o header]\n"
+"	[-l lambda] [-a alpha] [-s seed] [keyfile ...]\n"
+"\n"
+"    -h         print help and exit\n"
+"    -V         print version and exit\n"
+"    -v         print the table sizes, bits per key and build time on\n"
+"               stderr\n"
+"\n"
+"    -n         leave the keys out of the header: lookup() of a string\n"
+"               that is not a key returns an arbitrary index\n"
+"    -j threads number of search threads (default: online CPUs)\n"
+"    -p prefix  prefix of the names in the header (default mph)\n"
+"    -o header  write the header to this file (default stdout)\n"
+"    -l lambda  average keys per bucket (default 5)\n"
+"    -a alpha   load factor of each partition, 0.5 to 1 (default 0.99)\n"
+"    -s seed    first hash seed to try (default 0)\n"
+"\n"
+"    keyfile    file of keys, one per line (default or -: stdin)\n"
+"\n"
+"Writes a self-contained C header with the tables of a minimal perfect\n"
+"hash of the keys and:\n"
+"\n"
+"    static inline long prefix_lookup(const void *key, size_t len);\n"
+"\n"
+"which returns the index, 0 to nkeys-1, of a key in prefix_keys[], or\n"
+"-1 if it is not a key.\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening, reading or writing a file\n"
+"    5         no keys, duplicate keys, or no perfect hash was found\n"
+" >= 20        internal error\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+
+/*
+ * keys read from the key files
+ */
+static const char **key = NULL;	/* start of each key */
+static size_t *keylen = NULL;	/* length of each key */
+static size_t nkey = 0;		/* number of keys */
+static size_t maxkey = 0;	/* allocated keys */
+
+/*
+ * the perfect hash being built
+ *
+ * The keys are split by the top bits of their hash into partitions
+ * of about PART_KEYS keys, each built on its own, so that threads can
+ * search partitions at once and each search works in cache.  Within a
+ * partition of n keys and m >= n slots, the keys are hashed into r
+ * buckets.  Buckets are placed largest first: a bucket's pilot is the
+ * first value p for which every key x of the bucket lands on a free
+ * slot_of(x ^ fnv_mix64(p + PILOT_MIX), m).  Keys that land on slots
+ * n .. m-1 are then moved to the free slots below n through a remap
+ * table, so the hash is minimal.
+ */
+struct part {
+    size_t key_off;		/* first index of the partition */
+    size_t bucket_off;		/* first pilot of the partition */
+    size_t remap_off;		/* first remap entry of the partition */
+    size_t n;			/* keys */
+    size_t m;			/* slots, >= n */
+    size_t r;			/* buckets */
+};
+static struct part *part = NULL;	/* partitions */
+static size_t npart = 0;	/* number of partitions */
+static unsigned long long *hash = NULL;	/* hash of each key */
+static size_t *bypart = NULL;	/* key numbers sorted by partition */
+static unsigned int *pilot = NULL;	/* pilot of each bucket */
+static unsigned int *remap = NULL;	/* index of each slot >= n */
+static size_t *slot_key = NULL;	/* key number at each index */
+static double lambda = DEF_LAMBDA;	/* -l average keys per bucket */
+static double alpha = DEF_ALPHA;	/* -a load factor */
+static unsigned long long seed = 0;	/* hash seed */
+static size_t next_part = 0;	/* next partition for a thread */
+static int failed = 0;		/* 1 ==> a partition needs a new seed */
+static int dup_key = 0;		/* 1 ==> duplicate keys found */
+
+
+/*
+ * read_keys - read the lines of a key file as keys
+ *
+ * input:
+ *	file	- key file, or "-" for stdin
+ *
+ * The file contents are kept for as long as the keys are used.
+ */
+static void
+read_keys(char *file)
+{
+    FILE *stream;		/* open key file */
+    char *buf = NULL;		/* file contents */
+    size_t len = 0;		/* octets read */
+    size_t size = 0;		/* octets allocated */
+    size_t n;			/* octets read by fread() */
+    char *p;			/* start of a line */
+    char *nl;			/* end of a line */
+
+    stream = (strcmp(file, "-") == 0) ? stdin : fopen(file, "r");
+    if (stream == NULL) {
+	fprintf(stderr, "%s: unable to open: %s: %s\n",
+		prog, file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    do {
+	if (len == size) {
+	    size = (size == 0) ? 65536 : size * 2;
+	    buf = realloc(buf, size);
+	    if (buf == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(20);
+	    }
+	}
+	n = fread(buf + len, 1, size - len, stream);
+	len += n;
+    } while (n > 0);
+    if (ferror(stream)) {
+	fprintf(stderr, "%s: error reading: %s: %s\n",
+		prog, file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    if (stream != stdin) {
+	fclose(stream);
+    }
+    for (p = buf; p < buf + len; p = nl + 1) {
+	nl = memchr(p, '\n', (size_t)(buf + len - p));
+	if (nl == NULL) {
+	    nl = buf + len;	/* last line without a newline */
+	}
+	if (nkey == maxkey) {
+	    maxkey = (maxkey == 0) ? 4096 : maxkey * 2;
+	    key = realloc(key, maxkey * sizeof(key[0]));
+	    keylen = realloc(keylen, maxkey * sizeof(keylen[0]));
+	    if (key == NULL || keylen == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(21);
+	    }
+	}
+	key[nkey] = p;
+	keylen[nkey] = (size_t)(nl - p);
+	++nkey;
+    }
+}
+
+
+/*
+ * now - the current time in seconds
+ */
+static double
+now(void)
+{
+    struct timespec ts;		/* monotonic time */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+ * part_of, bucket_of - partition and bucket of a hash
+ *
+ * Buckets are skewed: the low 32 bits u of the hash, as a fraction,
+ * map to bucket (u + u*u)/2 * r, so the first buckets, placed while
+ * the partition is empty, get about twice the keys of the last ones.
+ * That shortens the search for the pilots of the last buckets.
+ */
+static size_t
+part_of(unsigned long long x)
+{
+    return (size_t)(((x >> 32) * (unsigned long long)npart) >> 32);
+}
+
+static size_t
+bucket_of(unsigned long long x, size_t r)
+{
+    unsigned long long u = x & 0xffffffffULL;
+    u = (u + ((u * u) >> 32)) >> 1;
+    return (size_t)((u * (unsigned long long)r) >> 32);
+}
+
+
+/*
+ * slot_of - slot, 0 to m-1, of a hash xor a mixed pilot
+ *
+ * The multiply carries every bit of x into the top 32 bits, which
+ * then range over m without a division.
+ */
+static size_t
+slot_of(unsigned long long x, size_t m)
+{
+    return (size_t)((((x * PILOT_MIX) >> 32) * (unsigned long long)m) >> 32);
+}
+
+
+/*
+ * build_part - find the pilots and remap table of one partition
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> a new seed is needed, -2 ==> duplicate keys
+ */
+static int
+build_part(struct part *pp)
+{
+    size_t *keys = bypart + pp->key_off;	/* our key numbers */
+    size_t *order;		/* keys sorted by bucket */
+    size_t *start;		/* first of each bucket in order */
+    size_t *bysize;		/* buckets, largest first */
+    size_t *cnt;		/* buckets of each size */
+    size_t maxsize = 0;		/* largest bucket */
+    unsigned char *taken;	/* 1 ==> slot is used */
+    size_t *high;		/* key numbers on slots n .. m-1 */
+    size_t pos[64];		/* slots of a bucket's keys */
+    unsigned long long ph;	/* mixed pilot */
+    size_t b;			/* bucket */
+    size_t i, j, k;
+    unsigned int p;		/* pilot */
+    size_t size;		/* keys in bucket */
+    size_t free_slot;		/* next free slot below n */
+    int ret = 0;		/* return value */
+
+    order = malloc((pp->n + 1) * sizeof(order[0]));
+    start = calloc(pp->r + 1, sizeof(start[0]));
+    bysize = malloc((pp->r + 1) * sizeof(bysize[0]));
+    taken = calloc(pp->m + 1, 1);
+    high = malloc((pp->m - pp->n + 1) * sizeof(high[0]));
+    if (order == NULL || start == NULL || bysize == NULL || taken == NULL ||
+	high == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+
+    /* counting sort of the keys by bucket */
+    for (i = 0; i < pp->n; ++i) {
+	++start[bucket_of(hash[keys[i]], pp->r) + 1];
+    }
+    for (b = 0; b < pp->r; ++b) {
+	size = start[b+1];
+	maxsize = (size > maxsize) ? size : maxsize;
+	start[b+1] += start[b];
+    }
+    if (maxsize > sizeof(pos) / sizeof(pos[0])) {
+	ret = -1;
+	goto done;
+    }
+    for (i = 0; i < pp->n; ++i) {
+	b = bucket_of(hash[keys[i]], pp->r);
+	order[start[b]++] = keys[i];
+    }
+    for (b = pp->r; b > 0; --b) {
+	start[b] = start[b-1];
+    }
+    start[0] = 0;
+
+    /* buckets by size, largest first */
+    cnt = calloc(maxsize + 2, sizeof(cnt[0]));
+    if (cnt == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    for (b = 0; b < pp->r; ++b) {
+	++cnt[maxsize - (start[b+1] - start[b])];
+    }
+    for (i = 0, k = 0; i <= maxsize; ++i) {
+	j = cnt[i];
+	cnt[i] = k;
+	k += j;
+    }
+    for (b = 0; b < pp->r; ++b) {
+	bysize[cnt[maxsize - (start[b+1] - start[b])]++] = b;
+    }
+    free(cnt);
+
+    /* place each bucket */
+    for (i = 0; i < pp->r && ret == 0; ++i) {
+	b = bysize[i];
+	size = start[b+1] - start[b];
+	if (size == 0) {
+	    pilot[pp->bucket_off + b] = 0;
+	    continue;
+	}
+	for (j = 1; j < size; ++j) {
+	    for (k = 0; k < j; ++k) {
+		if (hash[order[start[b]+j]] == hash[order[start[b]+k]]) {
+		    /* the same hash: the same key, or a new seed */
+		    if (keylen[order[start[b]+j]] ==
+			keylen[order[start[b]+k]] &&
+			memcmp(key[order[start[b]+j]], key[order[start[b]+k]],
+			       keylen[order[start[b]+j]]) == 0) {
+			ret = -2;
+		    } else {
+			ret = -1;
+		    }
+		    goto done;
+		}
+	    }
+	}
+	for (p = 0; p < MAX_PILOT; ++p) {
+	    ph = fnv_mix64(p + PILOT_MIX);
+	    for (j = 0; j < size; ++j) {
+		pos[j] = slot_of(hash[order[start[b]+j]] ^ ph, pp->m);
+		if (taken[pos[j]]) {
+		    break;
+		}
+		for (k = 0; k < j && pos[k] != pos[j]; ++k) {
+		}
+		if (k < j) {
+		    break;
+		}
+	    }
+	    if (j == size) {
+		break;
+	    }
+	}
+	if (p == MAX_PILOT) {
+	    ret = -1;
+	    break;
+	}
+	pilot[pp->bucket_off + b] = p;
+	for (j = 0; j < size; ++j) {
+	    taken[pos[j]] = 1;
+	    if (pos[j] < pp->n) {
+		slot_key[pp->key_off + pos[j]] = order[start[b]+j];
+	    } else {
+		high[pos[j] - pp->n] = order[start[b]+j];
+	    }
+	}
+    }
+    if (ret < 0) {
+	goto done;
+    }
+
+    /* move the keys on slots n .. m-1 to the free slots below n */
+    for (i = pp->n, free_slot = 0; i < pp->m; ++i) {
+	if (!taken[i]) {
+	    remap[pp->remap_off + i - pp->n] = 0;
+	    continue;
+	}
+	while (taken[free_slot]) {
+	    ++free_slot;
+	}
+	taken[free_slot] = 1;
+	remap[pp->remap_off + i - pp->n] = (unsigned int)(pp->key_off +
+							  free_slot);
+	slot_key[pp->key_off + free_slot] = high[i - pp->n];
+    }
+
+done:
+    free(order);
+    free(start);
+    free(bysize);
+    free(taken);
+    free(high);
+    return ret;
+}
+
+
+/*
+ * search - thread that builds partitions until none are left
+ */
+static void *
+search(void *arg)
+{
+    size_t i;			/* partition to build */
+    int ret;			/* build_part() return */
+
+    (void) arg;
+    for (;;) {
+	i = __atomic_fetch_add(&next_part, 1, __ATOMIC_RELAXED);
+	if (i >= npart || __atomic_load_n(&failed, __ATOMIC_RELAXED)) {
+	    break;
+	}
+	ret = build_part(&part[i]);
+	if (ret == -2) {
+	    __atomic_store_n(&dup_key, 1, __ATOMIC_RELAXED);
+	}
+	if (ret < 0) {
+	    __atomic_store_n(&failed, 1, __ATOMIC_RELAXED);
+	}
+    }
+    return NULL;
+}
+
+
+/*
+ * build - build the perfect hash with the current seed
+ *
+ * input:
+ *	nthread	- number of search threads
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> try another seed, -2 ==> duplicate keys
+ */
+static int
+build(int nthread)
+{
+    pthread_t tid[MAX_THREADS];	/* search threads */
+    size_t i;
+    size_t p;			/* partition */
+    size_t nbucket = 0;		/* buckets so far */
+    size_t nremap = 0;		/* remap entries so far */
+    int started;		/* threads started */
+
+    /* hash the keys and sort them by partition */
+    for (i = 0; i <= npart; ++i) {
+	part[i].n = 0;
+    }
+    for (i = 0; i < nkey; ++i) {
+	hash[i] = fnv_64a_mix(key[i], keylen[i], seed);
+	++part[part_of(hash[i])].n;
+    }
+    for (p = 0, i = 0; p < npart; ++p) {
+	part[p].key_off = i;
+	i += part[p].n;
+	part[p].n = 0;
+    }
+    for (i = 0; i < nkey; ++i) {
+	p = part_of(hash[i]);
+	bypart[part[p].key_off + part[p].n++] = i;
+    }
+
+    /* size each partition */
+    for (p = 0; p < npart; ++p) {
+	part[p].m = (size_t)((double)part[p].n / alpha);
+	if (part[p].m < part[p].n) {
+	    part[p].m = part[p].n;
+	}
+	if (part[p].m == 0) {
+	    part[p].m = 1;	/* so a lookup in an empty partition works */
+	}
+	part[p].r = (size_t)((double)part[p].n / lambda) + 1;
+	part[p].bucket_off = nbucket;
+	part[p].remap_off = nremap;
+	nbucket += part[p].r;
+	nremap += part[p].m - part[p].n;
+    }
+    part[npart].key_off = nkey;
+    part[npart].bucket_off = nbucket;
+    part[npart].remap_off = nremap;
+    free(pilot);
+    free(remap);
+    pilot = malloc((nbucket + 1) * sizeof(pilot[0]));
+    remap = malloc((nremap + 1) * sizeof(remap[0]));
+    if (pilot == NULL || remap == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(23);
+    }
+
+    /* search the partitions */
+    next_part = 0;
+    failed = 0;
+    dup_key = 0;
+    for (started = 1; started < nthread; ++started) {
+	if (pthread_create(&tid[started], NULL, search, NULL) != 0) {
+	    break;		/* search with the threads we have */
+	}
+    }
+    search(NULL);
+    while (--started > 0) {
+	pthread_join(tid[started], NULL);
+    }
+    if (dup_key) {
+	return -2;
+    }
+    return failed ? -1 : 0;
+}
+
+
+/*
+ * put_key - print a key as a C string literal
+ */
+static void
+put_key(FILE *out, const char *k, size_t len)
+{
+    size_t i;
+    unsigned char c;		/* octet of k */
+
+    putc('"', out);
+    for (i = 0; i < len; ++i) {
+	c = (unsigned char)k[i];
+	if (c == '"' || c == '\\' || c == '?') {
+	    fprintf(out, "\\%c", c);
+	} else if (c < ' ' || c > '~') {
+	    fprintf(out, "\\%03o", c);
+	} else {
+	    putc(c, out);
+	}
+    }
+    putc('"', out);
+}
+
+
+/*
+ * emit - write the header
+ *
+ * input:
+ *	out	- open header stream
+ *	name	- prefix of the names in the header
+ *	keys	- 1 ==> include the keys and check them in lookup()
+ *	bits	- bits of each pilot
+ */
+static void
+emit(FILE *out, char *name, int keys, int bits)
+{
+    char *up;			/* name in upper case */
+    size_t nbucket = part[npart].bucket_off;	/* total buckets */
+    size_t nremap = part[npart].remap_off;	/* total remap entries */
+    size_t i;
+
+    up = strdup(name);
+    if (up == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(24);
+    }
+    for (i = 0; up[i] != '\0'; ++i) {
+	up[i] = (char)toupper((unsigned char)up[i]);
+    }
+
+    fprintf(out,
+	"/*\n"
+	" * minimal perfect hash of %lu keys - generated by fnvmph %s\n"
+	" *\n"
+	" * %lu partitions, %lu buckets, %lu remap entries, %d bit pilots:\n"
+	" * %.2f bits per key, not counting the keys.\n"
+	" *\n"
+	" * %s_lookup(key, len) returns the index, 0 to %s_NKEY-1, of key\n"
+	" * %s.\n"
+	" */\n\n",
+	(unsigned long)nkey, FNV_VERSION, (unsigned long)npart,
+	(unsigned long)nbucket, (unsigned long)nremap, bits,
+	(double)((npart + 1) * 3 * 32 + nbucket * (size_t)bits + nremap * 32) /
+	    (double)nkey,
+	name, up,
+	keys ? "in the keys array, or -1 if it is not a key" :
+	       "among the keys; other strings give an arbitrary index");
+    fprintf(out, "#if !defined(%s_H)\n#define %s_H\n\n", up, up);
+    fprintf(out, "#include <stddef.h>\n#include <stdint.h>\n");
+    if (keys) {
+	fprintf(out, "#include <string.h>\n");
+    }
+    fprintf(out, "\n#define %s_NKEY %lu\n", up, (unsigned long)nkey);
+    fprintf(out, "#define %s_SEED 0x%016llxULL\n\n", up, seed);
+
+    /* partitions: first key, bucket and remap entry, then an end row */
+    fprintf(out, "static const uint32_t %s_part[%lu][3] = {\n",
+	    name, (unsigned long)npart + 1);
+    for (i = 0; i <= npart; ++i) {
+	fprintf(out, "    { %lu, %lu, %lu },\n", (unsigned long)part[i].key_off,
+		(unsigned long)part[i].bucket_off,
+		(unsigned long)part[i].remap_off);
+    }
+    fprintf(out, "};\n\n");
+
+    /* pilots, 8 to a line */
+    fprintf(out, "static const uint%d_t %s_pilot[%lu] = {",
+	    bits, name, (unsigned long)nbucket + 1);
+    for (i = 0; i <= nbucket; ++i) {
+	fprintf(out, "%s%u,", (i % 8 == 0) ? "\n    " : " ",
+		(i < nbucket) ? pilot[i] : 0);
+    }
+    fprintf(out, "\n};\n\n");
+
+    /* remap of slots n .. m-1 of each partition */
+    fprintf(out, "static const uint32_t %s_remap[%lu] = {",
+	    name, (unsigned long)nremap + 1);
+    for (i = 0; i <= nremap; ++i) {
+	fprintf(out, "%s%u,", (i % 8 == 0) ? "\n    " : " ",
+		(i < nremap) ? remap[i] : 0);
+    }
+    fprintf(out, "\n};\n\n");
+
+    /* keys at their index */
+    if (keys) {
+	fprintf(out, "static const char *const %s_keys[%lu] = {\n",
+		name, (unsigned long)nkey);
+	for (i = 0; i < nkey; ++i) {
+	    fprintf(out, "    ");
+	    put_key(out, key[slot_key[i]], keylen[slot_key[i]]);
+	    fprintf(out, ",\n");
+	}
+	fprintf(out, "};\n\n");
+	fprintf(out, "static const uint32_t %s_keylen[%lu] = {",
+		name, (unsigned long)nkey);
+	for (i = 0; i < nkey; ++i) {
+	    fprintf(out, "%s%lu,", (i % 8 == 0) ? "\n    " : " ",
+		    (unsigned long)keylen[slot_key[i]]);
+	}
+	fprintf(out, "\n};\n\n");
+    }
+
+    /* the lookup function */
+    fprintf(out,
+	"static inline uint64_t\n"
+	"%s_mix(uint64_t x)\n"
+	"{\n"
+	"    x ^= x >> 33;\n"
+	"    x *= 0xff51afd7ed558ccdULL;\n"
+	"    x ^= x >> 33;\n"
+	"    x *= 0xc4ceb9fe1a85ec53ULL;\n"
+	"    x ^= x >> 33;\n"
+	"    return x;\n"
+	"}\n\n", name);
+    fprintf(out,
+	"static inline long\n"
+	"%s_lookup(const void *key, size_t len)\n"
+	"{\n"
+	"    const unsigned char *k = (const unsigned char *)key;\n"
+	"    const uint32_t *pp, *pn;\n"
+	"    uint64_t h = 0xcbf29ce484222325ULL;\n"
+	"    uint64_t n, m, b, pos;\n"
+	"    size_t i;\n"
+	"\n"
+	"    for (i = 0; i < len; ++i) {\n"
+	"        h ^= k[i];\n"
+	"        h *= 0x100000001b3ULL;\n"
+	"    }\n"
+	"    h = %s_mix(h ^ %s_SEED);\n"
+	"    pp = %s_part[((h >> 32) * %luULL) >> 32];\n"
+	"    pn = pp + 3;\n"
+	"    n = pn[0] - pp[0];\n"
+	"    m = n + (pn[2] - pp[2]);\n"
+	"    b = h & 0xffffffffULL;\n"
+	"    b = (b + ((b * b) >> 32)) >> 1;\n"
+	"    b = pp[1] + ((b * (pn[1] - pp[1])) >> 32);\n"
+	"    pos = (h ^ %s_mix(%s_pilot[b] + 0x%016llxULL)) * 0x%016llxULL;\n"
+	"    pos = ((pos >> 32) * m) >> 32;\n"
+	"    pos = (pos < n) ? pp[0] + pos : %s_remap[pp[2] + pos - n];\n",
+	name, name, up, name, (unsigned long)npart, name, name,
+	(unsigned long long)PILOT_MIX, (unsigned long long)PILOT_MIX, name);
+    if (keys) {
+	fprintf(out,
+	    "    if (%s_keylen[pos] != len ||\n"
+	    "        memcmp(%s_keys[pos], key, len) != 0) {\n"
+	    "        return -1;\n"
+	    "    }\n", name, name);
+    }
+    fprintf(out,
+	"    return (long)pos;\n"
+	"}\n\n"
+	"#endif /* %s_H */\n", up);
+    free(up);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    char *name = "mph";		/* -p prefix */
+    char *outfile = NULL;	/* -o header or NULL ==> stdout */
+    FILE *out = stdout;		/* open header */
+    long nthread = 0;		/* -j threads, 0 ==> online CPUs */
+    int v_flag = 0;		/* 1 ==> -v report sizes */
+    int n_flag = 0;		/* 1 ==> -n leave out the keys */
+    unsigned int maxpilot = 0;	/* largest pilot */
+    int bits;			/* bits of each pilot */
+    int tries;			/* seeds tried */
+    int ret = -1;		/* build() return */
+    double start;		/* when the search started */
+    double secs;		/* search time */
+    char *end;			/* end of a number */
+    size_t i;
+    int c;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    while ((c = getopt(argc, argv, "hVvnj:p:o:l:a:s:")) != -1) {
+	switch (c) {
+
+	case 'h':	/* -h - print help and exit */
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'v':	/* -v - report sizes and build time */
+	    v_flag = 1;
+	    break;
+
+	case 'n':	/* -n - leave the keys out of the header */
+	    n_flag = 1;
+	    break;
+
+	case 'j':	/* -j threads - search threads */
+	    nthread = strtol(optarg, &end, 10);
+	    if (*end != '\0' || nthread < 1 || nthread > MAX_THREADS) {
+		fprintf(stderr, "%s: -j threads must be > 0 and <= %d\n",
+			prog, MAX_THREADS);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'p':	/* -p prefix - prefix of the names in the header */
+	    name = optarg;
+	    for (i = 0; name[i] != '\0'; ++i) {
+		if (!(isalpha((unsigned char)name[i]) || name[i] == '_' ||
+		      (i > 0 && isdigit((unsigned char)name[i])))) {
+		    break;
+		}
+	    }
+	    if (i == 0 || name[i] != '\0') {
+		fprintf(stderr, "%s: -p prefix must be a C identifier\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'o':	/* -o header - output file */
+	    outfile = optarg;
+	    break;
+
+	case 'l':	/* -l lambda - average keys per bucket */
+	    lambda = strtod(optarg, &end);
+	    if (*end != '\0' || !(lambda >= 1.0 && lambda <= 20.0)) {
+		fprintf(stderr, "%s: -l lambda must be >= 1 and <= 20\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'a':	/* -a alpha - load factor */
+	    alpha = strtod(optarg, &end);
+	    if (*end != '\0' || !(alpha >= 0.5 && alpha <= 1.0)) {
+		fprintf(stderr, "%s: -a alpha must be >= 0.5 and <= 1\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 's':	/* -s seed - first hash seed */
+	    errno = 0;
+	    seed = strtoull(optarg, &end, 0);
+	    if (errno != 0 || *end != '\0') {
+		fprintf(stderr, "%s: -s seed must be a number\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	default:
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(3); /*ooo*/
+	}
+    }
+    if (nthread == 0) {
+	nthread = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthread < 1) {
+	    nthread = 1;
+	} else if (nthread > MAX_THREADS) {
+	    nthread = MAX_THREADS;
+	}
+    }
+
+    /*
+     * read the keys
+     */
+    if (optind == argc) {
+	read_keys("-");
+    }
+    for (; optind < argc; ++optind) {
+	read_keys(argv[optind]);
+    }
+    if (nkey == 0) {
+	fprintf(stderr, "%s: no keys\n", prog);
+	exit(5); /*ooo*/
+    }
+    if (nkey > 0xffffffffUL / 2) {
+	fprintf(stderr, "%s: too many keys\n", prog);
+	exit(5); /*ooo*/
+    }
+
+    /*
+     * search seeds until every partition is built
+     */
+    npart = nkey / PART_KEYS;
+    npart = (npart < 1) ? 1 : npart;
+    part = calloc(npart + 1, sizeof(part[0]));
+    hash = malloc(nkey * sizeof(hash[0]));
+    bypart = malloc(nkey * sizeof(bypart[0]));
+    slot_key = malloc(nkey * sizeof(slot_key[0]));
+    if (part == NULL || hash == NULL || bypart == NULL || slot_key == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(25);
+    }
+    start = now();
+    for (tries = 1; tries <= MAX_SEEDS; ++tries, ++seed) {
+	ret = build((int)nthread);
+	if (ret != -1) {
+	    break;
+	}
+    }
+    secs = now() - start;
+    if (ret == -2) {
+	fprintf(stderr, "%s: duplicate keys\n", prog);
+	exit(5); /*ooo*/
+    } else if (ret != 0) {
+	fprintf(stderr, "%s: no perfect hash found after %d seeds\n",
+		prog, MAX_SEEDS);
+	exit(5); /*ooo*/
+    }
+
+    /*
+     * write the header with the smallest pilot type
+     */
+    for (i = 0; i < part[npart].bucket_off; ++i) {
+	maxpilot = (pilot[i] > maxpilot) ? pilot[i] : maxpilot;
+    }
+    bits = (maxpilot < 0x100) ? 8 : ((maxpilot < 0x10000) ? 16 : 32);
+    if (outfile != NULL) {
+	out = fopen(outfile, "w");
+	if (out == NULL) {
+	    fprintf(stderr, "%s: unable to create: %s: %s\n",
+		    prog, outfile, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+    }
+    emit(out, name, !n_flag, bits);
+    if (fflush(out) != 0 || ferror(out) ||
+	(out != stdout && fclose(out) != 0)) {
+	fprintf(stderr, "%s: error writing: %s\n",
+		prog, (outfile != NULL) ? outfile : "stdout");
+	exit(4); /*ooo*/
+    }
+    if (v_flag) {
+	fprintf(stderr, "%s: %lu keys, %lu partitions, %lu buckets, "
+		"%lu remap entries\n", prog, (unsigned long)nkey,
+		(unsigned long)npart, (unsigned long)part[npart].bucket_off,
+		(unsigned long)part[npart].remap_off);
+	fprintf(stderr, "%s: %d bit pilots (max %u), %.2f bits/key, "
+		"%d seed%s, %ld thread%s, %.3f sec\n", prog, bits, maxpilot,
+		(double)((npart + 1) * 3 * 32 +
+			 part[npart].bucket_off * (size_t)bits +
+			 part[npart].remap_off * 32) / (double)nkey,
+		tries, (tries == 1) ? "" : "s", nthread,
+		(nthread == 1) ? "" : "s", secs);
+    }
+    exit(0); /*ooo*/
+}
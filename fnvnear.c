@@ -0,0 +1,477 @@
+/*
+ * fnvnear - list near-duplicate documents with MinHash, LSH and SimHash
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+#define DEF_HASHES 128		/* default -k MinHash functions */
+#define DEF_BANDS 16		/* default -b LSH bands */
+#define DEF_WORDS 5		/* default -w words in a shingle */
+#define MAX_THREADS 256		/* most -j threads */
+#define BATCH 4096		/* documents hashed at once */
+#define MAX_CAND 65536		/* most candidates listed for a document */
+
+static const char * const usage =
+"usage: %s [-h] [-V] [-k hashes] [-b bands] [-w words] [-m min]\n"
+"	[-d dist] [-s seed] [-j threads] [file ...]\n"
+"\n"
+"    -h         print help and exit\n"
+"    -V         print version and exit\n"
+"\n"
+"    -k hashes  MinHash functions in a signature (default 128)\n"
+"    -b bands   LSH bands, dividing hashes (default 16)\n"
+"    -w words   words in a shingle (default 5)\n"
+"    -m min     list pairs sharing at least min bands (default 1)\n"
+"    -d dist    list pairs whose SimHash fingerprints differ in at most\n"
+"               dist bits (default 64: any)\n"
+"    -s seed    hash seed (default 0)\n"
+"    -j threads number of hashing threads (default: online CPUs)\n"
+"\n"
+"    file       file of documents, one per line (default or -: stdin)\n"
+"\n"
+"Lists candidate near-duplicate pairs of documents as lines of:\n"
+"\n"
+"    first second bands dist\n"
+"\n"
+"where first < second are document numbers, counting lines from 1\n"
+"across the files, bands is the number of LSH bands their MinHash\n"
+"signatures share and dist is the Hamming distance of their SimHash\n"
+"fingerprints.  Pairs are listed as the second document is read.\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening, reading or writing a file\n"
+" >= 20        internal error\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+
+/*
+ * a batch of documents and their hashes
+ */
+struct batch {
+    char *doc[BATCH];		/* document text */
+    size_t len[BATCH];		/* document length */
+    size_t cap[BATCH];		/* allocated octets of doc */
+    size_t nshingle[BATCH];	/* shingles of each document */
+    unsigned long long simhash[BATCH];	/* SimHash of each document */
+    uint32_t *sig;		/* MinHash of each document, k values */
+    size_t n;			/* documents in the batch */
+};
+
+/*
+ * what the hashing threads share
+ */
+struct shared {
+    struct batch *b;		/* batch being hashed */
+    struct fnv_minhash *m;	/* MinHash functions */
+    int k;			/* MinHash functions */
+    int w;			/* words in a shingle */
+    unsigned long long seed;	/* hash seed */
+    int nthread;		/* number of threads */
+};
+struct worker {
+    struct shared *sh;		/* what the threads share */
+    int id;			/* thread number */
+    pthread_t tid;		/* thread */
+};
+
+
+/*
+ * hash_docs - shingle and hash a slice of a batch
+ */
+static void *
+hash_docs(void *arg)
+{
+    struct worker *w = arg;	/* this thread */
+    struct shared *sh = w->sh;	/* what the threads share */
+    struct batch *b = sh->b;	/* the batch */
+    size_t lo = b->n * (size_t)w->id / (size_t)sh->nthread;
+    size_t hi = b->n * (size_t)(w->id + 1) / (size_t)sh->nthread;
+    unsigned long long *shingle = NULL;	/* shingles of a document */
+    size_t max = 0;		/* allocated shingles */
+    size_t i;
+
+    for (i = lo; i < hi; ++i) {
+	if (b->len[i] / 2 + 1 > max) {
+	    max = b->len[i] / 2 + 1;
+	    free(shingle);
+	    shingle = malloc(max * sizeof(shingle[0]));
+	    if (shingle == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(20);
+	    }
+	}
+	b->nshingle[i] = fnv_shingle(b->doc[i], b->len[i], sh->w, sh->seed,
+				     shingle, max);
+	fnv_minhash_sig(sh->m, shingle, b->nshingle[i],
+			b->sig + i * (size_t)sh->k);
+	b->simhash[i] = fnv_simhash(shingle, b->nshingle[i]);
+    }
+    free(shingle);
+    return NULL;
+}
+
+
+/*
+ * hash_batch - hash a batch with all threads
+ */
+static void
+hash_batch(struct shared *sh)
+{
+    struct worker w[MAX_THREADS];	/* threads */
+    int started;		/* threads started */
+    int i;
+
+    for (i = 0; i < sh->nthread; ++i) {
+	w[i].sh = sh;
+	w[i].id = i;
+    }
+    for (started = 1; started < sh->nthread; ++started) {
+	if (pthread_create(&w[started].tid, NULL, hash_docs,
+			   &w[started]) != 0) {
+	    break;
+	}
+    }
+    /* this thread hashes slice 0, and the slices of failed threads */
+    hash_docs(&w[0]);
+    for (i = started; i < sh->nthread; ++i) {
+	hash_docs(&w[i]);
+    }
+    for (i = 1; i < started; ++i) {
+	pthread_join(w[i].tid, NULL);
+    }
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    struct shared sh;		/* what the threads share */
+    struct batch *b;		/* batch of documents */
+    struct fnv_lsh *lsh;	/* LSH index */
+    unsigned long long *simhash = NULL;	/* SimHash of every document */
+    size_t nsim = 0;		/* allocated simhash */
+    uint32_t *cand;		/* candidates of a document */
+    unsigned int *nband;	/* bands each candidate shares */
+    size_t ncand;		/* number of candidates */
+    long bands = DEF_BANDS;	/* -b bands */
+    long k = DEF_HASHES;	/* -k hashes */
+    long w = DEF_WORDS;		/* -w words */
+    long min = 1;		/* -m min bands */
+    long dist = 64;		/* -d dist */
+    long nthread = 0;		/* -j threads, 0 ==> online CPUs */
+    unsigned long long ndoc = 0;	/* documents read */
+    unsigned long long first;	/* number of the batch's first document */
+    FILE *stream;		/* open document file */
+    ssize_t len;		/* length of a line */
+    char *file;			/* document file */
+    char *end;			/* end of a number */
+    int d;			/* SimHash distance */
+    int more;			/* 1 ==> documents left to read */
+    size_t i, j;
+    int c;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    memset(&sh, 0, sizeof(sh));
+    while ((c = getopt(argc, argv, "hVk:b:w:m:d:s:j:")) != -1) {
+	switch (c) {
+
+	case 'h':	/* -h - print help and exit */
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'k':	/* -k hashes - MinHash functions */
+	    k = strtol(optarg, &end, 10);
+	    if (*end != '\0' || k < 1 || k > 4096) {
+		fprintf(stderr, "%s: -k hashes must be > 0 and <= 4096\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'b':	/* -b bands - LSH bands */
+	    bands = strtol(optarg, &end, 10);
+	    if (*end != '\0' || bands < 1 || bands > 4096) {
+		fprintf(stderr, "%s: -b bands must be > 0 and <= 4096\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'w':	/* -w words - words in a shingle */
+	    w = strtol(optarg, &end, 10);
+	    if (*end != '\0' || w < 1 || w > 64) {
+		fprintf(stderr, "%s: -w words must be > 0 and <= 64\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'm':	/* -m min - least bands shared */
+	    min = strtol(optarg, &end, 10);
+	    if (*end != '\0' || min < 1) {
+		fprintf(stderr, "%s: -m min must be > 0\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'd':	/* -d dist - most SimHash bits differing */
+	    dist = strtol(optarg, &end, 10);
+	    if (*end != '\0' || dist < 0 || dist > 64) {
+		fprintf(stderr, "%s: -d dist must be >= 0 and <= 64\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 's':	/* -s seed - hash seed */
+	    errno = 0;
+	    sh.seed = strtoull(optarg, &end, 0);
+	    if (errno != 0 || *end != '\0') {
+		fprintf(stderr, "%s: -s seed must be a number\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'j':	/* -j threads - hashing threads */
+	    nthread = strtol(optarg, &end, 10);
+	    if (*end != '\0' || nthread < 1 || nthread > MAX_THREADS) {
+		fprintf(stderr, "%s: -j threads must be > 0 and <= %d\n",
+			prog, MAX_THREADS);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	default:
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(3); /*ooo*/
+	}
+    }
+    if (bands > k || k % bands != 0) {
+	fprintf(stderr, "%s: -b bands must divide -k hashes\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (nthread == 0) {
+	nthread = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthread < 1) {
+	    nthread = 1;
+	} else if (nthread > MAX_THREADS) {
+	    nthread = MAX_THREADS;
+	}
+    }
+
+    /*
+     * set up
+     */
+    sh.k = (int)k;
+    sh.w = (int)w;
+    sh.nthread = (int)nthread;
+    sh.m = fnv_minhash_new((int)k, sh.seed);
+    lsh = fnv_lsh_new((int)bands, (int)(k / bands));
+    b = calloc(1, sizeof(*b));
+    if (sh.m == NULL || lsh == NULL || b == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(21);
+    }
+    b->sig = malloc(BATCH * (size_t)k * sizeof(b->sig[0]));
+    cand = malloc(MAX_CAND * sizeof(cand[0]));
+    nband = malloc(MAX_CAND * sizeof(nband[0]));
+    if (b->sig == NULL || cand == NULL || nband == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(21);
+    }
+    sh.b = b;
+
+    /*
+     * read, hash and index the documents a batch at a time
+     */
+    file = (optind < argc) ? argv[optind++] : "-";
+    stream = (strcmp(file, "-") == 0) ? stdin : fopen(file, "r");
+    if (stream == NULL) {
+	fprintf(stderr, "%s: unable to open: %s: %s\n",
+		prog, file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    for (more = 1; more; ) {
+
+	/* fill the batch */
+	for (b->n = 0; b->n < BATCH; ) {
+	    len = getline(&b->doc[b->n], &b->cap[b->n], stream);
+	    if (len >= 0) {
+		b->len[b->n++] = (size_t)len;
+		continue;
+	    }
+	    if (ferror(stream)) {
+		fprintf(stderr, "%s: error reading: %s: %s\n",
+			prog, file, strerror(errno));
+		exit(4); /*ooo*/
+	    }
+	    if (stream != stdin) {
+		fclose(stream);
+	    }
+	    if (optind == argc) {
+		more = 0;
+		break;
+	    }
+	    file = argv[optind++];
+	    stream = (strcmp(file, "-") == 0) ? stdin : fopen(file, "r");
+	    if (stream == NULL) {
+		fprintf(stderr, "%s: unable to open: %s: %s\n",
+			prog, file, strerror(errno));
+		exit(4); /*ooo*/
+	    }
+	}
+	if (b->n == 0) {
+	    break;
+	}
+	hash_batch(&sh);
+
+	/* find the candidates of each document, then index it */
+	first = ndoc + 1;
+	ndoc += b->n;
+	if (ndoc > 0xffffffffULL) {
+	    fprintf(stderr, "%s: more than %lu documents\n", prog,
+		    0xffffffffUL);
+	    exit(22);
+	}
+	if (ndoc + 1 > nsim) {
+	    nsim = (nsim == 0) ? 65536 : nsim;
+	    while (nsim < ndoc + 1) {
+		nsim *= 2;
+	    }
+	    simhash = realloc(simhash, nsim * sizeof(simhash[0]));
+	    if (simhash == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(22);
+	    }
+	}
+	for (i = 0; i < b->n; ++i) {
+	    simhash[first + i] = b->simhash[i];
+	    if (b->nshingle[i] == 0) {
+		continue;	/* no words: like every other empty line */
+	    }
+	    ncand = fnv_lsh_query(lsh, b->sig + i * (size_t)k, cand, nband,
+				  MAX_CAND);
+	    if (ncand == (size_t)-1) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(23);
+	    }
+	    for (j = 0; j < ncand; ++j) {
+		d = fnv_simhash_dist(simhash[cand[j]], b->simhash[i]);
+		if (nband[j] >= (unsigned int)min && d <= dist) {
+		    printf("%lu %llu %u %d\n", (unsigned long)cand[j],
+			   first + i, nband[j], d);
+		}
+	    }
+	    if (fnv_lsh_add(lsh, (uint32_t)(first + i),
+			    b->sig + i * (size_t)k) != 0) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(23);
+	    }
+	}
+    }
+    if (fflush(stdout) != 0 || ferror(stdout)) {
+	fprintf(stderr, "%s: error writing output\n", prog);
+	exit(4); /*ooo*/
+    }
+    exit(0); /*ooo*/
+}
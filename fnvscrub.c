@@ -0,0 +1,752 @@
+/*
+ * fnvscrub - rate limited background check of block hash sidecars
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "longlong.h"
+#include "fnv.h"
+
+#define SUFFIX ".fnv"		/* default -x sidecar file suffix */
+#define READ_SIZE (1024*1024)	/* most octets read by one pread(2) */
+#define SAVE_INTERVAL 10.0	/* seconds between -c state saves */
+#define STATE_MAGIC "fnvscrub 1"	/* first line of a -c state file */
+
+static const char * const usage =
+"usage: %s [-h] [-V] [-c statefile] [-i iops] [-l] [-o report]\n"
+"	[-r rate] [-s] [-x suffix] path ...\n"
+"\n"
+"    -h            print help and exit\n"
+"    -V            print version and exit\n"
+"\n"
+"    -c statefile  save the scrub position in statefile and resume from\n"
+"                  it when restarted (removed when a pass completes)\n"
+"    -i iops       read at most iops times a second (default: no limit)\n"
+"    -l            loop: start another pass when a pass completes\n"
+"    -o report     append the corruption report to report (default stderr)\n"
+"    -r rate       read at most rate octets a second (default: no limit)\n"
+"    -s            print a summary of each pass on stderr\n"
+"    -x suffix     sidecar file of file is file+suffix (default .fnv)\n"
+"\n"
+"    rate may end in k, m, g or t for powers of 1024\n"
+"\n"
+"    path          file or directory to scrub (directories are searched\n"
+"                  recursively without following symbolic links)\n"
+"\n"
+"Each file that has a sidecar file written by fnv64 --sidecar is read\n"
+"and the hash of each block is compared with the sidecar.  Files whose\n"
+"size or modification time changed since the sidecar was written are\n"
+"reported as stale rather than checked.\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening or reading file\n"
+"    5         corruption found\n"
+"    6         interrupted, position saved in statefile\n"
+" >= 20        internal error\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+static char **path = NULL;	/* files found, sorted */
+static size_t npath = 0;	/* number of files found */
+static size_t maxpath = 0;	/* allocated paths */
+static char *suffix = SUFFIX;	/* -x suffix */
+static char *state_file = NULL;	/* -c statefile or NULL */
+static FILE *report = NULL;	/* corruption report */
+static int read_err = 0;	/* 1 ==> a file could not be read */
+static volatile sig_atomic_t stop = 0;	/* 1 ==> SIGINT or SIGTERM */
+
+/*
+ * token bucket
+ *
+ * Tokens accrue at rate per second up to burst.  A request may take
+ * more tokens than are present, leaving a debt that is slept off, so
+ * that requests larger than the burst are still paced at rate.
+ */
+struct bucket {
+    double rate;		/* tokens per second, 0 ==> no limit */
+    double burst;		/* most tokens held */
+    double tokens;		/* tokens available, < 0 ==> debt */
+    double last;		/* time of the last refill */
+};
+
+/*
+ * pass totals for -s
+ */
+static struct {
+    unsigned long long files;	/* files checked */
+    unsigned long long nosidecar;	/* files without a sidecar */
+    unsigned long long stale;	/* files changed since their sidecar */
+    unsigned long long blocks;	/* blocks checked */
+    unsigned long long corrupt;	/* blocks that did not match */
+    unsigned long long octets;	/* octets read */
+} total;
+
+
+/*
+ * now - return the monotonic time in seconds
+ */
+static double
+now(void)
+{
+    struct timespec ts;		/* current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+ * bucket_init - set up a token bucket holding up to one second of tokens
+ */
+static void
+bucket_init(struct bucket *b, double rate)
+{
+    b->rate = rate;
+    b->burst = rate;
+    b->tokens = rate;
+    b->last = now();
+}
+
+
+/*
+ * bucket_take - take n tokens from a bucket, sleeping off any debt
+ */
+static void
+bucket_take(struct bucket *b, double n)
+{
+    double t;			/* current time */
+    struct timespec ts;		/* time to sleep */
+    double wait;		/* seconds to sleep */
+
+    if (b->rate <= 0.0) {
+	return;
+    }
+    t = now();
+    b->tokens += (t - b->last) * b->rate;
+    if (b->tokens > b->burst) {
+	b->tokens = b->burst;
+    }
+    b->last = t;
+    b->tokens -= n;
+    if (b->tokens < 0.0 && !stop) {
+	wait = -b->tokens / b->rate;
+	ts.tv_sec = (time_t)wait;
+	ts.tv_nsec = (long)((wait - (double)ts.tv_sec) * 1e9);
+	(void) nanosleep(&ts, NULL);
+    }
+}
+
+
+/*
+ * on_signal - note SIGINT or SIGTERM so that the position can be saved
+ */
+static void
+on_signal(int sig)
+{
+    (void) sig;
+    stop = 1;
+}
+
+
+/*
+ * log_report - append a line to the corruption report
+ */
+static void
+log_report(const char *what, const char *file, const char *detail)
+{
+    time_t t = time(NULL);	/* current time */
+    char stamp[32];		/* ISO 8601 time stamp */
+
+    strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", localtime(&t));
+    fprintf(report, "%s %s %s%s%s\n", stamp, what, file,
+	    (detail != NULL) ? " " : "", (detail != NULL) ? detail : "");
+    fflush(report);
+}
+
+
+/*
+ * add_path - record a regular file
+ */
+static void
+add_path(char *p)
+{
+    if (npath >= maxpath) {
+	maxpath = (maxpath == 0) ? 1024 : maxpath * 2;
+	path = realloc(path, maxpath * sizeof(path[0]));
+	if (path == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(20);
+	}
+    }
+    path[npath] = strdup(p);
+    if (path[npath] == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(21);
+    }
+    ++npath;
+}
+
+
+/*
+ * is_sidecar - 1 ==> p is a sidecar file or a temporary sidecar file
+ */
+static int
+is_sidecar(char *p)
+{
+    size_t len = strlen(p);	/* length of p */
+    size_t slen = strlen(suffix);	/* length of suffix */
+
+    if (len >= slen && strcmp(p + len - slen, suffix) == 0) {
+	return 1;
+    }
+    if (len >= slen + 4 && strncmp(p + len - slen - 4, suffix, slen) == 0 &&
+	strcmp(p + len - 4, ".tmp") == 0) {
+	return 1;
+    }
+    return 0;
+}
+
+
+/*
+ * walk - record the regular files under a path, other than sidecars
+ *
+ * Symbolic links are not followed.
+ */
+static void
+walk(char *p)
+{
+    struct stat st;		/* path status */
+    DIR *dir;			/* open directory */
+    struct dirent *d;		/* directory entry */
+    char *sub;			/* path of a directory entry */
+    size_t len;			/* length of p */
+
+    if (lstat(p, &st) < 0) {
+	fprintf(stderr, "%s: unable to access: %s\n", prog, p);
+	read_err = 1;
+	return;
+    }
+    if (S_ISREG(st.st_mode)) {
+	if (!is_sidecar(p)) {
+	    add_path(p);
+	}
+	return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+	return;
+    }
+    dir = opendir(p);
+    if (dir == NULL) {
+	fprintf(stderr, "%s: unable to open directory: %s\n", prog, p);
+	read_err = 1;
+	return;
+    }
+    len = strlen(p);
+    while ((d = readdir(dir)) != NULL) {
+	if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0) {
+	    continue;
+	}
+	sub = malloc(len + 1 + strlen(d->d_name) + 1);
+	if (sub == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(22);
+	}
+	if (len > 0 && p[len-1] == '/') {
+	    sprintf(sub, "%s%s", p, d->d_name);
+	} else {
+	    sprintf(sub, "%s/%s", p, d->d_name);
+	}
+	walk(sub);
+	free(sub);
+    }
+    closedir(dir);
+}
+
+
+/*
+ * cmp_path - order paths so that a saved position is meaningful
+ */
+static int
+cmp_path(const void *a, const void *b)
+{
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+
+/*
+ * save_state - atomically write the -c state file
+ *
+ * given:
+ *	file	path of the file being scrubbed
+ *	blk	next block of file to check
+ *
+ * NOTE: This function does not return on a write error.
+ */
+static void
+save_state(char *file, off_t blk)
+{
+    char *tmp;			/* temporary file name */
+    FILE *f;			/* open temporary file */
+
+    tmp = malloc(strlen(state_file) + sizeof(".tmp"));
+    if (tmp == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(23);
+    }
+    sprintf(tmp, "%s.tmp", state_file);
+    f = fopen(tmp, "w");
+    if (f == NULL ||
+	fprintf(f, "%s\n%lld\n%s\n", STATE_MAGIC, (long long)blk, file) < 0 ||
+	fflush(f) != 0 || fsync(fileno(f)) < 0 || fclose(f) != 0 ||
+	rename(tmp, state_file) < 0) {
+	fprintf(stderr, "%s: unable to write state file: %s: %s\n",
+		prog, state_file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    free(tmp);
+}
+
+
+/*
+ * load_state - read the -c state file, if any
+ *
+ * given:
+ *	first	where to store the index of the first file to scrub
+ *	blk	where to store the first block of that file to check
+ */
+static void
+load_state(size_t *first, off_t *blk)
+{
+    char line[BUFSIZ];		/* state file line */
+    char *file = NULL;		/* saved file path */
+    long long saved = 0;	/* saved block */
+    FILE *f;			/* open state file */
+    size_t i;
+
+    *first = 0;
+    *blk = 0;
+    f = fopen(state_file, "r");
+    if (f == NULL) {
+	if (errno != ENOENT) {
+	    fprintf(stderr, "%s: unable to read state file: %s: %s\n",
+		    prog, state_file, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+	return;
+    }
+    if (fgets(line, sizeof(line), f) == NULL ||
+	strcmp(line, STATE_MAGIC "\n") != 0 ||
+	fgets(line, sizeof(line), f) == NULL ||
+	sscanf(line, "%lld", &saved) != 1 || saved < 0 ||
+	fgets(line, sizeof(line), f) == NULL) {
+	fprintf(stderr, "%s: invalid state file: %s\n", prog, state_file);
+	exit(4); /*ooo*/
+    }
+    fclose(f);
+    line[strcspn(line, "\n")] = '\0';
+    file = line;
+
+    /*
+     * resume at the saved file, or the file after it if it is gone
+     */
+    for (i = 0; i < npath && strcmp(path[i], file) < 0; ++i) {
+    }
+    *first = i;
+    if (i < npath && strcmp(path[i], file) == 0) {
+	*blk = (off_t)saved;
+    }
+}
+
+
+/*
+ * scrub_file - check one file against its sidecar
+ *
+ * given:
+ *	file	file to check
+ *	first	first block to check
+ *	bytes	octet rate bucket
+ *	ops	read rate bucket
+ *	buf	read buffer of READ_SIZE octets
+ *
+ * returns:
+ *	0 ==> file done, 1 ==> interrupted (position saved)
+ */
+static int
+scrub_file(char *file, off_t first, struct bucket *bytes, struct bucket *ops,
+	   char *buf)
+{
+    struct fnv_sidecar sc;	/* block hashes */
+    struct stat st;		/* file status */
+    char *scfile;		/* sidecar file */
+    char detail[128];		/* report detail */
+    double last_save;		/* time of the last state save */
+    off_t blk;			/* current block */
+    long nsec;			/* nanoseconds of mtime */
+    int err = 0;		/* read errno */
+    int fd;			/* open file */
+
+    /*
+     * read the sidecar
+     */
+    scfile = malloc(strlen(file) + strlen(suffix) + 1);
+    if (scfile == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(24);
+    }
+    sprintf(scfile, "%s%s", file, suffix);
+    if (fnv_sidecar_read(&sc, scfile) < 0) {
+	if (errno == ENOENT) {
+	    ++total.nosidecar;
+	} else {
+	    log_report("error", scfile, strerror(errno));
+	    read_err = 1;
+	}
+	free(scfile);
+	return 0;
+    }
+    free(scfile);
+
+    /*
+     * a changed file is stale, not corrupt
+     */
+    fd = open(file, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) < 0) {
+	log_report("error", file, strerror(errno));
+	read_err = 1;
+	if (fd >= 0) {
+	    close(fd);
+	}
+	fnv_sidecar_free(&sc);
+	return 0;
+    }
+#if defined(__APPLE__)
+    nsec = st.st_mtimespec.tv_nsec;
+#else /* __APPLE__ */
+    nsec = st.st_mtim.tv_nsec;
+#endif /* __APPLE__ */
+    if (st.st_size != sc.size || st.st_mtime != sc.mtime ||
+	nsec != sc.mtime_nsec) {
+	log_report("stale", file, NULL);
+	++total.stale;
+	close(fd);
+	fnv_sidecar_free(&sc);
+	return 0;
+    }
+    ++total.files;
+
+    /*
+     * check each block, pacing the reads
+     */
+    last_save = now();
+    for (blk = first; blk < sc.nblock; ++blk) {
+	off_t pos = blk * sc.blksize;	/* next octet to read */
+	off_t end = pos + sc.blksize;	/* beyond the end of the block */
+	Fnv64_t hval;			/* block hash */
+	ssize_t cnt;			/* octets read */
+	int same;			/* 1 ==> block matches */
+
+	if (stop) {
+	    break;
+	}
+	if (end > sc.size) {
+	    end = sc.size;
+	}
+	hval = (sc.type == FNV0_64) ? FNV0_64_INIT :
+	       ((sc.type == FNV1_64) ? FNV1_64_INIT : FNV1A_64_INIT);
+	while (pos < end) {
+	    size_t want = (end - pos < READ_SIZE) ? (size_t)(end - pos) :
+						   READ_SIZE;
+
+	    bucket_take(ops, 1.0);
+	    bucket_take(bytes, (double)want);
+	    cnt = pread(fd, buf, want, pos);
+	    if (cnt < 0 && errno == EINTR) {
+		continue;
+	    }
+	    if (cnt <= 0) {
+		err = (cnt < 0) ? errno : EIO;
+		break;
+	    }
+	    hval = fnv_buf_64(sc.type, buf, (size_t)cnt, hval);
+	    pos += cnt;
+	    total.octets += (unsigned long long)cnt;
+	}
+	if (pos < end) {
+	    log_report("error", file, strerror(err));
+	    read_err = 1;
+	    break;
+	}
+#if defined(HAVE_64BIT_LONG_LONG)
+	same = (hval == sc.block[blk]);
+#else /* HAVE_64BIT_LONG_LONG */
+	same = (hval.w32[0] == sc.block[blk].w32[0] &&
+		hval.w32[1] == sc.block[blk].w32[1]);
+#endif /* HAVE_64BIT_LONG_LONG */
+	++total.blocks;
+	if (!same) {
+	    snprintf(detail, sizeof(detail), "octets %lld-%lld",
+		     (long long)(blk * sc.blksize), (long long)(end - 1));
+	    log_report("corrupt", file, detail);
+	    ++total.corrupt;
+	}
+	if (state_file != NULL && now() - last_save >= SAVE_INTERVAL) {
+	    save_state(file, blk + 1);
+	    last_save = now();
+	}
+    }
+    close(fd);
+    fnv_sidecar_free(&sc);
+    if (stop) {
+	if (state_file != NULL) {
+	    save_state(file, blk);
+	}
+	return 1;
+    }
+    return 0;
+}
+
+
+/*
+ * main - the main function
+ *
+ * See the above usage for details.
+ */
+int
+main(int argc, char *argv[])
+{
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    char *report_file = NULL;	/* -o report or NULL */
+    off_t rate = 0;		/* -r rate, 0 ==> no limit */
+    int iops = 0;		/* -i iops, 0 ==> no limit */
+    int l_flag = 0;		/* 1 ==> -l loop */
+    int s_flag = 0;		/* 1 ==> -s print pass summary */
+    struct bucket bytes;	/* octet rate bucket */
+    struct bucket ops;		/* read rate bucket */
+    size_t first;		/* first file to scrub */
+    off_t blk;			/* first block of that file */
+    double start;		/* time the pass started */
+    char *buf;			/* read buffer */
+    size_t i;
+    int c;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    while ((c = getopt(argc, argv, "hVc:i:lo:r:sx:")) != -1) {
+	switch (c) {
+
+	case 'h':	/* -h - print help and exit */
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'c':	/* -c statefile - save and resume position */
+	    state_file = optarg;
+	    break;
+
+	case 'i':	/* -i iops - read rate limit */
+	    iops = atoi(optarg);
+	    if (iops < 0) {
+		fprintf(stderr, "%s: -i iops must be >= 0\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'l':	/* -l - loop */
+	    l_flag = 1;
+	    break;
+
+	case 'o':	/* -o report - corruption report file */
+	    report_file = optarg;
+	    break;
+
+	case 'r':	/* -r rate - octet rate limit */
+	    if (fnv_parse_size(optarg, &rate) < 0 || rate < 0) {
+		fprintf(stderr, "%s: invalid -r rate: %s\n", prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 's':	/* -s - print pass summary */
+	    s_flag = 1;
+	    break;
+
+	case 'x':	/* -x suffix - sidecar file suffix */
+	    if (optarg[0] == '\0') {
+		fprintf(stderr, "%s: -x suffix must not be empty\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    suffix = optarg;
+	    break;
+
+	default:
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(3); /*ooo*/
+	}
+    }
+    if (optind >= argc) {
+	fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	exit(3); /*ooo*/
+    }
+    report = stderr;
+    if (report_file != NULL) {
+	report = fopen(report_file, "a");
+	if (report == NULL) {
+	    fprintf(stderr, "%s: unable to open report file: %s: %s\n",
+		    prog, report_file, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+    }
+    buf = malloc(READ_SIZE);
+    if (buf == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(25);
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    /*
+     * find the files to scrub, in a stable order
+     */
+    for (i = optind; i < (size_t)argc; ++i) {
+	walk(argv[i]);
+    }
+    if (npath > 0) {
+	qsort(path, npath, sizeof(path[0]), cmp_path);
+    }
+    first = 0;
+    blk = 0;
+    if (state_file != NULL) {
+	load_state(&first, &blk);
+    }
+    bucket_init(&bytes, (double)rate);
+    bucket_init(&ops, (double)iops);
+
+    /*
+     * scrub passes
+     */
+    do {
+	memset(&total, 0, sizeof(total));
+	start = now();
+	for (i = first; i < npath; ++i, blk = 0) {
+	    if (scrub_file(path[i], blk, &bytes, &ops, buf) != 0) {
+		fprintf(stderr, "%s: interrupted\n", prog);
+		exit(6); /*ooo*/
+	    }
+	}
+	if (state_file != NULL) {
+	    (void) unlink(state_file);
+	}
+	if (s_flag) {
+	    fprintf(stderr, "%s: %llu files checked, %llu without sidecar, "
+		    "%llu stale, %llu blocks, %llu corrupt, %llu octets in "
+		    "%.3f sec\n", prog, total.files, total.nosidecar,
+		    total.stale, total.blocks, total.corrupt, total.octets,
+		    now() - start);
+	}
+	first = 0;
+	blk = 0;
+    } while (l_flag && !stop);
+    if (report != stderr) {
+	fclose(report);
+    }
+    if (total.corrupt > 0) {
+	exit(5); /*ooo*/
+    }
+    exit(read_err ? 4 : 0); /*ooo*/
+}
@@ -0,0 +1,540 @@
+/*
+ * fnvshard - simulate consistent hashing of keys to nodes
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+#define DEF_NODES 10		/* default -n nodes */
+#define DEF_KEYS 1000000	/* default -k keys */
+#define MAX_NODES 100000	/* most nodes */
+
+static const char * const usage =
+"usage: %s [-h] [-V] [-m method] [-n nodes] [-c change] [-k keys]\n"
+"	[-r vnodes] [-w] [keyfile ...]\n"
+"\n"
+"    -h         print help and exit\n"
+"    -V         print version and exit\n"
+"\n"
+"    -m method  jump, hrw or ring (default: all three)\n"
+"    -n nodes   number of nodes before the change (default 10)\n"
+"    -c change  nodes added (+cnt) or removed (-cnt) (default +1)\n"
+"    -k keys    number of generated keys when there is no keyfile\n"
+"               (default 1000000)\n"
+"    -r vnodes  ring points of a node of weight 1 (default 160)\n"
+"    -w         give node i weight 1 + i %% 4 (jump ignores weights)\n"
+"\n"
+"    keyfile    file of keys, one per line (default: key-0, key-1, ...)\n"
+"\n"
+"Nodes node-0, node-1, ... are added and each key is routed to one of\n"
+"them.  Then nodes are added after the last, or removed evenly spaced,\n"
+"and each key is routed again.  For each method a line is printed:\n"
+"\n"
+"    method     consistent hash method\n"
+"    nodes      nodes before and after the change\n"
+"    keys       number of keys\n"
+"    ns/key     nanoseconds per key routed\n"
+"    max        largest node load over its fair share, before and after\n"
+"    stddev     standard deviation of load over fair share, before\n"
+"    moved      percent of keys routed to another node by the change\n"
+"    ideal      least percent of keys the change must move\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening or reading a file\n"
+" >= 20        internal error\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+
+/*
+ * keys read from the key files or generated
+ */
+static const void **key = NULL;	/* start of each key */
+static size_t *keylen = NULL;	/* length of each key */
+static size_t nkey = 0;		/* number of keys */
+static size_t maxkey = 0;	/* allocated keys */
+
+
+/*
+ * add_lines - add the lines of a buffer as keys
+ *
+ * The buffer is kept for as long as the keys are used.
+ */
+static void
+add_lines(char *buf, size_t len)
+{
+    char *p;			/* start of a line */
+    char *nl;			/* end of a line */
+
+    for (p = buf; p < buf + len; p = nl + 1) {
+	nl = memchr(p, '\n', (size_t)(buf + len - p));
+	if (nl == NULL) {
+	    nl = buf + len;	/* last line without a newline */
+	}
+	if (nkey == maxkey) {
+	    maxkey = (maxkey == 0) ? 4096 : maxkey * 2;
+	    key = realloc(key, maxkey * sizeof(key[0]));
+	    keylen = realloc(keylen, maxkey * sizeof(keylen[0]));
+	    if (key == NULL || keylen == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(21);
+	    }
+	}
+	key[nkey] = p;
+	keylen[nkey] = (size_t)(nl - p);
+	++nkey;
+    }
+}
+
+
+/*
+ * read_keys - read the lines of a key file as keys
+ *
+ * input:
+ *	file	- key file, or "-" for stdin
+ */
+static void
+read_keys(char *file)
+{
+    FILE *stream;		/* open key file */
+    char *buf = NULL;		/* file contents */
+    size_t len = 0;		/* octets read */
+    size_t size = 0;		/* octets allocated */
+    size_t n;			/* octets read by fread() */
+
+    stream = (strcmp(file, "-") == 0) ? stdin : fopen(file, "r");
+    if (stream == NULL) {
+	fprintf(stderr, "%s: unable to open: %s: %s\n",
+		prog, file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    do {
+	if (len == size) {
+	    size = (size == 0) ? 65536 : size * 2;
+	    buf = realloc(buf, size);
+	    if (buf == NULL) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(20);
+	    }
+	}
+	n = fread(buf + len, 1, size - len, stream);
+	len += n;
+    } while (n > 0);
+    if (ferror(stream)) {
+	fprintf(stderr, "%s: error reading: %s: %s\n",
+		prog, file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    if (stream != stdin) {
+	fclose(stream);
+    }
+    add_lines(buf, len);
+}
+
+
+/*
+ * make_keys - generate the keys key-0 .. key-(cnt-1)
+ */
+static void
+make_keys(size_t cnt)
+{
+    char *buf;			/* the keys, one per line */
+    size_t len = 0;		/* octets in buf */
+    size_t i;
+
+    buf = malloc(cnt * 24 + 1);
+    if (buf == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(20);
+    }
+    for (i = 0; i < cnt; ++i) {
+	len += (size_t)sprintf(buf + len, "key-%zu\n", i);
+    }
+    add_lines(buf, len);
+}
+
+
+/*
+ * now - the current time in seconds
+ */
+static double
+now(void)
+{
+    struct timespec ts;		/* monotonic time */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+ * balance - load of each node over its fair share
+ *
+ * given:
+ *	s	set of nodes
+ *	id	node id of each key
+ *	weight	weight of each node id, 0 ==> removed
+ *	stddev	where to store the standard deviation of load / fair
+ *
+ * returns:	largest load / fair share of any node
+ */
+static double
+balance(struct fnv_shard *s, const int *id, const double *weight,
+	double *stddev)
+{
+    unsigned long long *load;	/* keys of each node */
+    double total = 0.0;		/* sum of weights */
+    double r;			/* load / fair share of a node */
+    double max = 0.0;		/* largest r */
+    double sum = 0.0;		/* sum of r */
+    double sum2 = 0.0;		/* sum of r * r */
+    int nlive = 0;		/* live nodes */
+    int nid = fnv_shard_ids(s);	/* node ids */
+    size_t i;
+    int j;
+
+    load = calloc((size_t)nid, sizeof(load[0]));
+    if (load == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    for (i = 0; i < nkey; ++i) {
+	++load[id[i]];
+    }
+    for (j = 0; j < nid; ++j) {
+	total += weight[j];
+    }
+    for (j = 0; j < nid; ++j) {
+	if (weight[j] > 0.0) {
+	    r = (double)load[j] / ((double)nkey * weight[j] / total);
+	    max = (r > max) ? r : max;
+	    sum += r;
+	    sum2 += r * r;
+	    ++nlive;
+	}
+    }
+    *stddev = sqrt(fabs(sum2 / nlive - (sum / nlive) * (sum / nlive)));
+    free(load);
+    return max;
+}
+
+
+/*
+ * simulate - route the keys before and after a change of nodes
+ *
+ * given:
+ *	type	consistent hash method
+ *	name	name of the method
+ *	nnode	nodes before the change
+ *	change	nodes added (> 0) or removed (< 0)
+ *	vnodes	ring points of a node of weight 1
+ *	w_flag	1 ==> node i has weight 1 + i % 4
+ */
+static void
+simulate(enum fnv_shard_type type, char *name, int nnode, int change,
+	 unsigned int vnodes, int w_flag)
+{
+    struct fnv_shard *s;	/* set of nodes */
+    int *before;		/* node of each key before the change */
+    int *after;			/* node of each key after the change */
+    double *w0;			/* weight of each node before */
+    double *w1;			/* weight of each node after */
+    int nid = nnode + ((change > 0) ? change : 0);	/* node ids */
+    char node[32];		/* node name */
+    double t0;			/* time before routing */
+    double ns;			/* nanoseconds per key */
+    double max0, max1;		/* largest load / fair share */
+    double dev0, dev1;		/* standard deviation of load / fair share */
+    double tw0 = 0.0, tw1 = 0.0;	/* total weight before and after */
+    double ideal = 0.0;		/* least fraction of keys to move */
+    size_t moved = 0;		/* keys moved */
+    size_t i;
+    int j;
+
+    s = fnv_shard_new(type, vnodes);
+    before = malloc((nkey > 0 ? nkey : 1) * sizeof(before[0]));
+    after = malloc((nkey > 0 ? nkey : 1) * sizeof(after[0]));
+    w0 = calloc((size_t)nid, sizeof(w0[0]));
+    w1 = calloc((size_t)nid, sizeof(w1[0]));
+    if (s == NULL || before == NULL || after == NULL || w0 == NULL ||
+	w1 == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    for (j = 0; j < nnode; ++j) {
+	snprintf(node, sizeof(node), "node-%d", j);
+	w0[j] = (w_flag && type != FNV_SHARD_JUMP) ? 1 + j % 4 : 1;
+	if (fnv_shard_add(s, node, w0[j]) != j) {
+	    fprintf(stderr, "%s: cannot add node: %s\n", prog, strerror(errno));
+	    exit(23);
+	}
+    }
+    memset(before, 0, (nkey > 0 ? nkey : 1) * sizeof(before[0]));
+    t0 = now();
+    fnv_shard_lookup_batch(s, nkey, key, keylen, before);
+    ns = (now() - t0) * 1e9 / (double)(nkey > 0 ? nkey : 1);
+    max0 = balance(s, before, w0, &dev0);
+
+    /* add nodes after the last, or remove nodes evenly spaced */
+    memcpy(w1, w0, (size_t)nid * sizeof(w1[0]));
+    for (j = 0; j < change; ++j) {
+	snprintf(node, sizeof(node), "node-%d", nnode + j);
+	w1[nnode+j] = (w_flag && type != FNV_SHARD_JUMP) ?
+		      1 + (nnode + j) % 4 : 1;
+	if (fnv_shard_add(s, node, w1[nnode+j]) < 0) {
+	    fprintf(stderr, "%s: cannot add node: %s\n", prog, strerror(errno));
+	    exit(23);
+	}
+    }
+    for (j = 0; j < -change; ++j) {
+	int id = (int)((2LL * j + 1) * nnode / (-2LL * change));	/* node */
+
+	snprintf(node, sizeof(node), "node-%d", id);
+	w1[id] = 0.0;
+	if (fnv_shard_del(s, node) < 0) {
+	    fprintf(stderr, "%s: cannot remove node: %s\n", prog,
+		    strerror(errno));
+	    exit(23);
+	}
+    }
+    fnv_shard_lookup_batch(s, nkey, key, keylen, after);
+    max1 = balance(s, after, w1, &dev1);
+    for (i = 0; i < nkey; ++i) {
+	moved += (before[i] != after[i]);
+    }
+
+    /* half the change in the shares of all nodes must move */
+    for (j = 0; j < nid; ++j) {
+	tw0 += w0[j];
+	tw1 += w1[j];
+    }
+    for (j = 0; j < nid; ++j) {
+	ideal += fabs(w1[j] / tw1 - w0[j] / tw0) / 2.0;
+    }
+
+    printf("%-6s %5d->%-5d %9zu %7.1f %6.3f %6.3f %6.2f%% %6.2f%% %6.2f%%\n",
+	   name, nnode, nnode + change, nkey, ns, max0, max1, 100.0 * dev0,
+	   100.0 * (double)moved / (double)(nkey > 0 ? nkey : 1),
+	   100.0 * ideal);
+    fnv_shard_free(s);
+    free(before);
+    free(after);
+    free(w0);
+    free(w1);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    char *method = NULL;	/* -m method or NULL ==> all */
+    long nnode = DEF_NODES;	/* -n nodes */
+    long change = 1;		/* -c change */
+    unsigned long long cnt = DEF_KEYS;	/* -k keys */
+    long vnodes = 0;		/* -r vnodes, 0 ==> library default */
+    int w_flag = 0;		/* 1 ==> -w weighted nodes */
+    char *end;			/* end of a number */
+    int c;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    while ((c = getopt(argc, argv, "hVm:n:c:k:r:w")) != -1) {
+	switch (c) {
+
+	case 'h':	/* -h - print help and exit */
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'm':	/* -m method - consistent hash method */
+	    method = optarg;
+	    if (strcmp(method, "jump") != 0 && strcmp(method, "hrw") != 0 &&
+		strcmp(method, "ring") != 0) {
+		fprintf(stderr, "%s: -m method must be jump, hrw or ring\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'n':	/* -n nodes - nodes before the change */
+	    nnode = strtol(optarg, &end, 10);
+	    if (*end != '\0' || nnode < 1 || nnode > MAX_NODES) {
+		fprintf(stderr, "%s: -n nodes must be > 0 and <= %d\n",
+			prog, MAX_NODES);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'c':	/* -c change - nodes added or removed */
+	    change = strtol(optarg, &end, 10);
+	    if (*end != '\0' || change == 0 || labs(change) > MAX_NODES) {
+		fprintf(stderr, "%s: -c change must be +cnt or -cnt\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'k':	/* -k keys - number of generated keys */
+	    errno = 0;
+	    cnt = strtoull(optarg, &end, 10);
+	    if (errno != 0 || *end != '\0' || cnt == 0) {
+		fprintf(stderr, "%s: -k keys must be > 0\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'r':	/* -r vnodes - ring points per node */
+	    vnodes = strtol(optarg, &end, 10);
+	    if (*end != '\0' || vnodes < 1 || vnodes > 100000) {
+		fprintf(stderr, "%s: -r vnodes must be > 0 and <= 100000\n",
+			prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case 'w':	/* -w - weighted nodes */
+	    w_flag = 1;
+	    break;
+
+	default:
+	    fprintf(stderr, usage, prog, prog, FNV_VERSION);
+	    exit(3); /*ooo*/
+	}
+    }
+    if (change < 0 && -change >= nnode) {
+	fprintf(stderr, "%s: -c change must leave at least one node\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (change > 0 && nnode + change > MAX_NODES) {
+	fprintf(stderr, "%s: at most %d nodes\n", prog, MAX_NODES);
+	exit(3); /*ooo*/
+    }
+
+    /*
+     * read or generate the keys
+     */
+    if (optind == argc) {
+	make_keys((size_t)cnt);
+    }
+    for (; optind < argc; ++optind) {
+	read_keys(argv[optind]);
+    }
+
+    /*
+     * route the keys with each method
+     */
+    printf("%-6s %12s %9s %7s %6s %6s %7s %7s %7s\n", "method", "nodes",
+	   "keys", "ns/key", "max", "max'", "stddev", "moved", "ideal");
+    if (method == NULL || strcmp(method, "jump") == 0) {
+	simulate(FNV_SHARD_JUMP, "jump", (int)nnode, (int)change,
+		 (unsigned int)vnodes, w_flag);
+    }
+    if (method == NULL || strcmp(method, "hrw") == 0) {
+	simulate(FNV_SHARD_HRW, "hrw", (int)nnode, (int)change,
+		 (unsigned int)vnodes, w_flag);
+    }
+    if (method == NULL || strcmp(method, "ring") == 0) {
+	simulate(FNV_SHARD_RING, "ring", (int)nnode, (int)change,
+		 (unsigned int)vnodes, w_flag);
+    }
+    if (fflush(stdout) != 0 || ferror(stdout)) {
+	fprintf(stderr, "%s: error writing output\n", prog);
+	exit(4); /*ooo*/
+    }
+    exit(0); /*ooo*/
+}
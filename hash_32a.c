@@ -161,3 +161,37 @@ fnv_32a_str(char *str, Fnv32_t hval)
     /* return our new hash value */
     return hval;
 }
+
+
+
+/*
+ * fnv_32a_zeros - perform a 32 bit Fowler/Noll/Vo FNV-1a hash on a run of zero octets
+ *
+ * input:
+ *	hval	- previous hash value
+ *	n	- number of zero octets, <= 0 ==> none
+ *
+ * returns:
+ *	32 bit hash as a static hash type, the same value as fnv_32a_buf() would
+ *	return for a buffer of n zero octets
+ *
+ * Hashing a zero octet only multiplies the hash by the FNV prime, so n
+ * zero octets multiply it by prime^n mod 2^32.  This is computed by
+ * exponentiation by squaring, taking O(log n) time.
+ */
+Fnv32_t
+fnv_32a_zeros(Fnv32_t hval, off_t n)
+{
+    Fnv32_t pow = FNV_32_PRIME;		/* prime^(2^i) mod 2^32 */
+
+    while (n > 0) {
+	if (n & 1) {
+	    hval *= pow;
+	}
+	pow *= pow;
+	n >>= 1;
+    }
+
+    /* return our new hash value */
+    return hval;
+}
@@ -322,3 +322,119 @@ fnv_64_str(char *str, Fnv64_t hval)
     /* return our new hash value */
     return hval;
 }
+
+
+
+#if !defined(HAVE_64BIT_LONG_LONG)
+/*
+ * mul_64 - multiply two base 2^16 arrays mod 2^64
+ *
+ * given:
+ *	val	- 64 bit value in base 2^16, replaced by val * mul mod 2^64
+ *	mul	- 64 bit multiplier in base 2^16
+ */
+static void
+mul_64(unsigned long *val, unsigned long *mul)
+{
+    unsigned long tmp[4];	/* product in base 2^16, before carries */
+    unsigned long prod;		/* product of two digits */
+    int i;
+    int j;
+
+    tmp[0] = tmp[1] = tmp[2] = tmp[3] = 0;
+    for (i = 0; i < 4; ++i) {
+	for (j = 0; i+j < 4; ++j) {
+	    prod = val[i] * mul[j];
+	    tmp[i+j] += prod & 0xffff;
+	    if (i+j < 3) {
+		tmp[i+j+1] += prod >> 16;
+	    }
+	}
+    }
+    /* propagate carries */
+    tmp[1] += (tmp[0] >> 16);
+    val[0] = tmp[0] & 0xffff;
+    tmp[2] += (tmp[1] >> 16);
+    val[1] = tmp[1] & 0xffff;
+    tmp[3] += (tmp[2] >> 16);
+    val[2] = tmp[2] & 0xffff;
+    val[3] = tmp[3] & 0xffff;
+}
+#endif /* HAVE_64BIT_LONG_LONG */
+
+
+/*
+ * fnv_64_zeros - perform a 64 bit Fowler/Noll/Vo FNV-1 hash on a run of zero octets
+ *
+ * input:
+ *	hval	- previous hash value
+ *	n	- number of zero octets, <= 0 ==> none
+ *
+ * returns:
+ *	64 bit hash as a static hash type, the same value as fnv_64_buf() would
+ *	return for a buffer of n zero octets
+ *
+ * Hashing a zero octet only multiplies the hash by the FNV prime, so n
+ * zero octets multiply it by prime^n mod 2^64.  This is computed by
+ * exponentiation by squaring, taking O(log n) time.  This allows holes
+ * in sparse files to be hashed without reading them.
+ */
+Fnv64_t
+fnv_64_zeros(Fnv64_t hval, off_t n)
+{
+#if defined(HAVE_64BIT_LONG_LONG)
+    Fnv64_t pow = FNV_64_PRIME;		/* prime^(2^i) mod 2^64 */
+
+    while (n > 0) {
+	if (n & 1) {
+	    hval *= pow;
+	}
+	pow *= pow;
+	n >>= 1;
+    }
+
+#else /* HAVE_64BIT_LONG_LONG */
+
+    unsigned long val[4];		/* hash value in base 2^16 */
+    unsigned long pow[4];		/* prime^(2^i) mod 2^64 in base 2^16 */
+    unsigned long sq[4];		/* copy of pow to square it */
+
+    /*
+     * Convert Fnv64_t hval into a base 2^16 array
+     */
+    val[0] = hval.w32[0] & 0xffff;
+    val[1] = (hval.w32[0] >> 16) & 0xffff;
+    val[2] = hval.w32[1] & 0xffff;
+    val[3] = (hval.w32[1] >> 16) & 0xffff;
+
+    /*
+     * 0x100000001b3 in base 2^16
+     */
+    pow[0] = FNV_64_PRIME_LOW;
+    pow[1] = 0;
+    pow[2] = 1UL << FNV_64_PRIME_SHIFT;
+    pow[3] = 0;
+
+    while (n > 0) {
+	if (n & 1) {
+	    mul_64(val, pow);
+	}
+	sq[0] = pow[0];
+	sq[1] = pow[1];
+	sq[2] = pow[2];
+	sq[3] = pow[3];
+	mul_64(pow, sq);
+	n >>= 1;
+    }
+
+    /*
+     * Convert base 2^16 array back into an Fnv64_t
+     */
+    hval.w32[1] = ((val[3]<<16) | val[2]);
+    hval.w32[0] = ((val[1]<<16) | val[0]);
+
+#endif /* HAVE_64BIT_LONG_LONG */
+
+    /* return our new hash value */
+    return hval;
+}
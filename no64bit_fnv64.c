@@ -0,0 +1,3294 @@
+/*
+ * fnv_64 - 64 bit Fowler/Noll/Vo hash of a buffer or string
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+#if defined(__linux__)
+#define _GNU_SOURCE		/* for tee(2) and splice(2) */
+#endif /* __linux__ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <time.h>
+#include <signal.h>
+#include <pthread.h>
+#include <math.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif /* __linux__ */
+#include "longlong.h"
+#include "fnv.h"
+
+#define WIDTH 64		/* bit width of hash */
+
+#define BUF_SIZE (32*1024)	/* number of bytes to hash at a time */
+#define READER_BUFS 4		/* --pipeline ring buffers */
+#define READER_BUF_SIZE (1024*1024)	/* --pipeline ring buffer size */
+#define SAMPLE_SIZE (64*1024)	/* default --sample-size block size */
+#define TEE_WINDOW (8*1024*1024)	/* --tee mmap window size */
+#define CKPT_EVERY ((off_t)1 << 30)	/* default --every checkpoint interval */
+#define SIDECAR_BLKSIZE (1024*1024)	/* default --block-size */
+#define SERVE_IN_SIZE (256*1024)	/* --serve input buffer size */
+#define SERVE_OUT_SIZE (64*1024)	/* --serve response buffer size */
+#define WATCH_DEBOUNCE 200	/* default --debounce in milliseconds */
+#define TOPK_MAX (1024*1024)	/* largest --topk */
+#define DISTINCT_P 14		/* --distinct uses 2^14 one octet registers */
+
+static const char * const usage =
+"usage: %s [-h] [-v] [-V] [-b bcnt] [-m] [-s arg] [-t code]\n"
+"	[--cache file [--cache-stats]] [--offset off] [--length len]\n"
+"	[--sample cnt [--sample-size size]] [--tee[=hashfile]]\n"
+"	[--progress] [--stats=statsfile] [--pipeline]\n"
+"	[--checkpoint ckfile [--every size]] [--resume ckfile] [arg ...]\n"
+"   or: %s --sidecar scfile [--block-size size] file\n"
+"   or: %s --verify scfile [--threads n] [--offset off] [--length len] file\n"
+"   or: %s --tree statefile dir\n"
+"   or: %s --tree-diff tree1 tree2\n"
+"   or: %s --watch mfile [--threads n] [--debounce ms] dir\n"
+"   or: %s --lookup mfile path ...\n"
+"   or: %s --tar [tarfile]\n"
+"   or: %s -l [-b bcnt] [-v] [--topk n | --distinct] [--threads n]\n"
+"	[file ...]\n"
+"   or: %s --serve\n"
+"\n"
+"    -h         print help and exit\n"
+"    -v         verbose mode, print arg after hash (implies -m)\n"
+"    -V         print version and exit\n"
+"\n"
+"    -b bcnt    mask off all but the lower bcnt bits (default 64)\n"
+"    -m         multiple hashes, one per line for each arg\n"
+"    -s arg     hash arg as a string (ignoring terminating NUL bytes)\n"
+"    -t code    test hash code: (0 ==> generate test vectors\n"
+"                                1 ==> validate against FNV test vectors)\n"
+"\n";
+static const char * const usage_opts =
+"    --cache file    consult and update the file hash cache in file\n"
+"                    (only the first file arg: each later one continues\n"
+"                    the hash of the args before it)\n"
+"    --cache-stats   print cache hit rate on stderr when done\n"
+"\n"
+"    --offset off    hash only from octet offset off (default 0)\n"
+"    --length len    hash at most len octets (default until EOF)\n"
+"    --sample cnt    fingerprint: hash the file size and cnt evenly spaced\n"
+"                    blocks instead of the whole file\n"
+"    --sample-size size  size of each --sample block (default 64k)\n"
+"\n"
+"    off, len and size may end in k, m, g or t for powers of 1024\n"
+"\n"
+"    --tee[=hashfile]  copy stdin to stdout unchanged and print the hash\n"
+"                      on stderr (or write it to hashfile) at EOF\n"
+"\n"
+"    --progress        print octets hashed, rate and ETA on stderr\n"
+"    --stats=statsfile write name=value totals, syscall counts and\n"
+"                      time spent in open, read and hashing when done\n"
+"                      (statsfile of - ==> stderr)\n"
+"\n"
+"    --pipeline      read with a separate thread so that I/O overlaps hashing\n"
+"\n"
+"    --checkpoint ckfile  save the hash state of a single input to ckfile\n"
+"                         every size octets hashed and at EOF\n"
+"    --every size    octets between checkpoints (default 1g)\n"
+"    --resume ckfile continue hashing from the state saved in ckfile, if\n"
+"                    it exists (a non-seekable input is assumed to start\n"
+"                    at the saved offset)\n"
+"\n"
+"    --sidecar scfile  write the hash of each block of file and of the\n"
+"                      whole file to scfile, print the whole file hash\n"
+"    --block-size size size of each --sidecar block (default 1m)\n"
+"    --verify scfile   check file, or the --offset/--length range of it,\n"
+"                      against the block hashes in scfile\n"
+"    --threads n       number of --verify threads (default: online CPUs)\n"
+"\n"
+"    --tree statefile  print the Merkle hash of directory dir, reading\n"
+"                      only files changed since statefile was written,\n"
+"                      then update statefile\n"
+"    --tree-diff       compare two trees (state files or directories)\n"
+"                      from the top down, printing differing paths\n"
+"\n"
+"    --watch mfile     hash every file below dir into the manifest mfile,\n"
+"                      then re-hash files as they change until SIGINT or\n"
+"                      SIGTERM (-v prints each change)\n"
+"    --threads n       number of --watch threads (default: online CPUs)\n"
+"    --debounce ms     quiet time before a changed file is hashed\n"
+"                      (default 200)\n"
+"    --lookup mfile    print the hash of each path (relative to dir) from\n"
+"                      the manifest mfile of a running --watch\n"
+"\n"
+"    --tar           print the hash and path of each regular member of\n"
+"                    a ustar or pax archive (default stdin) in one pass\n"
+"\n"
+"    -l              print the hash of each line of each file (default\n"
+"                    stdin), without its newline (-v prints the line)\n"
+"    --topk n        print the n most frequent lines, most frequent first,\n"
+"                    as count and line in bounded memory (-v also prints\n"
+"                    the most each count may be over)\n"
+"    --distinct      print an estimate of the number of distinct lines,\n"
+"                    in one pass and 16k of memory (-v also prints the\n"
+"                    relative standard error)\n"
+"    --threads n     number of --topk or --distinct threads for regular\n"
+"                    files (default: online CPUs)\n"
+"\n"
+"    --serve         coprocess mode: answer binary hash requests on stdin\n"
+"                    with binary responses on stdout until EOF\n"
+"\n";
+static const char * const usage_tail =
+"    arg        string (if -s was given) or filename (default stdin)\n"
+"\n"
+"Exit codes:\n"
+"    0         all OK\n"
+"    2         -h and help string printed or -V and version string printed\n"
+"    3         command line error\n"
+"    4         error on opening or reading file\n"
+"    5         --verify found a mismatch, --tree-diff a difference or\n"
+"              --lookup a path not in the manifest\n"
+" >= 10        test suite error\n"
+" >= 20        internal error\n"
+"\n"
+"NOTE: Programs that begin with fnv0 implement the FNV-0 hash.\n"
+"      The FNV-0 hash is historic FNV algorithm that is now deprecated.\n"
+"\n"
+"For more info, see:\n"
+"\n"
+"    http://www.isthe.com/chongo/tech/comp/fnv/index.html\n"
+"    https://github.com/lcn2/fnv\n"
+"\n"
+"%s version: %s\n";
+static char *program = NULL;	/* our name */
+static char *prog = NULL;	/* basename of our name */
+static struct fnv_cache *cache = NULL;	/* open --cache file or NULL */
+static int pipeline = 0;	/* 1 ==> --pipeline read ahead thread */
+static off_t range_offset = 0;	/* --offset octet offset */
+static off_t range_length = -1;	/* --length octets, < 0 ==> until EOF */
+static int sample_cnt = 0;	/* --sample block count, 0 ==> no sampling */
+static off_t sample_size = SAMPLE_SIZE;	/* --sample-size block size */
+static char *ckpt_file = NULL;	/* --checkpoint file or NULL */
+static off_t ckpt_every = CKPT_EVERY;	/* --every checkpoint interval */
+static struct fnv_ctx ckpt;	/* --checkpoint and --resume hash state */
+
+/*
+ * --stats and --progress counters
+ */
+static struct {
+    int timed;			/* 1 ==> time system calls and hashing */
+    int progress;		/* 1 ==> --progress */
+    const char *io_path;	/* how input was read */
+    unsigned long long files;	/* files hashed */
+    unsigned long long bytes;	/* octets hashed */
+    unsigned long long total;	/* octets expected, 0 ==> unknown */
+    unsigned long long open_calls;	/* open(2) calls */
+    unsigned long long read_calls;	/* read(2), pread(2) or similar calls */
+    double open_time;		/* seconds spent in open(2) */
+    double read_time;		/* seconds spent reading */
+    double hash_time;		/* seconds spent in the hash kernel */
+    double start;		/* time we started */
+    double next_progress;	/* when to print --progress next */
+} stats = { 0, 0, "read" };
+
+/*
+ * long only options
+ */
+enum long_opt {
+    OPT_CACHE = 256,		/* --cache file */
+    OPT_CACHE_STATS,		/* --cache-stats */
+    OPT_OFFSET,			/* --offset off */
+    OPT_LENGTH,			/* --length len */
+    OPT_SAMPLE,			/* --sample cnt */
+    OPT_SAMPLE_SIZE,		/* --sample-size size */
+    OPT_TEE,			/* --tee[=hashfile] */
+    OPT_PROGRESS,		/* --progress */
+    OPT_STATS,			/* --stats=statsfile */
+    OPT_PIPELINE,		/* --pipeline */
+    OPT_SERVE,			/* --serve */
+    OPT_CHECKPOINT,		/* --checkpoint ckfile */
+    OPT_EVERY,			/* --every size */
+    OPT_RESUME,			/* --resume ckfile */
+    OPT_SIDECAR,		/* --sidecar scfile */
+    OPT_BLOCK_SIZE,		/* --block-size size */
+    OPT_VERIFY,			/* --verify scfile */
+    OPT_THREADS,		/* --threads n */
+    OPT_TREE,			/* --tree statefile */
+    OPT_TREE_DIFF,		/* --tree-diff */
+    OPT_WATCH,			/* --watch mfile */
+    OPT_DEBOUNCE,		/* --debounce ms */
+    OPT_LOOKUP,			/* --lookup mfile */
+    OPT_TAR,			/* --tar */
+    OPT_TOPK,			/* --topk n */
+    OPT_DISTINCT,		/* --distinct */
+};
+static const struct option long_opts[] = {
+    {"cache", required_argument, NULL, OPT_CACHE},
+    {"cache-stats", no_argument, NULL, OPT_CACHE_STATS},
+    {"offset", required_argument, NULL, OPT_OFFSET},
+    {"length", required_argument, NULL, OPT_LENGTH},
+    {"sample", required_argument, NULL, OPT_SAMPLE},
+    {"sample-size", required_argument, NULL, OPT_SAMPLE_SIZE},
+    {"tee", optional_argument, NULL, OPT_TEE},
+    {"progress", no_argument, NULL, OPT_PROGRESS},
+    {"stats", required_argument, NULL, OPT_STATS},
+    {"pipeline", no_argument, NULL, OPT_PIPELINE},
+    {"serve", no_argument, NULL, OPT_SERVE},
+    {"checkpoint", required_argument, NULL, OPT_CHECKPOINT},
+    {"every", required_argument, NULL, OPT_EVERY},
+    {"resume", required_argument, NULL, OPT_RESUME},
+    {"sidecar", required_argument, NULL, OPT_SIDECAR},
+    {"block-size", required_argument, NULL, OPT_BLOCK_SIZE},
+    {"verify", required_argument, NULL, OPT_VERIFY},
+    {"threads", required_argument, NULL, OPT_THREADS},
+    {"tree", required_argument, NULL, OPT_TREE},
+    {"tree-diff", no_argument, NULL, OPT_TREE_DIFF},
+    {"watch", required_argument, NULL, OPT_WATCH},
+    {"debounce", required_argument, NULL, OPT_DEBOUNCE},
+    {"lookup", required_argument, NULL, OPT_LOOKUP},
+    {"tar", no_argument, NULL, OPT_TAR},
+    {"topk", required_argument, NULL, OPT_TOPK},
+    {"distinct", no_argument, NULL, OPT_DISTINCT},
+    {NULL, 0, NULL, 0}
+};
+
+
+/*
+ * print_usage - print the usage message on stderr
+ *
+ * The message is split into several strings, each shorter than the
+ * 4095 octets that ISO C99 compilers are required to support.
+ */
+static void
+print_usage(void)
+{
+    fprintf(stderr, usage, prog, prog, prog, prog, prog, prog, prog, prog,
+	    prog,
+	    prog);
+    fputs(usage_opts, stderr);
+    fprintf(stderr, usage_tail, prog, FNV_VERSION);
+}
+
+
+/*
+ * test_fnv64 - test the FNV64 hash
+ *
+ * given:
+ *	hash_type	type of FNV hash to test
+ *	init_hval	initial hash value
+ *	mask		lower bit mask
+ *	v_flag		1 => print test failure info on stderr
+ *	code	  0 ==> generate FNV test vectors
+ *		  1 ==> validate against FNV test vectors
+ *
+ * returns:	0 ==> OK, else test vector failure number
+ */
+static int
+test_fnv64(enum fnv_type hash_type, Fnv64_t init_hval,
+	   Fnv64_t mask, int v_flag, int code)
+{
+    struct test_vector *t;	/* FNV test vestor */
+    Fnv64_t hval;		/* current hash value */
+    int tstnum;			/* test vector that failed, starting at 1 */
+
+    /*
+     * print preamble if generating test vectors
+     */
+    if (code == 0) {
+	switch (hash_type) {
+	case FNV0_64:
+	    printf("struct fnv0_64_test_vector fnv0_64_vector[] = {\n");
+	    break;
+	case FNV1_64:
+	    printf("struct fnv1_64_test_vector fnv1_64_vector[] = {\n");
+	    break;
+	case FNV1a_64:
+	    printf("struct fnv1a_64_test_vector fnv1a_64_vector[] = {\n");
+	    break;
+	default:
+	    unknown_hash_type(prog, hash_type);
+	    exit(10); /*coo*/
+	    /*NOTREACHED*/
+	}
+    }
+
+    /*
+     * loop thru all test vectors
+     */
+    for (t = fnv_test_str, tstnum = 1; t->buf != NULL; ++t, ++tstnum) {
+
+        /*
+	 * compute the FNV hash
+	 */
+	hval = init_hval;
+	switch (hash_type) {
+	case FNV0_64:
+	case FNV1_64:
+	    hval = fnv_64_buf(t->buf, t->len, hval);
+	    break;
+	case FNV1a_64:
+	    hval = fnv_64a_buf(t->buf, t->len, hval);
+	    break;
+	default:
+	    unknown_hash_type(prog, hash_type);
+	    exit(11);
+	    /*NOTREACHED*/
+	}
+
+	/*
+	 * print the vector
+	 */
+#if defined(HAVE_64BIT_LONG_LONG)
+	/*
+	 * HAVE_64BIT_LONG_LONG testing
+	 */
+	switch (code) {
+	case 0:		/* generate the test vector */
+	    printf("    { &fnv_test_str[%d], (Fnv64_t) 0x%016llxUL },\n",
+		   tstnum-1, (unsigned long long)(hval & mask));
+	    break;
+
+	case 1:		/* validate against test vector */
+	    switch (hash_type) {
+	    case FNV0_64:
+		if ((hval&mask) != (fnv0_64_vector[tstnum-1].fnv0_64 & mask)) {
+		    if (v_flag) {
+			fprintf(stderr, "%s: failed fnv0_64 test # %d\n",
+				prog, tstnum);
+			fprintf(stderr, "%s: test # 1 is 1st test\n", prog);
+			fprintf(stderr,
+			    "%s: expected 0x%016llx != generated: 0x%016llx\n",
+			    prog,
+			    (unsigned long long)(hval&mask),
+			    (unsigned long long)(fnv0_64_vector[tstnum-1].fnv0_64 & mask));
+		    }
+		    return tstnum;
+		}
+		break;
+	    case FNV1_64:
+		if ((hval&mask) != (fnv1_64_vector[tstnum-1].fnv1_64 & mask)) {
+		    if (v_flag) {
+			fprintf(stderr, "%s: failed fnv1_64 test # %d\n",
+				prog, tstnum);
+			fprintf(stderr, "%s: test # 1 is 1st test\n", prog);
+			fprintf(stderr,
+			    "%s: expected 0x%016llx != generated: 0x%016llx\n",
+			    prog,
+			    (unsigned long long)(hval&mask),
+			    (unsigned long long)(fnv1_64_vector[tstnum-1].fnv1_64 & mask));
+		    }
+		    return tstnum;
+		}
+		break;
+	    case FNV1a_64:
+		if ((hval&mask) != (fnv1a_64_vector[tstnum-1].fnv1a_64 &mask)) {
+		    if (v_flag) {
+			fprintf(stderr, "%s: failed fnv1a_64 test # %d\n",
+				prog, tstnum);
+			fprintf(stderr, "%s: test # 1 is 1st test\n", prog);
+			fprintf(stderr,
+			    "%s: expected 0x%016llx != generated: 0x%016llx\n",
+			    prog,
+			    (unsigned long long)(hval&mask),
+			    (unsigned long long)(fnv1a_64_vector[tstnum-1].fnv1a_64 & mask));
+		    }
+		    return tstnum;
+		}
+		break;
+	    default:
+		break;
+	    }
+	    break;
+
+	default:
+	    fprintf(stderr, "%s: -m %d not implemented yet\n", prog, code);
+	    exit(12);
+	}
+#else /* HAVE_64BIT_LONG_LONG */
+	/*
+	 * non HAVE_64BIT_LONG_LONG testing
+	 */
+	switch (code) {
+	case 0:		/* generate the test vector */
+	    printf("    { &fnv_test_str[%d], "
+		   "(Fnv64_t) {0x%08xUL, 0x%08xUL} },\n",
+		   tstnum-1,
+		   (hval.w32[0] & mask.w32[0]),
+		   (hval.w32[1] & mask.w32[1]));
+	    break;
+
+	case 1:		/* validate against test vector */
+	    switch (hash_type) {
+	    case FNV0_64:
+		if (((hval.w32[0] & mask.w32[0]) !=
+		     (fnv0_64_vector[tstnum-1].fnv0_64.w32[0] &
+		      mask.w32[0])) &&
+		    ((hval.w32[1] & mask.w32[1]) !=
+		     (fnv0_64_vector[tstnum-1].fnv0_64.w32[1] &
+		      mask.w32[1]))) {
+		    if (v_flag) {
+			fprintf(stderr, "%s: failed fnv0_64 test # %d\n",
+				prog, tstnum);
+			fprintf(stderr, "%s: test # 1 is 1st test\n", prog);
+			fprintf(stderr,
+			    "%s: expected 0x%08x%08x != "
+			    "generated: 0x%08x%08x\n",
+			    prog,
+			    (hval.w32[0] & mask.w32[0]),
+			    (hval.w32[1] & mask.w32[1]),
+			    ((fnv0_64_vector[tstnum-1].fnv0_64.w32[0] &
+			     mask.w32[0])),
+			    ((fnv0_64_vector[tstnum-1].fnv0_64.w32[1] &
+			     mask.w32[1])));
+		    }
+		    return tstnum;
+		}
+		break;
+	    case FNV1_64:
+		if (((hval.w32[0] & mask.w32[0]) !=
+		     (fnv1_64_vector[tstnum-1].fnv1_64.w32[0] &
+		      mask.w32[0])) &&
+		    ((hval.w32[1] & mask.w32[1]) !=
+		     (fnv1_64_vector[tstnum-1].fnv1_64.w32[1] &
+		      mask.w32[1]))) {
+		    if (v_flag) {
+			fprintf(stderr, "%s: failed fnv1_64 test # %d\n",
+				prog, tstnum);
+			fprintf(stderr, "%s: test # 1 is 1st test\n", prog);
+			fprintf(stderr,
+			    "%s: expected 0x%08x%08x != "
+			    "generated: 0x%08x%08x\n",
+			    prog,
+			    (hval.w32[0] & mask.w32[0]),
+			    (hval.w32[1] & mask.w32[1]),
+			    ((fnv1_64_vector[tstnum-1].fnv1_64.w32[0] &
+			     mask.w32[0])),
+			    ((fnv1_64_vector[tstnum-1].fnv1_64.w32[1] &
+			     mask.w32[1])));
+		    }
+		    return tstnum;
+		}
+		break;
+	    case FNV1a_64:
+		if (((hval.w32[0] & mask.w32[0]) !=
+		     (fnv1a_64_vector[tstnum-1].fnv1a_64.w32[0] &
+		      mask.w32[0])) &&
+		    ((hval.w32[1] & mask.w32[1]) !=
+		     (fnv1a_64_vector[tstnum-1].fnv1a_64.w32[1] &
+		      mask.w32[1]))) {
+		    if (v_flag) {
+			fprintf(stderr, "%s: failed fnv1a_64 test # %d\n",
+				prog, tstnum);
+			fprintf(stderr, "%s: test # 1 is 1st test\n", prog);
+			fprintf(stderr,
+			    "%s: expected 0x%08x%08x != "
+			    "generated: 0x%08x%08x\n",
+			    prog,
+			    (hval.w32[0] & mask.w32[0]),
+			    (hval.w32[1] & mask.w32[1]),
+			    ((fnv1a_64_vector[tstnum-1].fnv1a_64.w32[0] &
+			     mask.w32[0])),
+			    ((fnv1a_64_vector[tstnum-1].fnv1a_64.w32[1] &
+			     mask.w32[1])));
+		    }
+		    return tstnum;
+		}
+		break;
+	    default:
+		fprintf(stderr, "%s: -m %d not implemented by this program\n", prog, code);
+		exit(13);
+	    }
+	    break;
+
+	default:
+	    fprintf(stderr, "%s: -m %d not implemented yet\n", prog, code);
+	    exit(14);
+	}
+#endif /* HAVE_64BIT_LONG_LONG */
+    }
+
+    /*
+     * print completion if generating test vectors
+     */
+    if (code == 0) {
+#if defined(HAVE_64BIT_LONG_LONG)
+	printf("    { NULL, (Fnv64_t) 0 }\n");
+#else /* HAVE_64BIT_LONG_LONG */
+	printf("    { NULL, (Fnv64_t) {0,0} }\n");
+#endif /* HAVE_64BIT_LONG_LONG */
+	printf("};\n");
+    }
+
+    /*
+     * no failures, return code 0 ==> all OK
+     */
+    return 0;
+}
+
+
+/*
+ * now - return the current monotonic time in seconds
+ */
+static double
+now(void)
+{
+    struct timespec ts;		/* current time */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+ * show_progress - print --progress on stderr
+ *
+ * given:
+ *	done	1 ==> final report
+ */
+static void
+show_progress(int done)
+{
+    double t;			/* current time */
+    double elapsed;		/* seconds since we started */
+    double rate;		/* octets per second */
+    double eta;			/* estimated seconds remaining */
+
+    t = now();
+    if (!done && t < stats.next_progress) {
+	return;
+    }
+    stats.next_progress = t + 1.0;
+    elapsed = t - stats.start;
+    rate = (elapsed > 0.0) ? (double)stats.bytes / elapsed : 0.0;
+    if (stats.total > 0) {
+	eta = (rate > 0.0 && stats.total > stats.bytes) ?
+	      (double)(stats.total - stats.bytes) / rate : 0.0;
+	fprintf(stderr, "\r%s: %.1f of %.1f MiB (%.1f%%), %.1f MiB/s, "
+		"ETA %d:%02d:%02d ", prog,
+		(double)stats.bytes / 1048576.0,
+		(double)stats.total / 1048576.0,
+		100.0 * (double)stats.bytes / (double)stats.total,
+		rate / 1048576.0,
+		(int)(eta / 3600.0), ((int)eta / 60) % 60, (int)eta % 60);
+    } else {
+	fprintf(stderr, "\r%s: %.1f MiB, %.1f MiB/s ", prog,
+		(double)stats.bytes / 1048576.0, rate / 1048576.0);
+    }
+    if (done) {
+	fputc('\n', stderr);
+    }
+}
+
+
+/*
+ * hash_buf - hash a buffer, keeping --stats and --progress
+ *
+ * given:
+ *	hash_type	type of FNV hash to perform
+ *	buf		start of buffer to hash
+ *	len		length of buffer in octets
+ *	hval		initial or previous hash value
+ *
+ * returns:	hash value after hashing the buffer
+ */
+static Fnv64_t
+hash_buf(enum fnv_type hash_type, void *buf, size_t len, Fnv64_t hval)
+{
+    double t0 = 0.0;		/* time before hashing */
+
+    if (stats.timed) {
+	t0 = now();
+    }
+    switch (hash_type) {
+    case FNV0_64:
+    case FNV1_64:
+	hval = fnv_64_buf(buf, len, hval);
+	break;
+    case FNV1a_64:
+	hval = fnv_64a_buf(buf, len, hval);
+	break;
+    default:
+	unknown_hash_type(prog, hash_type);
+	exit(21);
+	/*NOTREACHED*/
+    }
+    stats.bytes += len;
+    if (stats.timed) {
+	stats.hash_time += now() - t0;
+	if (stats.progress) {
+	    show_progress(0);
+	}
+    }
+    return hval;
+}
+
+
+/*
+ * hash_zeros - hash a run of zero octets, keeping --stats and --progress
+ *
+ * given:
+ *	hash_type	type of FNV hash to perform
+ *	n		number of zero octets
+ *	hval		initial or previous hash value
+ *
+ * returns:	hash value after hashing the zero octets
+ */
+static Fnv64_t
+hash_zeros(enum fnv_type hash_type, off_t n, Fnv64_t hval)
+{
+    double t0 = 0.0;		/* time before hashing */
+
+    if (stats.timed) {
+	t0 = now();
+    }
+    hval = fnv_zeros_64(hash_type, n, hval);
+    stats.bytes += (unsigned long long)n;
+    if (stats.timed) {
+	stats.hash_time += now() - t0;
+	if (stats.progress) {
+	    show_progress(0);
+	}
+    }
+    return hval;
+}
+
+
+/*
+ * stats_read - read(2), keeping --stats
+ */
+static ssize_t
+stats_read(int fd, void *buf, size_t len)
+{
+    double t0 = 0.0;		/* time before reading */
+    ssize_t ret;		/* read(2) return */
+
+    if (stats.timed) {
+	t0 = now();
+    }
+    ret = read(fd, buf, len);
+    ++stats.read_calls;
+    if (stats.timed) {
+	stats.read_time += now() - t0;
+    }
+    return ret;
+}
+
+
+/*
+ * write_stats - write the --stats file
+ *
+ * given:
+ *	name	file to write, "-" ==> stderr
+ *
+ * The file is a list of name=value lines, times are in seconds.
+ */
+static void
+write_stats(char *name)
+{
+    FILE *f;			/* stats file */
+    double elapsed;		/* seconds since we started */
+
+    elapsed = now() - stats.start;
+    if (strcmp(name, "-") == 0) {
+	f = stderr;
+    } else {
+	f = fopen(name, "w");
+	if (f == NULL) {
+	    fprintf(stderr, "%s: unable to open stats file: %s: %s\n",
+		    prog, name, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+    }
+    fprintf(f, "program=%s\n", prog);
+    fprintf(f, "version=%s\n", FNV_VERSION);
+    fprintf(f, "io_path=%s\n", stats.io_path);
+    fprintf(f, "files=%llu\n", stats.files);
+    fprintf(f, "bytes=%llu\n", stats.bytes);
+    fprintf(f, "open_calls=%llu\n", stats.open_calls);
+    fprintf(f, "read_calls=%llu\n", stats.read_calls);
+    fprintf(f, "elapsed_sec=%.6f\n", elapsed);
+    fprintf(f, "open_sec=%.6f\n", stats.open_time);
+    fprintf(f, "read_sec=%.6f\n", stats.read_time);
+    fprintf(f, "hash_sec=%.6f\n", stats.hash_time);
+    fprintf(f, "read_mib_per_sec=%.3f\n", (stats.read_time > 0.0) ?
+	    (double)stats.bytes / stats.read_time / 1048576.0 : 0.0);
+    fprintf(f, "hash_mib_per_sec=%.3f\n", (stats.hash_time > 0.0) ?
+	    (double)stats.bytes / stats.hash_time / 1048576.0 : 0.0);
+    fprintf(f, "bound=%s\n",
+	    (stats.read_time + stats.open_time > stats.hash_time) ? "io" : "cpu");
+    if (f != stderr && fclose(f) != 0) {
+	fprintf(stderr, "%s: error writing stats file: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+}
+
+
+/*
+ * hash_pipeline - hash an open file until EOF using a read ahead thread
+ *
+ * given:
+ *	fd		open file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *	name		filename for error messages
+ *
+ * returns:	hash value after hashing the rest of the file
+ *
+ * A reader thread fills a ring of large aligned buffers while this
+ * thread hashes them, so that the time taken is about the greater of
+ * the I/O time and the hash time rather than their sum.  The reader
+ * thread skips the holes of a sparse file, which are hashed as runs of
+ * zero octets without being read.
+ *
+ * NOTE: This function does not return on a read error.
+ */
+static Fnv64_t
+hash_pipeline(int fd, enum fnv_type hash_type, Fnv64_t hval, char *name)
+{
+    struct fnv_reader *r;	/* read ahead thread */
+    char *data;			/* full buffer */
+    ssize_t len;		/* octets in the buffer */
+    double t0 = 0.0;		/* time before waiting for a buffer */
+
+    r = fnv_reader_start(fd, READER_BUFS, READER_BUF_SIZE);
+    if (r == NULL) {
+	fprintf(stderr, "%s: unable to start reader thread: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    stats.io_path = "pipeline";
+    for (;;) {
+	if (stats.timed) {
+	    t0 = now();
+	}
+	len = fnv_reader_next(r, &data);
+	if (stats.timed) {
+	    stats.read_time += now() - t0;
+	}
+	if (len <= 0) {
+	    break;
+	}
+	if (data == NULL) {
+	    hval = hash_zeros(hash_type, (off_t)len, hval);
+	} else {
+	    hval = hash_buf(hash_type, data, (size_t)len, hval);
+	}
+	fnv_reader_release(r);
+    }
+    if (len < 0) {
+	fprintf(stderr, "%s: error reading file: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    stats.read_calls += fnv_reader_finish(r);
+    return hval;
+}
+
+
+/*
+ * hash_holes - hash a sparse file, skipping over its holes
+ *
+ * given:
+ *	fd		open file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		pointer to initial or previous hash value,
+ *			updated with the hash value so far
+ *	buf		read buffer of BUF_SIZE octets
+ *	name		filename for error messages
+ *
+ * The data regions of a regular file, as found by SEEK_DATA and
+ * SEEK_HOLE, are read and hashed while each hole is hashed as a run of
+ * zero octets in O(log n) time without reading it.  The result is the
+ * same as reading the whole file.
+ *
+ * On return fd is positioned after the octets hashed so far, which is
+ * EOF unless the file grew, was not a regular file or the filesystem
+ * does not support SEEK_DATA.  The caller reads and hashes the rest.
+ *
+ * NOTE: This function does not return on a read error.
+ */
+static void
+hash_holes(int fd, enum fnv_type hash_type, Fnv64_t *hval, char *buf,
+	   char *name)
+{
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    struct stat st;		/* file status */
+    off_t pos;			/* octets hashed so far */
+    off_t data;			/* start of the next data region */
+    off_t hole;			/* end of the data region */
+    ssize_t readcnt;		/* number of octets read */
+
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+	return;
+    }
+    pos = lseek(fd, 0, SEEK_CUR);
+    while (pos >= 0 && pos < st.st_size) {
+
+	/* hash the hole, if any, before the next data region */
+	data = lseek(fd, pos, SEEK_DATA);
+	if (data < 0) {
+	    if (errno != ENXIO) {
+		/* SEEK_DATA is not supported, read the rest */
+		break;
+	    }
+	    /* the rest of the file is a hole */
+	    data = st.st_size;
+	}
+	if (data > pos) {
+	    *hval = hash_zeros(hash_type, data - pos, *hval);
+	    stats.io_path = "sparse";
+	    pos = data;
+	}
+	if (pos >= st.st_size) {
+	    break;
+	}
+
+	/* read and hash the data region */
+	hole = lseek(fd, pos, SEEK_HOLE);
+	if (hole <= pos || hole > st.st_size) {
+	    hole = st.st_size;
+	}
+	if (lseek(fd, pos, SEEK_SET) < 0) {
+	    break;
+	}
+	while (pos < hole) {
+	    readcnt = stats_read(fd, buf, (hole - pos < BUF_SIZE) ?
+					  (size_t)(hole - pos) : BUF_SIZE);
+	    if (readcnt < 0) {
+		if (errno == EINTR) {
+		    continue;
+		}
+		fprintf(stderr, "%s: error reading file: %s: %s\n",
+			prog, name, strerror(errno));
+		exit(4); /*ooo*/
+	    }
+	    if (readcnt == 0) {
+		/* the file shrank */
+		return;
+	    }
+	    *hval = hash_buf(hash_type, buf, (size_t)readcnt, *hval);
+	    pos += readcnt;
+	}
+    }
+    if (pos >= 0) {
+	(void) lseek(fd, pos, SEEK_SET);
+    }
+#endif /* SEEK_DATA && SEEK_HOLE */
+}
+
+
+/*
+ * save_checkpoint - write the --checkpoint file
+ *
+ * NOTE: This function does not return on a write error.
+ */
+static void
+save_checkpoint(void)
+{
+    if (fnv_ctx_save(&ckpt, ckpt_file) < 0) {
+	fprintf(stderr, "%s: unable to write checkpoint file: %s: %s\n",
+		prog, ckpt_file, strerror(errno));
+	exit(4); /*ooo*/
+    }
+}
+
+
+/*
+ * hash_checkpointed - hash an open file until EOF, saving checkpoints
+ *
+ * given:
+ *	fd		open file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial hash value, or the --resume hash value
+ *	name		filename for error messages
+ *
+ * returns:	hash value after hashing the rest of the file
+ *
+ * When resuming, a seekable fd is positioned at the checkpoint offset
+ * so that the octets already hashed are neither read nor hashed again.
+ * A non-seekable fd is assumed to already start at that offset.
+ *
+ * A regular file must be at least as long as the checkpoint offset, and
+ * when the checkpoint was taken of a regular file, the size and
+ * modification time of the file must not have changed since.
+ *
+ * NOTE: This function does not return on a read or write error, nor
+ *	 when the checkpoint does not match a regular file.
+ */
+static Fnv64_t
+hash_checkpointed(int fd, enum fnv_type hash_type, Fnv64_t hval, char *name)
+{
+    char buf[BUF_SIZE+1];	/* read buffer */
+    ssize_t readcnt;		/* number of octets read */
+    off_t next;			/* offset of the next checkpoint */
+    struct stat st;		/* file status */
+    long nsec;			/* nanoseconds of mtime */
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+#if defined(__APPLE__)
+	nsec = st.st_mtimespec.tv_nsec;
+#else /* __APPLE__ */
+	nsec = st.st_mtim.tv_nsec;
+#endif /* __APPLE__ */
+	if (ckpt.offset > st.st_size) {
+	    fprintf(stderr, "%s: checkpoint offset is beyond the end of "
+		    "file: %s\n", prog, name);
+	    exit(3); /*ooo*/
+	}
+	if (ckpt.size >= 0 &&
+	    (st.st_size != ckpt.size || st.st_mtime != ckpt.mtime ||
+	     nsec != ckpt.mtime_nsec)) {
+	    fprintf(stderr, "%s: file changed since the checkpoint was "
+		    "written: %s\n", prog, name);
+	    exit(3); /*ooo*/
+	}
+	ckpt.size = st.st_size;
+	ckpt.mtime = st.st_mtime;
+	ckpt.mtime_nsec = nsec;
+    } else {
+	ckpt.size = -1;
+	ckpt.mtime = 0;
+	ckpt.mtime_nsec = 0;
+    }
+    if (ckpt.offset > 0 && lseek(fd, ckpt.offset, SEEK_SET) < 0 &&
+	errno != ESPIPE) {
+	fprintf(stderr, "%s: unable to seek to checkpoint offset: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    next = ckpt.offset + ckpt_every;
+    while ((readcnt = stats_read(fd, buf, BUF_SIZE)) != 0) {
+	if (readcnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    fprintf(stderr, "%s: error reading file: %s: %s\n",
+		    prog, name, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+	hval = hash_buf(hash_type, buf, (size_t)readcnt, hval);
+	ckpt.offset += readcnt;
+	if (ckpt_file != NULL && ckpt.offset >= next) {
+	    ckpt.hval = hval;
+	    save_checkpoint();
+	    next = ckpt.offset + ckpt_every;
+	}
+    }
+    ckpt.hval = hval;
+    if (ckpt_file != NULL) {
+	save_checkpoint();
+    }
+    return hval;
+}
+
+
+/*
+ * hash_fd - hash an open file until EOF
+ *
+ * given:
+ *	fd		open file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *	name		filename for error messages
+ *
+ * returns:	hash value after hashing the rest of the file
+ *
+ * Holes in sparse files are hashed without being read.
+ *
+ * NOTE: This function does not return on a read error.
+ */
+static Fnv64_t
+hash_fd(int fd, enum fnv_type hash_type, Fnv64_t hval, char *name)
+{
+    char buf[BUF_SIZE+1];	/* read buffer */
+    ssize_t readcnt;		/* number of octets read */
+
+    if (pipeline) {
+	return hash_pipeline(fd, hash_type, hval, name);
+    }
+    if (ckpt_file != NULL || ckpt.offset > 0) {
+	return hash_checkpointed(fd, hash_type, hval, name);
+    }
+    hash_holes(fd, hash_type, &hval, buf, name);
+    while ((readcnt = stats_read(fd, buf, BUF_SIZE)) != 0) {
+	if (readcnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    fprintf(stderr, "%s: error reading file: %s: %s\n",
+		    prog, name, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+	hval = hash_buf(hash_type, buf, (size_t)readcnt, hval);
+    }
+    return hval;
+}
+
+
+/*
+ * hash_input - hash an open file, or the --offset/--length range or
+ *		the --sample fingerprint of it
+ *
+ * given:
+ *	fd		open file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *	name		filename for error messages
+ *
+ * returns:	hash value after hashing the file
+ *
+ * NOTE: This function does not return on a read error.
+ */
+static Fnv64_t
+hash_input(int fd, enum fnv_type hash_type, Fnv64_t hval, char *name)
+{
+    int ret = 0;		/* library call return */
+    int lib = 1;		/* 1 ==> libfnv read and hashed the file */
+    double t0 = 0.0;		/* time before the library call */
+
+    /*
+     * The library reads and hashes in the same call, so --stats counts
+     * the time spent in fnv_sample_64() and fnv_range_64() as read time.
+     */
+    if (stats.timed) {
+	t0 = now();
+    }
+    if (sample_cnt > 0) {
+	stats.io_path = "sample";
+	ret = fnv_sample_64(fd, hash_type, sample_cnt, (size_t)sample_size,
+			    &hval);
+	++stats.read_calls;
+    } else if (range_offset > 0 || range_length >= 0) {
+	stats.io_path = "pread";
+	ret = fnv_range_64(fd, hash_type, range_offset, range_length, &hval);
+	++stats.read_calls;
+    } else {
+	lib = 0;
+	hval = hash_fd(fd, hash_type, hval, name);
+    }
+    if (stats.timed && lib) {
+	struct stat st;		/* file status */
+	off_t len;		/* octets hashed by the library */
+
+	stats.read_time += now() - t0;
+	if (ret == 0 && fstat(fd, &st) == 0) {
+	    if (sample_cnt > 0) {
+		len = (off_t)sample_cnt * sample_size;
+		len = (len < st.st_size) ? len : st.st_size;
+	    } else {
+		len = st.st_size - range_offset;
+		if (range_length >= 0 && len > range_length) {
+		    len = range_length;
+		}
+	    }
+	    stats.bytes += (len > 0) ? (unsigned long long)len : 0;
+	}
+    }
+    if (ret < 0) {
+	fprintf(stderr, "%s: error reading file: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    return hval;
+}
+
+
+/*
+ * write_all - write an entire buffer
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error
+ */
+static int
+write_all(int fd, const char *buf, size_t len)
+{
+    ssize_t cnt;		/* octets written */
+
+    while (len > 0) {
+	cnt = write(fd, buf, len);
+	if (cnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    return -1;
+	}
+	buf += cnt;
+	len -= (size_t)cnt;
+    }
+    return 0;
+}
+
+
+/*
+ * tee_failed - report a --tee I/O error and exit
+ */
+static void
+tee_failed(char *what)
+{
+    fprintf(stderr, "%s: --tee %s error: %s\n", prog, what, strerror(errno));
+    exit(4); /*ooo*/
+}
+
+
+#if defined(__linux__)
+/*
+ * tee_pipe - --tee from a pipe on stdin using tee(2) and splice(2)
+ *
+ * given:
+ *	hash_type	type of FNV hash to perform
+ *	hval		pointer to current hash value
+ *	out		fstat of stdout
+ *
+ * returns:
+ *	1 ==> all of stdin was copied and hashed
+ *	0 ==> tee(2) is not usable, nothing was consumed from stdin
+ *
+ * The data is duplicated in the kernel from the stdin pipe, either
+ * directly into the stdout pipe or into a private pipe that is then
+ * spliced to stdout, so the pass-through copy never enters user space.
+ * Only the copy we hash is read(2) from stdin.
+ *
+ * splice(2) refuses an O_APPEND stdout, as from >> redirection, so such
+ * a stdout takes the portable path.  Should a splice fail anyway, the
+ * private pipe is drained with read(2) and write(2), since tee(2) has
+ * already taken the data from stdin.
+ */
+static int
+tee_pipe(enum fnv_type hash_type, Fnv64_t *hval, struct stat *out)
+{
+    char buf[BUF_SIZE+1];	/* hash buffer */
+    int pfd[2] = {-1, -1};	/* private pipe for a non-pipe stdout */
+    int tfd = 1;		/* where tee(2) duplicates stdin */
+    ssize_t cnt;		/* octets duplicated */
+    ssize_t moved;		/* octets spliced or read */
+    ssize_t got;		/* total octets read */
+    ssize_t n;			/* octets spliced or drained */
+    int first = 1;		/* 1 ==> nothing consumed from stdin yet */
+    int flags;			/* stdout file status flags */
+
+    if (!S_ISFIFO(out->st_mode)) {
+	if (!S_ISREG(out->st_mode) && !S_ISSOCK(out->st_mode)) {
+	    return 0;
+	}
+	flags = fcntl(1, F_GETFL);
+	if (flags < 0 || (flags & O_APPEND) != 0) {
+	    return 0;
+	}
+	if (pipe(pfd) < 0) {
+	    return 0;
+	}
+	tfd = pfd[1];
+    }
+    for (;;) {
+
+	/* duplicate the next chunk of stdin */
+	cnt = tee(0, tfd, BUF_SIZE, 0);
+	if (cnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    if (first) {
+		if (pfd[0] >= 0) {
+		    close(pfd[0]);
+		    close(pfd[1]);
+		}
+		return 0;
+	    }
+	    tee_failed("tee");
+	}
+	if (cnt == 0) {
+	    break;
+	}
+	first = 0;
+	stats.io_path = (pfd[0] >= 0) ? "tee+splice" : "tee";
+
+	/* move the duplicate from our private pipe to stdout */
+	for (moved = 0; pfd[0] >= 0 && moved < cnt; moved += n) {
+	    n = splice(pfd[0], NULL, 1, NULL, (size_t)(cnt - moved),
+		       SPLICE_F_MOVE);
+	    if (n < 0 && errno == EINTR) {
+		n = 0;
+		continue;
+	    }
+	    if (n > 0) {
+		continue;
+	    }
+
+	    /* splice failed: drain the private pipe the portable way */
+	    n = read(pfd[0], buf, (size_t)(cnt - moved) < BUF_SIZE ?
+				  (size_t)(cnt - moved) : BUF_SIZE);
+	    if (n < 0 && errno == EINTR) {
+		n = 0;
+		continue;
+	    }
+	    if (n <= 0) {
+		tee_failed("read");
+	    }
+	    if (write_all(1, buf, (size_t)n) < 0) {
+		tee_failed("write");
+	    }
+	}
+
+	/* consume the same octets from stdin and hash them */
+	for (got = 0; got < cnt; got += moved) {
+	    moved = stats_read(0, buf, (size_t)(cnt - got));
+	    if (moved < 0 && errno == EINTR) {
+		moved = 0;
+		continue;
+	    }
+	    if (moved <= 0) {
+		tee_failed("read");
+	    }
+	    *hval = hash_buf(hash_type, buf, (size_t)moved, *hval);
+	}
+    }
+    if (pfd[0] >= 0) {
+	close(pfd[0]);
+	close(pfd[1]);
+    }
+    return 1;
+}
+
+
+/*
+ * tee_file - --tee from a regular file on stdin using mmap(2) and sendfile(2)
+ *
+ * given:
+ *	hash_type	type of FNV hash to perform
+ *	hval		pointer to current hash value
+ *	in		fstat of stdin
+ *
+ * The file is hashed from an mmap(2) window while sendfile(2) copies the
+ * same octets to stdout within the kernel.  When sendfile(2) is refused
+ * the window is written with write(2) instead.  On return the stdin file
+ * offset is just beyond the octets copied, so any data appended to the
+ * file meanwhile is copied by the read(2) loop.
+ */
+static void
+tee_file(enum fnv_type hash_type, Fnv64_t *hval, struct stat *in)
+{
+    off_t pos;			/* current stdin offset */
+    off_t base;			/* page aligned window start */
+    size_t len;			/* window length beyond pos */
+    size_t skip;		/* octets from base to pos */
+    char *map;			/* mapped window */
+    off_t off;			/* sendfile(2) offset */
+    ssize_t cnt;		/* octets sent */
+    int use_sendfile = 1;	/* 0 ==> sendfile(2) refused */
+    long pagesize;		/* system page size */
+
+    pagesize = sysconf(_SC_PAGESIZE);
+    pos = lseek(0, 0, SEEK_CUR);
+    if (pos < 0 || pagesize <= 0) {
+	return;
+    }
+    while (pos < in->st_size) {
+	base = pos - (pos % pagesize);
+	skip = (size_t)(pos - base);
+	len = TEE_WINDOW;
+	if ((off_t)len > in->st_size - pos) {
+	    len = (size_t)(in->st_size - pos);
+	}
+	map = mmap(NULL, skip + len, PROT_READ, MAP_SHARED, 0, base);
+	if (map == MAP_FAILED) {
+	    break;
+	}
+	(void) madvise(map, skip + len, MADV_SEQUENTIAL);
+	stats.io_path = use_sendfile ? "mmap+sendfile" : "mmap+write";
+	*hval = hash_buf(hash_type, map + skip, len, *hval);
+	for (off = pos; use_sendfile && off < pos + (off_t)len; ) {
+	    cnt = sendfile(1, 0, &off, (size_t)(pos + (off_t)len - off));
+	    if (cnt < 0 && errno == EINTR) {
+		continue;
+	    }
+	    if (cnt < 0 && off == pos && (errno == EINVAL || errno == ENOSYS)) {
+		use_sendfile = 0;
+		break;
+	    }
+	    if (cnt <= 0) {
+		tee_failed("sendfile");
+	    }
+	}
+	if (!use_sendfile && write_all(1, map + skip, len) < 0) {
+	    tee_failed("write");
+	}
+	munmap(map, skip + len);
+	pos += (off_t)len;
+	if (lseek(0, pos, SEEK_SET) < 0) {
+	    tee_failed("lseek");
+	}
+    }
+}
+#endif /* __linux__ */
+
+
+/*
+ * hash_tee - copy stdin to stdout unchanged while hashing it
+ *
+ * given:
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *
+ * returns:	hash value of stdin
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static Fnv64_t
+hash_tee(enum fnv_type hash_type, Fnv64_t hval)
+{
+    char buf[BUF_SIZE+1];	/* read buffer */
+    ssize_t readcnt;		/* octets read */
+    struct stat in;		/* fstat of stdin */
+    struct stat out;		/* fstat of stdout */
+
+    if (fstat(0, &in) < 0 || fstat(1, &out) < 0) {
+	tee_failed("fstat");
+    }
+#if defined(__linux__)
+    if (S_ISFIFO(in.st_mode)) {
+	if (tee_pipe(hash_type, &hval, &out)) {
+	    return hval;
+	}
+    } else if (S_ISREG(in.st_mode)) {
+	tee_file(hash_type, &hval, &in);
+    }
+#endif /* __linux__ */
+
+    /*
+     * portable read(2) and write(2) copy
+     */
+    while ((readcnt = stats_read(0, buf, BUF_SIZE)) != 0) {
+	if (readcnt < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    tee_failed("read");
+	}
+	hval = hash_buf(hash_type, buf, (size_t)readcnt, hval);
+	if (write_all(1, buf, (size_t)readcnt) < 0) {
+	    tee_failed("write");
+	}
+    }
+    return hval;
+}
+
+/*
+ * serve_put - append a --serve response to the output buffer
+ *
+ * given:
+ *	out	output buffer of at least FNV_SERVE_RESP_SIZE octets
+ *	status	FNV_SERVE_OK or an FNV_SERVE_BAD_* error status
+ *	type	hash type of the request
+ *	hval	hash value (Fnv32_t hashes are in the low order 32 bits)
+ */
+static void
+serve_put(unsigned char *out, int status, int type, Fnv64_t hval)
+{
+    int i;
+
+    memset(out, 0, FNV_SERVE_RESP_SIZE);
+    out[0] = (unsigned char)status;
+    out[1] = (unsigned char)type;
+#if defined(HAVE_64BIT_LONG_LONG)
+    for (i = 0; i < 8; ++i) {
+	out[8+i] = (unsigned char)(hval >> (8*i));
+    }
+#else /* HAVE_64BIT_LONG_LONG */
+    for (i = 0; i < 4; ++i) {
+	out[8+i] = (unsigned char)(hval.w32[0] >> (8*i));
+	out[12+i] = (unsigned char)(hval.w32[1] >> (8*i));
+    }
+#endif /* HAVE_64BIT_LONG_LONG */
+}
+
+
+/*
+ * serve - answer --serve coprocess requests on stdin until EOF
+ *
+ * Each request is an FNV_SERVE_REQ_SIZE octet header followed by the
+ * payload to hash:
+ *
+ *	octet 0		hash type (enum fnv_type: 1 thru 6)
+ *	octet 1		flags (FNV_SERVE_CONTINUE or 0)
+ *	octets 2-3	reserved, must be 0
+ *	octets 4-7	payload length, little endian
+ *
+ * Each response is FNV_SERVE_RESP_SIZE octets:
+ *
+ *	octet 0		status (FNV_SERVE_OK or FNV_SERVE_BAD_*)
+ *	octet 1		hash type from the request
+ *	octets 2-7	reserved, 0
+ *	octets 8-15	hash value, little endian (32 bit hashes are
+ *			zero extended)
+ *
+ * Responses are returned in request order.  The payload is hashed as it
+ * streams through a fixed input buffer, so no request allocates memory
+ * and any payload up to 4 GiB - 1 may be sent.  Responses are buffered
+ * and written when the buffer fills or when no more input is waiting, so
+ * a client that writes a batch of requests gets a batch of responses.
+ *
+ * NOTE: This function does not return on an I/O error or protocol error.
+ */
+static void
+serve(void)
+{
+    static unsigned char in[SERVE_IN_SIZE];	/* input buffer */
+    static unsigned char out[SERVE_OUT_SIZE];	/* response buffer */
+    unsigned char hdr[FNV_SERVE_REQ_SIZE];	/* request header */
+    size_t hlen = 0;		/* octets of hdr received */
+    size_t ipos = 0;		/* next unprocessed input octet */
+    size_t ilen = 0;		/* octets in the input buffer */
+    size_t olen = 0;		/* octets in the response buffer */
+    unsigned long left = 0;	/* payload octets left in this request */
+    int in_payload = 0;		/* 1 ==> reading a payload */
+    int type = FNV_NONE;	/* hash type of this request */
+    int status = FNV_SERVE_OK;	/* status of this request */
+    Fnv64_t basis[FNV1a_64+1];	/* initial basis of each type */
+    Fnv64_t last[FNV1a_64+1];	/* last hash of each type */
+    Fnv32_t h32 = 0;		/* 32 bit hash being computed */
+    Fnv64_t h64;		/* 64 bit hash being computed */
+    ssize_t cnt;		/* octets read */
+    size_t chunk;		/* payload octets in the input buffer */
+    int i;
+
+    /*
+     * 32 bit initial basis values are kept in the low order 32 bits
+     */
+    for (i = FNV_NONE; i <= FNV1a_64; ++i) {
+	basis[i] = FNV0_64_INIT;
+    }
+#if defined(HAVE_64BIT_LONG_LONG)
+    basis[FNV1_32] = (Fnv64_t)FNV1_32_INIT;
+    basis[FNV1a_32] = (Fnv64_t)FNV1_32A_INIT;
+#else /* HAVE_64BIT_LONG_LONG */
+    basis[FNV1_32].w32[0] = FNV1_32_INIT;
+    basis[FNV1a_32].w32[0] = FNV1_32A_INIT;
+#endif /* HAVE_64BIT_LONG_LONG */
+    basis[FNV1_64] = FNV1_64_INIT;
+    basis[FNV1a_64] = FNV1A_64_INIT;
+    memcpy(last, basis, sizeof(last));
+    h64 = basis[FNV_NONE];
+
+    for (;;) {
+
+	/*
+	 * refill the input buffer, first flushing responses if we may block
+	 */
+	if (ipos == ilen) {
+	    if (olen > 0) {
+		if (write_all(1, (char *)out, olen) < 0) {
+		    fprintf(stderr, "%s: --serve write error: %s\n",
+			    prog, strerror(errno));
+		    exit(4); /*ooo*/
+		}
+		olen = 0;
+	    }
+	    cnt = read(0, in, sizeof(in));
+	    if (cnt < 0) {
+		if (errno == EINTR) {
+		    continue;
+		}
+		fprintf(stderr, "%s: --serve read error: %s\n",
+			prog, strerror(errno));
+		exit(4); /*ooo*/
+	    }
+	    if (cnt == 0) {
+		if (hlen > 0 || in_payload) {
+		    fprintf(stderr, "%s: --serve EOF within a request\n", prog);
+		    exit(4); /*ooo*/
+		}
+		return;
+	    }
+	    ilen = (size_t)cnt;
+	    ipos = 0;
+	}
+
+	/*
+	 * collect and parse the request header
+	 */
+	if (!in_payload) {
+	    while (hlen < sizeof(hdr) && ipos < ilen) {
+		hdr[hlen++] = in[ipos++];
+	    }
+	    if (hlen < sizeof(hdr)) {
+		continue;
+	    }
+	    hlen = 0;
+	    in_payload = 1;
+	    type = hdr[0];
+	    left = (unsigned long)hdr[4] | ((unsigned long)hdr[5] << 8) |
+		   ((unsigned long)hdr[6] << 16) | ((unsigned long)hdr[7] << 24);
+	    status = FNV_SERVE_OK;
+	    if (type < FNV0_32 || type > FNV1a_64) {
+		status = FNV_SERVE_BAD_TYPE;
+	    } else if ((hdr[1] & ~FNV_SERVE_CONTINUE) != 0 ||
+		       hdr[2] != 0 || hdr[3] != 0) {
+		status = FNV_SERVE_BAD_FLAGS;
+	    }
+	    if (status == FNV_SERVE_BAD_TYPE) {
+		h64 = basis[FNV_NONE];
+	    } else if (hdr[1] & FNV_SERVE_CONTINUE) {
+		h64 = last[type];
+	    } else {
+		h64 = basis[type];
+	    }
+#if defined(HAVE_64BIT_LONG_LONG)
+	    h32 = (Fnv32_t)h64;
+#else /* HAVE_64BIT_LONG_LONG */
+	    h32 = h64.w32[0];
+#endif /* HAVE_64BIT_LONG_LONG */
+	}
+
+	/*
+	 * hash the part of the payload we have
+	 */
+	chunk = ilen - ipos;
+	if ((unsigned long)chunk > left) {
+	    chunk = (size_t)left;
+	}
+	if (status == FNV_SERVE_OK && chunk > 0) {
+	    switch (type) {
+	    case FNV0_32:
+	    case FNV1_32:
+		h32 = fnv_32_buf(in + ipos, chunk, h32);
+		break;
+	    case FNV1a_32:
+		h32 = fnv_32a_buf(in + ipos, chunk, h32);
+		break;
+	    case FNV0_64:
+	    case FNV1_64:
+		h64 = fnv_64_buf(in + ipos, chunk, h64);
+		break;
+	    case FNV1a_64:
+		h64 = fnv_64a_buf(in + ipos, chunk, h64);
+		break;
+	    default:
+		break;
+	    }
+	}
+	ipos += chunk;
+	left -= (unsigned long)chunk;
+	if (left > 0) {
+	    continue;
+	}
+
+	/*
+	 * queue the response
+	 */
+	in_payload = 0;
+	if (type == FNV0_32 || type == FNV1_32 || type == FNV1a_32) {
+#if defined(HAVE_64BIT_LONG_LONG)
+	    h64 = (Fnv64_t)h32;
+#else /* HAVE_64BIT_LONG_LONG */
+	    h64.w32[0] = h32;
+	    h64.w32[1] = 0;
+#endif /* HAVE_64BIT_LONG_LONG */
+	}
+	if (status == FNV_SERVE_OK) {
+	    last[type] = h64;
+	} else {
+	    h64 = basis[FNV_NONE];
+	}
+	if (olen + FNV_SERVE_RESP_SIZE > sizeof(out)) {
+	    if (write_all(1, (char *)out, olen) < 0) {
+		fprintf(stderr, "%s: --serve write error: %s\n",
+			prog, strerror(errno));
+		exit(4); /*ooo*/
+	    }
+	    olen = 0;
+	}
+	serve_put(out + olen, status, type, h64);
+	olen += FNV_SERVE_RESP_SIZE;
+    }
+}
+
+
+/*
+ * write_sidecar - write the --sidecar file for a file
+ *
+ * given:
+ *	name		file to hash
+ *	hash_type	type of FNV hash to perform
+ *	blksize		--block-size block size
+ *	scfile		sidecar file to write
+ *
+ * returns:	hash value of the whole file
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static Fnv64_t
+write_sidecar(char *name, enum fnv_type hash_type, off_t blksize,
+	      char *scfile)
+{
+    struct fnv_sidecar sc;	/* block hashes */
+    Fnv64_t hval;		/* whole file hash */
+    int fd;			/* open file to hash */
+
+    fd = open(name, O_RDONLY);
+    if (fd < 0) {
+	fprintf(stderr, "%s: unable to open file: %s\n", prog, name);
+	exit(4); /*ooo*/
+    }
+    if (fnv_sidecar_create(fd, hash_type, blksize, &sc) < 0) {
+	fprintf(stderr, "%s: unable to hash blocks of regular file: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    close(fd);
+    if (fnv_sidecar_write(&sc, scfile) < 0) {
+	fprintf(stderr, "%s: unable to write sidecar file: %s: %s\n",
+		prog, scfile, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    hval = sc.hval;
+    fnv_sidecar_free(&sc);
+    return hval;
+}
+
+
+/*
+ * verify_sidecar - check a file against a --verify sidecar file
+ *
+ * given:
+ *	name		file to check
+ *	scfile		sidecar file written by --sidecar
+ *	nthread		number of threads, < 1 ==> one per online CPU
+ *
+ * returns:	0 ==> file matches, 1 ==> mismatch
+ *
+ * Mismatched ranges are printed, as is "OK" if the file matches.
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static int
+verify_sidecar(char *name, char *scfile, int nthread)
+{
+    struct fnv_sidecar sc;	/* block hashes */
+    struct stat st;		/* file status */
+    unsigned char *bad;		/* 1 ==> block mismatch */
+    off_t nbad;			/* number of mismatched blocks */
+    off_t blk;			/* current block */
+    off_t run;			/* first block of a mismatched run */
+    long nsec;			/* nanoseconds of mtime */
+    int changed;		/* 1 ==> file changed since the sidecar */
+    int ret = 0;		/* 1 ==> mismatch */
+    int fd;			/* open file to check */
+
+    if (fnv_sidecar_read(&sc, scfile) < 0) {
+	fprintf(stderr, "%s: unable to read sidecar file: %s: %s\n",
+		prog, scfile, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    fd = open(name, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) < 0) {
+	fprintf(stderr, "%s: unable to open file: %s\n", prog, name);
+	exit(4); /*ooo*/
+    }
+#if defined(__APPLE__)
+    nsec = st.st_mtimespec.tv_nsec;
+#else /* __APPLE__ */
+    nsec = st.st_mtim.tv_nsec;
+#endif /* __APPLE__ */
+    changed = (st.st_size != sc.size || st.st_mtime != sc.mtime ||
+	       nsec != sc.mtime_nsec);
+    if (st.st_size != sc.size) {
+	printf("%s: size %lld, sidecar size %lld\n",
+	       name, (long long)st.st_size, (long long)sc.size);
+	ret = 1;
+    }
+    if (nthread < 1) {
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);	/* online CPUs */
+
+	nthread = (ncpu > 0) ? (int)ncpu : 1;
+    }
+    bad = calloc(sc.nblock > 0 ? (size_t)sc.nblock : 1, 1);
+    if (bad == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    nbad = fnv_sidecar_verify(fd, &sc, range_offset, range_length, nthread,
+			      bad);
+    if (nbad < 0) {
+	fprintf(stderr, "%s: error reading file: %s: %s\n",
+		prog, name, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    close(fd);
+
+    /*
+     * report runs of mismatched blocks as octet ranges, and whether the
+     * file was changed since the sidecar was written or is corrupt
+     */
+    for (blk = 0; blk < sc.nblock; ++blk) {
+	if (!bad[blk]) {
+	    continue;
+	}
+	for (run = blk; blk+1 < sc.nblock && bad[blk+1]; ++blk) {
+	}
+	printf("%s: mismatch at octets %lld-%lld\n", name,
+	       (long long)(run * sc.blksize),
+	       (long long)(((blk+1) * sc.blksize < sc.size) ?
+			   (blk+1) * sc.blksize - 1 : sc.size - 1));
+	ret = 1;
+    }
+    if (ret == 0) {
+	printf("%s: OK\n", name);
+    } else if (changed) {
+	printf("%s: changed since the sidecar was written\n", name);
+    } else {
+	printf("%s: corrupt, unchanged since the sidecar was written\n",
+	       name);
+    }
+    free(bad);
+    fnv_sidecar_free(&sc);
+    return ret;
+}
+
+
+/*
+ * hash_file - hash a file, consulting the --cache file if open
+ *
+ * given:
+ *	name		file to hash
+ *	hash_type	type of FNV hash to perform
+ *	hval		initial or previous hash value
+ *
+ * returns:	hash value after hashing the file
+ *
+ * The cache is keyed by the file and the hval it is hashed from, so a
+ * file that continues the hash of earlier args hits only when those
+ * args hashed the same as before.  A cache hit costs one stat(2) and
+ * the file is not opened.
+ *
+ * NOTE: This function does not return on an open or read error.
+ */
+static Fnv64_t
+hash_file(char *name, enum fnv_type hash_type, Fnv64_t hval)
+{
+    Fnv64_t basis = hval;		/* hash value the file is hashed from */
+    struct stat before;		/* file status before hashing */
+    struct stat after;		/* file status after hashing */
+    int use_cache = 0;		/* 1 ==> regular file we may cache */
+    int fd;			/* open file to process */
+
+    /* try the cache first */
+    ++stats.files;
+    if (cache != NULL &&
+	stat(name, &before) == 0 && S_ISREG(before.st_mode) &&
+	fnv_cache_lookup(cache, &before, hash_type, &basis, &hval,
+			 sizeof(hval))) {
+	return hval;
+    }
+
+    /* open the file */
+    if (stats.timed) {
+	double t0 = now();	/* time before open */
+
+	fd = open(name, O_RDONLY);
+	stats.open_time += now() - t0;
+    } else {
+	fd = open(name, O_RDONLY);
+    }
+    ++stats.open_calls;
+    if (fd < 0) {
+	fprintf(stderr, "%s: unable to open file: %s\n", prog, name);
+	exit(4); /*ooo*/
+    }
+    if (cache != NULL &&
+	fstat(fd, &before) == 0 && S_ISREG(before.st_mode)) {
+	use_cache = 1;
+    }
+
+    /* hash the file */
+    hval = hash_input(fd, hash_type, hval, name);
+
+    /* record the hash unless the file changed while we were reading it */
+    if (use_cache && fstat(fd, &after) == 0 &&
+	fnv_cache_same(&before, &after)) {
+	(void) fnv_cache_store(cache, &before, hash_type, &basis, &hval,
+			       sizeof(hval));
+    }
+    close(fd);
+    return hval;
+}
+
+
+
+/*
+ * hash_tree - Merkle hash a --tree directory and update its state file
+ *
+ * given:
+ *	dir		root of the directory tree
+ *	hash_type	type of FNV hash to perform
+ *	statefile	state file from an earlier --tree run, or to create
+ *	verbose		1 ==> print statistics on stderr
+ *
+ * returns:	hash value of the directory tree
+ *
+ * Only files whose size, times or inode changed since the state file
+ * was written are read again.
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static Fnv64_t
+hash_tree(char *dir, enum fnv_type hash_type, char *statefile, int verbose)
+{
+    struct fnv_tree *old;	/* tree from the state file, or NULL */
+    struct fnv_tree *t;		/* current tree */
+    struct fnv_tree_stat tstat;	/* build statistics */
+    Fnv64_t ret;		/* root hash */
+
+    old = fnv_tree_load(statefile);
+    if (old == NULL && errno != ENOENT) {
+	fprintf(stderr, "%s: unable to read tree state file: %s: %s\n",
+		prog, statefile, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    t = fnv_tree_build(dir, hash_type, old, &tstat);
+    if (t == NULL && errno == EINVAL) {
+	fprintf(stderr, "%s: tree state file is for another hash type: %s\n",
+		prog, statefile);
+	exit(3); /*ooo*/
+    }
+    if (t == NULL) {
+	fprintf(stderr, "%s: unable to hash tree: %s: %s\n",
+		prog, tstat.errpath, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    fnv_tree_free(old);
+    if (fnv_tree_save(t, statefile) < 0) {
+	fprintf(stderr, "%s: unable to write tree state file: %s: %s\n",
+		prog, statefile, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    if (verbose) {
+	fprintf(stderr, "%s: %llu nodes, %llu hashed, %llu reused\n",
+		prog, tstat.nodes, tstat.hashed, tstat.reused);
+    }
+    ret = fnv_tree_hash(t);
+    fnv_tree_free(t);
+    return ret;
+}
+
+
+/*
+ * get_tree - load a --tree-diff state file, or hash a directory
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static struct fnv_tree *
+get_tree(char *arg, enum fnv_type hash_type)
+{
+    struct fnv_tree_stat tstat;	/* build statistics */
+    struct fnv_tree *t;		/* loaded or built tree */
+    struct stat st;		/* arg status */
+
+    if (stat(arg, &st) == 0 && S_ISDIR(st.st_mode)) {
+	t = fnv_tree_build(arg, hash_type, NULL, &tstat);
+	if (t == NULL) {
+	    fprintf(stderr, "%s: unable to hash tree: %s: %s\n",
+		    prog, tstat.errpath, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+	return t;
+    }
+    t = fnv_tree_load(arg);
+    if (t == NULL) {
+	fprintf(stderr, "%s: unable to read tree state file: %s: %s\n",
+		prog, arg, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    return t;
+}
+
+
+/*
+ * diff_tree - compare two --tree-diff trees from the top down
+ *
+ * given:
+ *	arg1		first state file or directory
+ *	arg2		second state file or directory
+ *	hash_type	type of FNV hash for directory args
+ *
+ * returns:	0 ==> trees are the same, 1 ==> trees differ
+ *
+ * Only directories whose hashes differ are visited.  The differences
+ * are printed on stdout, see fnv_tree_diff().
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static int
+diff_tree(char *arg1, char *arg2, enum fnv_type hash_type)
+{
+    struct fnv_tree *a;		/* first tree */
+    struct fnv_tree *b;		/* second tree */
+    unsigned long long ndiff;	/* number of differences */
+
+    a = get_tree(arg1, hash_type);
+    b = get_tree(arg2, hash_type);
+    if (fnv_tree_hash_type(a) != fnv_tree_hash_type(b)) {
+	fprintf(stderr, "%s: trees use different hash types: %s %s\n",
+		prog, arg1, arg2);
+	exit(3); /*ooo*/
+    }
+    ndiff = fnv_tree_diff(a, b, stdout);
+    fnv_tree_free(a);
+    fnv_tree_free(b);
+    return ndiff > 0;
+}
+
+
+/*
+ * on_watch_signal - note SIGINT or SIGTERM so that --watch stops
+ */
+static volatile sig_atomic_t watch_stop = 0;	/* 1 ==> stop watching */
+
+static void
+on_watch_signal(int sig)
+{
+    (void) sig;
+    watch_stop = 1;
+}
+
+
+/*
+ * watch - keep a --watch manifest current until SIGINT or SIGTERM
+ *
+ * given:
+ *	dir		directory to watch
+ *	hash_type	type of FNV hash to perform
+ *	mfile		manifest file to create
+ *	nthread		number of hashing threads, < 1 ==> one per online CPU
+ *	debounce	--debounce quiet time in milliseconds
+ *	verbose		1 ==> print each change on stdout
+ *
+ * NOTE: This function does not return on an error.
+ */
+static void
+watch(char *dir, enum fnv_type hash_type, char *mfile, int nthread,
+      int debounce, int verbose)
+{
+    struct fnv_watch_stat wstat;	/* watch statistics */
+    struct sigaction sa;	/* SIGINT and SIGTERM action */
+
+    /* no SA_RESTART, so that a signal interrupts the wait for events */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_watch_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    if (fnv_watch(dir, hash_type, mfile, nthread, debounce,
+		  verbose ? stdout : NULL, &watch_stop, &wstat) < 0) {
+	if (errno == ENOSYS) {
+	    fprintf(stderr, "%s: --watch is not supported on this system\n",
+		    prog);
+	    exit(3); /*ooo*/
+	}
+	fprintf(stderr, "%s: --watch error: %s: %s\n", prog,
+		wstat.errpath[0] != '\0' ? wstat.errpath : dir,
+		strerror(errno));
+	exit(4); /*ooo*/
+    }
+    if (verbose) {
+	fprintf(stderr, "%s: %llu events, %llu dirs, %llu hashed, "
+		"%llu removed, %llu overflows, %llu errors\n", prog,
+		wstat.events, wstat.dirs, wstat.hashed, wstat.removed,
+		wstat.overflows, wstat.errors);
+    }
+}
+
+
+/*
+ * lookup - print hashes from a --watch manifest
+ *
+ * given:
+ *	mfile		manifest file of a running --watch
+ *	hash_type	type of FNV hash of this program
+ *	npath		number of paths
+ *	path		paths relative to the watched directory
+ *	bmask		mask to apply to output
+ *	verbose		1 ==> print each path after its hash
+ *
+ * returns:	0 ==> all paths found, 1 ==> some path was not in mfile
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static int
+lookup(char *mfile, enum fnv_type hash_type, int npath, char **path,
+       Fnv64_t bmask, int verbose)
+{
+    struct fnv_manifest *m;	/* open manifest */
+    Fnv64_t hval;		/* hash of a path */
+    int ret = 0;		/* 1 ==> some path was not found */
+    int i;
+
+    m = fnv_manifest_open(mfile);
+    if (m == NULL) {
+	fprintf(stderr, "%s: unable to open manifest: %s: %s\n",
+		prog, mfile, strerror(errno));
+	exit(4); /*ooo*/
+    }
+    if (fnv_manifest_hash_type(m) != hash_type) {
+	fprintf(stderr, "%s: manifest is for another hash type: %s\n",
+		prog, mfile);
+	exit(3); /*ooo*/
+    }
+    for (i = 0; i < npath; ++i) {
+	if (fnv_manifest_lookup(m, path[i], &hval, NULL, NULL) < 0) {
+	    fprintf(stderr, "%s: not in manifest: %s\n", prog, path[i]);
+	    ret = 1;
+	    continue;
+	}
+	print_fnv64(hval, bmask, verbose, path[i]);
+    }
+    fnv_manifest_close(m);
+    return ret;
+}
+
+
+/*
+ * print_member - fnv_tar_hash() callback that prints a member hash
+ */
+static void
+print_member(char *path, Fnv64_t hval, off_t size, void *arg)
+{
+    (void) size;
+    print_fnv64(hval, *(Fnv64_t *)arg, 1, path);
+}
+
+
+/*
+ * hash_tar - print the hash of each regular member of a --tar archive
+ *
+ * given:
+ *	name		tar archive, NULL ==> stdin
+ *	hash_type	type of FNV hash to perform
+ *	bmask		mask to apply to output
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static void
+hash_tar(char *name, enum fnv_type hash_type, Fnv64_t bmask)
+{
+    int fd = 0;			/* archive */
+
+    if (name != NULL) {
+	fd = open(name, O_RDONLY);
+	if (fd < 0) {
+	    fprintf(stderr, "%s: unable to open file: %s\n", prog, name);
+	    exit(4); /*ooo*/
+	}
+    }
+    if (fnv_tar_hash(fd, hash_type, print_member, &bmask) < 0) {
+	fflush(stdout);
+	fprintf(stderr, "%s: %s tar archive: %s\n", prog,
+		errno == EINVAL ? "invalid or truncated" : "unable to read",
+		name != NULL ? name : "(stdin)");
+	exit(4); /*ooo*/
+    }
+    if (name != NULL) {
+	close(fd);
+    }
+}
+
+
+/*
+ * hash_lines - print the hash of each line of each -l file
+ *
+ * given:
+ *	nfile		number of files, 0 ==> stdin
+ *	file		files to read
+ *	hash_type	type of FNV hash to perform
+ *	init_hval	initial basis for each line
+ *	bmask		mask to apply to output
+ *	verbose		1 ==> print each line after its hash
+ *
+ * The newline ending a line is not hashed.
+ *
+ * NOTE: This function does not return on an I/O error.
+ */
+static void
+hash_lines(int nfile, char **file, enum fnv_type hash_type,
+	   Fnv64_t init_hval, Fnv64_t bmask, int verbose)
+{
+    FILE *stream;		/* file being read */
+    char *line = NULL;		/* current line */
+    size_t size = 0;		/* allocated size of line */
+    ssize_t len;		/* length of line */
+    Fnv64_t hval;		/* hash of line */
+    int i = 0;
+
+    do {
+	stream = (nfile > 0) ? fopen(file[i], "r") : stdin;
+	if (stream == NULL) {
+	    fprintf(stderr, "%s: unable to open file: %s\n", prog, file[i]);
+	    exit(4); /*ooo*/
+	}
+	while ((len = getline(&line, &size, stream)) > 0) {
+	    if (line[len-1] == '\n') {
+		line[--len] = '\0';
+	    }
+	    hval = hash_buf(hash_type, line, (size_t)len, init_hval);
+	    print_fnv64(hval, bmask, verbose, line);
+	}
+	if (ferror(stream)) {
+	    fprintf(stderr, "%s: error reading file: %s\n", prog,
+		    (nfile > 0) ? file[i] : "(stdin)");
+	    exit(4); /*ooo*/
+	}
+	if (nfile > 0) {
+	    fclose(stream);
+	}
+    } while (++i < nfile);
+    free(line);
+}
+
+
+/*
+ * one --topk or --distinct thread: count the lines of part of a file
+ */
+struct lines_job {
+    const char *buf;		/* start of the lines */
+    size_t len;			/* octets of lines */
+    struct fnv_topk *t;		/* --topk summary of this thread or NULL */
+    struct fnv_hll *h;		/* --distinct counter of this thread or NULL */
+    int ret;			/* fnv_topk_lines() or fnv_hll_lines() return */
+};
+
+static void *
+lines_thread(void *arg)
+{
+    struct lines_job *job = arg;	/* our lines */
+
+    if (job->t != NULL) {
+	job->ret = fnv_topk_lines(job->t, job->buf, job->len);
+    } else {
+	job->ret = fnv_hll_lines(job->h, job->buf, job->len);
+    }
+    return NULL;
+}
+
+
+/*
+ * count_file - add the lines of a regular file to a summary or counter
+ *
+ * given:
+ *	fd		open regular file
+ *	size		size of the file
+ *	t		--topk summary to add to, or NULL
+ *	h		--distinct counter to add to if t is NULL
+ *	nthread		number of threads
+ *	cap		counters in each thread --topk summary
+ *
+ * returns:	0 ==> OK, -1 ==> error, errno set
+ *
+ * The file is mapped and cut at line boundaries into one part per
+ * thread.  Each thread counts its part in its own summary or counter,
+ * and these are merged into t or h.
+ */
+static int
+count_file(int fd, off_t size, struct fnv_topk *t, struct fnv_hll *h,
+	   int nthread, size_t cap)
+{
+    struct lines_job *job;	/* one job per thread */
+    pthread_t *tid;		/* thread ids */
+    const char *buf;		/* the mapped file */
+    const char *nl;		/* newline ending a part */
+    size_t len = (size_t)size;	/* octets in file */
+    size_t start;		/* start of a part */
+    size_t cut;			/* where a part would end without lines */
+    int ret = 0;		/* return value */
+    int n;			/* threads started */
+    int i;
+
+    buf = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (buf == MAP_FAILED) {
+	return -1;
+    }
+    (void) madvise((void *)buf, len, MADV_SEQUENTIAL);
+    if ((size_t)nthread > len / (64*1024) + 1) {
+	/* not worth a thread per 64k */
+	nthread = (int)(len / (64*1024)) + 1;
+    }
+    job = calloc((size_t)nthread, sizeof(job[0]));
+    tid = calloc((size_t)nthread, sizeof(tid[0]));
+    if (job == NULL || tid == NULL) {
+	free(job);
+	free(tid);
+	munmap((void *)buf, len);
+	errno = ENOMEM;
+	return -1;
+    }
+    for (i = 0, start = 0; i < nthread; ++i) {
+	cut = (i == nthread-1) ? len : (size_t)((double)len * (i+1) / nthread);
+	if (cut < start) {
+	    cut = start;
+	}
+	if (cut < len) {
+	    nl = memchr(buf + cut, '\n', len - cut);
+	    cut = (nl == NULL) ? len : (size_t)(nl - buf) + 1;
+	}
+	job[i].buf = buf + start;
+	job[i].len = cut - start;
+	start = cut;
+    }
+
+    /* the first part is counted straight into t or h */
+    job[0].t = t;
+    job[0].h = h;
+    for (n = 1; n < nthread; ++n) {
+	if (t != NULL) {
+	    job[n].t = fnv_topk_new(cap);
+	} else {
+	    job[n].h = fnv_hll_new(DISTINCT_P);
+	}
+	if ((job[n].t == NULL && job[n].h == NULL) ||
+	    pthread_create(&tid[n], NULL, lines_thread, &job[n]) != 0) {
+	    fnv_topk_free(job[n].t);
+	    fnv_hll_free(job[n].h);
+	    break;
+	}
+    }
+    lines_thread(&job[0]);
+    ret = job[0].ret;
+    for (i = n; i < nthread && ret == 0; ++i) {
+	/* parts without a thread are counted by this one */
+	job[i].t = t;
+	job[i].h = h;
+	lines_thread(&job[i]);
+	ret = job[i].ret;
+    }
+    for (i = 1; i < n; ++i) {
+	pthread_join(tid[i], NULL);
+	if (job[i].ret < 0) {
+	    ret = -1;
+	} else if (ret == 0 && t != NULL) {
+	    ret = fnv_topk_merge(t, job[i].t);
+	} else if (ret == 0) {
+	    ret = fnv_hll_merge(h, job[i].h);
+	}
+	fnv_topk_free(job[i].t);
+	fnv_hll_free(job[i].h);
+    }
+    free(job);
+    free(tid);
+    munmap((void *)buf, len);
+    if (ret < 0) {
+	errno = ENOMEM;
+    }
+    return ret;
+}
+
+
+/*
+ * count_lines - add the lines of the -l files to a summary or counter
+ *
+ * given:
+ *	nfile		number of files, 0 ==> stdin
+ *	file		files to read
+ *	t		--topk summary to add to, or NULL
+ *	h		--distinct counter to add to if t is NULL
+ *	nthread		number of threads, < 1 ==> one per online CPU
+ *	cap		counters in each thread --topk summary
+ *
+ * Regular files are counted by count_file(), while pipes and the like
+ * are streamed by this thread.
+ *
+ * NOTE: This function does not return on an error.
+ */
+static void
+count_lines(int nfile, char **file, struct fnv_topk *t, struct fnv_hll *h,
+	    int nthread, size_t cap)
+{
+    struct stat st;		/* file status */
+    FILE *stream;		/* file being read */
+    char *line = NULL;		/* current streamed line */
+    size_t size = 0;		/* allocated size of line */
+    ssize_t len;		/* length of line */
+    int fd;			/* file being read */
+    int i = 0;
+
+    if (nthread < 1) {
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);	/* online CPUs */
+
+	nthread = (ncpu > 0) ? (int)ncpu : 1;
+    }
+    do {
+	fd = (nfile > 0) ? open(file[i], O_RDONLY) : 0;
+	if (fd < 0) {
+	    fprintf(stderr, "%s: unable to open file: %s\n", prog, file[i]);
+	    exit(4); /*ooo*/
+	}
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+	    lseek(fd, 0, SEEK_CUR) == 0) {
+	    if (count_file(fd, st.st_size, t, h, nthread, cap) < 0) {
+		fprintf(stderr, "%s: error counting lines: %s: %s\n", prog,
+			(nfile > 0) ? file[i] : "(stdin)", strerror(errno));
+		exit(4); /*ooo*/
+	    }
+	    if (nfile > 0) {
+		close(fd);
+	    }
+	    continue;
+	}
+	stream = fdopen(fd, "r");
+	if (stream == NULL) {
+	    fprintf(stderr, "%s: out of memory\n", prog);
+	    exit(22);
+	}
+	while ((len = getline(&line, &size, stream)) > 0) {
+	    if (line[len-1] == '\n') {
+		--len;
+	    }
+	    if ((t != NULL) ? fnv_topk_add(t, line, (size_t)len, 1) :
+			      fnv_hll_add(h, line, (size_t)len)) {
+		fprintf(stderr, "%s: out of memory\n", prog);
+		exit(22);
+	    }
+	}
+	if (ferror(stream)) {
+	    fprintf(stderr, "%s: error reading file: %s\n", prog,
+		    (nfile > 0) ? file[i] : "(stdin)");
+	    exit(4); /*ooo*/
+	}
+	if (nfile > 0) {
+	    fclose(stream);
+	}
+    } while (++i < nfile);
+    free(line);
+}
+
+
+/*
+ * top_lines - print the most frequent lines of the -l --topk files
+ *
+ * given:
+ *	nfile		number of files, 0 ==> stdin
+ *	file		files to read
+ *	k		number of lines to print
+ *	nthread		number of threads, < 1 ==> one per online CPU
+ *	verbose		1 ==> also print the most each count may be over
+ *
+ * Lines are counted with a Space-Saving summary of max(10 * k, 1024)
+ * counters, so memory does not grow with the input.  Each printed count
+ * is at least the true count and over by at most its error, which is
+ * at most the number of lines divided by the number of counters.
+ *
+ * NOTE: This function does not return on an error.
+ */
+static void
+top_lines(int nfile, char **file, size_t k, int nthread, int verbose)
+{
+    struct fnv_topk *t;		/* summary of all lines */
+    struct fnv_topk_item *top;	/* most frequent lines */
+    size_t cap;			/* counters in a summary */
+    size_t ntop;		/* number of lines in top */
+    size_t i;
+
+    cap = (k > 1024 / 10) ? k * 10 : 1024;
+    t = fnv_topk_new(cap);
+    top = calloc(k, sizeof(top[0]));
+    if (t == NULL || top == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    count_lines(nfile, file, t, NULL, nthread, cap);
+    ntop = fnv_topk_list(t, k, top);
+    for (i = 0; i < ntop; ++i) {
+	if (verbose) {
+	    printf("%llu %llu ", top[i].count, top[i].err);
+	} else {
+	    printf("%llu ", top[i].count);
+	}
+	fwrite(top[i].key, 1, top[i].len, stdout);
+	putchar('\n');
+    }
+    free(top);
+    fnv_topk_free(t);
+}
+
+
+/*
+ * distinct_lines - print the number of distinct lines of the -l files
+ *
+ * given:
+ *	nfile		number of files, 0 ==> stdin
+ *	file		files to read
+ *	nthread		number of threads, < 1 ==> one per online CPU
+ *	verbose		1 ==> also print the relative standard error
+ *
+ * The count is a HyperLogLog++ estimate in 2^DISTINCT_P octets, exact
+ * for a few thousand lines and within about 1% beyond that.
+ *
+ * NOTE: This function does not return on an error.
+ */
+static void
+distinct_lines(int nfile, char **file, int nthread, int verbose)
+{
+    struct fnv_hll *h;		/* counter of all lines */
+    unsigned long long n;	/* estimated distinct lines */
+
+    h = fnv_hll_new(DISTINCT_P);
+    if (h == NULL) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    count_lines(nfile, file, NULL, h, nthread, 0);
+    errno = 0;
+    n = fnv_hll_count(h);
+    if (errno == ENOMEM) {
+	fprintf(stderr, "%s: out of memory\n", prog);
+	exit(22);
+    }
+    if (verbose) {
+	printf("%llu +-%.2f%%\n", n, 104.0 / sqrt((double)(1 << DISTINCT_P)));
+    } else {
+	printf("%llu\n", n);
+    }
+    fnv_hll_free(h);
+}
+
+/*
+ * main - the main function
+ *
+ * See the above usage for details.
+ */
+int
+main(int argc, char *argv[])
+{
+    Fnv64_t hval;		/* current hash value */
+    Fnv64_t init_hval;		/* initial basis for the hash type */
+    int s_flag = 0;		/* 1 => -s was given, hash args as strings */
+    int m_flag = 0;		/* 1 => print multiple hashes, one per arg */
+    int v_flag = 0;		/* 1 => verbose hash print */
+    int b_flag = WIDTH;		/* -b flag value */
+    int t_flag = -1;		/* FNV test vector code (0=>print, 1=>test) */
+    enum fnv_type hash_type = FNV_NONE;	/* type of FNV hash to perform */
+    Fnv64_t bmask;		/* mask to apply to output */
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    char *cache_file = NULL;	/* --cache file or NULL */
+    int cache_stats = 0;	/* 1 => --cache-stats was given */
+    int tee_flag = 0;		/* 1 => --tee was given */
+    char *tee_file = NULL;	/* --tee=hashfile or NULL for stderr */
+    char *stats_file = NULL;	/* --stats=statsfile or NULL */
+    int serve_flag = 0;		/* 1 => --serve was given */
+    char *resume_file = NULL;	/* --resume ckfile or NULL */
+    int every_flag = 0;		/* 1 => --every was given */
+    char *sidecar_file = NULL;	/* --sidecar scfile or NULL */
+    off_t blksize = SIDECAR_BLKSIZE;	/* --block-size size */
+    int blksize_flag = 0;	/* 1 => --block-size was given */
+    char *verify_file = NULL;	/* --verify scfile or NULL */
+    int nthread = 0;		/* --threads n, 0 => one per online CPU */
+    char *tree_file = NULL;	/* --tree statefile or NULL */
+    int tree_diff = 0;		/* 1 => --tree-diff was given */
+    char *watch_file = NULL;	/* --watch mfile or NULL */
+    int debounce = -1;		/* --debounce ms, -1 => not given */
+    char *lookup_file = NULL;	/* --lookup mfile or NULL */
+    int tar_flag = 0;		/* 1 => --tar was given */
+    int l_flag = 0;		/* 1 => -l was given, hash each line */
+    long topk = 0;		/* --topk n, 0 => not given */
+    int distinct = 0;		/* 1 => --distinct was given */
+    int i;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    prog = rindex(program, '/');
+    prog = (prog == NULL) ? program : prog+1;
+    while ((i = getopt_long(argc, argv, "hvVb:mst:l",
+			    long_opts, NULL)) != -1) {
+	switch (i) {
+
+	case 'h':	/* -h - print help and exit */
+	    print_usage();
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'v':	/* -v - verbose hash print */
+	    m_flag = 1;
+	    v_flag = 1;
+	    break;
+
+	case 'V':	/* -V - print version and exit */
+	    fprintf(stderr, "%s\n", FNV_VERSION);
+	    exit(2); /*ooo*/
+	    /*NOTREACHED*/
+
+	case 'b':	/* -b bcnt - bit mask count */
+	    b_flag = atoi(optarg);
+	    break;
+
+	case 'm':	/* -m - print multiple hashes, one per arg */
+	    m_flag = 1;
+	    break;
+
+	case 's':	/* -s - hash args as strings */
+	    s_flag = 1;
+	    break;
+
+	case 't':	/* -t code - FNV test vector code */
+	    t_flag = atoi(optarg);
+	    if (t_flag < 0 || t_flag > 1) {
+		fprintf(stderr, "%s: -t code must be 0 or 1\n", prog);
+		print_usage();
+		exit(3); /*ooo*/
+	    }
+	    m_flag = 1;
+	    break;
+
+	case OPT_CACHE:	/* --cache file - file hash cache */
+	    cache_file = optarg;
+	    break;
+
+	case OPT_CACHE_STATS:	/* --cache-stats - print cache statistics */
+	    cache_stats = 1;
+	    break;
+
+	case OPT_OFFSET:	/* --offset off - start of range to hash */
+	    if (fnv_parse_size(optarg, &range_offset) < 0) {
+		fprintf(stderr, "%s: invalid --offset: %s\n", prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case OPT_LENGTH:	/* --length len - length of range to hash */
+	    if (fnv_parse_size(optarg, &range_length) < 0) {
+		fprintf(stderr, "%s: invalid --length: %s\n", prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case OPT_SAMPLE:	/* --sample cnt - sampled fingerprint */
+	    sample_cnt = atoi(optarg);
+	    if (sample_cnt <= 0) {
+		fprintf(stderr, "%s: --sample cnt must be > 0\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case OPT_SAMPLE_SIZE:	/* --sample-size size - sample block size */
+	    if (fnv_parse_size(optarg, &sample_size) < 0 || sample_size <= 0) {
+		fprintf(stderr, "%s: invalid --sample-size: %s\n",
+			prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case OPT_TEE:	/* --tee[=hashfile] - copy stdin to stdout */
+	    tee_flag = 1;
+	    tee_file = optarg;
+	    break;
+
+	case OPT_PROGRESS:	/* --progress - print progress on stderr */
+	    stats.progress = 1;
+	    stats.timed = 1;
+	    break;
+
+	case OPT_STATS:	/* --stats=statsfile - write totals when done */
+	    stats_file = optarg;
+	    stats.timed = 1;
+	    break;
+
+	case OPT_PIPELINE:	/* --pipeline - read ahead thread */
+	    pipeline = 1;
+	    break;
+
+	case OPT_SERVE:	/* --serve - coprocess mode */
+	    serve_flag = 1;
+	    break;
+
+	case OPT_CHECKPOINT:	/* --checkpoint ckfile - save hash state */
+	    ckpt_file = optarg;
+	    break;
+
+	case OPT_EVERY:	/* --every size - checkpoint interval */
+	    if (fnv_parse_size(optarg, &ckpt_every) < 0 || ckpt_every <= 0) {
+		fprintf(stderr, "%s: invalid --every: %s\n", prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    every_flag = 1;
+	    break;
+
+	case OPT_RESUME:	/* --resume ckfile - continue from saved state */
+	    resume_file = optarg;
+	    break;
+
+	case OPT_SIDECAR:	/* --sidecar scfile - write block hashes */
+	    sidecar_file = optarg;
+	    break;
+
+	case OPT_BLOCK_SIZE:	/* --block-size size - sidecar block size */
+	    if (fnv_parse_size(optarg, &blksize) < 0 || blksize <= 0) {
+		fprintf(stderr, "%s: invalid --block-size: %s\n",
+			prog, optarg);
+		exit(3); /*ooo*/
+	    }
+	    blksize_flag = 1;
+	    break;
+
+	case OPT_VERIFY:	/* --verify scfile - check against block hashes */
+	    verify_file = optarg;
+	    break;
+
+	case OPT_THREADS:	/* --threads n - number of --verify threads */
+	    nthread = atoi(optarg);
+	    if (nthread < 1) {
+		fprintf(stderr, "%s: --threads must be > 0\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case OPT_TREE:	/* --tree statefile - Merkle hash a directory */
+	    tree_file = optarg;
+	    break;
+
+	case OPT_TREE_DIFF:	/* --tree-diff - compare two directory trees */
+	    tree_diff = 1;
+	    break;
+
+	case OPT_WATCH:	/* --watch mfile - keep a manifest current */
+	    watch_file = optarg;
+	    break;
+
+	case OPT_DEBOUNCE:	/* --debounce ms - --watch quiet time */
+	    debounce = atoi(optarg);
+	    if (debounce < 0) {
+		fprintf(stderr, "%s: --debounce must be >= 0\n", prog);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case OPT_LOOKUP:	/* --lookup mfile - read a --watch manifest */
+	    lookup_file = optarg;
+	    break;
+
+	case OPT_TAR:	/* --tar - hash the members of a tar archive */
+	    tar_flag = 1;
+	    break;
+
+	case 'l':	/* -l - hash each line */
+	    l_flag = 1;
+	    break;
+
+	case OPT_TOPK:	/* --topk n - print the n most frequent lines */
+	    topk = strtol(optarg, NULL, 0);
+	    if (topk < 1 || topk > TOPK_MAX) {
+		fprintf(stderr, "%s: --topk must be > 0 and <= %d\n", prog,
+			TOPK_MAX);
+		exit(3); /*ooo*/
+	    }
+	    break;
+
+	case OPT_DISTINCT:	/* --distinct - count distinct lines */
+	    distinct = 1;
+	    break;
+
+	case ':':
+            (void) fprintf(stderr, "%s: ERROR: requires an argument -- %c\n", prog, optopt);
+	    print_usage();
+            exit(3); /*ooo*/
+            /*NOTREACHED*/
+
+        case '?':
+	    /* a long option has no single letter optopt to report */
+	    if (optopt == 0 || optopt >= OPT_CACHE) {
+		(void) fprintf(stderr, "%s: ERROR: illegal option -- %s\n",
+			       prog, argv[optind-1]);
+	    } else {
+		(void) fprintf(stderr, "%s: ERROR: illegal option -- %c\n",
+			       prog, optopt);
+	    }
+	    print_usage();
+            exit(3); /*ooo*/
+            /*NOTREACHED*/
+
+	default:
+	    print_usage();
+	    exit(3); /*ooo*/
+	}
+    }
+    /* -t code incompatible with -b, -m and args */
+    if (t_flag >= 0) {
+	if (b_flag != WIDTH) {
+	    fprintf(stderr, "%s: -t code incompatible with -b\n", prog);
+	    exit(3); /*ooo*/
+	}
+	if (s_flag != 0) {
+	    fprintf(stderr, "%s: -t code incompatible with -s\n", prog);
+	    exit(3); /*ooo*/
+	}
+	if (optind < argc) {
+	    fprintf(stderr, "%s: -t code incompatible args\n", prog);
+	    exit(3); /*ooo*/
+	}
+    }
+    /* --cache only applies to file args */
+    if (cache_file != NULL && (t_flag >= 0 || s_flag)) {
+	fprintf(stderr, "%s: --cache incompatible with -t and -s\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* partial hashes are not whole file hashes */
+    if ((sample_cnt > 0 || range_offset > 0 || range_length >= 0) &&
+	(t_flag >= 0 || s_flag || cache_file != NULL)) {
+	fprintf(stderr, "%s: --offset, --length and --sample incompatible "
+		"with -t, -s and --cache\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (sample_cnt > 0 && (range_offset > 0 || range_length >= 0)) {
+	fprintf(stderr, "%s: --sample incompatible with --offset and "
+		"--length\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* --tee only copies stdin */
+    if (tee_flag && (t_flag >= 0 || s_flag || optind < argc ||
+		     cache_file != NULL || sample_cnt > 0 ||
+		     range_offset > 0 || range_length >= 0)) {
+	fprintf(stderr, "%s: --tee incompatible with args, -t, -s, --cache, "
+		"--offset, --length and --sample\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (stats.timed && (t_flag >= 0 || s_flag)) {
+	fprintf(stderr, "%s: --progress and --stats incompatible with -t and "
+		"-s\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (pipeline && (t_flag >= 0 || s_flag || tee_flag || sample_cnt > 0 ||
+		     range_offset > 0 || range_length >= 0)) {
+	fprintf(stderr, "%s: --pipeline incompatible with -t, -s, --tee, "
+		"--offset, --length and --sample\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* checkpoints record the state of a single whole input */
+    if ((ckpt_file != NULL || resume_file != NULL) &&
+	(optind+1 < argc || t_flag >= 0 || s_flag || cache_file != NULL ||
+	 tee_flag || pipeline || sample_cnt > 0 || range_offset > 0 ||
+	 range_length >= 0)) {
+	fprintf(stderr, "%s: --checkpoint and --resume incompatible with "
+		"more than one arg, -t, -s, --cache, --tee, --pipeline, "
+		"--offset, --length and --sample\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* --sidecar and --verify process a single file */
+    if ((sidecar_file != NULL || verify_file != NULL) &&
+	(optind+1 != argc || t_flag >= 0 || s_flag || cache_file != NULL ||
+	 tee_flag || pipeline || sample_cnt > 0 || stats.timed ||
+	 ckpt_file != NULL || resume_file != NULL ||
+	 (sidecar_file != NULL && verify_file != NULL))) {
+	fprintf(stderr, "%s: --sidecar and --verify require one file arg "
+		"and are incompatible with each other and with -t, -s, "
+		"--cache, --tee, --pipeline, --sample, --progress, --stats, "
+		"--checkpoint and --resume\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (sidecar_file != NULL && (range_offset > 0 || range_length >= 0)) {
+	fprintf(stderr, "%s: --sidecar incompatible with --offset and "
+		"--length\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (blksize_flag && sidecar_file == NULL) {
+	fprintf(stderr, "%s: --block-size requires --sidecar\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* --watch and --lookup work on a manifest of a directory */
+    if ((watch_file != NULL || lookup_file != NULL) &&
+	(optind + 1 > argc || (watch_file != NULL && optind + 1 != argc) ||
+	 t_flag >= 0 || s_flag || cache_file != NULL || tee_flag ||
+	 pipeline || sample_cnt > 0 || stats.timed || range_offset > 0 ||
+	 range_length >= 0 || ckpt_file != NULL || resume_file != NULL ||
+	 sidecar_file != NULL || verify_file != NULL ||
+	 (watch_file != NULL && lookup_file != NULL))) {
+	fprintf(stderr, "%s: --watch requires one dir arg, --lookup "
+		"requires path args, and both are incompatible with each "
+		"other and with all other options except -b and -v\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* --tar reads one archive */
+    if (tar_flag &&
+	(optind + 1 < argc || t_flag >= 0 || s_flag || cache_file != NULL ||
+	 tee_flag || pipeline || sample_cnt > 0 || stats.timed ||
+	 range_offset > 0 || range_length >= 0 || ckpt_file != NULL ||
+	 resume_file != NULL || sidecar_file != NULL || verify_file != NULL ||
+	 tree_file != NULL || tree_diff || watch_file != NULL ||
+	 lookup_file != NULL)) {
+	fprintf(stderr, "%s: --tar allows at most one arg and is incompatible "
+		"with all other options except -b\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* -l hashes or counts lines */
+    if (l_flag &&
+	(t_flag >= 0 || s_flag || cache_file != NULL || tee_flag ||
+	 pipeline || sample_cnt > 0 || stats.timed || range_offset > 0 ||
+	 range_length >= 0 || ckpt_file != NULL || resume_file != NULL ||
+	 sidecar_file != NULL || verify_file != NULL || tree_file != NULL ||
+	 tree_diff || watch_file != NULL || lookup_file != NULL ||
+	 tar_flag)) {
+	fprintf(stderr, "%s: -l is incompatible with all other options "
+		"except -b, -v, --topk, --distinct and --threads\n", prog);
+	exit(3); /*ooo*/
+    }
+    if ((topk > 0 || distinct) && !l_flag) {
+	fprintf(stderr, "%s: --topk and --distinct require -l\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (topk > 0 && distinct) {
+	fprintf(stderr, "%s: --topk incompatible with --distinct\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (nthread > 0 && verify_file == NULL && watch_file == NULL &&
+	topk == 0 && !distinct) {
+	fprintf(stderr, "%s: --threads requires --verify, --watch, --topk "
+		"or --distinct\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (debounce >= 0 && watch_file == NULL) {
+	fprintf(stderr, "%s: --debounce requires --watch\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* --tree and --tree-diff hash whole directory trees */
+    if ((tree_file != NULL || tree_diff) &&
+	(optind + (tree_diff ? 2 : 1) != argc || t_flag >= 0 || s_flag ||
+	 cache_file != NULL || tee_flag || pipeline || sample_cnt > 0 ||
+	 stats.timed || range_offset > 0 || range_length >= 0 ||
+	 ckpt_file != NULL || resume_file != NULL || sidecar_file != NULL ||
+	 verify_file != NULL || watch_file != NULL || lookup_file != NULL ||
+	 (tree_file != NULL && tree_diff))) {
+	fprintf(stderr, "%s: --tree requires one dir arg, --tree-diff "
+		"requires two tree args, and both are incompatible with "
+		"each other and with all other options except -b and -v\n",
+		prog);
+	exit(3); /*ooo*/
+    }
+    if (every_flag && ckpt_file == NULL) {
+	fprintf(stderr, "%s: --every requires --checkpoint\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* --serve takes its hash types from each request */
+    if (serve_flag && (optind < argc || t_flag >= 0 || s_flag || m_flag ||
+		       b_flag != WIDTH || cache_file != NULL || tee_flag ||
+		       stats.timed || pipeline || sample_cnt > 0 ||
+		       range_offset > 0 || range_length >= 0 ||
+		       ckpt_file != NULL || resume_file != NULL ||
+		       sidecar_file != NULL || verify_file != NULL ||
+		       tree_file != NULL || tree_diff ||
+		       watch_file != NULL || lookup_file != NULL ||
+		       tar_flag || l_flag || topk > 0 || distinct)) {
+	fprintf(stderr, "%s: --serve incompatible with args and all other "
+		"options\n", prog);
+	exit(3); /*ooo*/
+    }
+    if (serve_flag) {
+	serve();
+	exit(0); /*ooo*/
+    }
+    if (cache_stats && cache_file == NULL) {
+	fprintf(stderr, "%s: --cache-stats requires --cache\n", prog);
+	exit(3); /*ooo*/
+    }
+    /* -s requires at least 1 arg */
+    if (s_flag && optind >= argc) {
+	print_usage();
+	exit(3); /*ooo*/
+    }
+    /* limit -b values */
+    if (b_flag < 0 || b_flag > WIDTH) {
+	fprintf(stderr, "%s: -b bcnt: %d must be >= 0 and < %d\n",
+		prog, b_flag, WIDTH);
+	exit(3); /*ooo*/
+    }
+#if defined(HAVE_64BIT_LONG_LONG)
+    if (b_flag == WIDTH) {
+	bmask = (Fnv64_t)0xffffffffffffffffULL;
+    } else {
+	bmask = (Fnv64_t)((1ULL << b_flag) - 1ULL);
+    }
+#else /* HAVE_64BIT_LONG_LONG */
+    if (b_flag == WIDTH) {
+	bmask.w32[0] = 0xffffffffUL;
+	bmask.w32[1] = 0xffffffffUL;
+    } else if (b_flag >= WIDTH/2) {
+	bmask.w32[0] = 0xffffffffUL;
+	bmask.w32[1] = ((1UL << (b_flag-(WIDTH/2))) - 1UL);
+    } else {
+	bmask.w32[0] = ((1UL << b_flag) - 1UL);
+	bmask.w32[1] = 0UL;
+    }
+#endif /* HAVE_64BIT_LONG_LONG */
+
+    /*
+     * start with the initial basis depending on the hash type
+     */
+    if (strcmp(prog, "fnv064") == 0 || strcmp(prog, "no64bit_fnv064") == 0) {
+	/* using non-recommended FNV-0 and zero initial basis */
+	hval = FNV0_64_INIT;
+	hash_type = FNV0_64;
+    } else if (strcmp(prog, "fnv164") == 0 || strcmp(prog, "no64bit_fnv164") == 0) {
+	/* using FNV-1 and non-zero initial basis */
+	hval = FNV1_64_INIT;
+	hash_type = FNV1_64;
+    } else if (strcmp(prog, "fnv1a64") == 0 || strcmp(prog, "no64bit_fnv1a64") == 0) {
+	 /* start with the FNV-1a initial basis */
+	hval = FNV1A_64_INIT;
+	hash_type = FNV1a_64;
+    } else {
+	fprintf(stderr, "%s: unknown program name, unknown hash type\n",
+		prog);
+	exit(3); /*ooo*/
+    }
+
+    init_hval = hval;
+
+    /*
+     * FNV test vector processing, if needed
+     */
+    if (t_flag >= 0) {
+	int code;		/* test vector that failed, starting at 1 */
+
+	/*
+	 * perform all tests
+	 */
+	code = test_fnv64(hash_type, hval, bmask, v_flag, t_flag);
+
+	/*
+	 * evaluate the tests
+	 */
+	if (code == 0) {
+	    if (v_flag) {
+		printf("passed\n");
+	    }
+	    exit(0); /*ooo*/
+	} else {
+	    printf("failed vector (1 is 1st test): %d\n", code);
+	    exit(15);
+	}
+    }
+
+    /*
+     * write or check block hashes, if needed
+     */
+    if (sidecar_file != NULL) {
+	hval = write_sidecar(argv[optind], hash_type, blksize, sidecar_file);
+	print_fnv64(hval, bmask, v_flag, argv[optind]);
+	exit(0); /*ooo*/
+    }
+    if (verify_file != NULL) {
+	exit(verify_sidecar(argv[optind], verify_file, nthread) ? 5 : 0);
+    }
+
+    /*
+     * hash or compare directory trees, if needed
+     */
+    if (tree_file != NULL) {
+	hval = hash_tree(argv[optind], hash_type, tree_file, v_flag);
+	print_fnv64(hval, bmask, v_flag, argv[optind]);
+	exit(0); /*ooo*/
+    }
+    if (tree_diff) {
+	exit(diff_tree(argv[optind], argv[optind+1], hash_type) ? 5 : 0);
+    }
+
+    /*
+     * keep or read a manifest of a directory, if needed
+     */
+    if (watch_file != NULL) {
+	watch(argv[optind], hash_type, watch_file, nthread,
+	      debounce < 0 ? WATCH_DEBOUNCE : debounce, v_flag);
+	exit(0); /*ooo*/
+    }
+    if (lookup_file != NULL) {
+	exit(lookup(lookup_file, hash_type, argc - optind, argv + optind,
+		    bmask, v_flag) ? 5 : 0);
+    }
+
+    /*
+     * hash the members of a tar archive, if needed
+     */
+    if (tar_flag) {
+	hash_tar(optind < argc ? argv[optind] : NULL, hash_type, bmask);
+	exit(0); /*ooo*/
+    }
+
+    /*
+     * hash or count lines, if needed
+     */
+    if (topk > 0) {
+	top_lines(argc - optind, argv + optind, (size_t)topk, nthread,
+		  v_flag);
+	exit(0); /*ooo*/
+    }
+    if (distinct) {
+	distinct_lines(argc - optind, argv + optind, nthread, v_flag);
+	exit(0); /*ooo*/
+    }
+    if (l_flag) {
+	hash_lines(argc - optind, argv + optind, hash_type, init_hval, bmask,
+		   v_flag);
+	exit(0); /*ooo*/
+    }
+
+    /*
+     * continue from the --resume state, if any
+     */
+    ckpt.type = hash_type;
+    ckpt.hval = hval;
+    ckpt.offset = 0;
+    ckpt.size = -1;
+    if (resume_file != NULL) {
+	if (fnv_ctx_load(&ckpt, resume_file) == 0) {
+	    if (ckpt.type != hash_type) {
+		fprintf(stderr, "%s: checkpoint file is for another hash "
+			"type: %s\n", prog, resume_file);
+		exit(3); /*ooo*/
+	    }
+	    hval = ckpt.hval;
+	} else if (errno != ENOENT) {
+	    fprintf(stderr, "%s: unable to resume from checkpoint file: "
+		    "%s: %s\n", prog, resume_file, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+    }
+
+    /*
+     * open the file hash cache, if needed
+     */
+    if (cache_file != NULL) {
+	cache = fnv_cache_open(cache_file);
+	if (cache == NULL) {
+	    fprintf(stderr, "%s: unable to open cache file: %s: %s\n",
+		    prog, cache_file, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+    }
+
+    /*
+     * note the expected size for --progress ETA
+     */
+    stats.start = now();
+    stats.next_progress = stats.start + 1.0;
+    if (stats.progress) {
+	struct stat st;		/* input file status */
+
+	if (optind >= argc) {
+	    if (fstat(0, &st) == 0 && S_ISREG(st.st_mode)) {
+		off_t pos = lseek(0, 0, SEEK_CUR);	/* stdin offset */
+
+		stats.total = (unsigned long long)(st.st_size -
+						   ((pos > 0) ? pos : 0));
+	    }
+	} else if (sample_cnt == 0) {
+	    for (i=optind; i < argc; ++i) {
+		if (stat(argv[i], &st) == 0 && S_ISREG(st.st_mode)) {
+		    off_t len = st.st_size - range_offset;	/* to hash */
+
+		    if (range_length >= 0 && len > range_length) {
+			len = range_length;
+		    }
+		    stats.total += (len > 0) ? (unsigned long long)len : 0;
+		}
+	    }
+	}
+    }
+
+    /*
+     * copy stdin to stdout while hashing it
+     */
+    if (tee_flag) {
+	FILE *hashfile = stderr;	/* where to print the hash */
+
+	++stats.files;
+	hval = hash_tee(hash_type, hval);
+	if (tee_file != NULL) {
+	    hashfile = fopen(tee_file, "w");
+	    if (hashfile == NULL) {
+		fprintf(stderr, "%s: unable to open hash file: %s: %s\n",
+			prog, tee_file, strerror(errno));
+		exit(4); /*ooo*/
+	    }
+	}
+	if (stats.progress) {
+	    show_progress(1);
+	}
+	if (stats_file != NULL) {
+	    write_stats(stats_file);
+	}
+	fprint_fnv64(hashfile, hval, bmask, v_flag, "(stdin)");
+	if (hashfile != stderr && fclose(hashfile) != 0) {
+	    fprintf(stderr, "%s: error writing hash file: %s: %s\n",
+		    prog, tee_file, strerror(errno));
+	    exit(4); /*ooo*/
+	}
+	exit(0); /*ooo*/
+    }
+
+    /*
+     * string hashing
+     */
+    if (s_flag) {
+
+	/* hash any other strings */
+	for (i=optind; i < argc; ++i) {
+	    switch (hash_type) {
+	    case FNV0_64:
+	    case FNV1_64:
+		hval = fnv_64_str(argv[i], hval);
+		break;
+	    case FNV1a_64:
+		hval = fnv_64a_str(argv[i], hval);
+		break;
+	    default:
+		unknown_hash_type(prog, hash_type);
+		exit(20); /*coo*/
+		/*NOTREACHED*/
+	    }
+	    if (m_flag) {
+		print_fnv64(hval, bmask, v_flag, argv[i]);
+	    }
+	}
+
+
+    /*
+     * file hashing
+     */
+    } else {
+
+	/*
+	 * case: process only stdin
+	 */
+	if (optind >= argc) {
+
+	    /* case: process only stdin */
+	    ++stats.files;
+	    hval = hash_input(0, hash_type, hval, "(stdin)");
+	    if (m_flag) {
+		print_fnv64(hval, bmask, v_flag, "(stdin)");
+	    }
+
+	} else {
+
+	    /*
+	     * process any other files
+	     */
+	    for (i=optind; i < argc; ++i) {
+
+		/* hash the file */
+		hval = hash_file(argv[i], hash_type, hval);
+
+		/* finish processing the file */
+		if (m_flag) {
+		    print_fnv64(hval, bmask, v_flag, argv[i]);
+		}
+	    }
+	}
+    }
+
+    /*
+     * report --progress and --stats, if needed
+     */
+    if (stats.progress) {
+	show_progress(1);
+    }
+    if (stats_file != NULL) {
+	write_stats(stats_file);
+    }
+
+    /*
+     * report cache statistics, if needed
+     */
+    if (cache != NULL) {
+	if (cache_stats) {
+	    struct fnv_cache_stat cstat;	/* cache statistics */
+
+	    fnv_cache_getstat(cache, &cstat);
+	    fprintf(stderr, "%s: cache: %llu lookups, %llu hits (%.1f%%), "
+		    "%llu misses, %llu stores\n", prog,
+		    cstat.lookups, cstat.hits,
+		    (cstat.lookups > 0) ?
+			(100.0 * (double)cstat.hits / (double)cstat.lookups) : 0.0,
+		    cstat.misses, cstat.stores);
+	}
+	fnv_cache_close(cache);
+    }
+
+    /*
+     * report hash and exit
+     */
+    if (!m_flag) {
+	print_fnv64(hval, bmask, v_flag, "");
+    }
+    exit(0); /*ooo*/
+}
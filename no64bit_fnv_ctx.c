@@ -0,0 +1,334 @@
+/*
+ * fnv_ctx - save and restore FNV hashing contexts
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/types.h>
+#include "fnv.h"
+
+
+/*
+ * A serialized context is FNV_CTX_SIZE octets, all integers little
+ * endian so that a checkpoint may be resumed on another machine:
+ *
+ *	octets 0-7	FNV_CTX_MAGIC
+ *	octet 8		hash type (enum fnv_type)
+ *	octet 9		1 ==> octets 32-51 identify a regular file, else 0
+ *	octets 10-15	reserved, 0
+ *	octets 16-23	hash value (32 bit hashes are zero extended)
+ *	octets 24-31	number of octets hashed
+ *	octets 32-39	file size
+ *	octets 40-47	file modification time, seconds
+ *	octets 48-51	file modification time, nanoseconds
+ *	octets 52-55	FNV-1a 32 bit hash of octets 0-51
+ *
+ * The file size and modification time let a checkpoint of a file be
+ * refused when resuming on a different or changed file.
+ */
+#define FNV_CTX_MAGIC "FNVctx\0\2"	/* 8 octet magic, format version 2 */
+
+
+/*
+ * put_le - store a value as little endian octets
+ */
+static void
+put_le(unsigned char *buf, unsigned long val, int len)
+{
+    int i;
+
+    for (i = 0; i < len; ++i) {
+	buf[i] = (unsigned char)(val & 0xff);
+	val >>= 8;
+    }
+}
+
+
+/*
+ * get_le - load a value from little endian octets
+ */
+static unsigned long
+get_le(unsigned char *buf, int len)
+{
+    unsigned long val = 0;
+    int i;
+
+    for (i = len-1; i >= 0; --i) {
+	val = (val << 8) | buf[i];
+    }
+    return val;
+}
+
+
+/*
+ * put_off - store a non-negative off_t as 8 little endian octets
+ */
+static void
+put_off(unsigned char *buf, off_t off)
+{
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+	buf[i] = (unsigned char)(off & 0xff);
+	off >>= 8;
+    }
+}
+
+
+/*
+ * get_off - load a non-negative off_t from 8 little endian octets
+ */
+static off_t
+get_off(unsigned char *buf)
+{
+    off_t off = 0;
+    int i;
+
+    for (i = 7; i >= 0; --i) {
+	off = (off << 8) | buf[i];
+    }
+    return off;
+}
+
+
+/*
+ * fnv_ctx_export - serialize a hashing context
+ *
+ * input:
+ *	ctx	- context to serialize
+ *	buf	- where to write FNV_CTX_SIZE octets
+ */
+void
+fnv_ctx_export(struct fnv_ctx *ctx, unsigned char *buf)
+{
+    memset(buf, 0, FNV_CTX_SIZE);
+    memcpy(buf, FNV_CTX_MAGIC, 8);
+    buf[8] = (unsigned char)ctx->type;
+#if defined(HAVE_64BIT_LONG_LONG)
+    put_le(buf+16, (unsigned long)(ctx->hval & 0xffffffffULL), 4);
+    put_le(buf+20, (unsigned long)(ctx->hval >> 32), 4);
+#else /* HAVE_64BIT_LONG_LONG */
+    put_le(buf+16, ctx->hval.w32[0], 4);
+    put_le(buf+20, ctx->hval.w32[1], 4);
+#endif /* HAVE_64BIT_LONG_LONG */
+    put_off(buf+24, ctx->offset);
+    if (ctx->size >= 0 && ctx->mtime >= 0) {
+	buf[9] = 1;
+	put_off(buf+32, ctx->size);
+	put_off(buf+40, (off_t)ctx->mtime);
+	put_le(buf+48, (unsigned long)ctx->mtime_nsec, 4);
+    }
+    put_le(buf+52, fnv_32a_buf(buf, 52, FNV1_32A_INIT), 4);
+}
+
+
+/*
+ * fnv_ctx_import - deserialize a hashing context
+ *
+ * input:
+ *	ctx	- where to store the context
+ *	buf	- serialized context from fnv_ctx_export()
+ *	len	- length of buf in octets
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> not a valid context, errno set to EINVAL
+ */
+int
+fnv_ctx_import(struct fnv_ctx *ctx, unsigned char *buf, size_t len)
+{
+    if (len < FNV_CTX_SIZE || memcmp(buf, FNV_CTX_MAGIC, 8) != 0 ||
+	get_le(buf+52, 4) != fnv_32a_buf(buf, 52, FNV1_32A_INIT) ||
+	buf[8] < FNV0_32 || buf[8] > FNV1a_64 || buf[9] > 1 ||
+	(buf[31] & 0x80) != 0 || (buf[39] & 0x80) != 0 ||
+	(buf[47] & 0x80) != 0 || get_le(buf+48, 4) > 999999999) {
+	errno = EINVAL;
+	return -1;
+    }
+    ctx->type = (enum fnv_type)buf[8];
+#if defined(HAVE_64BIT_LONG_LONG)
+    ctx->hval = ((Fnv64_t)get_le(buf+20, 4) << 32) | get_le(buf+16, 4);
+#else /* HAVE_64BIT_LONG_LONG */
+    ctx->hval.w32[0] = get_le(buf+16, 4);
+    ctx->hval.w32[1] = get_le(buf+20, 4);
+#endif /* HAVE_64BIT_LONG_LONG */
+    ctx->offset = get_off(buf+24);
+    if (buf[9] == 1) {
+	ctx->size = get_off(buf+32);
+	ctx->mtime = (time_t)get_off(buf+40);
+	ctx->mtime_nsec = (long)get_le(buf+48, 4);
+    } else {
+	ctx->size = -1;
+	ctx->mtime = 0;
+	ctx->mtime_nsec = 0;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_ctx_save - atomically write a hashing context to a file
+ *
+ * input:
+ *	ctx	- context to save
+ *	path	- file to write
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ *
+ * The context is written to path.tmp, flushed to stable storage and
+ * renamed over path, so that path always holds a complete context even
+ * if the process or the system dies while saving.
+ */
+int
+fnv_ctx_save(struct fnv_ctx *ctx, char *path)
+{
+    unsigned char buf[FNV_CTX_SIZE];	/* serialized context */
+    char *tmp;			/* temporary file name */
+    int fd;			/* open temporary file */
+    int err;			/* saved errno */
+
+    fnv_ctx_export(ctx, buf);
+    tmp = malloc(strlen(path) + sizeof(".tmp"));
+    if (tmp == NULL) {
+	return -1;
+    }
+    sprintf(tmp, "%s.tmp", path);
+    fd = open(tmp, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+    if (fd < 0) {
+	err = errno;
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    if (write(fd, buf, sizeof(buf)) != (ssize_t)sizeof(buf) ||
+	fsync(fd) < 0) {
+	err = (errno != 0) ? errno : EIO;
+	close(fd);
+	unlink(tmp);
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    if (close(fd) < 0 || rename(tmp, path) < 0) {
+	err = errno;
+	unlink(tmp);
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    free(tmp);
+    return 0;
+}
+
+
+/*
+ * fnv_ctx_load - read a hashing context from a file
+ *
+ * input:
+ *	ctx	- where to store the context
+ *	path	- file written by fnv_ctx_save()
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set (EINVAL ==> not a valid context)
+ */
+int
+fnv_ctx_load(struct fnv_ctx *ctx, char *path)
+{
+    unsigned char buf[FNV_CTX_SIZE+1];	/* serialized context */
+    ssize_t len;		/* octets read */
+    int fd;			/* open context file */
+    int err;			/* saved errno */
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+	return -1;
+    }
+    len = read(fd, buf, sizeof(buf));
+    err = errno;
+    close(fd);
+    if (len < 0) {
+	errno = err;
+	return -1;
+    }
+    if (len != FNV_CTX_SIZE) {
+	errno = EINVAL;
+	return -1;
+    }
+    return fnv_ctx_import(ctx, buf, (size_t)len);
+}
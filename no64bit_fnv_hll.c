@@ -0,0 +1,553 @@
+/*
+ * fnv_hll - HyperLogLog++ distinct counter keyed by FNV-1a 64
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "longlong.h"
+#include "fnv.h"
+
+
+/*
+ * A HyperLogLog++ distinct counter.
+ *
+ * Each key is hashed with fnv_64a_mix(), as HyperLogLog needs every bit
+ * of the hash to be equally random.  The top p bits of the hash
+ * select one of m = 2^p registers, and the register keeps the largest
+ * rank seen, the rank being 1 + the number of leading zeros of the
+ * other 64 - p bits.
+ *
+ * A new counter is sparse, as in HyperLogLog++: it keeps a sorted list
+ * of 32 bit entries, each the top 25 bits of a hash with the rank of
+ * the other 39 bits, and estimates the count by linear counting over
+ * 2^25 buckets, which is nearly exact for small counts.  New entries
+ * are collected in a small buffer that is sorted into the list when
+ * full.  Once the list would take more memory than the registers, the
+ * counter becomes dense: one octet per register, so p = 14 takes 16k.
+ * Merging two dense counters is an octet by octet maximum, which
+ * compilers turn into SIMD code.
+ *
+ * HyperLogLog++ corrects the bias of the raw HyperLogLog estimate with
+ * tables of empirical values.  Ertl's improved estimator ("New
+ * cardinality estimation algorithms for HyperLogLog sketches", 2017)
+ * has no such bias over the whole range and needs no tables, so it is
+ * used instead.  The relative standard error is about 1.04 / sqrt(m).
+ */
+#define HLL_SPARSE_P 25		/* index bits of a sparse entry */
+#define HLL_SPARSE_Q (64 - HLL_SPARSE_P)	/* rank bits of a sparse entry */
+#define HLL_TMP 256		/* sparse entries buffered before sorting */
+#define HLL_ENTRY(i, r) (((uint32_t)(i) << 6) | (uint32_t)(r))
+#define HLL_INDEX(e) ((e) >> 6)
+#define HLL_RANK(e) ((e) & 0x3f)
+
+struct fnv_hll {
+    unsigned int p;		/* log2 of the number of registers */
+    size_t m;			/* number of registers */
+    unsigned char *reg;		/* m registers, NULL ==> sparse */
+    uint32_t *sparse;		/* sorted sparse entries, unique index */
+    size_t nsparse;		/* entries in sparse */
+    size_t cap;			/* allocated entries in sparse */
+    size_t ntmp;		/* entries in tmp */
+    uint32_t tmp[HLL_TMP];	/* unsorted new sparse entries */
+};
+
+
+/*
+ * rank - 1 + leading zeros of the top bits bits of w, at most bits + 1
+ */
+static unsigned int
+rank(unsigned long long w, unsigned int bits)
+{
+    unsigned int r = 1;		/* rank */
+
+    if (w == 0) {
+	return bits + 1;
+    }
+#if defined(__GNUC__)
+    r += (unsigned int)__builtin_clzll(w);
+#else /* __GNUC__ */
+    while ((w & (1ULL << 63)) == 0) {
+	w <<= 1;
+	++r;
+    }
+#endif /* __GNUC__ */
+    return (r > bits + 1) ? bits + 1 : r;
+}
+
+
+/*
+ * fnv_hll_new - create an empty distinct counter
+ *
+ * input:
+ *	p	- log2 of the number of registers, 4 to 18 (14 ==> 16k)
+ *
+ * returns:
+ *	new counter, free with fnv_hll_free(), or NULL ==> error, errno set
+ */
+struct fnv_hll *
+fnv_hll_new(unsigned int p)
+{
+    struct fnv_hll *h;		/* new counter */
+
+    if (p < 4 || p > 18) {
+	errno = EINVAL;
+	return NULL;
+    }
+    h = calloc(1, sizeof(*h));
+    if (h == NULL) {
+	errno = ENOMEM;
+	return NULL;
+    }
+    h->p = p;
+    h->m = (size_t)1 << p;
+    return h;
+}
+
+
+/*
+ * fnv_hll_free - free a distinct counter
+ */
+void
+fnv_hll_free(struct fnv_hll *h)
+{
+    if (h != NULL) {
+	free(h->reg);
+	free(h->sparse);
+	free(h);
+    }
+}
+
+
+/*
+ * dense_set - raise register i to rank r
+ */
+static inline void
+dense_set(struct fnv_hll *h, size_t i, unsigned int r)
+{
+    if (r > h->reg[i]) {
+	h->reg[i] = (unsigned char)r;
+    }
+}
+
+
+/*
+ * dense_entry - raise the register of a sparse entry
+ */
+static void
+dense_entry(struct fnv_hll *h, uint32_t e)
+{
+    unsigned int shift = HLL_SPARSE_P - h->p;	/* index bits not in p */
+    uint32_t idx = HLL_INDEX(e);	/* 25 bit index */
+    uint32_t low = idx & ((1U << shift) - 1);	/* bits below p */
+
+    if (low != 0) {
+	/* the rank is found in the index bits below the top p */
+	dense_set(h, idx >> shift,
+		  rank((unsigned long long)low << (64 - shift), shift));
+    } else {
+	dense_set(h, idx >> shift, shift + HLL_RANK(e));
+    }
+}
+
+
+/*
+ * to_dense - make a sparse counter dense
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+to_dense(struct fnv_hll *h)
+{
+    size_t i;
+
+    h->reg = calloc(h->m, 1);
+    if (h->reg == NULL) {
+	return -1;
+    }
+    for (i = 0; i < h->nsparse; ++i) {
+	dense_entry(h, h->sparse[i]);
+    }
+    for (i = 0; i < h->ntmp; ++i) {
+	dense_entry(h, h->tmp[i]);
+    }
+    free(h->sparse);
+    h->sparse = NULL;
+    h->nsparse = 0;
+    h->cap = 0;
+    h->ntmp = 0;
+    return 0;
+}
+
+
+/*
+ * cmp_entry - qsort() order of sparse entries
+ */
+static int
+cmp_entry(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;	/* first entry */
+    uint32_t y = *(const uint32_t *)b;	/* second entry */
+
+    return (x > y) - (x < y);
+}
+
+
+/*
+ * flush - sort the buffered sparse entries into the sparse list
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ *
+ * The counter becomes dense once the sparse list would be larger than
+ * the registers.
+ */
+static int
+flush(struct fnv_hll *h)
+{
+    uint32_t *out;		/* merged list */
+    size_t n = 0;		/* entries in out */
+    size_t i = 0;		/* next entry of sparse */
+    size_t j = 0;		/* next entry of tmp */
+    uint32_t e;			/* next entry in order */
+
+    if (h->reg != NULL || h->ntmp == 0) {
+	return 0;
+    }
+    qsort(h->tmp, h->ntmp, sizeof(h->tmp[0]), cmp_entry);
+    out = malloc((h->nsparse + h->ntmp) * sizeof(out[0]));
+    if (out == NULL) {
+	return -1;
+    }
+    while (i < h->nsparse || j < h->ntmp) {
+	if (j >= h->ntmp || (i < h->nsparse && h->sparse[i] < h->tmp[j])) {
+	    e = h->sparse[i++];
+	} else {
+	    e = h->tmp[j++];
+	}
+	/* entries sort by index then rank: keep the last of an index */
+	if (n > 0 && HLL_INDEX(out[n-1]) == HLL_INDEX(e)) {
+	    out[n-1] = e;
+	} else {
+	    out[n++] = e;
+	}
+    }
+    free(h->sparse);
+    h->sparse = out;
+    h->nsparse = n;
+    h->cap = n;
+    h->ntmp = 0;
+    if (h->nsparse * sizeof(h->sparse[0]) > h->m) {
+	return to_dense(h);
+    }
+    return 0;
+}
+
+
+/*
+ * add_hash - add a finalized hash to a counter
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory
+ */
+static int
+add_hash(struct fnv_hll *h, unsigned long long x)
+{
+    uint32_t e;			/* sparse entry of x */
+    size_t lo;			/* lowest sparse entry that may match */
+    size_t hi;			/* beyond the highest that may match */
+    size_t mid;			/* entry being compared */
+
+    if (h->reg != NULL) {
+	dense_set(h, (size_t)(x >> (64 - h->p)), rank(x << h->p, 64 - h->p));
+	return 0;
+    }
+    e = HLL_ENTRY(x >> HLL_SPARSE_Q, rank(x << HLL_SPARSE_P, HLL_SPARSE_Q));
+
+    /* a key seen before does not need to be sorted in again */
+    for (lo = 0, hi = h->nsparse; lo < hi; ) {
+	mid = lo + (hi - lo) / 2;
+	if (HLL_INDEX(h->sparse[mid]) < HLL_INDEX(e)) {
+	    lo = mid + 1;
+	} else {
+	    hi = mid;
+	}
+    }
+    if (lo < h->nsparse && HLL_INDEX(h->sparse[lo]) == HLL_INDEX(e) &&
+	h->sparse[lo] >= e) {
+	return 0;
+    }
+    h->tmp[h->ntmp++] = e;
+    if (h->ntmp == HLL_TMP) {
+	return flush(h);
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_hll_add - add a key to a distinct counter
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory (errno ENOMEM)
+ */
+int
+fnv_hll_add(struct fnv_hll *h, const void *key, size_t len)
+{
+    if (add_hash(h, fnv_64a_mix(key, len, 0)) < 0) {
+	errno = ENOMEM;
+	return -1;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_hll_lines - add each line of a buffer to a distinct counter
+ *
+ * input:
+ *	h	- counter
+ *	buf	- lines, each ending in a newline except perhaps the last
+ *	len	- octets in buf
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> out of memory (errno ENOMEM)
+ *
+ * The newlines are not part of the keys.
+ */
+int
+fnv_hll_lines(struct fnv_hll *h, const char *buf, size_t len)
+{
+    const char *end = buf + len;	/* end of buf */
+    const char *nl;		/* end of a line */
+
+    while (buf < end) {
+	nl = memchr(buf, '\n', (size_t)(end - buf));
+	if (nl == NULL) {
+	    nl = end;
+	}
+	if (fnv_hll_add(h, buf, (size_t)(nl - buf)) < 0) {
+	    return -1;
+	}
+	buf = nl + 1;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_hll_merge - add the keys of one distinct counter to another
+ *
+ * input:
+ *	dst	- counter to add to
+ *	src	- counter with the same p
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error (errno EINVAL for another p, or ENOMEM)
+ *
+ * src may be sorted or made dense, but counts the same keys.
+ */
+int
+fnv_hll_merge(struct fnv_hll *dst, struct fnv_hll *src)
+{
+    unsigned char *d;		/* dst registers */
+    const unsigned char *s;	/* src registers */
+    size_t i;
+
+    if (dst->p != src->p) {
+	errno = EINVAL;
+	return -1;
+    }
+    if (flush(src) < 0 || flush(dst) < 0) {
+	errno = ENOMEM;
+	return -1;
+    }
+    if (src->reg == NULL) {
+	/* add the sparse entries of src */
+	for (i = 0; i < src->nsparse; ++i) {
+	    if (dst->reg != NULL) {
+		dense_entry(dst, src->sparse[i]);
+	    } else {
+		dst->tmp[dst->ntmp++] = src->sparse[i];
+		if (dst->ntmp == HLL_TMP && flush(dst) < 0) {
+		    errno = ENOMEM;
+		    return -1;
+		}
+	    }
+	}
+	if (flush(dst) < 0) {
+	    errno = ENOMEM;
+	    return -1;
+	}
+	return 0;
+    }
+    if (dst->reg == NULL && to_dense(dst) < 0) {
+	errno = ENOMEM;
+	return -1;
+    }
+    d = dst->reg;
+    s = src->reg;
+    for (i = 0; i < dst->m; ++i) {
+	d[i] = (s[i] > d[i]) ? s[i] : d[i];
+    }
+    return 0;
+}
+
+
+/*
+ * sigma, tau - the series of Ertl's improved estimator
+ */
+static double
+sigma(double x)
+{
+    double y = 1.0;		/* power of 2 */
+    double z = x;		/* sum */
+    double prev;		/* previous sum */
+
+    if (x == 1.0) {
+	return INFINITY;
+    }
+    do {
+	x *= x;
+	prev = z;
+	z += x * y;
+	y += y;
+    } while (z != prev);
+    return z;
+}
+
+static double
+tau(double x)
+{
+    double y = 1.0;		/* power of 1/2 */
+    double z = 1.0 - x;		/* sum */
+    double prev;		/* previous sum */
+
+    if (x == 0.0 || x == 1.0) {
+	return 0.0;
+    }
+    do {
+	x = sqrt(x);
+	prev = z;
+	y *= 0.5;
+	z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z != prev);
+    return z / 3.0;
+}
+
+
+/*
+ * fnv_hll_count - estimate the number of distinct keys added
+ *
+ * returns:
+ *	estimate, or 0 with errno ENOMEM if a sparse list could not be sorted
+ */
+unsigned long long
+fnv_hll_count(struct fnv_hll *h)
+{
+    unsigned int c[66];		/* number of registers of each rank */
+    unsigned int q = 64 - h->p;	/* largest rank is q + 1 */
+    double m = (double)h->m;	/* number of registers */
+    double z;			/* estimator denominator */
+    double sm;			/* sparse buckets */
+    size_t i;
+    int k;
+
+    if (flush(h) < 0) {
+	errno = ENOMEM;
+	return 0;
+    }
+    if (h->reg == NULL) {
+	/* linear counting over the 2^25 sparse buckets */
+	sm = (double)(1UL << HLL_SPARSE_P);
+	return (unsigned long long)(sm * log(sm / (sm - (double)h->nsparse)) +
+				    0.5);
+    }
+    memset(c, 0, sizeof(c));
+    for (i = 0; i < h->m; ++i) {
+	++c[h->reg[i]];
+    }
+    z = m * tau(1.0 - (double)c[q+1] / m);
+    for (k = (int)q; k >= 1; --k) {
+	z = 0.5 * (z + c[k]);
+    }
+    z += m * sigma((double)c[0] / m);
+    return (unsigned long long)(m * m / (2.0 * log(2.0)) / z + 0.5);
+}
@@ -0,0 +1,894 @@
+/*
+ * fnv_tree - Merkle tree hashes of directory trees
+ *
+ ***
+ *
+ * For the most up to date copy of this code, see:
+ *
+ *	https://github.com/lcn2/fnv
+ *
+ * For more information on the FNV hash, see:
+ *
+ *	http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ ***
+ *
+ * Fowler/Noll/Vo hash
+ *
+ * The basis of this hash algorithm was taken from an idea sent
+ * as reviewer comments to the IEEE POSIX P1003.2 committee by:
+ *
+ *      Phong Vo (http://www.research.att.com/info/kpv/)
+ *      Glenn Fowler (http://www.research.att.com/~gsf/)
+ *
+ * In a subsequent ballot round:
+ *
+ *      Landon Curt Noll (http://www.isthe.com/chongo/)
+ *
+ * improved on their algorithm.  Some people tried this hash
+ * and found that it worked rather well.  In an EMail message
+ * to Landon, they named it the ``Fowler/Noll/Vo'' or FNV hash.
+ *
+ * FNV hashes are designed to be fast while maintaining a low
+ * collision rate. The FNV speed allows one to quickly hash lots
+ * of data while maintaining a reasonable collision rate.
+ *
+ ***
+ *
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <https://unlicense.org>
+ *
+ ***
+ *
+ * Author:
+ *
+ * chongo (Landon Curt Noll) /\oo/\
+ *
+ * http://www.isthe.com/chongo/index.html
+ * https://github.com/lcn2
+ *
+ * Share and enjoy!  :-)
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "fnv.h"
+
+
+/*
+ * A tree is an array of nodes in pre-order: each directory is followed
+ * by its children in strcmp(3) order of their names, each child being
+ * followed by its own descendants.  The next sibling of node i is node
+ * i + 1 + ndesc, so the children of a directory are enumerated without
+ * visiting their descendants.
+ *
+ * The hash of a regular file is the FNV hash of its contents, the hash
+ * of a symbolic link is the FNV hash of its target and the hash of a
+ * directory is the FNV hash of, for each child in order, its type
+ * character, its name, a NUL and its 8 octet little endian hash.  Other
+ * file types are ignored.
+ *
+ * A state file is a "fnvtree 1 <type>" line followed by a record per
+ * node in pre-order:
+ *
+ *	<type> <hash> <size> <mtime_ns> <ctime_ns> <ino> <ndesc> <name>\0\n
+ *
+ * where type is d, f or l, hash is 16 hex digits and the other numbers
+ * are decimal.  The name of the root node is ".".
+ */
+#define FNV_TREE_MAGIC "fnvtree 1"	/* state file magic */
+
+struct fnv_tree_node {
+    char *name;			/* name within the parent directory */
+    int type;			/* 'd', 'f' or 'l' */
+    Fnv64_t hval;		/* FNV hash of the node */
+    long long size;		/* st_size */
+    long long mtime_ns;		/* st_mtime in nanoseconds */
+    long long ctime_ns;		/* st_ctime in nanoseconds */
+    unsigned long long ino;	/* st_ino */
+    size_t ndesc;		/* number of descendants */
+};
+
+struct fnv_tree {
+    enum fnv_type type;		/* type of FNV hash */
+    struct fnv_tree_node *node;	/* nodes in pre-order */
+    size_t nnode;		/* number of nodes */
+    size_t maxnode;		/* allocated nodes */
+    char *buf;			/* loaded state file, names point into it */
+};
+
+/*
+ * stat(2) nanosecond time stamps
+ */
+#if defined(__APPLE__)
+#define ST_MTIME_NS(st) ((long long)(st)->st_mtimespec.tv_sec * 1000000000LL + \
+			 (long long)(st)->st_mtimespec.tv_nsec)
+#define ST_CTIME_NS(st) ((long long)(st)->st_ctimespec.tv_sec * 1000000000LL + \
+			 (long long)(st)->st_ctimespec.tv_nsec)
+#else /* __APPLE__ */
+#define ST_MTIME_NS(st) ((long long)(st)->st_mtim.tv_sec * 1000000000LL + \
+			 (long long)(st)->st_mtim.tv_nsec)
+#define ST_CTIME_NS(st) ((long long)(st)->st_ctim.tv_sec * 1000000000LL + \
+			 (long long)(st)->st_ctim.tv_nsec)
+#endif /* __APPLE__ */
+
+
+/*
+ * same_hash - compare two hash values
+ */
+static int
+same_hash(Fnv64_t a, Fnv64_t b)
+{
+#if defined(HAVE_64BIT_LONG_LONG)
+    return a == b;
+#else /* HAVE_64BIT_LONG_LONG */
+    return a.w32[0] == b.w32[0] && a.w32[1] == b.w32[1];
+#endif /* HAVE_64BIT_LONG_LONG */
+}
+
+
+/*
+ * init_hval - initial basis of a 64 bit hash type
+ */
+static Fnv64_t
+init_hval(enum fnv_type type)
+{
+    switch (type) {
+    case FNV1_64:
+	return FNV1_64_INIT;
+    case FNV1a_64:
+	return FNV1A_64_INIT;
+    default:
+	break;
+    }
+    return FNV0_64_INIT;
+}
+
+
+/*
+ * new_tree - allocate an empty tree
+ */
+static struct fnv_tree *
+new_tree(enum fnv_type type)
+{
+    struct fnv_tree *t;		/* new tree */
+
+    t = calloc(1, sizeof(*t));
+    if (t != NULL) {
+	t->type = type;
+    }
+    return t;
+}
+
+
+/*
+ * add_node - append a node to a tree
+ *
+ * returns:
+ *	index of the new node, or (size_t)-1 ==> out of memory
+ */
+static size_t
+add_node(struct fnv_tree *t)
+{
+    struct fnv_tree_node *n;	/* grown node array */
+
+    if (t->nnode >= t->maxnode) {
+	t->maxnode = (t->maxnode == 0) ? 1024 : t->maxnode * 2;
+	n = realloc(t->node, t->maxnode * sizeof(t->node[0]));
+	if (n == NULL) {
+	    return (size_t)-1;
+	}
+	t->node = n;
+    }
+    memset(&t->node[t->nnode], 0, sizeof(t->node[0]));
+    return t->nnode++;
+}
+
+
+/*
+ * find_child - find a child of directory node d by name
+ *
+ * returns:
+ *	node index, or (size_t)-1 ==> no such child
+ */
+static size_t
+find_child(struct fnv_tree *t, size_t d, char *name, size_t *hint)
+{
+    size_t end = d + 1 + t->node[d].ndesc;	/* beyond d's descendants */
+    size_t i;			/* child being looked at */
+    int cmp;			/* name comparison */
+
+    /*
+     * names are looked up in increasing order, so resume from the hint
+     */
+    for (i = (*hint > d) ? *hint : d + 1; i < end;
+	 i += 1 + t->node[i].ndesc) {
+	cmp = strcmp(t->node[i].name, name);
+	if (cmp == 0) {
+	    *hint = i;
+	    return i;
+	}
+	if (cmp > 0) {
+	    break;
+	}
+    }
+    *hint = i;
+    return (size_t)-1;
+}
+
+
+/*
+ * hash_entry - add a directory entry to a directory hash
+ */
+static Fnv64_t
+hash_entry(enum fnv_type type, Fnv64_t hval, int ntype, char *name,
+	   Fnv64_t child)
+{
+    unsigned char ent[8];	/* child hash, little endian */
+    unsigned char c = (unsigned char)ntype;	/* type character */
+    int i;
+
+    hval = fnv_buf_64(type, &c, 1, hval);
+    hval = fnv_buf_64(type, name, strlen(name) + 1, hval);
+#if defined(HAVE_64BIT_LONG_LONG)
+    for (i = 0; i < 8; ++i) {
+	ent[i] = (unsigned char)(child >> (8*i));
+    }
+#else /* HAVE_64BIT_LONG_LONG */
+    for (i = 0; i < 4; ++i) {
+	ent[i] = (unsigned char)(child.w32[0] >> (8*i));
+	ent[4+i] = (unsigned char)(child.w32[1] >> (8*i));
+    }
+#endif /* HAVE_64BIT_LONG_LONG */
+    return fnv_buf_64(type, ent, sizeof(ent), hval);
+}
+
+
+/*
+ * cmp_name - order directory entry names
+ */
+static int
+cmp_name(const void *a, const void *b)
+{
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+
+/*
+ * build_node - add a node, and its descendants, for a path
+ *
+ * given:
+ *	t	tree being built
+ *	path	path of the node
+ *	name	name of the node within its parent
+ *	st	lstat(2) of path
+ *	old	previous tree or NULL
+ *	oi	index of the same node in old, or (size_t)-1
+ *	stat	statistics to update
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set and stat->errpath set
+ */
+static int
+build_node(struct fnv_tree *t, char *path, char *name, struct stat *st,
+	   struct fnv_tree *old, size_t oi, struct fnv_tree_stat *stat)
+{
+    struct fnv_tree_node *n;	/* new node */
+    struct fnv_tree_node *o = NULL;	/* same node in old, or NULL */
+    size_t ni;			/* index of the new node */
+    int err;			/* saved errno */
+
+    ni = add_node(t);
+    if (ni == (size_t)-1) {
+	snprintf(stat->errpath, sizeof(stat->errpath), "%s", path);
+	errno = ENOMEM;
+	return -1;
+    }
+    n = &t->node[ni];
+    n->name = strdup(name);
+    if (n->name == NULL) {
+	snprintf(stat->errpath, sizeof(stat->errpath), "%s", path);
+	errno = ENOMEM;
+	return -1;
+    }
+    n->type = S_ISDIR(st->st_mode) ? 'd' : (S_ISLNK(st->st_mode) ? 'l' : 'f');
+    n->size = (long long)st->st_size;
+    n->mtime_ns = ST_MTIME_NS(st);
+    n->ctime_ns = ST_CTIME_NS(st);
+    n->ino = (unsigned long long)st->st_ino;
+    n->hval = init_hval(t->type);
+    ++stat->nodes;
+    if (old != NULL && oi != (size_t)-1) {
+	o = &old->node[oi];
+    }
+
+    /*
+     * reuse the hash of an unchanged file or symbolic link
+     */
+    if (n->type != 'd' && o != NULL && o->type == n->type &&
+	o->size == n->size && o->mtime_ns == n->mtime_ns &&
+	o->ctime_ns == n->ctime_ns && o->ino == n->ino) {
+	n->hval = o->hval;
+	++stat->reused;
+	return 0;
+    }
+
+    /*
+     * hash a changed or new file or symbolic link
+     */
+    if (n->type == 'f') {
+	int fd = open(path, O_RDONLY);	/* open file */
+
+	if (fd < 0 || fnv_range_64(fd, t->type, 0, -1, &n->hval) < 0) {
+	    err = errno;
+	    if (fd >= 0) {
+		close(fd);
+	    }
+	    snprintf(stat->errpath, sizeof(stat->errpath), "%s", path);
+	    errno = err;
+	    return -1;
+	}
+	close(fd);
+	++stat->hashed;
+	return 0;
+    }
+    if (n->type == 'l') {
+	char target[4096];	/* symbolic link target */
+	ssize_t len;		/* length of target */
+
+	len = readlink(path, target, sizeof(target));
+	if (len < 0) {
+	    snprintf(stat->errpath, sizeof(stat->errpath), "%s", path);
+	    return -1;
+	}
+	n->hval = fnv_buf_64(t->type, target, (size_t)len, n->hval);
+	++stat->hashed;
+	return 0;
+    }
+
+    /*
+     * a directory: add its children in name order, then hash them
+     */
+    {
+	DIR *dir;		/* open directory */
+	struct dirent *d;	/* directory entry */
+	char **names = NULL;	/* entry names */
+	size_t nname = 0;	/* number of names */
+	size_t maxname = 0;	/* allocated names */
+	size_t hint = 0;	/* find_child() position in old */
+	size_t plen = strlen(path);	/* length of path */
+	Fnv64_t hval;		/* directory hash */
+	size_t i;
+	int ret = 0;		/* return value */
+
+	dir = opendir(path);
+	if (dir == NULL) {
+	    snprintf(stat->errpath, sizeof(stat->errpath), "%s", path);
+	    return -1;
+	}
+	while ((d = readdir(dir)) != NULL) {
+	    if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0) {
+		continue;
+	    }
+	    if (nname >= maxname) {
+		char **grown;	/* grown name array */
+
+		maxname = (maxname == 0) ? 64 : maxname * 2;
+		grown = realloc(names, maxname * sizeof(names[0]));
+		if (grown == NULL) {
+		    ret = -1;
+		    break;
+		}
+		names = grown;
+	    }
+	    names[nname] = strdup(d->d_name);
+	    if (names[nname] == NULL) {
+		ret = -1;
+		break;
+	    }
+	    ++nname;
+	}
+	closedir(dir);
+	if (ret < 0) {
+	    snprintf(stat->errpath, sizeof(stat->errpath), "%s", path);
+	    errno = ENOMEM;
+	}
+	if (nname > 0) {
+	    qsort(names, nname, sizeof(names[0]), cmp_name);
+	}
+	if (o != NULL && o->type != 'd') {
+	    oi = (size_t)-1;
+	}
+	for (i = 0; i < nname && ret == 0; ++i) {
+	    struct stat cst;	/* child status */
+	    char *sub;		/* path of the child */
+
+	    sub = malloc(plen + 1 + strlen(names[i]) + 1);
+	    if (sub == NULL) {
+		snprintf(stat->errpath, sizeof(stat->errpath), "%s", path);
+		errno = ENOMEM;
+		ret = -1;
+		break;
+	    }
+	    if (plen > 0 && path[plen-1] == '/') {
+		sprintf(sub, "%s%s", path, names[i]);
+	    } else {
+		sprintf(sub, "%s/%s", path, names[i]);
+	    }
+	    if (lstat(sub, &cst) < 0) {
+		snprintf(stat->errpath, sizeof(stat->errpath), "%s", sub);
+		ret = -1;
+	    } else if (S_ISREG(cst.st_mode) || S_ISDIR(cst.st_mode) ||
+		       S_ISLNK(cst.st_mode)) {
+		ret = build_node(t, sub, names[i], &cst, old,
+				 (oi == (size_t)-1) ? (size_t)-1 :
+				 find_child(old, oi, names[i], &hint), stat);
+	    }
+	    free(sub);
+	}
+	err = errno;
+	for (i = 0; i < nname; ++i) {
+	    free(names[i]);
+	}
+	free(names);
+	if (ret < 0) {
+	    errno = err;
+	    return -1;
+	}
+
+	/* t->node may have moved while adding the children */
+	n = &t->node[ni];
+	n->ndesc = t->nnode - ni - 1;
+	hval = init_hval(t->type);
+	for (i = ni + 1; i < t->nnode; i += 1 + t->node[i].ndesc) {
+	    hval = hash_entry(t->type, hval, t->node[i].type,
+			      t->node[i].name, t->node[i].hval);
+	}
+	n->hval = hval;
+    }
+    return 0;
+}
+
+
+/*
+ * fnv_tree_build - hash a directory tree into a Merkle tree
+ *
+ * input:
+ *	dir	- root of the tree
+ *	type	- FNV0_64, FNV1_64 or FNV1a_64
+ *	old	- previous tree of the same directory, or NULL
+ *	stat	- where to store statistics, and the path of an error
+ *
+ * returns:
+ *	new tree, free with fnv_tree_free(), or NULL ==> error, errno set
+ *
+ * Every node is lstat(2)-ed but a file or symbolic link is only read if
+ * its size, times or inode differ from the same path in old.  Directory
+ * hashes are recomputed from their children, which is cheap.
+ * Symbolic links are not followed.
+ */
+struct fnv_tree *
+fnv_tree_build(char *dir, enum fnv_type type, struct fnv_tree *old,
+	       struct fnv_tree_stat *stat)
+{
+    struct fnv_tree *t;		/* new tree */
+    struct stat st;		/* root status */
+
+    memset(stat, 0, sizeof(*stat));
+    if (type < FNV0_64 || type > FNV1a_64 ||
+	(old != NULL && old->type != type)) {
+	errno = EINVAL;
+	return NULL;
+    }
+    if (lstat(dir, &st) < 0) {
+	snprintf(stat->errpath, sizeof(stat->errpath), "%s", dir);
+	return NULL;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+	snprintf(stat->errpath, sizeof(stat->errpath), "%s", dir);
+	errno = ENOTDIR;
+	return NULL;
+    }
+    t = new_tree(type);
+    if (t == NULL) {
+	return NULL;
+    }
+    if (build_node(t, dir, ".", &st, old,
+		   (old != NULL && old->nnode > 0) ? 0 : (size_t)-1,
+		   stat) < 0) {
+	int err = errno;	/* saved errno */
+
+	fnv_tree_free(t);
+	errno = err;
+	return NULL;
+    }
+    return t;
+}
+
+
+/*
+ * fnv_tree_hash - return the hash of the root of a tree
+ */
+Fnv64_t
+fnv_tree_hash(struct fnv_tree *t)
+{
+    return (t->nnode > 0) ? t->node[0].hval : init_hval(t->type);
+}
+
+
+/*
+ * fnv_tree_hash_type - return the FNV hash type of a tree
+ */
+enum fnv_type
+fnv_tree_hash_type(struct fnv_tree *t)
+{
+    return t->type;
+}
+
+
+/*
+ * fnv_tree_save - atomically write a tree to a state file
+ *
+ * input:
+ *	t	- tree from fnv_tree_build()
+ *	path	- state file to write
+ *
+ * returns:
+ *	0 ==> OK, -1 ==> error, errno set
+ */
+int
+fnv_tree_save(struct fnv_tree *t, char *path)
+{
+    struct fnv_tree_node *n;	/* node being written */
+    char *tmp;			/* temporary file name */
+    FILE *f;			/* open temporary file */
+    size_t i;
+    int err;			/* saved errno */
+
+    tmp = malloc(strlen(path) + sizeof(".tmp"));
+    if (tmp == NULL) {
+	return -1;
+    }
+    sprintf(tmp, "%s.tmp", path);
+    f = fopen(tmp, "w");
+    if (f == NULL) {
+	err = errno;
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    fprintf(f, "%s %d\n", FNV_TREE_MAGIC, (int)t->type);
+    for (i = 0; i < t->nnode; ++i) {
+	n = &t->node[i];
+#if defined(HAVE_64BIT_LONG_LONG)
+	fprintf(f, "%c %016llx", n->type, (unsigned long long)n->hval);
+#else /* HAVE_64BIT_LONG_LONG */
+	fprintf(f, "%c %08lx%08lx", n->type, (unsigned long)n->hval.w32[1],
+		(unsigned long)n->hval.w32[0]);
+#endif /* HAVE_64BIT_LONG_LONG */
+	fprintf(f, " %lld %lld %lld %llu %llu %s%c\n", n->size, n->mtime_ns,
+		n->ctime_ns, n->ino, (unsigned long long)n->ndesc, n->name,
+		'\0');
+    }
+    if (ferror(f) || fflush(f) != 0 || fsync(fileno(f)) < 0) {
+	err = (errno != 0) ? errno : EIO;
+	fclose(f);
+	unlink(tmp);
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    if (fclose(f) != 0 || rename(tmp, path) < 0) {
+	err = errno;
+	unlink(tmp);
+	free(tmp);
+	errno = err;
+	return -1;
+    }
+    free(tmp);
+    return 0;
+}
+
+
+/*
+ * parse_hex - parse 16 hex digits into a hash value
+ *
+ * returns:
+ *	pointer beyond the digits, or NULL ==> invalid
+ */
+static char *
+parse_hex(char *p, Fnv64_t *hval)
+{
+    unsigned long w[2] = {0, 0};	/* high and low 32 bits */
+    int i;
+    int d;			/* digit value */
+
+    for (i = 0; i < 16; ++i) {
+	if (p[i] >= '0' && p[i] <= '9') {
+	    d = p[i] - '0';
+	} else if (p[i] >= 'a' && p[i] <= 'f') {
+	    d = p[i] - 'a' + 10;
+	} else {
+	    return NULL;
+	}
+	w[i / 8] = (w[i / 8] << 4) | (unsigned long)d;
+    }
+#if defined(HAVE_64BIT_LONG_LONG)
+    *hval = ((Fnv64_t)w[0] << 32) | (Fnv64_t)w[1];
+#else /* HAVE_64BIT_LONG_LONG */
+    hval->w32[1] = w[0];
+    hval->w32[0] = w[1];
+#endif /* HAVE_64BIT_LONG_LONG */
+    return p + 16;
+}
+
+
+/*
+ * fnv_tree_load - read a tree from a state file
+ *
+ * input:
+ *	path	- state file written by fnv_tree_save()
+ *
+ * returns:
+ *	tree, free with fnv_tree_free(), or NULL ==> error, errno set
+ *	(ENOENT ==> no state file, EINVAL ==> invalid state file)
+ */
+struct fnv_tree *
+fnv_tree_load(char *path)
+{
+    struct fnv_tree *t;		/* loaded tree */
+    struct fnv_tree_node *n;	/* node being parsed */
+    struct stat st;		/* state file status */
+    char *p;			/* parse position */
+    char *end;			/* end of the loaded file */
+    ssize_t cnt;		/* octets read */
+    size_t got = 0;		/* octets loaded */
+    int type;			/* hash type */
+    int fd;			/* open state file */
+    int err;			/* saved errno */
+    size_t i;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+	return NULL;
+    }
+    if (fstat(fd, &st) < 0) {
+	err = errno;
+	close(fd);
+	errno = err;
+	return NULL;
+    }
+    t = new_tree(FNV_NONE);
+    if (t == NULL || (t->buf = malloc((size_t)st.st_size + 1)) == NULL) {
+	close(fd);
+	free(t);
+	errno = ENOMEM;
+	return NULL;
+    }
+    while (got < (size_t)st.st_size) {
+	cnt = read(fd, t->buf + got, (size_t)st.st_size - got);
+	if (cnt < 0 && errno == EINTR) {
+	    continue;
+	}
+	if (cnt <= 0) {
+	    err = (cnt < 0) ? errno : EINVAL;
+	    close(fd);
+	    fnv_tree_free(t);
+	    errno = err;
+	    return NULL;
+	}
+	got += (size_t)cnt;
+    }
+    close(fd);
+    t->buf[got] = '\0';
+    end = t->buf + got;
+
+    /*
+     * parse the header and the nodes
+     */
+    p = t->buf;
+    if (strncmp(p, FNV_TREE_MAGIC " ", sizeof(FNV_TREE_MAGIC)) != 0) {
+	goto invalid;
+    }
+    type = (int)strtol(p + sizeof(FNV_TREE_MAGIC), &p, 10);
+    if (type < FNV0_64 || type > FNV1a_64 || *p != '\n') {
+	goto invalid;
+    }
+    t->type = (enum fnv_type)type;
+    ++p;
+    while (p < end) {
+	if (add_node(t) == (size_t)-1) {
+	    fnv_tree_free(t);
+	    errno = ENOMEM;
+	    return NULL;
+	}
+	n = &t->node[t->nnode - 1];
+	n->type = *p;
+	if ((n->type != 'd' && n->type != 'f' && n->type != 'l') ||
+	    p[1] != ' ' || (p = parse_hex(p + 2, &n->hval)) == NULL) {
+	    goto invalid;
+	}
+	n->size = strtoll(p, &p, 10);
+	n->mtime_ns = strtoll(p, &p, 10);
+	n->ctime_ns = strtoll(p, &p, 10);
+	n->ino = strtoull(p, &p, 10);
+	n->ndesc = (size_t)strtoull(p, &p, 10);
+	if (*p != ' ') {
+	    goto invalid;
+	}
+	n->name = ++p;
+	p += strlen(p);
+	if (p + 1 >= end || p[1] != '\n') {
+	    goto invalid;
+	}
+	p += 2;
+    }
+
+    /*
+     * check that the descendant counts nest
+     */
+    for (i = 0; i < t->nnode; ++i) {
+	if (i + t->node[i].ndesc >= t->nnode ||
+	    (t->node[i].type != 'd' && t->node[i].ndesc != 0)) {
+	    goto invalid;
+	}
+    }
+    if (t->nnode > 0 && t->node[0].ndesc != t->nnode - 1) {
+	goto invalid;
+    }
+    return t;
+
+invalid:
+    fnv_tree_free(t);
+    errno = EINVAL;
+    return NULL;
+}
+
+
+/*
+ * diff_node - compare node ai of a with node bi of b, top down
+ */
+static unsigned long long
+diff_node(struct fnv_tree *a, size_t ai, struct fnv_tree *b, size_t bi,
+	  char *path, FILE *out)
+{
+    struct fnv_tree_node *an = &a->node[ai];	/* node in a */
+    struct fnv_tree_node *bn = &b->node[bi];	/* node in b */
+    size_t aend = ai + 1 + an->ndesc;	/* beyond an's descendants */
+    size_t bend = bi + 1 + bn->ndesc;	/* beyond bn's descendants */
+    unsigned long long ndiff = 0;	/* differences found */
+    size_t plen = strlen(path);	/* length of path */
+    size_t i, j;
+    char *sub;			/* path of a child */
+    int cmp;			/* name comparison */
+
+    if (an->type == bn->type && same_hash(an->hval, bn->hval)) {
+	return 0;
+    }
+    if (an->type != 'd' || bn->type != 'd') {
+	fprintf(out, "~ %s\n", path);
+	return 1;
+    }
+
+    /*
+     * merge the sorted children of both directories
+     */
+    i = ai + 1;
+    j = bi + 1;
+    while (i < aend || j < bend) {
+	if (i >= aend) {
+	    cmp = 1;
+	} else if (j >= bend) {
+	    cmp = -1;
+	} else {
+	    cmp = strcmp(a->node[i].name, b->node[j].name);
+	}
+	sub = malloc(plen + 1 + strlen(cmp > 0 ? b->node[j].name :
+					       a->node[i].name) + 1);
+	if (sub == NULL) {
+	    return ndiff + 1;
+	}
+	if (ai == 0) {
+	    strcpy(sub, cmp > 0 ? b->node[j].name : a->node[i].name);
+	} else {
+	    sprintf(sub, "%s/%s", path,
+		    cmp > 0 ? b->node[j].name : a->node[i].name);
+	}
+	if (cmp < 0) {
+	    fprintf(out, "- %s%s\n", sub, a->node[i].type == 'd' ? "/" : "");
+	    ++ndiff;
+	    i += 1 + a->node[i].ndesc;
+	} else if (cmp > 0) {
+	    fprintf(out, "+ %s%s\n", sub, b->node[j].type == 'd' ? "/" : "");
+	    ++ndiff;
+	    j += 1 + b->node[j].ndesc;
+	} else {
+	    ndiff += diff_node(a, i, b, j, sub, out);
+	    i += 1 + a->node[i].ndesc;
+	    j += 1 + b->node[j].ndesc;
+	}
+	free(sub);
+    }
+    return ndiff;
+}
+
+
+/*
+ * fnv_tree_diff - compare two trees from the top down
+ *
+ * input:
+ *	a	- first tree
+ *	b	- second tree, of the same hash type
+ *	out	- where to print the differences
+ *
+ * returns:
+ *	number of differences printed
+ *
+ * Only directories whose hashes differ are descended into.  Paths are
+ * relative to the roots.  Each difference is printed on a line as:
+ *
+ *	- path		only in a (a trailing / marks a directory)
+ *	+ path		only in b
+ *	~ path		changed file or symbolic link, or changed type
+ */
+unsigned long long
+fnv_tree_diff(struct fnv_tree *a, struct fnv_tree *b, FILE *out)
+{
+    if (a->nnode == 0 || b->nnode == 0) {
+	return (a->nnode != b->nnode) ? 1 : 0;
+    }
+    return diff_node(a, 0, b, 0, ".", out);
+}
+
+
+/*
+ * fnv_tree_free - free a tree
+ */
+void
+fnv_tree_free(struct fnv_tree *t)
+{
+    size_t i;
+
+    if (t == NULL) {
+	return;
+    }
+    if (t->buf == NULL) {
+	for (i = 0; i < t->nnode; ++i) {
+	    free(t->node[i].name);
+	}
+    }
+    free(t->node);
+    free(t->buf);
+    free(t);
+}
@@ -2237,21 +2237,38 @@ print_fnv32(Fnv32_t hval, Fnv32_t mask, int verbose, char *arg)
  */
 void
 print_fnv64(Fnv64_t hval, Fnv64_t mask, int verbose, char *arg)
+{
+    fprint_fnv64(stdout, hval, mask, verbose, arg);
+}
+
+
+/*
+ * fprint_fnv64 - print an FNV hash on a stream
+ *
+ * given:
+ *	stream	  where to print
+ *	hval	  the hash value to print
+ *	mask	  lower bit mask
+ *	verbose	  1 => print arg with hash
+ *	arg	  string or filename arg
+ */
+void
+fprint_fnv64(FILE *stream, Fnv64_t hval, Fnv64_t mask, int verbose, char *arg)
 {
 #if defined(HAVE_64BIT_LONG_LONG)
     if (verbose) {
-	printf("0x%016llx %s\n", (unsigned long long)(hval & mask), arg);
+	fprintf(stream, "0x%016llx %s\n", (unsigned long long)(hval & mask), arg);
     } else {
-	printf("0x%016llx\n", (unsigned long long)(hval & mask));
+	fprintf(stream, "0x%016llx\n", (unsigned long long)(hval & mask));
     }
 #else
     if (verbose) {
-	printf("0x%08x%08x %s\n",
+	fprintf(stream, "0x%08x%08x %s\n",
 	       hval.w32[1] & mask.w32[1],
 	       hval.w32[0] & mask.w32[0],
 	       arg);
     } else {
-	printf("0x%08x%08x\n",
+	fprintf(stream, "0x%08x%08x\n",
 	       hval.w32[1] & mask.w32[1],
 	       hval.w32[0] & mask.w32[0]);
     }